@@ -77,6 +77,8 @@ namespace Simd
         }
     };
 
+    typedef Array<uint8_t> Array8u;
+    typedef Array<int8_t> Array8i;
     typedef Array<int32_t> Array32i;
     typedef Array<float> Array32f;
 
@@ -22,6 +22,7 @@
 * SOFTWARE.
 */
 #include "Simd/SimdConvolution.h"
+#include "Simd/SimdSse1.h"
 #include "Simd/SimdAvx1.h"
 
 namespace Simd
@@ -32,15 +33,12 @@ namespace Simd
         ConvolutionImgToCol::ConvolutionImgToCol(const ConvParam & p)
             : Sse::ConvolutionImgToCol(p)
         {
+            SetGemm(Avx::Gemm32fInit(SimdFalse, SimdFalse, _M, _N, _K));
         }
 
         void ConvolutionImgToCol::GemmAndBias(const float * src, float * dst)
         {
-            const ConvParam & p = _param;
-            for (size_t g = 0; g < p.group; ++g)
-                Avx::Gemm32fNN(_M, _N, _K, &_1, _weight + _weightStep * g, _K, src + _srcStep * g, _N, &_0, dst + _dstStep * g, _N);
-            if (_bias)
-                Avx::SynetAddBias(_bias, p.dstC, p.dstH*p.dstW, dst);
+            RunGemm(_gemm, src, dst);
         }
 
         //---------------------------------------------------------------------
@@ -48,15 +46,12 @@ namespace Simd
         ConvolutionImgToRow::ConvolutionImgToRow(const ConvParam & p)
             : Sse3::ConvolutionImgToRow(p)
         {
+            SetGemm(Avx::Gemm32fInit(SimdFalse, SimdTrue, _M, _N, _K));
         }
 
         void ConvolutionImgToRow::GemmAndBias(const float * src, float * dst)
         {
-            const ConvParam & p = _param;
-            for (size_t g = 0; g < p.group; ++g)
-                Avx::Gemm32fNT(_M, _N, _K, &_1, _weight + _weightStep * g, _K, src + _srcStep * g, _K, &_0, dst + _dstStep * g, _N);
-            if (_bias)
-                Avx::SynetAddBias(_bias, p.dstC, p.dstH*p.dstW, dst);
+            RunGemm(_gemm, src, dst);
         }
 
         //---------------------------------------------------------------------
@@ -64,6 +59,7 @@ namespace Simd
         ConvolutionWinograd2x3p::ConvolutionWinograd2x3p(const ConvParam & p)
             : Sse::ConvolutionWinograd2x3p(p)
         {
+            _applyEpilogue = Avx::GemmApplyEpilogue;
         }
 
         void ConvolutionWinograd2x3p::Forward(const float * src, float * buf, float * dst)
@@ -71,21 +67,395 @@ namespace Simd
             const ConvParam & p = _param;
             float * bufS = Buffer(buf);
             float * bufD = bufS + _strideS * _count;
-            Avx::Winograd2x3pSetInput(src, p.srcC, p.srcH, p.srcW, buf, _pad);
-            for (size_t i = 0; i < _count; ++i)
-                Avx::Gemm32fNN(_M, _N, _K, &_1, _weight.data + i * _strideW, _K, bufS + i * _strideS, _N, &_0, bufD + i * _strideD, _N);
-            Avx::Winograd2x3pSetOutput(bufD, dst, p.dstC, p.dstH, p.dstW);
-            if (_bias)
-                Avx::SynetAddBias(_bias, p.dstC, p.dstH*p.dstW, dst);
+            for (size_t b = 0; b < p.batch; ++b)
+            {
+                Avx::Winograd2x3pSetInput(src, p.srcC, p.srcH, p.srcW, bufS, _pad);
+                Simd::Parallel(0, _count, [&](size_t thread, size_t begin, size_t end)
+                {
+                    for (size_t i = begin; i < end; ++i)
+                        Avx::Gemm32fNN(_M, _N, _K, &_1, _weight.data + i * _strideW, _K, bufS + i * _strideS, _N, &_0, bufD + i * _strideD, _N);
+                }, GemmBatchThreads(_count, _M, _N, _K));
+                Avx::Winograd2x3pSetOutput(bufD, dst, p.dstC, p.dstH, p.dstW);
+                ApplyEpilogue(_bias, dst);
+                src += p.SrcSize();
+                dst += p.DstSize();
+            }
         }
 
         //---------------------------------------------------------------------
 
-        void * ConvolutionInit(size_t srcC, size_t srcH, size_t srcW, size_t dstC, size_t kernelY, size_t kernelX, size_t dilationY, size_t dilationX, size_t strideY, size_t strideX, size_t padY, size_t padX, size_t padH, size_t padW, size_t group)
+        ConvolutionWinograd4x3p::ConvolutionWinograd4x3p(const ConvParam & p)
+            : Sse::ConvolutionWinograd4x3p(p)
+        {
+            _applyEpilogue = Avx::GemmApplyEpilogue;
+            SetGemm(Avx::Gemm32fInit(SimdFalse, SimdFalse, _M, _N, _K));
+        }
+
+        void ConvolutionWinograd4x3p::Forward(const float * src, float * buf, float * dst)
+        {
+            const ConvParam & p = _param;
+            float * bufS = Buffer(buf);
+            float * bufD = bufS + _strideS * _count;
+            for (size_t b = 0; b < p.batch; ++b)
+            {
+                Sse::Winograd4x3pSetInput(src, p.srcC, p.srcH, p.srcW, bufS, _pad);
+                _gemm->RunBatched(_count, &_1, _weight.data, _K, _strideW, bufS, _N, _strideS, &_0, bufD, _N, _strideD);
+                Sse::Winograd4x3pSetOutput(bufD, dst, p.dstC, p.dstH, p.dstW);
+                ApplyEpilogue(_bias, dst);
+                src += p.SrcSize();
+                dst += p.DstSize();
+            }
+        }
+
+        bool ConvolutionWinograd4x3p::Preferable(const ConvParam & p)
+        {
+            // The transforms are the 4-wide SSE ones, so with a wider GEMM 4x3p only pays off on large outputs with enough output channels.
+            return Base::ConvolutionWinograd4x3p::Preferable(p) && p.dstC >= 64 && p.dstH * p.dstW >= 48 * 48;
+        }
+
+        //---------------------------------------------------------------------
+
+        ConvolutionDepthwise::ConvolutionDepthwise(const ConvParam & p)
+            : Sse::ConvolutionDepthwise(p)
+        {
+            _applyEpilogue = Avx::GemmApplyEpilogue;
+        }
+
+        template<size_t stride> SIMD_INLINE __m256 DepthwiseLoad(const float * src);
+
+        template<> SIMD_INLINE __m256 DepthwiseLoad<1>(const float * src)
+        {
+            return _mm256_loadu_ps(src);
+        }
+
+        template<> SIMD_INLINE __m256 DepthwiseLoad<2>(const float * src)
+        {
+            __m256 lo = _mm256_loadu_ps(src), hi = _mm256_loadu_ps(src + F);
+            return _mm256_shuffle_ps(_mm256_permute2f128_ps(lo, hi, 0x20), _mm256_permute2f128_ps(lo, hi, 0x31), 0x88);
+        }
+
+        template<size_t kernel, size_t stride> SIMD_INLINE __m256 DepthwiseSum(const float * src, size_t srcW, const __m256 * weight)
+        {
+            __m256 sum = _mm256_setzero_ps();
+            for (size_t ky = 0; ky < kernel; ++ky, src += srcW, weight += kernel)
+                for (size_t kx = 0; kx < kernel; ++kx)
+                    sum = _mm256_add_ps(sum, _mm256_mul_ps(DepthwiseLoad<stride>(src + kx), weight[kx]));
+            return sum;
+        }
+
+        template<size_t kernel, size_t stride> void DepthwiseChannel(const float * src, size_t srcW, const float * weight, float bias, float * dst, size_t dstH, size_t dstW)
+        {
+            __m256 _weight[kernel * kernel];
+            for (size_t i = 0; i < kernel * kernel; ++i)
+                _weight[i] = _mm256_set1_ps(weight[i]);
+            __m256 _bias = _mm256_set1_ps(bias);
+            size_t dstWF = AlignLo(dstW, F);
+            for (size_t dy = 0; dy < dstH; ++dy)
+            {
+                for (size_t dx = 0; dx < dstWF; dx += F)
+                    _mm256_storeu_ps(dst + dx, _mm256_add_ps(_bias, DepthwiseSum<kernel, stride>(src + dx * stride, srcW, _weight)));
+                if (dstWF < dstW)
+                {
+                    size_t dx = dstW - F;
+                    _mm256_storeu_ps(dst + dx, _mm256_add_ps(_bias, DepthwiseSum<kernel, stride>(src + dx * stride, srcW, _weight)));
+                }
+                src += srcW * stride;
+                dst += dstW;
+            }
+        }
+
+        void ConvolutionDepthwise::ConvolveChannel(const float * src, const float * weight, float bias, float * dst)
+        {
+            const ConvParam & p = _param;
+            size_t srcW = _pad ? _srcW : p.srcW;
+            if (p.dstW < F)
+                Sse::ConvolutionDepthwise::ConvolveChannel(src, weight, bias, dst);
+            else if (p.IsKernel(3) && p.IsStride(1))
+                DepthwiseChannel<3, 1>(src, srcW, weight, bias, dst, p.dstH, p.dstW);
+            else if (p.IsKernel(3) && p.IsStride(2))
+                DepthwiseChannel<3, 2>(src, srcW, weight, bias, dst, p.dstH, p.dstW);
+            else if (p.IsKernel(5) && p.IsStride(1))
+                DepthwiseChannel<5, 1>(src, srcW, weight, bias, dst, p.dstH, p.dstW);
+            else if (p.IsKernel(5) && p.IsStride(2))
+                DepthwiseChannel<5, 2>(src, srcW, weight, bias, dst, p.dstH, p.dstW);
+            else
+                Sse::ConvolutionDepthwise::ConvolveChannel(src, weight, bias, dst);
+        }
+
+        //---------------------------------------------------------------------
+
+        ConvolutionNhwcGemm::ConvolutionNhwcGemm(const ConvParam & p)
+            : Sse::ConvolutionNhwcGemm(p)
+        {
+            SetGemm(Avx::Gemm32fInit(SimdFalse, SimdFalse, _M, _N, _K));
+        }
+
+        //---------------------------------------------------------------------
+
+        ConvolutionNhwcDirect::ConvolutionNhwcDirect(const ConvParam & p)
+            : Sse::ConvolutionNhwcDirect(p)
+        {
+            _applyEpilogue = Avx::GemmApplyEpilogue;
+        }
+
+        template<size_t count> SIMD_INLINE void NhwcDirectPixel(const ConvParam & p, const float * src, size_t dy, size_t dx, 
+            size_t srcC, const float * weight, const float * bias, float * dst)
+        {
+            __m256 sums[count];
+            for (size_t i = 0; i < count; ++i)
+                sums[i] = bias ? _mm256_loadu_ps(bias + i * F) : _mm256_setzero_ps();
+            for (size_t ky = 0; ky < p.kernelY; ++ky)
+            {
+                size_t sy = dy * p.strideY + ky * p.dilationY - p.padY;
+                if (sy >= p.srcH)
+                    continue;
+                for (size_t kx = 0; kx < p.kernelX; ++kx)
+                {
+                    size_t sx = dx * p.strideX + kx * p.dilationX - p.padX;
+                    if (sx >= p.srcW)
+                        continue;
+                    const float * ps = src + (sy * p.srcW + sx) * p.srcC;
+                    const float * pw = weight + (ky * p.kernelX + kx) * srcC * p.dstC;
+                    for (size_t sc = 0; sc < srcC; ++sc, pw += p.dstC)
+                    {
+                        __m256 s = _mm256_set1_ps(ps[sc]);
+                        for (size_t i = 0; i < count; ++i)
+                            sums[i] = _mm256_add_ps(sums[i], _mm256_mul_ps(s, _mm256_loadu_ps(pw + i * F)));
+                    }
+                }
+            }
+            for (size_t i = 0; i < count; ++i)
+                _mm256_storeu_ps(dst + i * F, sums[i]);
+        }
+
+        void ConvolutionNhwcDirect::ConvolvePixel(const float * src, size_t dy, size_t dx, float * dst)
+        {
+            const ConvParam & p = _param;
+            if (_dstC < F)
+            {
+                Sse::ConvolutionNhwcDirect::ConvolvePixel(src, dy, dx, dst);
+                return;
+            }
+            size_t dstCF = AlignLo(_dstC, F), dstC4F = AlignLo(_dstC, 4 * F);
+            for (size_t g = 0; g < p.group; ++g)
+            {
+                const float * ps = src + g * _srcC;
+                const float * pw = _weight + g * _dstC;
+                const float * pb = _bias ? _bias + g * _dstC : NULL;
+                float * pd = dst + g * _dstC;
+                size_t dc = 0;
+                for (; dc < dstC4F; dc += 4 * F)
+                    NhwcDirectPixel<4>(p, ps, dy, dx, _srcC, pw + dc, pb ? pb + dc : NULL, pd + dc);
+                for (; dc < dstCF; dc += F)
+                    NhwcDirectPixel<1>(p, ps, dy, dx, _srcC, pw + dc, pb ? pb + dc : NULL, pd + dc);
+                if (dc < _dstC)
+                {
+                    dc = _dstC - F;
+                    NhwcDirectPixel<1>(p, ps, dy, dx, _srcC, pw + dc, pb ? pb + dc : NULL, pd + dc);
+                }
+            }
+        }
+
+        template<size_t n, size_t m> SIMD_INLINE void NhwcDirectBody(const ConvParam & p, const float * src, size_t srcC, 
+            const float * weight, const float * bias, float * dst)
+        {
+            __m256 sums[n][m], w[m];
+            for (size_t i = 0; i < n; ++i)
+                for (size_t j = 0; j < m; ++j)
+                    sums[i][j] = bias ? _mm256_loadu_ps(bias + j * F) : _mm256_setzero_ps();
+            size_t strideX = p.strideX * p.srcC;
+            for (size_t ky = 0; ky < p.kernelY; ++ky)
+            {
+                for (size_t kx = 0; kx < p.kernelX; ++kx)
+                {
+                    const float * ps = src + (ky * p.dilationY * p.srcW + kx * p.dilationX) * p.srcC;
+                    const float * pw = weight + (ky * p.kernelX + kx) * srcC * p.dstC;
+                    for (size_t sc = 0; sc < srcC; ++sc, pw += p.dstC)
+                    {
+                        for (size_t j = 0; j < m; ++j)
+                            w[j] = _mm256_loadu_ps(pw + j * F);
+                        for (size_t i = 0; i < n; ++i)
+                        {
+                            __m256 s = _mm256_set1_ps(ps[i * strideX + sc]);
+                            for (size_t j = 0; j < m; ++j)
+                                sums[i][j] = _mm256_add_ps(sums[i][j], _mm256_mul_ps(s, w[j]));
+                        }
+                    }
+                }
+            }
+            for (size_t i = 0; i < n; ++i)
+                for (size_t j = 0; j < m; ++j)
+                    _mm256_storeu_ps(dst + i * p.dstC + j * F, sums[i][j]);
+        }
+
+        template<size_t m> SIMD_INLINE void NhwcDirectBody(const ConvParam & p, size_t n, const float * src, size_t srcC,
+            const float * weight, const float * bias, float * dst)
+        {
+            switch (n)
+            {
+            case 1: NhwcDirectBody<1, m>(p, src, srcC, weight, bias, dst); break;
+            case 2: NhwcDirectBody<2, m>(p, src, srcC, weight, bias, dst); break;
+            case 3: NhwcDirectBody<3, m>(p, src, srcC, weight, bias, dst); break;
+            case 4: NhwcDirectBody<4, m>(p, src, srcC, weight, bias, dst); break;
+            case 5: NhwcDirectBody<5, m>(p, src, srcC, weight, bias, dst); break;
+            case 6: NhwcDirectBody<6, m>(p, src, srcC, weight, bias, dst); break;
+            default: assert(0);
+            }
+        }
+
+        void ConvolutionNhwcDirect::ConvolveBody(const float * src, size_t dy, size_t dx, size_t n, float * dst)
+        {
+            const ConvParam & p = _param;
+            size_t dstCF = AlignLo(_dstC, F), dstC2F = AlignLo(_dstC, 2 * F);
+            src += ((dy * p.strideY - p.padY) * p.srcW + dx * p.strideX - p.padX) * p.srcC;
+            for (size_t g = 0; g < p.group; ++g)
+            {
+                const float * ps = src + g * _srcC;
+                const float * pw = _weight + g * _dstC;
+                const float * pb = _bias ? _bias + g * _dstC : NULL;
+                float * pd = dst + g * _dstC;
+                size_t dc = 0;
+                for (; dc < dstC2F; dc += 2 * F)
+                    NhwcDirectBody<2>(p, n, ps, _srcC, pw + dc, pb ? pb + dc : NULL, pd + dc);
+                for (; dc < dstCF; dc += F)
+                    NhwcDirectBody<1>(p, n, ps, _srcC, pw + dc, pb ? pb + dc : NULL, pd + dc);
+                if (dc < _dstC)
+                {
+                    dc = _dstC - F;
+                    NhwcDirectBody<1>(p, n, ps, _srcC, pw + dc, pb ? pb + dc : NULL, pd + dc);
+                }
+            }
+        }
+
+        void ConvolutionNhwcDirect::Forward(const float * src, float * buf, float * dst)
+        {
+            const ConvParam & p = _param;
+            if (_dstC < F)
+            {
+                Sse::ConvolutionNhwcDirect::Forward(src, buf, dst);
+                return;
+            }
+            GemmEpilogue epilogue = Epilogue(NULL, true);
+            size_t dyBeg, dyEnd, dxBeg, dxEnd;
+            BodyRange(p.srcH, p.dstH, p.kernelY, p.dilationY, p.strideY, p.padY, dyBeg, dyEnd);
+            BodyRange(p.srcW, p.dstW, p.kernelX, p.dilationX, p.strideX, p.padX, dxBeg, dxEnd);
+            for (size_t b = 0; b < p.batch; ++b)
+            {
+                for (size_t dy = 0; dy < p.dstH; ++dy)
+                {
+                    float * pd = dst + dy * p.dstW * p.dstC;
+                    size_t dx = 0;
+                    if (dy >= dyBeg && dy < dyEnd)
+                    {
+                        for (; dx < dxBeg; ++dx)
+                            ConvolvePixel(src, dy, dx, pd + dx * p.dstC);
+                        for (size_t n; dx < dxEnd; dx += n)
+                        {
+                            n = Simd::Min<size_t>(6, dxEnd - dx);
+                            ConvolveBody(src, dy, dx, n, pd + dx * p.dstC);
+                        }
+                    }
+                    for (; dx < p.dstW; ++dx)
+                        ConvolvePixel(src, dy, dx, pd + dx * p.dstC);
+                    if (!epilogue.Empty())
+                        _applyEpilogue(epilogue, 0, 0, p.dstW, p.dstC, pd, p.dstC);
+                }
+                src += p.SrcSize();
+                dst += p.DstSize();
+            }
+        }
+
+        //---------------------------------------------------------------------
+
+        ConvolutionNhwcDepthwise::ConvolutionNhwcDepthwise(const ConvParam & p)
+            : Sse::ConvolutionNhwcDepthwise(p)
+        {
+            _applyEpilogue = Avx::GemmApplyEpilogue;
+        }
+
+        template<size_t count> SIMD_INLINE void NhwcDepthwisePixel(const ConvParam & p, const float * src, size_t dy, size_t dx, 
+            const float * weight, const float * bias, float * dst)
+        {
+            __m256 sums[count];
+            for (size_t i = 0; i < count; ++i)
+                sums[i] = bias ? _mm256_loadu_ps(bias + i * F) : _mm256_setzero_ps();
+            for (size_t ky = 0; ky < p.kernelY; ++ky)
+            {
+                size_t sy = dy * p.strideY + ky * p.dilationY - p.padY;
+                if (sy >= p.srcH)
+                    continue;
+                for (size_t kx = 0; kx < p.kernelX; ++kx)
+                {
+                    size_t sx = dx * p.strideX + kx * p.dilationX - p.padX;
+                    if (sx >= p.srcW)
+                        continue;
+                    const float * ps = src + (sy * p.srcW + sx) * p.srcC;
+                    const float * pw = weight + (ky * p.kernelX + kx) * p.srcC;
+                    for (size_t i = 0; i < count; ++i)
+                        sums[i] = _mm256_add_ps(sums[i], _mm256_mul_ps(_mm256_loadu_ps(ps + i * F), _mm256_loadu_ps(pw + i * F)));
+                }
+            }
+            for (size_t i = 0; i < count; ++i)
+                _mm256_storeu_ps(dst + i * F, sums[i]);
+        }
+
+        void ConvolutionNhwcDepthwise::ConvolvePixel(const float * src, size_t dy, size_t dx, float * dst)
+        {
+            const ConvParam & p = _param;
+            size_t C = p.srcC;
+            if (C < F)
+            {
+                Sse::ConvolutionNhwcDepthwise::ConvolvePixel(src, dy, dx, dst);
+                return;
+            }
+            size_t CF = AlignLo(C, F), C4F = AlignLo(C, 4 * F), c = 0;
+            for (; c < C4F; c += 4 * F)
+                NhwcDepthwisePixel<4>(p, src + c, dy, dx, _weight + c, _bias ? _bias + c : NULL, dst + c);
+            for (; c < CF; c += F)
+                NhwcDepthwisePixel<1>(p, src + c, dy, dx, _weight + c, _bias ? _bias + c : NULL, dst + c);
+            if (c < C)
+            {
+                c = C - F;
+                NhwcDepthwisePixel<1>(p, src + c, dy, dx, _weight + c, _bias ? _bias + c : NULL, dst + c);
+            }
+        }
+
+        //---------------------------------------------------------------------
+
+        Convolution * ConvolutionCreate(const ConvParam & p, ConvolutionAlgorithm algorithm)
+        {
+            switch (algorithm)
+            {
+            case ConvolutionAlgorithmImgToCol: return new ConvolutionImgToCol(p);
+            case ConvolutionAlgorithmImgToRow: return new ConvolutionImgToRow(p);
+            case ConvolutionAlgorithmWinograd2x3p: return new ConvolutionWinograd2x3p(p);
+            case ConvolutionAlgorithmWinograd4x3p: return new ConvolutionWinograd4x3p(p);
+            case ConvolutionAlgorithmDirect: return new Base::ConvolutionDirect(p);
+            case ConvolutionAlgorithmDepthwise: return new ConvolutionDepthwise(p);
+            case ConvolutionAlgorithmNhwcGemm: return new ConvolutionNhwcGemm(p);
+            case ConvolutionAlgorithmNhwcDirect: return new ConvolutionNhwcDirect(p);
+            case ConvolutionAlgorithmNhwcDepthwise: return new ConvolutionNhwcDepthwise(p);
+            default: return NULL;
+            }
+        }
+
+        void * ConvolutionInit(SimdBool trans, size_t batch, size_t srcC, size_t srcH, size_t srcW, size_t dstC, size_t kernelY, size_t kernelX, size_t dilationY, size_t dilationX, size_t strideY, size_t strideX, size_t padY, size_t padX, size_t padH, size_t padW, size_t group, SimdConvolutionActivationType activation, const float * activationParams)
         {
-            ConvParam param(srcC, srcH, srcW, dstC, kernelY, kernelX, dilationY, dilationX, strideY, strideX, padY, padX, padH, padW, group);
-            if (ConvolutionWinograd2x3p::Preferable(param))
+            ConvParam param(trans, batch, srcC, srcH, srcW, dstC, kernelY, kernelX, dilationY, dilationX, strideY, strideX, padY, padX, padH, padW, group, activation, activationParams);
+            if (Convolution * convolution = Base::ConvolutionTune(param, "Avx", ConvolutionCreate))
+                return convolution;
+            if (ConvolutionNhwcDepthwise::Preferable(param))
+                return new ConvolutionNhwcDepthwise(param);
+            else if (ConvolutionNhwcDirect::Preferable(param))
+                return new ConvolutionNhwcDirect(param);
+            else if (ConvolutionNhwcGemm::Preferable(param))
+                return new ConvolutionNhwcGemm(param);
+            else if (ConvolutionWinograd4x3p::Preferable(param))
+                return new ConvolutionWinograd4x3p(param);
+            else if (ConvolutionWinograd2x3p::Preferable(param))
                 return new ConvolutionWinograd2x3p(param);
+            else if (ConvolutionDepthwise::Preferable(param))
+                return new ConvolutionDepthwise(param);
             else if (ConvolutionImgToRow::Preferable(param))
                 return new ConvolutionImgToRow(param);
             else
@@ -0,0 +1,59 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2018 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdDeconvolution.h"
+
+namespace Simd
+{
+#ifdef SIMD_AVX_ENABLE    
+    namespace Avx
+    {
+        DeconvolutionGemm::DeconvolutionGemm(const DeconvParam & p)
+            : Base::DeconvolutionGemm(p)
+        {
+            SetGemm(Avx::Gemm32fInit(SimdFalse, SimdFalse, _M, _N, _K));
+            _applyEpilogue = Avx::GemmApplyEpilogue;
+        }
+
+        //---------------------------------------------------------------------
+
+        DeconvolutionStride2::DeconvolutionStride2(const DeconvParam & p)
+            : Base::DeconvolutionStride2(p)
+        {
+            SetGemm(Avx::Gemm32fInit(SimdFalse, SimdFalse, _M, _N, _K));
+            _applyEpilogue = Avx::GemmApplyEpilogue;
+        }
+
+        //---------------------------------------------------------------------
+
+        void * DeconvolutionInit(SimdBool trans, size_t batch, size_t srcC, size_t srcH, size_t srcW, size_t dstC, size_t kernelY, size_t kernelX, size_t dilationY, size_t dilationX, size_t strideY, size_t strideX, size_t padY, size_t padX, size_t padH, size_t padW, size_t group, SimdConvolutionActivationType activation, const float * activationParams)
+        {
+            DeconvParam param(trans, batch, srcC, srcH, srcW, dstC, kernelY, kernelX, dilationY, dilationX, strideY, strideX, padY, padX, padH, padW, group, activation, activationParams);
+            if (DeconvolutionStride2::Preferable(param))
+                return new DeconvolutionStride2(param);
+            else
+                return new DeconvolutionGemm(param);
+        }
+    }
+#endif//SIMD_AVX_ENABLE
+}
@@ -429,6 +429,102 @@ namespace Simd
             }
         }
 
+        template<SimdConvolutionActivationType type> SIMD_INLINE __m256 GemmActivate(__m256 value, __m256 slope)
+        {
+            return value;
+        }
+
+        template<> SIMD_INLINE __m256 GemmActivate<SimdConvolutionActivationRelu>(__m256 value, __m256 slope)
+        {
+            return _mm256_max_ps(_mm256_setzero_ps(), value);
+        }
+
+        template<> SIMD_INLINE __m256 GemmActivate<SimdConvolutionActivationLeakyRelu>(__m256 value, __m256 slope)
+        {
+            return _mm256_add_ps(_mm256_max_ps(_mm256_setzero_ps(), value), _mm256_mul_ps(slope, _mm256_min_ps(_mm256_setzero_ps(), value)));
+        }
+
+        template<> SIMD_INLINE __m256 GemmActivate<SimdConvolutionActivationPrelu>(__m256 value, __m256 slope)
+        {
+            return _mm256_add_ps(_mm256_max_ps(_mm256_setzero_ps(), value), _mm256_mul_ps(slope, _mm256_min_ps(_mm256_setzero_ps(), value)));
+        }
+
+        // Sigmoid(x) = 0.5 + 0.5 * tanh(x / 2); tanh uses a [13/6] rational approximation (max error ~1e-7), so it needs only float arithmetic.
+        SIMD_INLINE __m256 GemmSigmoid(__m256 value)
+        {
+            __m256 x = _mm256_min_ps(_mm256_set1_ps(7.90531110f), _mm256_max_ps(_mm256_set1_ps(-7.90531110f), _mm256_mul_ps(value, _mm256_set1_ps(0.5f))));
+            __m256 x2 = _mm256_mul_ps(x, x);
+            __m256 p = _mm256_add_ps(_mm256_mul_ps(x2, _mm256_set1_ps(-2.76076847742355e-16f)), _mm256_set1_ps(2.00018790482477e-13f));
+            p = _mm256_add_ps(_mm256_mul_ps(p, x2), _mm256_set1_ps(-8.60467152213735e-11f));
+            p = _mm256_add_ps(_mm256_mul_ps(p, x2), _mm256_set1_ps(5.12229709037114e-08f));
+            p = _mm256_add_ps(_mm256_mul_ps(p, x2), _mm256_set1_ps(1.48572235717979e-05f));
+            p = _mm256_add_ps(_mm256_mul_ps(p, x2), _mm256_set1_ps(6.37261928875436e-04f));
+            p = _mm256_add_ps(_mm256_mul_ps(p, x2), _mm256_set1_ps(4.89352455891786e-03f));
+            __m256 q = _mm256_add_ps(_mm256_mul_ps(x2, _mm256_set1_ps(1.19825839466702e-06f)), _mm256_set1_ps(1.18534705686654e-04f));
+            q = _mm256_add_ps(_mm256_mul_ps(q, x2), _mm256_set1_ps(2.26843463243900e-03f));
+            q = _mm256_add_ps(_mm256_mul_ps(q, x2), _mm256_set1_ps(4.89352518554385e-03f));
+            __m256 half = _mm256_set1_ps(0.5f);
+            return _mm256_add_ps(half, _mm256_mul_ps(half, _mm256_div_ps(_mm256_mul_ps(x, p), q)));
+        }
+
+        template<> SIMD_INLINE __m256 GemmActivate<SimdConvolutionActivationSigmoid>(__m256 value, __m256 slope)
+        {
+            return GemmSigmoid(value);
+        }
+
+        template<SimdConvolutionActivationType type> void GemmApplyEpilogue(const GemmEpilogue & epilogue, size_t row, size_t col, size_t M, size_t N, float * C, size_t ldc)
+        {
+            const float * bias = epilogue.bias;
+            const float * slope = epilogue.params;
+            float leaky = type == SimdConvolutionActivationLeakyRelu ? slope[0] : 0.0f;
+            size_t NF = AlignLo(N, F);
+            for (size_t i = 0; i < M; ++i, C += ldc)
+            {
+                size_t j = 0;
+                if (epilogue.perColumn)
+                {
+                    __m256 _slope = _mm256_set1_ps(leaky);
+                    for (; j < NF; j += F)
+                    {
+                        __m256 value = _mm256_loadu_ps(C + j);
+                        if (bias)
+                            value = _mm256_add_ps(value, _mm256_loadu_ps(bias + col + j));
+                        if (type == SimdConvolutionActivationPrelu)
+                            _slope = _mm256_loadu_ps(slope + col + j);
+                        _mm256_storeu_ps(C + j, GemmActivate<type>(value, _slope));
+                    }
+                    for (; j < N; ++j)
+                    {
+                        float value = bias ? C[j] + bias[col + j] : C[j];
+                        C[j] = Base::GemmActivate<type>(value, type == SimdConvolutionActivationPrelu ? slope[col + j] : leaky);
+                    }
+                }
+                else
+                {
+                    float b = bias ? bias[row + i] : 0.0f;
+                    float s = type == SimdConvolutionActivationPrelu ? slope[row + i] : leaky;
+                    __m256 _bias = _mm256_set1_ps(b), _slope = _mm256_set1_ps(s);
+                    for (; j < NF; j += F)
+                        _mm256_storeu_ps(C + j, GemmActivate<type>(_mm256_add_ps(_mm256_loadu_ps(C + j), _bias), _slope));
+                    for (; j < N; ++j)
+                        C[j] = Base::GemmActivate<type>(C[j] + b, s);
+                }
+            }
+        }
+
+        void GemmApplyEpilogue(const GemmEpilogue & epilogue, size_t row, size_t col, size_t M, size_t N, float * C, size_t ldc)
+        {
+            switch (epilogue.activation)
+            {
+            case SimdConvolutionActivationIdentity: GemmApplyEpilogue<SimdConvolutionActivationIdentity>(epilogue, row, col, M, N, C, ldc); break;
+            case SimdConvolutionActivationRelu: GemmApplyEpilogue<SimdConvolutionActivationRelu>(epilogue, row, col, M, N, C, ldc); break;
+            case SimdConvolutionActivationLeakyRelu: GemmApplyEpilogue<SimdConvolutionActivationLeakyRelu>(epilogue, row, col, M, N, C, ldc); break;
+            case SimdConvolutionActivationPrelu: GemmApplyEpilogue<SimdConvolutionActivationPrelu>(epilogue, row, col, M, N, C, ldc); break;
+            case SimdConvolutionActivationSigmoid: GemmApplyEpilogue<SimdConvolutionActivationSigmoid>(epilogue, row, col, M, N, C, ldc); break;
+            default: Base::GemmApplyEpilogue(epilogue, row, col, M, N, C, ldc);
+            }
+        }
+
         void GemmPackB(const float * B, size_t ldb, size_t K, size_t N, size_t microN, float * pB)
         {
             for (size_t j = 0; j < N; j += microN)
@@ -579,11 +675,11 @@ namespace Simd
             }
         }
 
-        void Gemm32fNN(size_t M, size_t N, size_t K, const float * alpha, const float * A, size_t lda, const float * B, size_t ldb, const float * beta, float * C, size_t ldc)
+        static Gemm<float> * CreateGemm32fNN(size_t M, size_t N, size_t K, SimdBool transA = SimdFalse, SimdBool transB = SimdFalse)
         {
-            const size_t CACHE_L1_SIZE = 32 * 1024;
-            const size_t CACHE_L2_SIZE = 256 * 1024;
-            const size_t CACHE_L3_SIZE = 2 * 1024 * 1024;
+            const size_t CACHE_L1_SIZE = Base::AlgCacheL1();
+            const size_t CACHE_L2_SIZE = Base::AlgCacheL2();
+            const size_t CACHE_L3_SIZE = Base::AlgCacheL3();
             typedef Simd::GemmNN<float, size_t> GemmNN;
             GemmNN::Main kernelMM, kernelMT;
             GemmNN::Tail kernelTM, kernelTT;
@@ -619,9 +715,30 @@ namespace Simd
 #endif
             L1 = N > 4096 ? CACHE_L2_SIZE : CACHE_L1_SIZE;
             L2 = N > 4096 ? CACHE_L3_SIZE : CACHE_L2_SIZE;
-            GemmNN gemmNN(M, N, K, microM, microN, L1, L2, CACHE_L3_SIZE, F,
-                kernelMM, kernelMT, kernelTM, kernelTT, Avx::GemmScaleC, Avx::GemmPackB, NULL);
-            gemmNN.Run(alpha, A, lda, B, ldb, beta, C, ldc);
+            return new GemmNN(M, N, K, microM, microN, L1, L2, CACHE_L3_SIZE, F,
+                kernelMM, kernelMT, kernelTM, kernelTT, Avx::GemmScaleC, Avx::GemmPackB, NULL, Avx::GemmApplyEpilogue, 
+                transA ? Sse::GemmPackAT : NULL, transB ? Sse::GemmPackBT : NULL, Base::GemmPackA16);
+        }
+
+        void Gemm32fNN(size_t M, size_t N, size_t K, const float * alpha, const float * A, size_t lda, const float * B, size_t ldb, const float * beta, float * C, size_t ldc)
+        {
+            Gemm<float> * gemm = CreateGemm32fNN(M, N, K);
+            gemm->Run(alpha, A, lda, B, ldb, beta, C, ldc);
+            delete gemm;
+        }
+
+        void Gemm32fTN(size_t M, size_t N, size_t K, const float * alpha, const float * A, size_t lda, const float * B, size_t ldb, const float * beta, float * C, size_t ldc)
+        {
+            Gemm<float> * gemm = CreateGemm32fNN(M, N, K, SimdTrue, SimdFalse);
+            gemm->Run(alpha, A, lda, B, ldb, beta, C, ldc);
+            delete gemm;
+        }
+
+        void Gemm32fTT(size_t M, size_t N, size_t K, const float * alpha, const float * A, size_t lda, const float * B, size_t ldb, const float * beta, float * C, size_t ldc)
+        {
+            Gemm<float> * gemm = CreateGemm32fNN(M, N, K, SimdTrue, SimdTrue);
+            gemm->Run(alpha, A, lda, B, ldb, beta, C, ldc);
+            delete gemm;
         }
 
         //---------------------------------------------------------------------
@@ -739,7 +856,7 @@ namespace Simd
 
         static void Kernel2x4x8nt(size_t K, float alpha, const float * A, size_t lda, const float * B, size_t ldb, float * C, size_t ldc)
         {
-            size_t K8 = K & (~8);
+            size_t K8 = K & (~7);
             const float * A0 = A + 0 * lda;
             const float * A1 = A + 1 * lda;
             const float * B0 = B + 0 * ldb;
@@ -909,20 +1026,35 @@ namespace Simd
             Add4ExtractedSums(c20, c21, c22, c23, _alpha, C + 2 * ldc);
         }
 
-        void Gemm32fNT(size_t M, size_t N, size_t K, const float * alpha, const float * A, size_t lda, const float * B, size_t ldb, const float * beta, float * C, size_t ldc)
+        static Gemm<float> * CreateGemm32fNT(size_t M, size_t N, size_t K)
         {
-            const size_t CACHE_L1_SIZE = 32 * 1024;
-            const size_t CACHE_L2_SIZE = 256 * 1024;
-            const size_t CACHE_L3_SIZE = 2 * 1024 * 1024;
+            const size_t CACHE_L1_SIZE = Base::AlgCacheL1();
+            const size_t CACHE_L2_SIZE = Base::AlgCacheL2();
+            const size_t CACHE_L3_SIZE = Base::AlgCacheL3();
             typedef Simd::GemmNT<float> GemmNT;
 #ifdef SIMD_X64_ENABLE
-            GemmNT gemmNT(M, N, K, CACHE_L1_SIZE, CACHE_L2_SIZE, CACHE_L3_SIZE, F, Avx::GemmScaleC,
-                Kernel1x1x8nt, Kernel1x4x8nt, Kernel2x1x8nt, Kernel2x4x8nt, Kernel3x1x8nt, Kernel3x4x8nt, NULL, NULL);
+            return new GemmNT(M, N, K, CACHE_L1_SIZE, CACHE_L2_SIZE, CACHE_L3_SIZE, F, Avx::GemmScaleC,
+                Kernel1x1x8nt, Kernel1x4x8nt, Kernel2x1x8nt, Kernel2x4x8nt, Kernel3x1x8nt, Kernel3x4x8nt, NULL, NULL, Avx::GemmApplyEpilogue);
 #else
-            GemmNT gemmNT(M, N, K, CACHE_L1_SIZE, CACHE_L2_SIZE, CACHE_L3_SIZE, F, Sse::GemmScaleC,
-                Kernel1x1x8nt, Kernel1x4x8nt, NULL, NULL, NULL, NULL, NULL, NULL);
+            return new GemmNT(M, N, K, CACHE_L1_SIZE, CACHE_L2_SIZE, CACHE_L3_SIZE, F, Sse::GemmScaleC,
+                Kernel1x1x8nt, Kernel1x4x8nt, NULL, NULL, NULL, NULL, NULL, NULL, Avx::GemmApplyEpilogue);
 #endif
-            gemmNT.Run(alpha, A, lda, B, ldb, beta, C, ldc);
+        }
+
+        void Gemm32fNT(size_t M, size_t N, size_t K, const float * alpha, const float * A, size_t lda, const float * B, size_t ldb, const float * beta, float * C, size_t ldc)
+        {
+            Gemm<float> * gemm = CreateGemm32fNT(M, N, K);
+            gemm->Run(alpha, A, lda, B, ldb, beta, C, ldc);
+            delete gemm;
+        }
+
+        void * Gemm32fInit(SimdBool transA, SimdBool transB, size_t M, size_t N, size_t K)
+        {
+            if (transA)
+                return CreateGemm32fNN(M, N, K, transA, transB);
+            if (transB)
+                return CreateGemm32fNT(M, N, K);
+            return CreateGemm32fNN(M, N, K);
         }
     }
 #endif// SIMD_AVX_ENABLE
@@ -472,18 +472,12 @@ namespace Simd
             Winograd2x3pSetInput8Store(t, dst, dstStride);
         }
 
-        void Winograd2x3pSetInput(const float * src, size_t srcChannels, size_t srcHeight, size_t srcWidth, float * dst, int pad)
+        static void Winograd2x3pSetInput(const float * src, size_t srcChannels, size_t srcHeight, size_t srcWidth, float * dst, size_t dstStride, int pad)
         {
-            if (srcHeight < 4 || srcWidth < 18)
-            {
-                Sse::Winograd2x3pSetInput(src, srcChannels, srcHeight, srcWidth, dst, pad);
-                return;
-            }
             size_t dstH = pad ? srcHeight : srcHeight - 2;
             size_t dstW = pad ? srcWidth : srcWidth - 2;
             size_t tileH = (dstH + 1) / 2;
             size_t tileW = (dstW + 1) / 2;
-            size_t dstStride = srcChannels * tileH*tileW;
 
             size_t dstH2 = AlignLo(dstH, 2);
             size_t dstW2 = AlignLo(dstW, 2);
@@ -547,6 +541,16 @@ namespace Simd
             }
         }
 
+        void Winograd2x3pSetInput(const float * src, size_t srcChannels, size_t srcHeight, size_t srcWidth, float * dst, int pad)
+        {
+            if (srcHeight < 4 || srcWidth < 18)
+            {
+                Sse::Winograd2x3pSetInput(src, srcChannels, srcHeight, srcWidth, dst, pad);
+                return;
+            }
+            WinogradSetInput(Winograd2x3pSetInput, 2, src, srcChannels, srcHeight, srcWidth, dst, pad);
+        }
+
         SIMD_INLINE void Winograd2x3pSetOutputLoad2t(const float * src, size_t srcStride, __m256 * dst)
         {
             __m256 s0 = _mm256_loadu_ps(src + 0 * srcStride);
@@ -608,16 +612,10 @@ namespace Simd
             }
         }
 
-        void Winograd2x3pSetOutput(const float * src, float * dst, size_t dstChannels, size_t dstHeight, size_t dstWidth)
+        static void Winograd2x3pSetOutput(const float * src, size_t srcStride, float * dst, size_t dstChannels, size_t dstHeight, size_t dstWidth)
         {
-            if (dstHeight < 2 || dstWidth < 16)
-            {
-                Sse::Winograd2x3pSetOutput(src, dst, dstChannels, dstHeight, dstWidth);
-                return;
-            }
             size_t tileH = (dstHeight + 1) / 2;
             size_t tileW = (dstWidth + 1) / 2;
-            size_t srcStride = dstChannels * tileH*tileW;
             size_t dstH2 = AlignLo(dstHeight, 2);
             size_t dstW2 = AlignLo(dstWidth, 2);
             size_t dstW16 = AlignLo(dstWidth, 16);
@@ -651,6 +649,16 @@ namespace Simd
                 dst += dstHeight * dstWidth;
             }
         }
+
+        void Winograd2x3pSetOutput(const float * src, float * dst, size_t dstChannels, size_t dstHeight, size_t dstWidth)
+        {
+            if (dstHeight < 2 || dstWidth < 16)
+            {
+                Sse::Winograd2x3pSetOutput(src, dst, dstChannels, dstHeight, dstWidth);
+                return;
+            }
+            WinogradSetOutput(Winograd2x3pSetOutput, 2, src, dst, dstChannels, dstHeight, dstWidth);
+        }
     }
 #endif// SIMD_AVX_ENABLE
 }
@@ -24,6 +24,7 @@
 #include "Simd/SimdStore.h"
 #include "Simd/SimdExtract.h"
 #include "Simd/SimdGemm.h"
+#include "Simd/SimdAvx2.h"
 
 namespace Simd
 {
@@ -354,8 +355,13 @@ namespace Simd
 
         static void KernelMx8nn(size_t M, size_t N, size_t K, float alpha, const float * A, size_t lda, const float * B, size_t ldb, float * C, size_t ldc, size_t tail)
         {
+#ifdef SIMD_X64_ENABLE
+            __m256 c[6];
+            const float * a[6];
+#else
             __m256 c[4];
             const float * a[4];
+#endif
             for (size_t i = 0; i < M; ++i)
             {
                 c[i] = _mm256_setzero_ps();
@@ -433,11 +439,56 @@ namespace Simd
             }
         }
 
-        void Gemm32fNN(size_t M, size_t N, size_t K, const float * alpha, const float * A, size_t lda, const float * B, size_t ldb, const float * beta, float * C, size_t ldc)
+        void GemmApplyEpilogue(const GemmEpilogue & epilogue, size_t row, size_t col, size_t M, size_t N, float * C, size_t ldc)
+        {
+            if (epilogue.activation == SimdConvolutionActivationSigmoid)
+            {
+                const float slope = 1.0f;
+                if (epilogue.bias)
+                    Avx::GemmApplyEpilogue(GemmEpilogue(epilogue.bias, SimdConvolutionActivationIdentity, NULL, epilogue.perColumn), row, col, M, N, C, ldc);
+                for (size_t i = 0; i < M; ++i)
+                    NeuralSigmoid(C + i * ldc, N, &slope, C + i * ldc);
+            }
+            else
+                Avx::GemmApplyEpilogue(epilogue, row, col, M, N, C, ldc);
+        }
+
+        SIMD_INLINE __m256 GemmLoad16b(const uint16_t * src)
+        {
+            __m128i value = _mm_loadu_si128((__m128i*)src);
+            return _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_cvtepu16_epi32(value), 16));
+        }
+
+        void GemmPackA16(const uint16_t * A, size_t lda, size_t M, size_t K, SimdGemmFormatType format, bool trans, float * pA)
+        {
+            if (trans)
+            {
+                Base::GemmPackA16(A, lda, M, K, format, trans, pA);
+                return;
+            }
+            size_t KF = AlignLo(K, F);
+            for (size_t i = 0; i < M; ++i)
+            {
+                const uint16_t * a = A + i * lda;
+                float * p = pA + i * K;
+                if (format == SimdGemmFormat16f)
+                    Avx2::Float16ToFloat32(a, K, p);
+                else
+                {
+                    size_t k = 0;
+                    for (; k < KF; k += F)
+                        _mm256_storeu_ps(p + k, GemmLoad16b(a + k));
+                    if (k < K)
+                        Base::GemmPackA16(a + k, lda, 1, K - k, format, false, p + k);
+                }
+            }
+        }
+
+        static Gemm<float> * CreateGemm32fNN(size_t M, size_t N, size_t K, SimdBool transA = SimdFalse, SimdBool transB = SimdFalse)
         {
-            const size_t CACHE_L1_SIZE = 32 * 1024;
-            const size_t CACHE_L2_SIZE = 256 * 1024;
-            const size_t CACHE_L3_SIZE = 2 * 1024 * 1024;
+            const size_t CACHE_L1_SIZE = Base::AlgCacheL1();
+            const size_t CACHE_L2_SIZE = Base::AlgCacheL2();
+            const size_t CACHE_L3_SIZE = Base::AlgCacheL3();
             typedef Simd::GemmNN<float, size_t> GemmNN;
             GemmNN::Main kernelMM, kernelMT;
             GemmNN::Tail kernelTM, kernelTT;
@@ -473,9 +524,30 @@ namespace Simd
 #endif
             L1 = N > 4096 ? CACHE_L2_SIZE : CACHE_L1_SIZE;
             L2 = N > 4096 ? CACHE_L3_SIZE : CACHE_L2_SIZE;
-            GemmNN gemmNN(M, N, K, microM, microN, L1, L2, CACHE_L3_SIZE, F,
-                kernelMM, kernelMT, kernelTM, kernelTT, Avx::GemmScaleC, Avx::GemmPackB, NULL);
-            gemmNN.Run(alpha, A, lda, B, ldb, beta, C, ldc);
+            return new GemmNN(M, N, K, microM, microN, L1, L2, CACHE_L3_SIZE, F,
+                kernelMM, kernelMT, kernelTM, kernelTT, Avx::GemmScaleC, Avx::GemmPackB, NULL, Avx2::GemmApplyEpilogue, 
+                transA ? Sse::GemmPackAT : NULL, transB ? Sse::GemmPackBT : NULL, Avx2::GemmPackA16);
+        }
+
+        void Gemm32fNN(size_t M, size_t N, size_t K, const float * alpha, const float * A, size_t lda, const float * B, size_t ldb, const float * beta, float * C, size_t ldc)
+        {
+            Gemm<float> * gemm = CreateGemm32fNN(M, N, K);
+            gemm->Run(alpha, A, lda, B, ldb, beta, C, ldc);
+            delete gemm;
+        }
+
+        void Gemm32fTN(size_t M, size_t N, size_t K, const float * alpha, const float * A, size_t lda, const float * B, size_t ldb, const float * beta, float * C, size_t ldc)
+        {
+            Gemm<float> * gemm = CreateGemm32fNN(M, N, K, SimdTrue, SimdFalse);
+            gemm->Run(alpha, A, lda, B, ldb, beta, C, ldc);
+            delete gemm;
+        }
+
+        void Gemm32fTT(size_t M, size_t N, size_t K, const float * alpha, const float * A, size_t lda, const float * B, size_t ldb, const float * beta, float * C, size_t ldc)
+        {
+            Gemm<float> * gemm = CreateGemm32fNN(M, N, K, SimdTrue, SimdTrue);
+            gemm->Run(alpha, A, lda, B, ldb, beta, C, ldc);
+            delete gemm;
         }
 
         //---------------------------------------------------------------------
@@ -593,7 +665,7 @@ namespace Simd
 
         static void Kernel2x4x8nt(size_t K, float alpha, const float * A, size_t lda, const float * B, size_t ldb, float * C, size_t ldc)
         {
-            size_t K8 = K & (~8);
+            size_t K8 = K & (~7);
             const float * A0 = A + 0 * lda;
             const float * A1 = A + 1 * lda;
             const float * B0 = B + 0 * ldb;
@@ -763,20 +835,35 @@ namespace Simd
             Add4ExtractedSums(c20, c21, c22, c23, _alpha, C + 2 * ldc);
         }
 
-        void Gemm32fNT(size_t M, size_t N, size_t K, const float * alpha, const float * A, size_t lda, const float * B, size_t ldb, const float * beta, float * C, size_t ldc)
+        static Gemm<float> * CreateGemm32fNT(size_t M, size_t N, size_t K)
         {
-            const size_t CACHE_L1_SIZE = 32 * 1024;
-            const size_t CACHE_L2_SIZE = 256 * 1024;
-            const size_t CACHE_L3_SIZE = 2 * 1024 * 1024;
+            const size_t CACHE_L1_SIZE = Base::AlgCacheL1();
+            const size_t CACHE_L2_SIZE = Base::AlgCacheL2();
+            const size_t CACHE_L3_SIZE = Base::AlgCacheL3();
             typedef Simd::GemmNT<float> GemmNT;
 #ifdef SIMD_X64_ENABLE
-            GemmNT gemmNT(M, N, K, CACHE_L1_SIZE, CACHE_L2_SIZE, CACHE_L3_SIZE, F, Avx::GemmScaleC,
-                Kernel1x1x8nt, Kernel1x4x8nt, Kernel2x1x8nt, Kernel2x4x8nt, Kernel3x1x8nt, Kernel3x4x8nt, NULL, NULL);
+            return new GemmNT(M, N, K, CACHE_L1_SIZE, CACHE_L2_SIZE, CACHE_L3_SIZE, F, Avx::GemmScaleC,
+                Kernel1x1x8nt, Kernel1x4x8nt, Kernel2x1x8nt, Kernel2x4x8nt, Kernel3x1x8nt, Kernel3x4x8nt, NULL, NULL, Avx2::GemmApplyEpilogue);
 #else
-            GemmNT gemmNT(M, N, K, CACHE_L1_SIZE, CACHE_L2_SIZE, CACHE_L3_SIZE, F, Sse::GemmScaleC,
-                Kernel1x1x8nt, Kernel1x4x8nt, NULL, NULL, NULL, NULL, NULL, NULL);
+            return new GemmNT(M, N, K, CACHE_L1_SIZE, CACHE_L2_SIZE, CACHE_L3_SIZE, F, Sse::GemmScaleC,
+                Kernel1x1x8nt, Kernel1x4x8nt, NULL, NULL, NULL, NULL, NULL, NULL, Avx2::GemmApplyEpilogue);
 #endif
-            gemmNT.Run(alpha, A, lda, B, ldb, beta, C, ldc);
+        }
+
+        void Gemm32fNT(size_t M, size_t N, size_t K, const float * alpha, const float * A, size_t lda, const float * B, size_t ldb, const float * beta, float * C, size_t ldc)
+        {
+            Gemm<float> * gemm = CreateGemm32fNT(M, N, K);
+            gemm->Run(alpha, A, lda, B, ldb, beta, C, ldc);
+            delete gemm;
+        }
+
+        void * Gemm32fInit(SimdBool transA, SimdBool transB, size_t M, size_t N, size_t K)
+        {
+            if (transA)
+                return CreateGemm32fNN(M, N, K, transA, transB);
+            if (transB)
+                return CreateGemm32fNT(M, N, K);
+            return CreateGemm32fNN(M, N, K);
         }
     }
 #endif// SIMD_AVX2_ENABLE
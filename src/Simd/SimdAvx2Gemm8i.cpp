@@ -0,0 +1,171 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2018 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdStore.h"
+#include "Simd/SimdGemm.h"
+
+namespace Simd
+{
+#ifdef SIMD_AVX2_ENABLE
+    namespace Avx2
+    {
+        SIMD_INLINE void Gemm8u8iSave(const __m256i * sum, const GemmRequant & requant, size_t col, size_t N, int32_t * C)
+        {
+            if (N == 16)
+            {
+                _mm256_storeu_si256((__m256i*)C + 0, sum[0]);
+                _mm256_storeu_si256((__m256i*)C + 1, sum[1]);
+            }
+            else
+            {
+                SIMD_ALIGNED(32) int32_t buffer[16];
+                _mm256_store_si256((__m256i*)buffer + 0, sum[0]);
+                _mm256_store_si256((__m256i*)buffer + 1, sum[1]);
+                for (size_t j = 0; j < N; ++j)
+                    C[j] = buffer[j];
+            }
+        }
+
+        SIMD_INLINE __m256i Gemm8u8iRequantize(__m256i sum, const GemmRequant & requant, size_t col)
+        {
+            __m256i value = requant.bias ? _mm256_add_epi32(sum, _mm256_loadu_si256((__m256i*)(requant.bias + col))) : sum;
+            __m256 scaled = _mm256_mul_ps(_mm256_cvtepi32_ps(value), _mm256_loadu_ps(requant.scale + col));
+            return _mm256_add_epi32(_mm256_cvtps_epi32(scaled), _mm256_set1_epi32(requant.zero));
+        }
+
+        SIMD_INLINE void Gemm8u8iSave(const __m256i * sum, const GemmRequant & requant, size_t col, size_t N, uint8_t * C)
+        {
+            if (N == 16)
+            {
+                __m256i lo = Gemm8u8iRequantize(sum[0], requant, col + 0);
+                __m256i hi = Gemm8u8iRequantize(sum[1], requant, col + 8);
+                __m256i value = PackU16ToU8(PackI32ToI16(lo, hi), K_ZERO);
+                _mm_storeu_si128((__m128i*)C, _mm256_castsi256_si128(value));
+            }
+            else
+            {
+                SIMD_ALIGNED(32) int32_t buffer[16];
+                _mm256_store_si256((__m256i*)buffer + 0, sum[0]);
+                _mm256_store_si256((__m256i*)buffer + 1, sum[1]);
+                for (size_t j = 0; j < N; ++j)
+                    C[j] = Base::GemmRequantize(buffer[j], requant, col + j);
+            }
+        }
+
+        void Gemm8iPackA(const uint8_t * A, size_t lda, size_t M, size_t K, size_t group, int32_t * pA)
+        {
+            assert(group == 2);
+            size_t KG = AlignHi(K, 2) / 2, K16 = AlignLo(K, 16);
+            for (size_t i = 0; i < M; ++i, A += lda, pA += KG)
+            {
+                uint16_t * pa = (uint16_t*)pA;
+                size_t k = 0;
+                for (; k < K16; k += 16)
+                    _mm256_storeu_si256((__m256i*)(pa + k), _mm256_cvtepu8_epi16(_mm_loadu_si128((__m128i*)(A + k))));
+                for (; k < K; ++k)
+                    pa[k] = A[k];
+                if (K & 1)
+                    pa[K] = 0;
+            }
+        }
+
+        void Gemm8iPackB(const int8_t * B, size_t ldb, size_t K, size_t N, size_t microN, size_t group, int8_t * pB)
+        {
+            assert(group == 2 && microN % 16 == 0);
+            size_t K2 = AlignLo(K, 2);
+            for (size_t j = 0; j < N; j += microN)
+            {
+                size_t n = Simd::Min(N, j + microN) - j;
+                if (n < microN)
+                {
+                    Base::Gemm8iPackB(B + j, ldb, K, n, microN, group, pB);
+                    break;
+                }
+                for (size_t k = 0; k < K2; k += 2)
+                {
+                    const int8_t * b = B + k * ldb + j;
+                    for (size_t c = 0; c < microN; c += 16, pB += 64)
+                    {
+                        __m256i b0 = _mm256_cvtepi8_epi16(_mm_loadu_si128((__m128i*)(b + c)));
+                        __m256i b1 = _mm256_cvtepi8_epi16(_mm_loadu_si128((__m128i*)(b + ldb + c)));
+                        __m256i lo = _mm256_unpacklo_epi16(b0, b1), hi = _mm256_unpackhi_epi16(b0, b1);
+                        _mm256_storeu_si256((__m256i*)pB + 0, _mm256_permute2x128_si256(lo, hi, 0x20));
+                        _mm256_storeu_si256((__m256i*)pB + 1, _mm256_permute2x128_si256(lo, hi, 0x31));
+                    }
+                }
+                if (K2 < K)
+                {
+                    Base::Gemm8iPackB(B + K2 * ldb + j, ldb, K - K2, microN, microN, group, pB);
+                    pB += 4 * microN;
+                }
+            }
+        }
+
+        template<class TC, int M> void Gemm8u8iKernel(size_t N, size_t KG, const int32_t * pA, const int8_t * pB, const GemmRequant & requant, size_t col, TC * C, size_t ldc)
+        {
+            __m256i sum[M][2];
+            for (size_t m = 0; m < M; ++m)
+                sum[m][0] = sum[m][1] = _mm256_setzero_si256();
+            for (size_t k = 0; k < KG; ++k, pB += 64)
+            {
+                __m256i b0 = _mm256_loadu_si256((__m256i*)pB + 0);
+                __m256i b1 = _mm256_loadu_si256((__m256i*)pB + 1);
+                for (size_t m = 0; m < M; ++m)
+                {
+                    __m256i a0 = _mm256_set1_epi32(pA[m * KG + k]);
+                    sum[m][0] = _mm256_add_epi32(sum[m][0], _mm256_madd_epi16(a0, b0));
+                    sum[m][1] = _mm256_add_epi32(sum[m][1], _mm256_madd_epi16(a0, b1));
+                }
+            }
+            for (size_t m = 0; m < M; ++m)
+                Gemm8u8iSave(sum[m], requant, col, N, C + m * ldc);
+        }
+
+        template<class TC> void Gemm8u8iKernel(size_t M, size_t N, size_t KG, const int32_t * pA, const int8_t * pB, const GemmRequant & requant, size_t col, TC * C, size_t ldc)
+        {
+            switch (M)
+            {
+            case 1: Gemm8u8iKernel<TC, 1>(N, KG, pA, pB, requant, col, C, ldc); break;
+            case 2: Gemm8u8iKernel<TC, 2>(N, KG, pA, pB, requant, col, C, ldc); break;
+            case 3: Gemm8u8iKernel<TC, 3>(N, KG, pA, pB, requant, col, C, ldc); break;
+            case 4: Gemm8u8iKernel<TC, 4>(N, KG, pA, pB, requant, col, C, ldc); break;
+            case 5: Gemm8u8iKernel<TC, 5>(N, KG, pA, pB, requant, col, C, ldc); break;
+            case 6: Gemm8u8iKernel<TC, 6>(N, KG, pA, pB, requant, col, C, ldc); break;
+            default: assert(0);
+            }
+        }
+
+        void Gemm8u8i32iNN(size_t M, size_t N, size_t K, const uint8_t * A, size_t lda, const int8_t * B, size_t ldb, int32_t * C, size_t ldc)
+        {
+            Gemm8u8iNN<int32_t> gemm(M, N, K, 6, 16, 2, Base::AlgCacheL2(), Gemm8u8iKernel<int32_t>, Gemm8iPackA, Gemm8iPackB);
+            gemm.Run(A, lda, B, ldb, GemmRequant(), C, ldc);
+        }
+
+        void Gemm8u8i8uNN(size_t M, size_t N, size_t K, const uint8_t * A, size_t lda, const int8_t * B, size_t ldb, const int32_t * bias, const float * scale, uint8_t zero, uint8_t * C, size_t ldc)
+        {
+            Gemm8u8iNN<uint8_t> gemm(M, N, K, 6, 16, 2, Base::AlgCacheL2(), Gemm8u8iKernel<uint8_t>, Gemm8iPackA, Gemm8iPackB);
+            gemm.Run(A, lda, B, ldb, GemmRequant(bias, scale, zero), C, ldc);
+        }
+    }
+#endif// SIMD_AVX2_ENABLE
+}
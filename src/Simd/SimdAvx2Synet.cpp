@@ -105,6 +105,65 @@ namespace Simd
                 SynetEltwiseLayerForwardSum<false>(src, weight, count, size, dst);
         }
 
+        template <bool align, class Activation> SIMD_INLINE void SynetActivation32f(const float * src, size_t size, const Activation & activation, float * dst)
+        {
+            size_t partial = AlignLo(size, F);
+            size_t i = 0;
+            for (; i < partial; i += F)
+                Avx::Store<align>(dst + i, activation(Avx::Load<align>(src + i)));
+            if (i < size)
+            {
+                float buffer[F] = { 0 };
+                for (size_t j = i; j < size; ++j)
+                    buffer[j - i] = src[j];
+                Avx::Store<false>(buffer, activation(Avx::Load<false>(buffer)));
+                for (size_t j = i; j < size; ++j)
+                    dst[j] = buffer[j - i];
+            }
+        }
+
+        template <class Activation> SIMD_INLINE void SynetActivation32f(const float * src, size_t size, const Activation & activation, float * dst)
+        {
+            if (Aligned(src) && Aligned(dst))
+                SynetActivation32f<true>(src, size, activation, dst);
+            else
+                SynetActivation32f<false>(src, size, activation, dst);
+        }
+
+        void SynetElu32f(const float * src, size_t size, const float * alpha, float * dst)
+        {
+            __m256 _alpha = _mm256_set1_ps(alpha[0]);
+            __m256 _one = _mm256_set1_ps(1.0f);
+            SynetActivation32f(src, size, [&](__m256 x)
+            {
+                __m256 e = Exponent(_mm256_min_ps(x, _mm256_setzero_ps()));
+                return _mm256_fmadd_ps(_alpha, _mm256_sub_ps(e, _one), _mm256_max_ps(x, _mm256_setzero_ps()));
+            }, dst);
+        }
+
+        void SynetGelu32f(const float * src, size_t size, float * dst)
+        {
+            __m256 _k0 = _mm256_set1_ps(-1.5957691216f);
+            __m256 _k1 = _mm256_set1_ps(0.044715f);
+            __m256 _one = _mm256_set1_ps(1.0f);
+            SynetActivation32f(src, size, [&](__m256 x)
+            {
+                __m256 u = _mm256_mul_ps(_k0, _mm256_fmadd_ps(_k1, _mm256_mul_ps(x, _mm256_mul_ps(x, x)), x));
+                return _mm256_div_ps(x, _mm256_add_ps(_one, Exponent(u)));
+            }, dst);
+        }
+
+        void SynetHswish32f(const float * src, size_t size, const float * shift, const float * scale, float * dst)
+        {
+            __m256 _shift = _mm256_set1_ps(shift[0]);
+            __m256 _scale = _mm256_set1_ps(scale[0]);
+            SynetActivation32f(src, size, [&](__m256 x)
+            {
+                __m256 t = _mm256_max_ps(_mm256_add_ps(_mm256_min_ps(x, _shift), _shift), _mm256_setzero_ps());
+                return _mm256_mul_ps(_mm256_mul_ps(t, _scale), x);
+            }, dst);
+        }
+
         template <bool align> SIMD_INLINE void SynetLrnLayerCrossChannels(const float * src, size_t half, size_t count, size_t size, const float * k, float * dst)
         {
             size_t aligned = AlignLo(size, F);
@@ -233,6 +292,109 @@ namespace Simd
             else
                 SynetScaleLayerForward<false>(src, scale, bias, count, size, dst);
         }
+
+        void SynetSigmoid32f(const float * src, size_t size, float * dst)
+        {
+            SynetActivation32f(src, size, [](__m256 x) { return Sigmoid(x); }, dst);
+        }
+
+        void SynetSoftmaxLayerForward(const float * src, size_t outer, size_t count, size_t inner, float * dst)
+        {
+            if (inner == 1)
+            {
+                size_t aligned = AlignLo(count, F);
+                for (size_t o = 0; o < outer; ++o)
+                {
+                    __m256 _max = _mm256_set1_ps(-FLT_MAX);
+                    size_t c = 0;
+                    for (; c < aligned; c += F)
+                        _max = _mm256_max_ps(_max, Avx::Load<false>(src + c));
+                    float max = Avx::ExtractMax(_max);
+                    for (; c < count; ++c)
+                        max = Simd::Max(max, src[c]);
+                    _max = _mm256_set1_ps(max);
+                    __m256 _sum = _mm256_setzero_ps();
+                    for (c = 0; c < aligned; c += F)
+                    {
+                        __m256 exp = Exponent(_mm256_sub_ps(Avx::Load<false>(src + c), _max));
+                        Avx::Store<false>(dst + c, exp);
+                        _sum = _mm256_add_ps(_sum, exp);
+                    }
+                    float sum = Avx::ExtractSum(_sum);
+                    for (; c < count; ++c)
+                    {
+                        dst[c] = ::expf(src[c] - max);
+                        sum += dst[c];
+                    }
+                    float k = 1.0f / sum;
+                    __m256 _k = _mm256_set1_ps(k);
+                    for (c = 0; c < aligned; c += F)
+                        Avx::Store<false>(dst + c, _mm256_mul_ps(Avx::Load<false>(dst + c), _k));
+                    for (; c < count; ++c)
+                        dst[c] *= k;
+                    src += count;
+                    dst += count;
+                }
+            }
+            else
+            {
+                size_t aligned = AlignLo(inner, F);
+                Array32f buffer(inner * 2);
+                float * max = buffer.data, * sum = buffer.data + inner;
+                for (size_t o = 0; o < outer; ++o)
+                {
+                    memcpy(max, src, inner * sizeof(float));
+                    for (size_t c = 1; c < count; ++c)
+                    {
+                        const float * s = src + c * inner;
+                        size_t j = 0;
+                        for (; j < aligned; j += F)
+                            Avx::Store<false>(max + j, _mm256_max_ps(Avx::Load<false>(max + j), Avx::Load<false>(s + j)));
+                        for (; j < inner; ++j)
+                            max[j] = Simd::Max(max[j], s[j]);
+                    }
+                    memset(sum, 0, inner * sizeof(float));
+                    for (size_t c = 0; c < count; ++c)
+                    {
+                        const float * s = src + c * inner;
+                        float * d = dst + c * inner;
+                        size_t j = 0;
+                        for (; j < aligned; j += F)
+                        {
+                            __m256 exp = Exponent(_mm256_sub_ps(Avx::Load<false>(s + j), Avx::Load<false>(max + j)));
+                            Avx::Store<false>(d + j, exp);
+                            Avx::Store<false>(sum + j, _mm256_add_ps(Avx::Load<false>(sum + j), exp));
+                        }
+                        for (; j < inner; ++j)
+                        {
+                            d[j] = ::expf(s[j] - max[j]);
+                            sum[j] += d[j];
+                        }
+                    }
+                    size_t j = 0;
+                    for (; j < aligned; j += F)
+                        Avx::Store<false>(sum + j, _mm256_div_ps(_mm256_set1_ps(1.0f), Avx::Load<false>(sum + j)));
+                    for (; j < inner; ++j)
+                        sum[j] = 1.0f / sum[j];
+                    for (size_t c = 0; c < count; ++c)
+                    {
+                        float * d = dst + c * inner;
+                        size_t j = 0;
+                        for (; j < aligned; j += F)
+                            Avx::Store<false>(d + j, _mm256_mul_ps(Avx::Load<false>(d + j), Avx::Load<false>(sum + j)));
+                        for (; j < inner; ++j)
+                            d[j] *= sum[j];
+                    }
+                    src += count * inner;
+                    dst += count * inner;
+                }
+            }
+        }
+
+        void SynetTanh32f(const float * src, size_t size, float * dst)
+        {
+            SynetActivation32f(src, size, [](__m256 x) { return Tanh(x); }, dst);
+        }
     }
 #endif// SIMD_AVX2_ENABLE
 }
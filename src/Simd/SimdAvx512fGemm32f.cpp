@@ -24,6 +24,7 @@
 #include "Simd/SimdStore.h"
 #include "Simd/SimdExtract.h"
 #include "Simd/SimdGemm.h"
+#include "Simd/SimdAvx512f.h"
 
 namespace Simd
 {
@@ -875,6 +876,89 @@ namespace Simd
             }
         }
 
+        template<SimdConvolutionActivationType type> SIMD_INLINE __m512 GemmActivate(__m512 value, __m512 slope)
+        {
+            return value;
+        }
+
+        template<> SIMD_INLINE __m512 GemmActivate<SimdConvolutionActivationRelu>(__m512 value, __m512 slope)
+        {
+            return _mm512_max_ps(_mm512_setzero_ps(), value);
+        }
+
+        template<> SIMD_INLINE __m512 GemmActivate<SimdConvolutionActivationLeakyRelu>(__m512 value, __m512 slope)
+        {
+            return _mm512_fmadd_ps(slope, _mm512_min_ps(_mm512_setzero_ps(), value), _mm512_max_ps(_mm512_setzero_ps(), value));
+        }
+
+        template<> SIMD_INLINE __m512 GemmActivate<SimdConvolutionActivationPrelu>(__m512 value, __m512 slope)
+        {
+            return _mm512_fmadd_ps(slope, _mm512_min_ps(_mm512_setzero_ps(), value), _mm512_max_ps(_mm512_setzero_ps(), value));
+        }
+
+        template<SimdConvolutionActivationType type> SIMD_INLINE void GemmActivate(float * C, const float * bias, const float * slope, __m512 _slope, __mmask16 mask = -1)
+        {
+            __m512 value = _mm512_maskz_loadu_ps(mask, C);
+            if (bias)
+                value = _mm512_add_ps(value, _mm512_maskz_loadu_ps(mask, bias));
+            if (type == SimdConvolutionActivationPrelu)
+                _slope = _mm512_maskz_loadu_ps(mask, slope);
+            _mm512_mask_storeu_ps(C, mask, GemmActivate<type>(value, _slope));
+        }
+
+        template<SimdConvolutionActivationType type> void GemmApplyEpilogue(const GemmEpilogue & epilogue, size_t row, size_t col, size_t M, size_t N, float * C, size_t ldc)
+        {
+            const float * bias = epilogue.bias;
+            const float * slope = epilogue.params;
+            float leaky = type == SimdConvolutionActivationLeakyRelu ? slope[0] : 0.0f;
+            size_t NF = AlignLo(N, F);
+            __mmask16 tail = TailMask16(N - NF);
+            for (size_t i = 0; i < M; ++i, C += ldc)
+            {
+                size_t j = 0;
+                if (epilogue.perColumn)
+                {
+                    const float * pb = bias ? bias + col : NULL;
+                    const float * ps = type == SimdConvolutionActivationPrelu ? slope + col : NULL;
+                    __m512 _slope = _mm512_set1_ps(leaky);
+                    for (; j < NF; j += F)
+                        GemmActivate<type>(C + j, pb ? pb + j : NULL, ps ? ps + j : NULL, _slope);
+                    if (j < N)
+                        GemmActivate<type>(C + j, pb ? pb + j : NULL, ps ? ps + j : NULL, _slope, tail);
+                }
+                else
+                {
+                    __m512 _bias = _mm512_set1_ps(bias ? bias[row + i] : 0.0f);
+                    __m512 _slope = _mm512_set1_ps(type == SimdConvolutionActivationPrelu ? slope[row + i] : leaky);
+                    for (; j < NF; j += F)
+                        _mm512_storeu_ps(C + j, GemmActivate<type>(_mm512_add_ps(_mm512_loadu_ps(C + j), _bias), _slope));
+                    if (j < N)
+                        _mm512_mask_storeu_ps(C + j, tail, GemmActivate<type>(_mm512_add_ps(_mm512_maskz_loadu_ps(tail, C + j), _bias), _slope));
+                }
+            }
+        }
+
+        void GemmApplyEpilogue(const GemmEpilogue & epilogue, size_t row, size_t col, size_t M, size_t N, float * C, size_t ldc)
+        {
+            switch (epilogue.activation)
+            {
+            case SimdConvolutionActivationIdentity: GemmApplyEpilogue<SimdConvolutionActivationIdentity>(epilogue, row, col, M, N, C, ldc); break;
+            case SimdConvolutionActivationRelu: GemmApplyEpilogue<SimdConvolutionActivationRelu>(epilogue, row, col, M, N, C, ldc); break;
+            case SimdConvolutionActivationLeakyRelu: GemmApplyEpilogue<SimdConvolutionActivationLeakyRelu>(epilogue, row, col, M, N, C, ldc); break;
+            case SimdConvolutionActivationPrelu: GemmApplyEpilogue<SimdConvolutionActivationPrelu>(epilogue, row, col, M, N, C, ldc); break;
+            case SimdConvolutionActivationSigmoid:
+            {
+                const float one = 1.0f;
+                if (epilogue.bias)
+                    GemmApplyEpilogue<SimdConvolutionActivationIdentity>(epilogue, row, col, M, N, C, ldc);
+                for (size_t i = 0; i < M; ++i)
+                    NeuralSigmoid(C + i * ldc, N, &one, C + i * ldc);
+                break;
+            }
+            default: assert(0);
+            }
+        }
+
         static void PackA(const float * src, size_t stride, size_t M, size_t K, size_t cell, float * dst)
         {
             size_t K4 = AlignLo(K, 4), K8 = AlignLo(K, 8);
@@ -988,11 +1072,11 @@ namespace Simd
             }
         }
 
-        void Gemm32fNN(size_t M, size_t N, size_t K, const float * alpha, const float * A, size_t lda, const float * B, size_t ldb, const float * beta, float * C, size_t ldc)
+        static Gemm<float> * CreateGemm32fNN(size_t M, size_t N, size_t K, SimdBool transA = SimdFalse, SimdBool transB = SimdFalse)
         {
-            const size_t CACHE_L1_SIZE = 32 * 1024;
-            const size_t CACHE_L2_SIZE = 256 * 1024;
-            const size_t CACHE_L3_SIZE = 2 * 1024 * 1024;
+            const size_t CACHE_L1_SIZE = Base::AlgCacheL1();
+            const size_t CACHE_L2_SIZE = Base::AlgCacheL2();
+            const size_t CACHE_L3_SIZE = Base::AlgCacheL3();
             typedef Simd::GemmNN<float, __mmask16> GemmNN;
             GemmNN::Main kernelMM, kernelMT;
             GemmNN::Tail kernelTM, kernelTT;
@@ -1047,9 +1131,30 @@ namespace Simd
             kernelTM = KernelMx16nn;
             kernelTT = KernelMx16nn;
 #endif
-            GemmNN gemmNN(M, N, K, microM, microN, CACHE_L2_SIZE, CACHE_L3_SIZE, CACHE_L3_SIZE, F,
-                kernelMM, kernelMT, kernelTM, kernelTT, Avx512f::ScaleC, Avx512f::PackB, TailMask16);
-            gemmNN.Run(alpha, A, lda, B, ldb, beta, C, ldc);
+            return new GemmNN(M, N, K, microM, microN, CACHE_L2_SIZE, CACHE_L3_SIZE, CACHE_L3_SIZE, F,
+                kernelMM, kernelMT, kernelTM, kernelTT, Avx512f::ScaleC, Avx512f::PackB, TailMask16, Avx512f::GemmApplyEpilogue, 
+                transA ? Sse::GemmPackAT : NULL, transB ? Sse::GemmPackBT : NULL, Avx2::GemmPackA16);
+        }
+
+        void Gemm32fNN(size_t M, size_t N, size_t K, const float * alpha, const float * A, size_t lda, const float * B, size_t ldb, const float * beta, float * C, size_t ldc)
+        {
+            Gemm<float> * gemm = CreateGemm32fNN(M, N, K);
+            gemm->Run(alpha, A, lda, B, ldb, beta, C, ldc);
+            delete gemm;
+        }
+
+        void Gemm32fTN(size_t M, size_t N, size_t K, const float * alpha, const float * A, size_t lda, const float * B, size_t ldb, const float * beta, float * C, size_t ldc)
+        {
+            Gemm<float> * gemm = CreateGemm32fNN(M, N, K, SimdTrue, SimdFalse);
+            gemm->Run(alpha, A, lda, B, ldb, beta, C, ldc);
+            delete gemm;
+        }
+
+        void Gemm32fTT(size_t M, size_t N, size_t K, const float * alpha, const float * A, size_t lda, const float * B, size_t ldb, const float * beta, float * C, size_t ldc)
+        {
+            Gemm<float> * gemm = CreateGemm32fNN(M, N, K, SimdTrue, SimdTrue);
+            gemm->Run(alpha, A, lda, B, ldb, beta, C, ldc);
+            delete gemm;
         }
 
         //---------------------------------------------------------------------
@@ -1164,7 +1269,7 @@ namespace Simd
 
         static void Kernel2x4x16nt(size_t K, float alpha, const float * A, size_t lda, const float * B, size_t ldb, float * C, size_t ldc)
         {
-            size_t K16 = K & (~16);
+            size_t K16 = K & (~15);
             const float * A0 = A + 0 * lda;
             const float * A1 = A + 1 * lda;
             const float * B0 = B + 0 * ldb;
@@ -1516,23 +1621,38 @@ namespace Simd
             Add4ExtractedSums(c50, c51, c52, c53, _alpha, C + 5 * ldc);
         }
 
-        void Gemm32fNT(size_t M, size_t N, size_t K, const float * alpha, const float * A, size_t lda, const float * B, size_t ldb, const float * beta, float * C, size_t ldc)
+        static Gemm<float> * CreateGemm32fNT(size_t M, size_t N, size_t K)
         {
-            const size_t CACHE_L1_SIZE = 32 * 1024;
-            const size_t CACHE_L2_SIZE = 256 * 1024;
-            const size_t CACHE_L3_SIZE = 2 * 1024 * 1024;
+            const size_t CACHE_L1_SIZE = Base::AlgCacheL1();
+            const size_t CACHE_L2_SIZE = Base::AlgCacheL2();
+            const size_t CACHE_L3_SIZE = Base::AlgCacheL3();
             typedef Simd::GemmNT<float> GemmNT;
 #if SIMD_ZMM_COUNT == 32
-            GemmNT gemmNT(M, N, K, CACHE_L1_SIZE, CACHE_L2_SIZE, CACHE_L3_SIZE, F, Avx::GemmScaleC,
-                Kernel1x1x16nt, Kernel1x4x16nt, Kernel2x1x16nt, Kernel2x4x16nt, Kernel3x1x16nt, Kernel3x4x16nt, Kernel6x1x16nt, Kernel6x4x16nt);
+            return new GemmNT(M, N, K, CACHE_L1_SIZE, CACHE_L2_SIZE, CACHE_L3_SIZE, F, Avx::GemmScaleC,
+                Kernel1x1x16nt, Kernel1x4x16nt, Kernel2x1x16nt, Kernel2x4x16nt, Kernel3x1x16nt, Kernel3x4x16nt, Kernel6x1x16nt, Kernel6x4x16nt, Avx512f::GemmApplyEpilogue);
 #elif defined(SIMD_X64_ENABLE)
-            GemmNT gemmNT(M, N, K, CACHE_L1_SIZE, CACHE_L2_SIZE, CACHE_L3_SIZE, F, Avx::GemmScaleC,
-                Kernel1x1x16nt, Kernel1x4x16nt, Kernel2x1x16nt, Kernel2x4x16nt, Kernel3x1x16nt, Kernel3x4x16nt, NULL, NULL);
+            return new GemmNT(M, N, K, CACHE_L1_SIZE, CACHE_L2_SIZE, CACHE_L3_SIZE, F, Avx::GemmScaleC,
+                Kernel1x1x16nt, Kernel1x4x16nt, Kernel2x1x16nt, Kernel2x4x16nt, Kernel3x1x16nt, Kernel3x4x16nt, NULL, NULL, Avx512f::GemmApplyEpilogue);
 #else
-            GemmNT gemmNT(M, N, K, CACHE_L1_SIZE, CACHE_L2_SIZE, CACHE_L3_SIZE, F, Sse::GemmScaleC,
-                Kernel1x1x16nt, Kernel1x4x16nt, NULL, NULL, NULL, NULL, NULL, NULL);
+            return new GemmNT(M, N, K, CACHE_L1_SIZE, CACHE_L2_SIZE, CACHE_L3_SIZE, F, Sse::GemmScaleC,
+                Kernel1x1x16nt, Kernel1x4x16nt, NULL, NULL, NULL, NULL, NULL, NULL, Avx512f::GemmApplyEpilogue);
 #endif
-            gemmNT.Run(alpha, A, lda, B, ldb, beta, C, ldc);
+        }
+
+        void Gemm32fNT(size_t M, size_t N, size_t K, const float * alpha, const float * A, size_t lda, const float * B, size_t ldb, const float * beta, float * C, size_t ldc)
+        {
+            Gemm<float> * gemm = CreateGemm32fNT(M, N, K);
+            gemm->Run(alpha, A, lda, B, ldb, beta, C, ldc);
+            delete gemm;
+        }
+
+        void * Gemm32fInit(SimdBool transA, SimdBool transB, size_t M, size_t N, size_t K)
+        {
+            if (transA)
+                return CreateGemm32fNN(M, N, K, transA, transB);
+            if (transB)
+                return CreateGemm32fNT(M, N, K);
+            return CreateGemm32fNN(M, N, K);
         }
     }
 #endif// SIMD_AVX512F_ENABLE
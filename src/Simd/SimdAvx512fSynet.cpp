@@ -210,6 +210,59 @@ namespace Simd
                 SynetEltwiseLayerForward<false>(src, weight, count, size, type, dst);
         }
 
+        template <bool align, class Activation> SIMD_INLINE void SynetActivation32f(const float * src, size_t size, const Activation & activation, float * dst)
+        {
+            size_t partial = AlignLo(size, F);
+            __mmask16 tail = __mmask16(-1) >> (F + partial - size);
+            size_t i = 0;
+            for (; i < partial; i += F)
+                Store<align>(dst + i, activation(Load<align>(src + i)));
+            if (i < size)
+                Store<align, true>(dst + i, activation(Load<align, true>(src + i, tail)), tail);
+        }
+
+        template <class Activation> SIMD_INLINE void SynetActivation32f(const float * src, size_t size, const Activation & activation, float * dst)
+        {
+            if (Aligned(src) && Aligned(dst))
+                SynetActivation32f<true>(src, size, activation, dst);
+            else
+                SynetActivation32f<false>(src, size, activation, dst);
+        }
+
+        void SynetElu32f(const float * src, size_t size, const float * alpha, float * dst)
+        {
+            __m512 _alpha = _mm512_set1_ps(alpha[0]);
+            __m512 _one = _mm512_set1_ps(1.0f);
+            SynetActivation32f(src, size, [&](__m512 x)
+            {
+                __m512 e = Exponent(_mm512_min_ps(x, _mm512_setzero_ps()));
+                return _mm512_fmadd_ps(_alpha, _mm512_sub_ps(e, _one), _mm512_max_ps(x, _mm512_setzero_ps()));
+            }, dst);
+        }
+
+        void SynetGelu32f(const float * src, size_t size, float * dst)
+        {
+            __m512 _k0 = _mm512_set1_ps(-1.5957691216f);
+            __m512 _k1 = _mm512_set1_ps(0.044715f);
+            __m512 _one = _mm512_set1_ps(1.0f);
+            SynetActivation32f(src, size, [&](__m512 x)
+            {
+                __m512 u = _mm512_mul_ps(_k0, _mm512_fmadd_ps(_k1, _mm512_mul_ps(x, _mm512_mul_ps(x, x)), x));
+                return _mm512_div_ps(x, _mm512_add_ps(_one, Exponent(u)));
+            }, dst);
+        }
+
+        void SynetHswish32f(const float * src, size_t size, const float * shift, const float * scale, float * dst)
+        {
+            __m512 _shift = _mm512_set1_ps(shift[0]);
+            __m512 _scale = _mm512_set1_ps(scale[0]);
+            SynetActivation32f(src, size, [&](__m512 x)
+            {
+                __m512 t = _mm512_max_ps(_mm512_add_ps(_mm512_min_ps(x, _shift), _shift), _mm512_setzero_ps());
+                return _mm512_mul_ps(_mm512_mul_ps(t, _scale), x);
+            }, dst);
+        }
+
         template <bool align> SIMD_INLINE void SynetLrnLayerCrossChannels(const float * src, size_t half, size_t count, size_t size, const float * k, float * dst)
         {
             size_t aligned = AlignLo(size, F);
@@ -342,6 +395,110 @@ namespace Simd
             else
                 SynetScaleLayerForward<false>(src, scale, bias, count, size, dst);
         }
+
+        void SynetSigmoid32f(const float * src, size_t size, float * dst)
+        {
+            SynetActivation32f(src, size, [](__m512 x) { return Sigmoid(x); }, dst);
+        }
+
+        void SynetSoftmaxLayerForward(const float * src, size_t outer, size_t count, size_t inner, float * dst)
+        {
+            if (inner == 1)
+            {
+                size_t aligned = AlignLo(count, F);
+                __mmask16 tail = __mmask16(-1) >> (F + aligned - count);
+                for (size_t o = 0; o < outer; ++o)
+                {
+                    __m512 _max = _mm512_set1_ps(-FLT_MAX);
+                    size_t c = 0;
+                    for (; c < aligned; c += F)
+                        _max = _mm512_max_ps(_max, Load<false>(src + c));
+                    if (c < count)
+                        _max = _mm512_mask_max_ps(_max, tail, _max, Load<false, true>(src + c, tail));
+                    _max = _mm512_set1_ps(_mm512_reduce_max_ps(_max));
+                    __m512 _sum = _mm512_setzero_ps();
+                    for (c = 0; c < aligned; c += F)
+                    {
+                        __m512 exp = Exponent(_mm512_sub_ps(Load<false>(src + c), _max));
+                        Store<false>(dst + c, exp);
+                        _sum = _mm512_add_ps(_sum, exp);
+                    }
+                    if (c < count)
+                    {
+                        __m512 exp = Exponent(_mm512_sub_ps(Load<false, true>(src + c, tail), _max));
+                        Store<false, true>(dst + c, exp, tail);
+                        _sum = _mm512_mask_add_ps(_sum, tail, _sum, exp);
+                    }
+                    __m512 _k = _mm512_set1_ps(1.0f / ExtractSum(_sum));
+                    for (c = 0; c < aligned; c += F)
+                        Store<false>(dst + c, _mm512_mul_ps(Load<false>(dst + c), _k));
+                    if (c < count)
+                        Store<false, true>(dst + c, _mm512_mul_ps(Load<false, true>(dst + c, tail), _k), tail);
+                    src += count;
+                    dst += count;
+                }
+            }
+            else
+            {
+                size_t aligned = AlignLo(inner, F);
+                __mmask16 tail = __mmask16(-1) >> (F + aligned - inner);
+                Array32f buffer(inner * 2);
+                float * max = buffer.data, * sum = buffer.data + inner;
+                for (size_t o = 0; o < outer; ++o)
+                {
+                    memcpy(max, src, inner * sizeof(float));
+                    for (size_t c = 1; c < count; ++c)
+                    {
+                        const float * s = src + c * inner;
+                        size_t j = 0;
+                        for (; j < aligned; j += F)
+                            Store<false>(max + j, _mm512_max_ps(Load<false>(max + j), Load<false>(s + j)));
+                        if (j < inner)
+                            Store<false, true>(max + j, _mm512_max_ps(Load<false, true>(max + j, tail), Load<false, true>(s + j, tail)), tail);
+                    }
+                    memset(sum, 0, inner * sizeof(float));
+                    for (size_t c = 0; c < count; ++c)
+                    {
+                        const float * s = src + c * inner;
+                        float * d = dst + c * inner;
+                        size_t j = 0;
+                        for (; j < aligned; j += F)
+                        {
+                            __m512 exp = Exponent(_mm512_sub_ps(Load<false>(s + j), Load<false>(max + j)));
+                            Store<false>(d + j, exp);
+                            Store<false>(sum + j, _mm512_add_ps(Load<false>(sum + j), exp));
+                        }
+                        if (j < inner)
+                        {
+                            __m512 exp = Exponent(_mm512_sub_ps(Load<false, true>(s + j, tail), Load<false, true>(max + j, tail)));
+                            Store<false, true>(d + j, exp, tail);
+                            Store<false, true>(sum + j, _mm512_add_ps(Load<false, true>(sum + j, tail), exp), tail);
+                        }
+                    }
+                    size_t j = 0;
+                    for (; j < aligned; j += F)
+                        Store<false>(sum + j, _mm512_div_ps(_mm512_set1_ps(1.0f), Load<false>(sum + j)));
+                    if (j < inner)
+                        Store<false, true>(sum + j, _mm512_div_ps(_mm512_set1_ps(1.0f), Load<false, true>(sum + j, tail)), tail);
+                    for (size_t c = 0; c < count; ++c)
+                    {
+                        float * d = dst + c * inner;
+                        size_t j = 0;
+                        for (; j < aligned; j += F)
+                            Store<false>(d + j, _mm512_mul_ps(Load<false>(d + j), Load<false>(sum + j)));
+                        if (j < inner)
+                            Store<false, true>(d + j, _mm512_mul_ps(Load<false, true>(d + j, tail), Load<false, true>(sum + j, tail)), tail);
+                    }
+                    src += count * inner;
+                    dst += count * inner;
+                }
+            }
+        }
+
+        void SynetTanh32f(const float * src, size_t size, float * dst)
+        {
+            SynetActivation32f(src, size, [](__m512 x) { return Tanh(x); }, dst);
+        }
     }
 #endif// SIMD_AVX512F_ENABLE
 }
@@ -25,6 +25,7 @@
 #include "Simd/SimdStore.h"
 #include "Simd/SimdExtract.h"
 #include "Simd/SimdSet.h"
+#include "Simd/SimdWinograd.h"
 #include "Simd/SimdBase.h"
 
 namespace Simd
@@ -101,18 +102,12 @@ namespace Simd
             Winograd2x3pSetInput16Store<mask>(t, dst, dstStride, tails);
         }
 
-        void Winograd2x3pSetInput(const float * src, size_t srcChannels, size_t srcHeight, size_t srcWidth, float * dst, int pad)
+        static void Winograd2x3pSetInput(const float * src, size_t srcChannels, size_t srcHeight, size_t srcWidth, float * dst, size_t dstStride, int pad)
         {
-            if (srcHeight < 4 || srcWidth < 4)
-            {
-                Base::Winograd2x3pSetInput(src, srcChannels, srcHeight, srcWidth, dst, pad);
-                return;
-            }
             size_t dstH = pad ? srcHeight : srcHeight - 2;
             size_t dstW = pad ? srcWidth : srcWidth - 2;
             size_t tileH = (dstH + 1) / 2;
             size_t tileW = (dstW + 1) / 2;
-            size_t dstStride = srcChannels * tileH*tileW;
 
             size_t dstH2 = AlignLo(dstH, 2);
             size_t dstW2 = AlignLo(dstW, 2);
@@ -186,6 +181,16 @@ namespace Simd
             }
         }
 
+        void Winograd2x3pSetInput(const float * src, size_t srcChannels, size_t srcHeight, size_t srcWidth, float * dst, int pad)
+        {
+            if (srcHeight < 4 || srcWidth < 4)
+            {
+                Base::Winograd2x3pSetInput(src, srcChannels, srcHeight, srcWidth, dst, pad);
+                return;
+            }
+            WinogradSetInput(Winograd2x3pSetInput, 2, src, srcChannels, srcHeight, srcWidth, dst, pad);
+        }
+
         template<bool mask> SIMD_INLINE void Winograd2x3pSetOutputLoad2t(const float * src, size_t srcStride, __m512 * dst, __mmask16 tail)
         {
             __m512 s0 = Load<false, mask>(src + 0 * srcStride, tail);
@@ -217,11 +222,10 @@ namespace Simd
             }
         }
 
-        void Winograd2x3pSetOutput(const float * src, float * dst, size_t dstChannels, size_t dstHeight, size_t dstWidth)
+        static void Winograd2x3pSetOutput(const float * src, size_t srcStride, float * dst, size_t dstChannels, size_t dstHeight, size_t dstWidth)
         {
             size_t tileH = (dstHeight + 1) / 2;
             size_t tileW = (dstWidth + 1) / 2;
-            size_t srcStride = dstChannels * tileH*tileW;
             size_t dstH2 = AlignLo(dstHeight, 2);
             size_t dstW2 = AlignLo(dstWidth, 2);
             size_t dstW32 = AlignLo(dstWidth, 32);
@@ -256,6 +260,11 @@ namespace Simd
                 dst += dstHeight * dstWidth;
             }
         }
+
+        void Winograd2x3pSetOutput(const float * src, float * dst, size_t dstChannels, size_t dstHeight, size_t dstWidth)
+        {
+            WinogradSetOutput(Winograd2x3pSetOutput, 2, src, dst, dstChannels, dstHeight, dstWidth);
+        }
     }
 #endif// SIMD_AVX512F_ENABLE
 }
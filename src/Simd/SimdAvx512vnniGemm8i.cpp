@@ -0,0 +1,120 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2018 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdMath.h"
+#include "Simd/SimdGemm.h"
+
+namespace Simd
+{
+#ifdef SIMD_AVX512VNNI_ENABLE
+    namespace Avx512vnni
+    {
+        void Gemm8iPackB(const int8_t * B, size_t ldb, size_t K, size_t N, size_t microN, size_t group, int8_t * pB)
+        {
+            assert(group == 4 && microN % 16 == 0);
+            size_t K4 = AlignLo(K, 4);
+            for (size_t j = 0; j < N; j += microN)
+            {
+                size_t n = Simd::Min(N, j + microN) - j;
+                if (n < microN)
+                {
+                    Base::Gemm8iPackB(B + j, ldb, K, n, microN, group, pB);
+                    break;
+                }
+                for (size_t k = 0; k < K4; k += 4)
+                {
+                    const int8_t * b = B + k * ldb + j;
+                    for (size_t c = 0; c < microN; c += 16, pB += 64)
+                    {
+                        __m128i b0 = _mm_loadu_si128((__m128i*)(b + 0 * ldb + c));
+                        __m128i b1 = _mm_loadu_si128((__m128i*)(b + 1 * ldb + c));
+                        __m128i b2 = _mm_loadu_si128((__m128i*)(b + 2 * ldb + c));
+                        __m128i b3 = _mm_loadu_si128((__m128i*)(b + 3 * ldb + c));
+                        __m128i b01lo = _mm_unpacklo_epi8(b0, b1), b01hi = _mm_unpackhi_epi8(b0, b1);
+                        __m128i b23lo = _mm_unpacklo_epi8(b2, b3), b23hi = _mm_unpackhi_epi8(b2, b3);
+                        _mm_storeu_si128((__m128i*)pB + 0, _mm_unpacklo_epi16(b01lo, b23lo));
+                        _mm_storeu_si128((__m128i*)pB + 1, _mm_unpackhi_epi16(b01lo, b23lo));
+                        _mm_storeu_si128((__m128i*)pB + 2, _mm_unpacklo_epi16(b01hi, b23hi));
+                        _mm_storeu_si128((__m128i*)pB + 3, _mm_unpackhi_epi16(b01hi, b23hi));
+                    }
+                }
+                if (K4 < K)
+                {
+                    Base::Gemm8iPackB(B + K4 * ldb + j, ldb, K - K4, microN, microN, group, pB);
+                    pB += 4 * microN;
+                }
+            }
+        }
+
+        template<class TC, int M> void Gemm8u8iKernel(size_t N, size_t KG, const int32_t * pA, const int8_t * pB, const GemmRequant & requant, size_t col, TC * C, size_t ldc)
+        {
+            __m512i sum[M][2];
+            for (size_t m = 0; m < M; ++m)
+                sum[m][0] = sum[m][1] = _mm512_setzero_si512();
+            for (size_t k = 0; k < KG; ++k, pB += 128)
+            {
+                __m512i b0 = _mm512_loadu_si512((__m512i*)pB + 0);
+                __m512i b1 = _mm512_loadu_si512((__m512i*)pB + 1);
+                for (size_t m = 0; m < M; ++m)
+                {
+                    __m512i a0 = _mm512_set1_epi32(pA[m * KG + k]);
+                    sum[m][0] = _mm512_dpbusd_epi32(sum[m][0], a0, b0);
+                    sum[m][1] = _mm512_dpbusd_epi32(sum[m][1], a0, b1);
+                }
+            }
+            __mmask16 tail0 = Avx512f::TailMask16(N), tail1 = Avx512f::TailMask16(N - 16);
+            for (size_t m = 0; m < M; ++m)
+            {
+                Avx512bw::Gemm8u8iSave(sum[m][0], requant, col + 0, tail0, C + m * ldc + 0);
+                Avx512bw::Gemm8u8iSave(sum[m][1], requant, col + 16, tail1, C + m * ldc + 16);
+            }
+        }
+
+        template<class TC> void Gemm8u8iKernel(size_t M, size_t N, size_t KG, const int32_t * pA, const int8_t * pB, const GemmRequant & requant, size_t col, TC * C, size_t ldc)
+        {
+            switch (M)
+            {
+            case 1: Gemm8u8iKernel<TC, 1>(N, KG, pA, pB, requant, col, C, ldc); break;
+            case 2: Gemm8u8iKernel<TC, 2>(N, KG, pA, pB, requant, col, C, ldc); break;
+            case 3: Gemm8u8iKernel<TC, 3>(N, KG, pA, pB, requant, col, C, ldc); break;
+            case 4: Gemm8u8iKernel<TC, 4>(N, KG, pA, pB, requant, col, C, ldc); break;
+            case 5: Gemm8u8iKernel<TC, 5>(N, KG, pA, pB, requant, col, C, ldc); break;
+            case 6: Gemm8u8iKernel<TC, 6>(N, KG, pA, pB, requant, col, C, ldc); break;
+            default: assert(0);
+            }
+        }
+
+        void Gemm8u8i32iNN(size_t M, size_t N, size_t K, const uint8_t * A, size_t lda, const int8_t * B, size_t ldb, int32_t * C, size_t ldc)
+        {
+            Gemm8u8iNN<int32_t> gemm(M, N, K, 6, 32, 4, Base::AlgCacheL2(), Gemm8u8iKernel<int32_t>, Base::Gemm8iPackA, Gemm8iPackB);
+            gemm.Run(A, lda, B, ldb, GemmRequant(), C, ldc);
+        }
+
+        void Gemm8u8i8uNN(size_t M, size_t N, size_t K, const uint8_t * A, size_t lda, const int8_t * B, size_t ldb, const int32_t * bias, const float * scale, uint8_t zero, uint8_t * C, size_t ldc)
+        {
+            Gemm8u8iNN<uint8_t> gemm(M, N, K, 6, 32, 4, Base::AlgCacheL2(), Gemm8u8iKernel<uint8_t>, Base::Gemm8iPackA, Gemm8iPackB);
+            gemm.Run(A, lda, B, ldb, GemmRequant(bias, scale, zero), C, ldc);
+        }
+    }
+#endif// SIMD_AVX512VNNI_ENABLE
+}
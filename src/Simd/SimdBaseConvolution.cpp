@@ -30,6 +30,7 @@ namespace Simd
     {
         ConvolutionImgToCol::ConvolutionImgToCol(const ConvParam & p)
             : Convolution(p)
+            , _gemm(NULL)
         {
             _is1x1 = p.IsKernel(1) && p.IsDilation(1) && p.IsStride(1) && p.IsPad(0);
             _M = p.dstC / p.group;
@@ -38,6 +39,13 @@ namespace Simd
             _weightStep = p.dstC * _K / p.group;
             _srcStep = _K * _N;
             _dstStep = p.dstC * _N / p.group;
+            _format = SimdGemmFormat32f;
+            SetGemm(Base::Gemm32fInit(SimdFalse, SimdFalse, _M, _N, _K));
+        }
+
+        ConvolutionImgToCol::~ConvolutionImgToCol()
+        {
+            delete _gemm;
         }
 
         size_t ConvolutionImgToCol::BufferSize() const
@@ -51,38 +59,90 @@ namespace Simd
             }
         };
 
-        void ConvolutionImgToCol::SetWeight(const float * weight, const float * bias)
+        void ConvolutionImgToCol::SetWeight(const float * weight, const float * bias, SimdGemmFormatType format)
         {
-            _weight = weight;
+            const ConvParam & p = _param;
+            _format = format;
+            if (_format == SimdGemmFormat32f)
+            {
+                _weight = weight;
+                _weight16.Resize(0);
+            }
+            else
+            {
+                _weight = NULL;
+                _weight16.Resize(_weightStep * p.group);
+                Base::GemmConvertA16(weight, _weight16.size, _format, _weight16.data);
+            }
             _bias = bias;
         }
 
         void ConvolutionImgToCol::Forward(const float * src, float * buf, float * dst)
         {
+            const ConvParam & p = _param;
             if (!_is1x1)
-            {
                 buf = Buffer(buf);
-                ImgToCol(src, _param, buf);
-                src = buf;
+            for (size_t b = 0; b < p.batch; ++b)
+            {
+                if (_is1x1)
+                    GemmAndBias(src, dst);
+                else
+                {
+                    ImgToCol(src, p, buf);
+                    GemmAndBias(buf, dst);
+                }
+                src += p.SrcSize();
+                dst += p.DstSize();
             }
-            GemmAndBias(src, dst);
         }
 
         void ConvolutionImgToCol::GemmAndBias(const float * src, float * dst)
         {
             const ConvParam & p = _param;
-            for (size_t g = 0; g < p.group; ++g)
-                Base::Gemm32fNN(_M, _N, _K, &_1, _weight + _weightStep * g, _K, src + _srcStep * g, _N, &_0, dst + _dstStep * g, _N);
-            if (_bias)
-                Base::SynetAddBias(_bias, p.dstC, p.dstH*p.dstW, dst);
+            if (_format != SimdGemmFormat32f)
+            {
+                RunGemm(_gemm, src, dst);
+                return;
+            }
+            Simd::Parallel(0, p.group, [&](size_t thread, size_t begin, size_t end)
+            {
+                for (size_t g = begin; g < end; ++g)
+                    Base::Gemm32fNN(_M, _N, _K, &_1, _weight + _weightStep * g, _K, src + _srcStep * g, _N, &_0, dst + _dstStep * g, _N);
+            }, GemmBatchThreads(p.group, _M, _N, _K));
+            ApplyEpilogue(_bias, dst);
+        }
+
+        void ConvolutionImgToCol::SetGemm(void * gemm)
+        {
+            delete _gemm;
+            _gemm = (Gemm<float>*)gemm;
+        }
+
+        void ConvolutionImgToCol::RunGemm(Gemm<float> * gemm, const float * src, float * dst)
+        {
+            const ConvParam & p = _param;
+            GemmEpilogue epilogue = Epilogue(_bias);
+            if (_format == SimdGemmFormat32f)
+                gemm->RunBatched(p.group, &_1, _weight, _K, _weightStep, src, _N, _srcStep, &_0, dst, _N, _dstStep, &epilogue);
+            else
+                gemm->RunBatched16(_format, p.group, &_1, _weight16.data, _K, _weightStep, src, _N, _srcStep, &_0, dst, _N, _dstStep, &epilogue);
         }
 
         void ConvolutionImgToCol::ImgToCol(const float * src, const ConvParam & p, float * dst)
+        {
+            size_t srcSize = p.srcW * p.srcH, dstSize = p.kernelY * p.kernelX * p.dstH * p.dstW;
+            Simd::Parallel(0, p.srcC, [&](size_t thread, size_t begin, size_t end)
+            {
+                ImgToCol(src + begin * srcSize, p, end - begin, dst + begin * dstSize);
+            }, ConvolutionThreads(p.srcC * dstSize));
+        }
+
+        void ConvolutionImgToCol::ImgToCol(const float * src, const ConvParam & p, size_t channels, float * dst)
         {
             size_t srcSize = p.srcW * p.srcH;
             if (p.dilationX == 1 && p.dilationY == 1 && p.strideX == 2 && p.strideY == 2 && p.padX == 0 && p.padY == 0 && p.padW == 0 && p.padH == 0 && p.kernelX == 1 && p.kernelY == 1)
             {
-                for (size_t c = 0; c < p.srcC; ++c)
+                for (size_t c = 0; c < channels; ++c)
                 {
                     for (size_t dy = 0; dy < p.dstH; ++dy)
                     {
@@ -95,7 +155,7 @@ namespace Simd
             }
             else if (p.dilationX*p.dilationY*p.strideX*p.strideY != 1)
             {
-                for (size_t c = 0; c < p.srcC; ++c)
+                for (size_t c = 0; c < channels; ++c)
                 {
                     for (size_t ky = 0; ky < p.kernelY; ky++)
                     {
@@ -131,7 +191,7 @@ namespace Simd
             else
             {
                 const ptrdiff_t bodySize = p.dstW - p.padX - p.padW;
-                for (size_t c = 0; c < p.srcC; ++c)
+                for (size_t c = 0; c < channels; ++c)
                 {
                     for (size_t ky = 0; ky < p.kernelY; ++ky)
                     {
@@ -183,6 +243,7 @@ namespace Simd
 
         ConvolutionImgToRow::ConvolutionImgToRow(const ConvParam & p)
             : Convolution(p)
+            , _gemm(NULL)
         {
             _M = p.dstC / p.group;
             _N = p.dstH  * p.dstW;
@@ -190,6 +251,13 @@ namespace Simd
             _weightStep = p.dstC * _K / p.group;
             _srcStep = _K * _N;
             _dstStep = p.dstC * _N / p.group;
+            _format = SimdGemmFormat32f;
+            SetGemm(Base::Gemm32fInit(SimdFalse, SimdTrue, _M, _N, _K));
+        }
+
+        ConvolutionImgToRow::~ConvolutionImgToRow()
+        {
+            delete _gemm;
         }
 
         size_t ConvolutionImgToRow::BufferSize() const
@@ -198,17 +266,35 @@ namespace Simd
             return p.srcC*p.kernelY*p.kernelX*p.dstH*p.dstW;
         };
 
-        void ConvolutionImgToRow::SetWeight(const float * weight, const float * bias)
+        void ConvolutionImgToRow::SetWeight(const float * weight, const float * bias, SimdGemmFormatType format)
         {
-            _weight = weight;
+            const ConvParam & p = _param;
+            _format = format;
+            if (_format == SimdGemmFormat32f)
+            {
+                _weight = weight;
+                _weight16.Resize(0);
+            }
+            else
+            {
+                _weight = NULL;
+                _weight16.Resize(_weightStep * p.group);
+                Base::GemmConvertA16(weight, _weight16.size, _format, _weight16.data);
+            }
             _bias = bias;
         }
 
         void ConvolutionImgToRow::Forward(const float * src, float * buf, float * dst)
         {
+            const ConvParam & p = _param;
             buf = Buffer(buf);
-            ImgToRow(src, _param, buf);
-            GemmAndBias(buf, dst);
+            for (size_t b = 0; b < p.batch; ++b)
+            {
+                ImgToRow(src, p, buf);
+                GemmAndBias(buf, dst);
+                src += p.SrcSize();
+                dst += p.DstSize();
+            }
         }
 
         bool ConvolutionImgToRow::Preferable(const ConvParam & p)
@@ -219,10 +305,33 @@ namespace Simd
         void ConvolutionImgToRow::GemmAndBias(const float * src, float * dst)
         {
             const ConvParam & p = _param;
-            for (size_t g = 0; g < p.group; ++g)
-                Base::Gemm32fNT(_M, _N, _K, &_1, _weight + _weightStep * g, _K, src + _srcStep * g, _K, &_0, dst + _dstStep * g, _N);
-            if (_bias)
-                Base::SynetAddBias(_bias, p.dstC, p.dstH*p.dstW, dst);
+            if (_format != SimdGemmFormat32f)
+            {
+                RunGemm(_gemm, src, dst);
+                return;
+            }
+            Simd::Parallel(0, p.group, [&](size_t thread, size_t begin, size_t end)
+            {
+                for (size_t g = begin; g < end; ++g)
+                    Base::Gemm32fNT(_M, _N, _K, &_1, _weight + _weightStep * g, _K, src + _srcStep * g, _K, &_0, dst + _dstStep * g, _N);
+            }, GemmBatchThreads(p.group, _M, _N, _K));
+            ApplyEpilogue(_bias, dst);
+        }
+
+        void ConvolutionImgToRow::SetGemm(void * gemm)
+        {
+            delete _gemm;
+            _gemm = (Gemm<float>*)gemm;
+        }
+
+        void ConvolutionImgToRow::RunGemm(Gemm<float> * gemm, const float * src, float * dst)
+        {
+            const ConvParam & p = _param;
+            GemmEpilogue epilogue = Epilogue(_bias);
+            if (_format == SimdGemmFormat32f)
+                gemm->RunBatched(p.group, &_1, _weight, _K, _weightStep, src, _K, _srcStep, &_0, dst, _N, _dstStep, &epilogue);
+            else
+                gemm->RunBatched16(_format, p.group, &_1, _weight16.data, _K, _weightStep, src, _K, _srcStep, &_0, dst, _N, _dstStep, &epilogue);
         }
 
         void ConvolutionImgToRow::ImgToRow(const float * src, const ConvParam & p, float * dst)
@@ -230,7 +339,7 @@ namespace Simd
             const size_t K = p.kernelX * p.kernelY*p.srcC, N = p.dstH * p.dstW;
             if (p.IsDilation(1) && p.IsStride(1))
             {
-                if (p.IsKernel(1))
+                if (p.IsKernel(1) && p.IsPad(0))
                 {
                     for (size_t i = 0; i < N; ++i)
                     {
@@ -334,7 +443,7 @@ namespace Simd
             return (_strideS + _strideD)*_count;
         }
         
-        void ConvolutionWinograd2x3p::SetWeight(const float * weight, const float * bias)
+        void ConvolutionWinograd2x3p::SetWeight(const float * weight, const float * bias, SimdGemmFormatType format)
         {
             const ConvParam & p = _param;
             _weight.Resize(_strideW*_count);
@@ -347,12 +456,19 @@ namespace Simd
             const ConvParam & p = _param;
             float * bufS = Buffer(buf);
             float * bufD = bufS + _strideS * _count;
-            Base::Winograd2x3pSetInput(src, p.srcC, p.srcH, p.srcW, buf, _pad);
-            for (size_t i = 0; i < _count; ++i)
-                Base::Gemm32fNN(_M, _N, _K, &_1, _weight.data + i * _strideW, _K, bufS + i * _strideS, _N, &_0, bufD + i * _strideD, _N);
-            Base::Winograd2x3pSetOutput(bufD, dst, p.dstC, p.dstH, p.dstW);
-            if (_bias)
-                Base::SynetAddBias(_bias, p.dstC, p.dstH*p.dstW, dst);
+            for (size_t b = 0; b < p.batch; ++b)
+            {
+                Base::Winograd2x3pSetInput(src, p.srcC, p.srcH, p.srcW, bufS, _pad);
+                Simd::Parallel(0, _count, [&](size_t thread, size_t begin, size_t end)
+                {
+                    for (size_t i = begin; i < end; ++i)
+                        Base::Gemm32fNN(_M, _N, _K, &_1, _weight.data + i * _strideW, _K, bufS + i * _strideS, _N, &_0, bufD + i * _strideD, _N);
+                }, GemmBatchThreads(_count, _M, _N, _K));
+                Base::Winograd2x3pSetOutput(bufD, dst, p.dstC, p.dstH, p.dstW);
+                ApplyEpilogue(_bias, dst);
+                src += p.SrcSize();
+                dst += p.DstSize();
+            }
         }
 
         bool ConvolutionWinograd2x3p::Preferable(const ConvParam & p)
@@ -362,6 +478,71 @@ namespace Simd
 
         //---------------------------------------------------------------------
 
+        ConvolutionWinograd4x3p::ConvolutionWinograd4x3p(const ConvParam & p)
+            : Convolution(p)
+            , _block(4)
+            , _gemm(NULL)
+        {
+            _count = Simd::Square(_block + p.kernelX - 1);
+            _tileH = (p.dstH + _block - 1) / _block;
+            _tileW = (p.dstW + _block - 1) / _block;
+            _strideW = p.srcC * p.dstC;
+            _strideS = p.srcC * _tileH * _tileW;
+            _strideD = p.dstC * _tileH * _tileW;
+            _M = p.dstC;
+            _N = _tileW * _tileH;
+            _K = p.srcC;
+            _pad = (int)p.padX;
+            SetGemm(Base::Gemm32fInit(SimdFalse, SimdFalse, _M, _N, _K));
+        }
+
+        ConvolutionWinograd4x3p::~ConvolutionWinograd4x3p()
+        {
+            delete _gemm;
+        }
+
+        size_t ConvolutionWinograd4x3p::BufferSize() const
+        {
+            return (_strideS + _strideD)*_count;
+        }
+
+        void ConvolutionWinograd4x3p::SetWeight(const float * weight, const float * bias, SimdGemmFormatType format)
+        {
+            const ConvParam & p = _param;
+            _weight.Resize(_strideW*_count);
+            Base::Winograd4x3pSetFilter(weight, p.srcC*p.dstC, _weight.data);
+            _bias = bias;
+        }
+
+        void ConvolutionWinograd4x3p::Forward(const float * src, float * buf, float * dst)
+        {
+            const ConvParam & p = _param;
+            float * bufS = Buffer(buf);
+            float * bufD = bufS + _strideS * _count;
+            for (size_t b = 0; b < p.batch; ++b)
+            {
+                Base::Winograd4x3pSetInput(src, p.srcC, p.srcH, p.srcW, bufS, _pad);
+                _gemm->RunBatched(_count, &_1, _weight.data, _K, _strideW, bufS, _N, _strideS, &_0, bufD, _N, _strideD);
+                Base::Winograd4x3pSetOutput(bufD, dst, p.dstC, p.dstH, p.dstW);
+                ApplyEpilogue(_bias, dst);
+                src += p.SrcSize();
+                dst += p.DstSize();
+            }
+        }
+
+        bool ConvolutionWinograd4x3p::Preferable(const ConvParam & p)
+        {
+            return p.IsKernel(3) && p.IsDilation(1) && p.IsStride(1) && (p.IsPad(0) || p.IsPad(1)) && p.group == 1 && p.srcC >= 16 && p.dstC >= 16 && p.dstH >= 24 && p.dstW >= 24;
+        }
+
+        void ConvolutionWinograd4x3p::SetGemm(void * gemm)
+        {
+            delete _gemm;
+            _gemm = (Gemm<float>*)gemm;
+        }
+
+        //---------------------------------------------------------------------
+
         ConvolutionDirect::ConvolutionDirect(const ConvParam & p)
             : Convolution(p)
         {
@@ -383,7 +564,7 @@ namespace Simd
                 return 1;
         }
 
-        void ConvolutionDirect::SetWeight(const float * weight, const float * bias)
+        void ConvolutionDirect::SetWeight(const float * weight, const float * bias, SimdGemmFormatType format)
         {
             _weight = weight;
             _bias = bias;
@@ -392,27 +573,33 @@ namespace Simd
         void ConvolutionDirect::Forward(const float * src, float * buf, float * dst)
         {
             const ConvParam & p = _param;
-            const float * weight = _weight;
-            const float * bias = _bias;
+            GemmEpilogue epilogue = Epilogue(NULL);
             if(_pad)
                 buf = Buffer(buf);
-            for (size_t g = 0; g < p.group; ++g)
+            for (size_t b = 0; b < p.batch; ++b)
             {
-                if (_bias)
-                    SetBias(bias, dst);
-                else
-                    memset(dst, 0, _dstStep*sizeof(float));
-                if (_pad)
+                const float * weight = _weight;
+                const float * bias = _bias;
+                for (size_t g = 0; g < p.group; ++g)
                 {
-                    Pad(src, buf);
-                    AddConvolution(buf, weight, dst);
+                    if (_bias)
+                        SetBias(bias, dst);
+                    else
+                        memset(dst, 0, _dstStep*sizeof(float));
+                    if (_pad)
+                    {
+                        Pad(src, buf);
+                        AddConvolution(buf, weight, dst);
+                    }
+                    else
+                        AddConvolution(src, weight, dst);
+                    if (!epilogue.Empty())
+                        _applyEpilogue(epilogue, g * _dstC, 0, _dstC, p.dstH * p.dstW, dst, p.dstH * p.dstW);
+                    weight += _weightStep;
+                    bias += _dstC;
+                    src += _srcStep;
+                    dst += _dstStep;
                 }
-                else
-                    AddConvolution(src, weight, dst);
-                weight += _weightStep;
-                bias += _dstC;
-                src += _srcStep;
-                dst += _dstStep;
             }
         }
 
@@ -522,11 +709,410 @@ namespace Simd
         }
         //---------------------------------------------------------------------
 
-        void * ConvolutionInit(size_t srcC, size_t srcH, size_t srcW, size_t dstC, size_t kernelY, size_t kernelX, size_t dilationY, size_t dilationX, size_t strideY, size_t strideX, size_t padY, size_t padX, size_t padH, size_t padW, size_t group)
+        ConvolutionDepthwise::ConvolutionDepthwise(const ConvParam & p)
+            : Convolution(p)
+        {
+            _srcH = p.padY + p.srcH + p.padH;
+            _srcW = p.padX + p.srcW + p.padW;
+            _pad = !p.IsPad(0) || !p.IsStride(1);
+        }
+
+        size_t ConvolutionDepthwise::BufferSize() const
+        {
+            if (_pad)
+                return _param.srcC * _srcH * _srcW + 1;
+            else
+                return 1;
+        }
+
+        void ConvolutionDepthwise::SetWeight(const float * weight, const float * bias, SimdGemmFormatType format)
+        {
+            _weight = weight;
+            _bias = bias;
+        }
+
+        void ConvolutionDepthwise::Forward(const float * src, float * buf, float * dst)
+        {
+            const ConvParam & p = _param;
+            size_t srcStep = p.srcH * p.srcW, dstStep = p.dstH * p.dstW, weightStep = p.kernelY * p.kernelX;
+            GemmEpilogue epilogue = Epilogue(NULL);
+            if (_pad)
+            {
+                buf = Buffer(buf);
+                buf[p.srcC * _srcH * _srcW] = 0;
+            }
+            for (size_t b = 0; b < p.batch; ++b)
+            {
+                Simd::Parallel(0, p.srcC, [&](size_t thread, size_t begin, size_t end)
+                {
+                    for (size_t c = begin; c < end; ++c)
+                    {
+                        const float * ps = src + c * srcStep;
+                        if (_pad)
+                        {
+                            float * pb = buf + c * _srcH * _srcW;
+                            Pad(ps, pb);
+                            ps = pb;
+                        }
+                        float * pd = dst + c * dstStep;
+                        ConvolveChannel(ps, _weight + c * weightStep, _bias ? _bias[c] : 0.0f, pd);
+                        if (!epilogue.Empty())
+                            _applyEpilogue(epilogue, c, 0, 1, dstStep, pd, dstStep);
+                    }
+                }, ConvolutionThreads(p.srcC * dstStep * weightStep));
+                src += p.SrcSize();
+                dst += p.DstSize();
+            }
+        }
+
+        bool ConvolutionDepthwise::Preferable(const ConvParam & p)
+        {
+            return p.group > 1 && p.group == p.srcC && p.group == p.dstC && p.IsDilation(1) && 
+                (p.IsKernel(3) || p.IsKernel(5)) && (p.IsStride(1) || p.IsStride(2));
+        }
+
+        void ConvolutionDepthwise::Pad(const float * src, float * dst) const
+        {
+            const ConvParam & p = _param;
+            if (p.padY)
+            {
+                memset(dst, 0, p.padY*_srcW * sizeof(float));
+                dst += p.padY*_srcW;
+            }
+            for (size_t row = 0; row < p.srcH; ++row)
+            {
+                for (size_t col = 0; col < p.padX; ++col)
+                    *dst++ = 0;
+                memcpy(dst, src, p.srcW * sizeof(float));
+                dst += p.srcW;
+                src += p.srcW;
+                for (size_t col = 0; col < p.padW; ++col)
+                    *dst++ = 0;
+            }
+            if (p.padH)
+                memset(dst, 0, p.padH*_srcW * sizeof(float));
+        }
+
+        void ConvolutionDepthwise::ConvolveChannel(const float * src, const float * weight, float bias, float * dst)
+        {
+            const ConvParam & p = _param;
+            size_t srcW = _pad ? _srcW : p.srcW;
+            for (size_t dy = 0; dy < p.dstH; ++dy)
+            {
+                for (size_t dx = 0, sx = 0; dx < p.dstW; ++dx, sx += p.strideX)
+                {
+                    float sum = bias;
+                    for (size_t ky = 0; ky < p.kernelY; ++ky)
+                    {
+                        const float * s = src + ky * srcW + sx;
+                        const float * w = weight + p.kernelX * ky;
+                        for (size_t kx = 0; kx < p.kernelX; ++kx)
+                            sum += s[kx] * w[kx];
+                    }
+                    dst[dx] = sum;
+                }
+                src += srcW * p.strideY;
+                dst += p.dstW;
+            }
+        }
+
+        //---------------------------------------------------------------------
+
+        ConvolutionNhwcGemm::ConvolutionNhwcGemm(const ConvParam & p)
+            : Convolution(p)
+            , _gemm(NULL)
+        {
+            _is1x1 = p.IsKernel(1) && p.IsDilation(1) && p.IsStride(1) && p.IsPad(0);
+            _batch = 1;
+            for (size_t n = 2, size = p.dstH * p.dstW; n <= p.batch && n * size <= 1024; ++n)
+                if (p.batch % n == 0)
+                    _batch = n;
+            _M = _batch * p.dstH * p.dstW;
+            _N = p.dstC / p.group;
+            _K = p.srcC * p.kernelY * p.kernelX / p.group;
+            SetGemm(Base::Gemm32fInit(SimdFalse, SimdFalse, _M, _N, _K));
+        }
+
+        ConvolutionNhwcGemm::~ConvolutionNhwcGemm()
+        {
+            delete _gemm;
+        }
+
+        size_t ConvolutionNhwcGemm::BufferSize() const
+        {
+            return _is1x1 ? 1 : _M * _K * _param.group;
+        }
+
+        void ConvolutionNhwcGemm::SetWeight(const float * weight, const float * bias, SimdGemmFormatType format)
+        {
+            _weight = weight;
+            _bias = bias;
+            if (_param.group == 1)
+            {
+                _packedB.Resize(_gemm->PackedBSize());
+                _gemm->PackMatrixB(_weight, _N, _packedB.data);
+            }
+        }
+
+        void ConvolutionNhwcGemm::Forward(const float * src, float * buf, float * dst)
+        {
+            const ConvParam & p = _param;
+            GemmEpilogue epilogue = Epilogue(_bias, true);
+            if (!_is1x1)
+                buf = Buffer(buf);
+            for (size_t b = 0; b < p.batch; b += _batch)
+            {
+                const float * A = src;
+                size_t lda = p.srcC;
+                if (!_is1x1)
+                {
+                    ImgToRow(src, p, _batch, buf);
+                    A = buf, lda = _K;
+                }
+                if (_packedB.size)
+                    _gemm->RunPackedB(&_1, A, lda, _packedB.data, &_0, dst, p.dstC, &epilogue);
+                else
+                    _gemm->RunBatched(p.group, &_1, A, lda, _is1x1 ? _K : _M * _K, _weight, p.dstC, _N, &_0, dst, p.dstC, _N, &epilogue);
+                src += _batch * p.SrcSize();
+                dst += _batch * p.DstSize();
+            }
+        }
+
+        bool ConvolutionNhwcGemm::Preferable(const ConvParam & p)
+        {
+            return p.trans;
+        }
+
+        void ConvolutionNhwcGemm::SetGemm(void * gemm)
+        {
+            delete _gemm;
+            _gemm = (Gemm<float>*)gemm;
+        }
+
+        void ConvolutionNhwcGemm::ImgToRow(const float * src, const ConvParam & p, size_t batch, float * dst)
+        {
+            size_t srcC = p.srcC / p.group, rows = p.group * batch * p.dstH, rowSize = p.dstW * p.kernelY * p.kernelX * srcC;
+            Simd::Parallel(0, rows, [&](size_t thread, size_t begin, size_t end)
+            {
+                float * pd = dst + begin * rowSize;
+                for (size_t row = begin; row < end; ++row)
+                {
+                    size_t g = row / (batch * p.dstH), b = row / p.dstH % batch, dy = row % p.dstH;
+                    const float * ps = src + b * p.SrcSize() + g * srcC;
+                    for (size_t dx = 0; dx < p.dstW; ++dx)
+                    {
+                        for (size_t ky = 0; ky < p.kernelY; ++ky)
+                        {
+                            size_t sy = dy * p.strideY + ky * p.dilationY - p.padY;
+                            for (size_t kx = 0; kx < p.kernelX; ++kx)
+                            {
+                                size_t sx = dx * p.strideX + kx * p.dilationX - p.padX;
+                                if (sy < p.srcH && sx < p.srcW)
+                                    memcpy(pd, ps + (sy * p.srcW + sx) * p.srcC, srcC * sizeof(float));
+                                else
+                                    memset(pd, 0, srcC * sizeof(float));
+                                pd += srcC;
+                            }
+                        }
+                    }
+                }
+            }, ConvolutionThreads(rows * rowSize));
+        }
+
+        //---------------------------------------------------------------------
+
+        ConvolutionNhwcDirect::ConvolutionNhwcDirect(const ConvParam & p)
+            : Convolution(p)
+        {
+            _srcC = p.srcC / p.group;
+            _dstC = p.dstC / p.group;
+        }
+
+        size_t ConvolutionNhwcDirect::BufferSize() const
+        {
+            return 1;
+        }
+
+        void ConvolutionNhwcDirect::SetWeight(const float * weight, const float * bias, SimdGemmFormatType format)
+        {
+            _weight = weight;
+            _bias = bias;
+        }
+
+        void ConvolutionNhwcDirect::Forward(const float * src, float * buf, float * dst)
+        {
+            const ConvParam & p = _param;
+            GemmEpilogue epilogue = Epilogue(NULL, true);
+            for (size_t b = 0; b < p.batch; ++b)
+            {
+                Simd::Parallel(0, p.dstH, [&](size_t thread, size_t begin, size_t end)
+                {
+                    for (size_t dy = begin; dy < end; ++dy)
+                    {
+                        float * pd = dst + dy * p.dstW * p.dstC;
+                        for (size_t dx = 0; dx < p.dstW; ++dx)
+                            ConvolvePixel(src, dy, dx, pd + dx * p.dstC);
+                        if (!epilogue.Empty())
+                            _applyEpilogue(epilogue, 0, 0, p.dstW, p.dstC, pd, p.dstC);
+                    }
+                }, ConvolutionThreads(p.DstSize() * p.kernelY * p.kernelX));
+                src += p.SrcSize();
+                dst += p.DstSize();
+            }
+        }
+
+        bool ConvolutionNhwcDirect::Preferable(const ConvParam & p)
+        {
+            return p.trans && p.srcC * p.dstC / p.group * p.kernelY * p.kernelX * sizeof(float) <= Base::AlgCacheL2();
+        }
+
+        void ConvolutionNhwcDirect::ConvolvePixel(const float * src, size_t dy, size_t dx, float * dst)
+        {
+            const ConvParam & p = _param;
+            for (size_t g = 0; g < p.group; ++g)
+            {
+                float * pd = dst + g * _dstC;
+                if (_bias)
+                    memcpy(pd, _bias + g * _dstC, _dstC * sizeof(float));
+                else
+                    memset(pd, 0, _dstC * sizeof(float));
+                for (size_t ky = 0; ky < p.kernelY; ++ky)
+                {
+                    size_t sy = dy * p.strideY + ky * p.dilationY - p.padY;
+                    if (sy >= p.srcH)
+                        continue;
+                    for (size_t kx = 0; kx < p.kernelX; ++kx)
+                    {
+                        size_t sx = dx * p.strideX + kx * p.dilationX - p.padX;
+                        if (sx >= p.srcW)
+                            continue;
+                        const float * ps = src + (sy * p.srcW + sx) * p.srcC + g * _srcC;
+                        const float * pw = _weight + (ky * p.kernelX + kx) * _srcC * p.dstC + g * _dstC;
+                        for (size_t sc = 0; sc < _srcC; ++sc, pw += p.dstC)
+                        {
+                            float s = ps[sc];
+                            for (size_t dc = 0; dc < _dstC; ++dc)
+                                pd[dc] += s * pw[dc];
+                        }
+                    }
+                }
+            }
+        }
+
+        void ConvolutionNhwcDirect::BodyRange(size_t srcS, size_t dstS, size_t kernel, size_t dilation, size_t stride, size_t pad, size_t & beg, size_t & end)
+        {
+            size_t extent = (kernel - 1) * dilation;
+            beg = (pad + stride - 1) / stride;
+            end = srcS + pad > extent ? Simd::Min((srcS + pad - extent - 1) / stride + 1, dstS) : 0;
+        }
+
+        //---------------------------------------------------------------------
+
+        ConvolutionNhwcDepthwise::ConvolutionNhwcDepthwise(const ConvParam & p)
+            : Convolution(p)
+        {
+        }
+
+        size_t ConvolutionNhwcDepthwise::BufferSize() const
+        {
+            return 1;
+        }
+
+        void ConvolutionNhwcDepthwise::SetWeight(const float * weight, const float * bias, SimdGemmFormatType format)
+        {
+            _weight = weight;
+            _bias = bias;
+        }
+
+        void ConvolutionNhwcDepthwise::Forward(const float * src, float * buf, float * dst)
+        {
+            const ConvParam & p = _param;
+            GemmEpilogue epilogue = Epilogue(NULL, true);
+            for (size_t b = 0; b < p.batch; ++b)
+            {
+                Simd::Parallel(0, p.dstH, [&](size_t thread, size_t begin, size_t end)
+                {
+                    for (size_t dy = begin; dy < end; ++dy)
+                    {
+                        float * pd = dst + dy * p.dstW * p.dstC;
+                        for (size_t dx = 0; dx < p.dstW; ++dx)
+                            ConvolvePixel(src, dy, dx, pd + dx * p.dstC);
+                        if (!epilogue.Empty())
+                            _applyEpilogue(epilogue, 0, 0, p.dstW, p.dstC, pd, p.dstC);
+                    }
+                }, ConvolutionThreads(p.DstSize() * p.kernelY * p.kernelX));
+                src += p.SrcSize();
+                dst += p.DstSize();
+            }
+        }
+
+        bool ConvolutionNhwcDepthwise::Preferable(const ConvParam & p)
+        {
+            return p.trans && p.group > 1 && p.group == p.srcC && p.group == p.dstC;
+        }
+
+        void ConvolutionNhwcDepthwise::ConvolvePixel(const float * src, size_t dy, size_t dx, float * dst)
+        {
+            const ConvParam & p = _param;
+            size_t C = p.srcC;
+            if (_bias)
+                memcpy(dst, _bias, C * sizeof(float));
+            else
+                memset(dst, 0, C * sizeof(float));
+            for (size_t ky = 0; ky < p.kernelY; ++ky)
+            {
+                size_t sy = dy * p.strideY + ky * p.dilationY - p.padY;
+                if (sy >= p.srcH)
+                    continue;
+                for (size_t kx = 0; kx < p.kernelX; ++kx)
+                {
+                    size_t sx = dx * p.strideX + kx * p.dilationX - p.padX;
+                    if (sx >= p.srcW)
+                        continue;
+                    const float * ps = src + (sy * p.srcW + sx) * C;
+                    const float * pw = _weight + (ky * p.kernelX + kx) * C;
+                    for (size_t c = 0; c < C; ++c)
+                        dst[c] += ps[c] * pw[c];
+                }
+            }
+        }
+
+        //---------------------------------------------------------------------
+
+        Convolution * ConvolutionCreate(const ConvParam & p, ConvolutionAlgorithm algorithm)
+        {
+            switch (algorithm)
+            {
+            case ConvolutionAlgorithmImgToCol: return new ConvolutionImgToCol(p);
+            case ConvolutionAlgorithmImgToRow: return new ConvolutionImgToRow(p);
+            case ConvolutionAlgorithmWinograd2x3p: return new ConvolutionWinograd2x3p(p);
+            case ConvolutionAlgorithmWinograd4x3p: return new ConvolutionWinograd4x3p(p);
+            case ConvolutionAlgorithmDirect: return new ConvolutionDirect(p);
+            case ConvolutionAlgorithmDepthwise: return new ConvolutionDepthwise(p);
+            case ConvolutionAlgorithmNhwcGemm: return new ConvolutionNhwcGemm(p);
+            case ConvolutionAlgorithmNhwcDirect: return new ConvolutionNhwcDirect(p);
+            case ConvolutionAlgorithmNhwcDepthwise: return new ConvolutionNhwcDepthwise(p);
+            default: return NULL;
+            }
+        }
+
+        void * ConvolutionInit(SimdBool trans, size_t batch, size_t srcC, size_t srcH, size_t srcW, size_t dstC, size_t kernelY, size_t kernelX, size_t dilationY, size_t dilationX, size_t strideY, size_t strideX, size_t padY, size_t padX, size_t padH, size_t padW, size_t group, SimdConvolutionActivationType activation, const float * activationParams)
         {
-            ConvParam param(srcC, srcH, srcW, dstC, kernelY, kernelX, dilationY, dilationX, strideY, strideX, padY, padX, padH, padW, group);
-            if(ConvolutionWinograd2x3p::Preferable(param))
+            ConvParam param(trans, batch, srcC, srcH, srcW, dstC, kernelY, kernelX, dilationY, dilationX, strideY, strideX, padY, padX, padH, padW, group, activation, activationParams);
+            if (Convolution * convolution = ConvolutionTune(param, "Base", ConvolutionCreate))
+                return convolution;
+            if (ConvolutionNhwcDepthwise::Preferable(param))
+                return new ConvolutionNhwcDepthwise(param);
+            else if (ConvolutionNhwcDirect::Preferable(param))
+                return new ConvolutionNhwcDirect(param);
+            else if (ConvolutionNhwcGemm::Preferable(param))
+                return new ConvolutionNhwcGemm(param);
+            else if (ConvolutionWinograd4x3p::Preferable(param))
+                return new ConvolutionWinograd4x3p(param);
+            else if(ConvolutionWinograd2x3p::Preferable(param))
                 return new ConvolutionWinograd2x3p(param);
+            else if (ConvolutionDepthwise::Preferable(param))
+                return new ConvolutionDepthwise(param);
             else if (ConvolutionImgToRow::Preferable(param))
                 return new ConvolutionImgToRow(param);
             else if (ConvolutionDirect::Preferable(param))
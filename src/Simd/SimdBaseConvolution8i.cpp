@@ -0,0 +1,183 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2018 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdConvolution8i.h"
+#include "Simd/SimdMath.h"
+
+namespace Simd
+{
+    namespace Base
+    {
+        void Convolution8iQuantizeWeight(const float * weight, size_t K, size_t N, int8_t * quantized, float * scale)
+        {
+            for (size_t j = 0; j < N; ++j)
+            {
+                float max = 0.0f;
+                for (size_t k = 0; k < K; ++k)
+                    max = Simd::Max(max, ::fabs(weight[k * N + j]));
+                scale[j] = max > 0.0f ? max / 127.0f : 1.0f;
+                for (size_t k = 0; k < K; ++k)
+                    quantized[k * N + j] = (int8_t)RestrictRange(int(std::nearbyint(weight[k * N + j] / scale[j])), -127, 127);
+            }
+        }
+
+        //---------------------------------------------------------------------
+
+        Convolution8iNhwcGemm::Convolution8iNhwcGemm(const ConvParam & p, bool dst8u, Gemm32iPtr gemm32i, Gemm8uPtr gemm8u)
+            : Convolution8i(p, dst8u)
+            , _srcZero(0)
+            , _dstZero(0)
+            , _gemm32i(gemm32i)
+            , _gemm8u(gemm8u)
+        {
+            _is1x1 = p.IsKernel(1) && p.IsDilation(1) && p.IsStride(1) && p.IsPad(0);
+            _batch = 1;
+            for (size_t n = 2, size = p.dstH * p.dstW; n <= p.batch && n * size <= 1024; ++n)
+                if (p.batch % n == 0)
+                    _batch = n;
+            _M = _batch * p.dstH * p.dstW;
+            _N = p.dstC / p.group;
+            _K = p.srcC * p.kernelY * p.kernelX / p.group;
+        }
+
+        size_t Convolution8iNhwcGemm::BufferSize() const
+        {
+            size_t size = 0;
+            if (!_is1x1)
+                size += _M * _K * _param.group;
+            if (!_dst8u)
+                size += _M * _param.dstC * sizeof(int32_t);
+            return Simd::Max<size_t>(size, 1);
+        }
+
+        void Convolution8iNhwcGemm::SetWeight(const float * weight, const float * bias, float srcScale, uint8_t srcZero, float dstScale, uint8_t dstZero)
+        {
+            const ConvParam & p = _param;
+            _srcZero = srcZero;
+            _dstZero = dstZero;
+            _weight.Resize(_K * p.dstC);
+            _bias.Resize(p.dstC);
+            _scale.Resize(p.dstC);
+            Convolution8iQuantizeWeight(weight, _K, p.dstC, _weight.data, _scale.data);
+            for (size_t j = 0; j < p.dstC; ++j)
+            {
+                float scale = srcScale * _scale[j];
+                int32_t sum = 0;
+                for (size_t k = 0; k < _K; ++k)
+                    sum += _weight[k * p.dstC + j];
+                _bias[j] = (bias ? int32_t(std::nearbyint(bias[j] / scale)) : 0) - int32_t(srcZero) * sum;
+                _scale[j] = _dst8u ? scale / dstScale : scale;
+            }
+        }
+
+        void Convolution8iNhwcGemm::Forward(const uint8_t * src, uint8_t * buf, uint8_t * dst)
+        {
+            const ConvParam & p = _param;
+            bool relu = p.activation == SimdConvolutionActivationRelu;
+            buf = Buffer(buf);
+            int32_t * sum = (int32_t*)buf;
+            uint8_t * rows = _dst8u ? buf : buf + _M * p.dstC * sizeof(int32_t);
+            for (size_t b = 0; b < p.batch; b += _batch)
+            {
+                const uint8_t * A = src;
+                size_t lda = p.srcC, strideA = _K;
+                if (!_is1x1)
+                {
+                    ImgToRow(src, p, _batch, _srcZero, rows);
+                    A = rows, lda = _K, strideA = _M * _K;
+                }
+                for (size_t g = 0; g < p.group; ++g)
+                {
+                    if (_dst8u)
+                        _gemm8u(_M, _N, _K, A + g * strideA, lda, _weight.data + g * _N, p.dstC, _bias.data + g * _N, _scale.data + g * _N, _dstZero, dst + g * _N, p.dstC);
+                    else
+                        _gemm32i(_M, _N, _K, A + g * strideA, lda, _weight.data + g * _N, p.dstC, sum + g * _N, p.dstC);
+                }
+                if (_dst8u)
+                {
+                    if (relu)
+                        for (size_t i = 0, n = _M * p.dstC; i < n; ++i)
+                            dst[i] = Simd::Max(dst[i], _dstZero);
+                    dst += _batch * p.DstSize();
+                }
+                else
+                {
+                    float * pd = (float*)dst;
+                    for (size_t i = 0; i < _M; ++i)
+                    {
+                        const int32_t * ps = sum + i * p.dstC;
+                        for (size_t j = 0; j < p.dstC; ++j)
+                            pd[j] = float(ps[j] + _bias[j]) * _scale[j];
+                        if (relu)
+                            for (size_t j = 0; j < p.dstC; ++j)
+                                pd[j] = Simd::Max(pd[j], 0.0f);
+                        pd += p.dstC;
+                    }
+                    dst += _batch * p.DstSize() * sizeof(float);
+                }
+                src += _batch * p.SrcSize();
+            }
+        }
+
+        void Convolution8iNhwcGemm::ImgToRow(const uint8_t * src, const ConvParam & p, size_t batch, uint8_t zero, uint8_t * dst)
+        {
+            size_t srcC = p.srcC / p.group;
+            for (size_t g = 0; g < p.group; ++g)
+            {
+                for (size_t b = 0; b < batch; ++b)
+                {
+                    const uint8_t * ps = src + b * p.SrcSize() + g * srcC;
+                    for (size_t dy = 0; dy < p.dstH; ++dy)
+                    {
+                        for (size_t dx = 0; dx < p.dstW; ++dx)
+                        {
+                            for (size_t ky = 0; ky < p.kernelY; ++ky)
+                            {
+                                size_t sy = dy * p.strideY + ky * p.dilationY - p.padY;
+                                for (size_t kx = 0; kx < p.kernelX; ++kx)
+                                {
+                                    size_t sx = dx * p.strideX + kx * p.dilationX - p.padX;
+                                    if (sy < p.srcH && sx < p.srcW)
+                                        memcpy(dst, ps + (sy * p.srcW + sx) * p.srcC, srcC);
+                                    else
+                                        memset(dst, zero, srcC);
+                                    dst += srcC;
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        //---------------------------------------------------------------------
+
+        void * Convolution8iInit(size_t batch, size_t srcC, size_t srcH, size_t srcW, size_t dstC, size_t kernelY, size_t kernelX, size_t dilationY, size_t dilationX, size_t strideY, size_t strideX, size_t padY, size_t padX, size_t padH, size_t padW, size_t group, SimdConvolutionActivationType activation, SimdBool dst8u)
+        {
+            if (activation != SimdConvolutionActivationIdentity && activation != SimdConvolutionActivationRelu)
+                return NULL;
+            ConvParam param(SimdTrue, batch, srcC, srcH, srcW, dstC, kernelY, kernelX, dilationY, dilationX, strideY, strideX, padY, padX, padH, padW, group, activation, NULL);
+            return new Convolution8iNhwcGemm(param, dst8u == SimdTrue, Base::Gemm8u8i32iNN, Base::Gemm8u8i8uNN);
+        }
+    }
+}
@@ -0,0 +1,217 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2018 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdConvolution.h"
+#include "Simd/SimdBase.h"
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+
+namespace Simd
+{
+    namespace Base
+    {
+        static const char * ConvolutionAlgorithmNames[ConvolutionAlgorithmSize] =
+        {
+            "ImgToCol", "ImgToRow", "Winograd2x3p", "Winograd4x3p", "Direct", "Depthwise", "NhwcGemm", "NhwcDirect", "NhwcDepthwise"
+        };
+
+        static bool ConvolutionApplicable(const ConvParam & p, ConvolutionAlgorithm algorithm)
+        {
+            if (p.trans != (algorithm >= ConvolutionAlgorithmNhwcGemm))
+                return false;
+            switch (algorithm)
+            {
+            case ConvolutionAlgorithmImgToCol:
+                return true;
+            case ConvolutionAlgorithmImgToRow:
+                return p.group == 1;
+            case ConvolutionAlgorithmWinograd2x3p:
+            case ConvolutionAlgorithmWinograd4x3p:
+                return p.IsKernel(3) && p.IsDilation(1) && p.IsStride(1) && (p.IsPad(0) || p.IsPad(1)) && p.group == 1;
+            case ConvolutionAlgorithmDirect:
+                return p.IsDilation(1);
+            case ConvolutionAlgorithmDepthwise:
+                return p.group > 1 && p.group == p.srcC && p.group == p.dstC && p.IsDilation(1);
+            case ConvolutionAlgorithmNhwcGemm:
+            case ConvolutionAlgorithmNhwcDirect:
+                return true;
+            case ConvolutionAlgorithmNhwcDepthwise:
+                return p.group > 1 && p.group == p.srcC && p.group == p.dstC;
+            default:
+                return false;
+            }
+        }
+
+        class ConvolutionTuner
+        {
+        public:
+            static ConvolutionTuner & Global()
+            {
+                static ConvolutionTuner tuner;
+                return tuner;
+            }
+
+            void Set(bool enable, const char * cache)
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _enable = enable;
+                _path = cache ? cache : "";
+                _decisions.clear();
+                if (_enable && _path.size())
+                    Load();
+            }
+
+            Convolution * Create(const ConvParam & p, const char * isa, ConvolutionCreatePtr create)
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                if (!_enable)
+                    return NULL;
+                std::string key = Key(p, isa);
+                std::map<std::string, int>::const_iterator decision = _decisions.find(key);
+                if (decision != _decisions.end())
+                {
+                    Convolution * convolution = create(p, (ConvolutionAlgorithm)decision->second);
+                    if (convolution)
+                        return convolution;
+                }
+                Array32f weight(p.dstC * p.srcC / p.group * p.kernelY * p.kernelX), bias(p.dstC);
+                Array32f src(p.batch * p.SrcSize()), dst(p.batch * p.DstSize()), buf;
+                Fill(weight), Fill(bias), Fill(src);
+                Convolution * best = NULL;
+                int bestAlgorithm = -1;
+                double bestTime = 0;
+                for (int algorithm = 0; algorithm < ConvolutionAlgorithmSize; ++algorithm)
+                {
+                    if (!ConvolutionApplicable(p, (ConvolutionAlgorithm)algorithm))
+                        continue;
+                    Convolution * convolution = create(p, (ConvolutionAlgorithm)algorithm);
+                    if (convolution == NULL)
+                        continue;
+                    convolution->SetWeight(weight.data, bias.data, SimdGemmFormat32f);
+                    buf.Resize(convolution->BufferSize());
+                    double time = Measure(convolution, src.data, buf.data, dst.data);
+                    if (best == NULL || time < bestTime)
+                    {
+                        delete best;
+                        best = convolution;
+                        bestAlgorithm = algorithm;
+                        bestTime = time;
+                    }
+                    else
+                        delete convolution;
+                }
+                if (best)
+                {
+                    _decisions[key] = bestAlgorithm;
+                    Save(key, bestAlgorithm);
+                }
+                return best;
+            }
+
+        private:
+            ConvolutionTuner()
+                : _enable(false)
+            {
+            }
+
+            std::mutex _mutex;
+            bool _enable;
+            std::string _path;
+            std::map<std::string, int> _decisions;
+
+            static std::string Key(const ConvParam & p, const char * isa)
+            {
+                std::stringstream ss;
+                ss << CpuModel() << "\t" << isa << "\t" << GetThreadNumber() << "\t";
+                ss << (p.trans ? "nhwc" : "nchw") << " " << p.batch << " " << p.srcC << " " << p.srcH << " " << p.srcW << " " << p.dstC << " ";
+                ss << p.kernelY << " " << p.kernelX << " " << p.dilationY << " " << p.dilationX << " ";
+                ss << p.strideY << " " << p.strideX << " " << p.padY << " " << p.padX << " " << p.padH << " " << p.padW << " " << p.group << " " << p.activation;
+                return ss.str();
+            }
+
+            static void Fill(Array32f & array)
+            {
+                for (size_t i = 0; i < array.size; ++i)
+                    array[i] = float(int(i % 17) - 8) * 0.0625f;
+            }
+
+            static double Measure(Convolution * convolution, const float * src, float * buf, float * dst)
+            {
+                typedef std::chrono::high_resolution_clock Clock;
+                convolution->Forward(src, buf, dst);
+                double best = 0;
+                for (int run = 0; run < 3; ++run)
+                {
+                    Clock::time_point start = Clock::now();
+                    convolution->Forward(src, buf, dst);
+                    double time = std::chrono::duration<double>(Clock::now() - start).count();
+                    if (run == 0 || time < best)
+                        best = time;
+                }
+                return best;
+            }
+
+            void Load()
+            {
+                std::ifstream file(_path.c_str());
+                std::string line;
+                while (std::getline(file, line))
+                {
+                    size_t tab = line.rfind('\t');
+                    if (tab == std::string::npos)
+                        continue;
+                    std::string name = line.substr(tab + 1);
+                    if (name.size() && name[name.size() - 1] == '\r')
+                        name.resize(name.size() - 1);
+                    for (int algorithm = 0; algorithm < ConvolutionAlgorithmSize; ++algorithm)
+                        if (name == ConvolutionAlgorithmNames[algorithm])
+                            _decisions[line.substr(0, tab)] = algorithm;
+                }
+            }
+
+            void Save(const std::string & key, int algorithm)
+            {
+                if (_path.empty())
+                    return;
+                std::ofstream file(_path.c_str(), std::ios::app);
+                if (file)
+                    file << key << "\t" << ConvolutionAlgorithmNames[algorithm] << std::endl;
+            }
+        };
+
+        void ConvolutionSetTuning(bool enable, const char * cache)
+        {
+            ConvolutionTuner::Global().Set(enable, cache);
+        }
+
+        Convolution * ConvolutionTune(const ConvParam & p, const char * isa, ConvolutionCreatePtr create)
+        {
+            return ConvolutionTuner::Global().Create(p, isa, create);
+        }
+    }
+}
@@ -0,0 +1,240 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2018 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdMath.h"
+#include "Simd/SimdBase.h"
+#include "Simd/SimdEnable.h"
+
+#if defined(__linux__)
+#include <stdio.h>
+#include <stdarg.h>
+#endif
+
+namespace Simd
+{
+    namespace Base
+    {
+        struct CacheInfo
+        {
+            size_t size[4], sharing[4];
+
+            CacheInfo()
+            {
+                for (size_t level = 0; level < 4; ++level)
+                    size[level] = 0, sharing[level] = 1;
+#if defined(SIMD_X86_ENABLE) || defined(SIMD_X64_ENABLE)
+                if (!LoadCpuid(4))
+                    LoadCpuid(0x8000001D);
+#endif
+#if defined(__linux__)
+                if (size[1] == 0)
+                    LoadSysfs();
+#endif
+                if (size[1] == 0)
+                    size[1] = 32 * 1024;
+                if (size[2] == 0)
+                    size[2] = 256 * 1024;
+                if (size[3] == 0)
+                    size[3] = 2 * 1024 * 1024;
+            }
+
+#if defined(SIMD_X86_ENABLE) || defined(SIMD_X64_ENABLE)
+            bool LoadCpuid(unsigned int leaf)
+            {
+                unsigned int registers[4] = { 0, 0, 0, 0 };
+#if defined(_MSC_VER)
+                __cpuid((int*)registers, leaf & 0x80000000);
+#else
+                registers[Cpuid::Eax] = __get_cpuid_max(leaf & 0x80000000, NULL);
+#endif
+                if (registers[Cpuid::Eax] < leaf)
+                    return false;
+                bool result = false;
+                for (int index = 0; index < 16; ++index)
+                {
+#if defined(_MSC_VER)
+                    __cpuidex((int*)registers, leaf, index);
+#else
+                    __cpuid_count(leaf, index, registers[Cpuid::Eax], registers[Cpuid::Ebx], registers[Cpuid::Ecx], registers[Cpuid::Edx]);
+#endif
+                    unsigned int type = registers[Cpuid::Eax] & 0x1F;
+                    if (type == 0)
+                        break;
+                    size_t level = (registers[Cpuid::Eax] >> 5) & 0x7;
+                    if (type == 2 || level > 3)
+                        continue;
+                    size_t ways = (registers[Cpuid::Ebx] >> 22) + 1;
+                    size_t partitions = ((registers[Cpuid::Ebx] >> 12) & 0x3FF) + 1;
+                    size_t line = (registers[Cpuid::Ebx] & 0xFFF) + 1;
+                    size_t sets = registers[Cpuid::Ecx] + 1;
+                    size[level] = ways * partitions * line * sets;
+                    sharing[level] = ((registers[Cpuid::Eax] >> 14) & 0xFFF) + 1;
+                    result = true;
+                }
+                return result;
+            }
+#endif
+
+#if defined(__linux__)
+            void LoadSysfs()
+            {
+                for (int index = 0; index < 16; ++index)
+                {
+                    unsigned int level = 0;
+                    char type[32], unit = 0, list[256];
+                    size_t value = 0;
+                    if (Read("level", index, "%u", &level) == 0)
+                        break;
+                    if (level < 1 || level > 3 || Read("type", index, "%31s", type) == 0 || type[0] == 'I')
+                        continue;
+                    if (Read("size", index, "%zu%c", &value, &unit) == 0)
+                        continue;
+                    size[level] = value * (unit == 'K' ? 1024 : (unit == 'M' ? 1024 * 1024 : 1));
+                    if (Read("shared_cpu_list", index, "%255s", list))
+                        sharing[level] = Simd::Max<size_t>(CountCpus(list), 1);
+                }
+            }
+
+            static size_t CountCpus(const char * list)
+            {
+                size_t count = 0;
+                while (*list)
+                {
+                    unsigned int lo = 0, hi = 0;
+                    int length = 0;
+                    if (sscanf(list, "%u-%u%n", &lo, &hi, &length) == 2)
+                        count += hi - lo + 1;
+                    else if (sscanf(list, "%u%n", &lo, &length) == 1)
+                        count += 1;
+                    else
+                        break;
+                    list += length;
+                    if (*list == ',')
+                        list++;
+                }
+                return count;
+            }
+
+            static int Read(const char * name, int index, const char * format, ...)
+            {
+                char path[128];
+                snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index%d/%s", index, name);
+                FILE * file = fopen(path, "r");
+                if (file == NULL)
+                    return 0;
+                char line[256];
+                int result = 0;
+                if (fgets(line, sizeof(line), file))
+                {
+                    va_list args;
+                    va_start(args, format);
+                    result = vsscanf(line, format, args);
+                    va_end(args);
+                }
+                fclose(file);
+                return result > 0 ? result : 0;
+            }
+#endif
+        };
+
+        static const CacheInfo & GetCacheInfo()
+        {
+            static const CacheInfo info;
+            return info;
+        }
+
+        size_t CpuCacheSize(size_t level)
+        {
+            return level >= 1 && level <= 3 ? GetCacheInfo().size[level] : 0;
+        }
+
+        size_t CpuCacheSharing(size_t level)
+        {
+            return level >= 1 && level <= 3 ? GetCacheInfo().sharing[level] : 0;
+        }
+
+        struct ModelInfo
+        {
+            char name[64];
+
+            ModelInfo()
+            {
+                strcpy(name, "Unknown");
+#if defined(SIMD_X86_ENABLE) || defined(SIMD_X64_ENABLE)
+                unsigned int registers[12] = { 0 };
+#if defined(_MSC_VER)
+                __cpuid((int*)registers, 0x80000000);
+#else
+                registers[Cpuid::Eax] = __get_cpuid_max(0x80000000, NULL);
+#endif
+                if (registers[Cpuid::Eax] < 0x80000004)
+                    return;
+                for (unsigned int i = 0; i < 3; ++i)
+                {
+#if defined(_MSC_VER)
+                    __cpuid((int*)registers + i * 4, 0x80000002 + i);
+#else
+                    __cpuid(0x80000002 + i, registers[i * 4 + Cpuid::Eax], registers[i * 4 + Cpuid::Ebx], registers[i * 4 + Cpuid::Ecx], registers[i * 4 + Cpuid::Edx]);
+#endif
+                }
+                const char * brand = (const char*)registers;
+                size_t begin = 0, end = 0;
+                while (end < 48 && brand[end] != 0)
+                    end++;
+                while (begin < end && brand[begin] == ' ')
+                    begin++;
+                while (end > begin && brand[end - 1] == ' ')
+                    end--;
+                if (end > begin)
+                {
+                    memcpy(name, brand + begin, end - begin);
+                    name[end - begin] = 0;
+                }
+#endif
+            }
+        };
+
+        const char * CpuModel()
+        {
+            static const ModelInfo info;
+            return info.name;
+        }
+
+        size_t AlgCacheL1()
+        {
+            return GetCacheInfo().size[1];
+        }
+
+        size_t AlgCacheL2()
+        {
+            return GetCacheInfo().size[2];
+        }
+
+        size_t AlgCacheL3()
+        {
+            const CacheInfo & info = GetCacheInfo();
+            size_t cores = Simd::Max<size_t>(info.sharing[3] / Simd::Max<size_t>(info.sharing[2], 1), 1);
+            return Simd::Min(info.size[3] / cores, info.size[2] * 4);
+        }
+    }
+}
@@ -0,0 +1,248 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2018 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdDeconvolution.h"
+#include "Simd/SimdBase.h"
+
+namespace Simd
+{
+    namespace Base
+    {
+        DeconvolutionGemm::DeconvolutionGemm(const DeconvParam & p)
+            : Deconvolution(p)
+        {
+            if (p.trans)
+            {
+                _M = p.srcH * p.srcW;
+                _N = p.kernelY * p.kernelX * p.dstC / p.group;
+            }
+            else
+            {
+                _M = p.kernelY * p.kernelX * p.dstC / p.group;
+                _N = p.srcH * p.srcW;
+            }
+            _K = p.srcC / p.group;
+            SetGemm(Base::Gemm32fInit(SimdFalse, SimdFalse, _M, _N, _K));
+        }
+
+        size_t DeconvolutionGemm::BufferSize() const
+        {
+            return _M * _N * _param.group;
+        }
+
+        void DeconvolutionGemm::SetWeight(const float * weight, const float * bias)
+        {
+            const DeconvParam & p = _param;
+            _weight.Resize((p.trans ? _N : _M) * _K * p.group);
+            _bias = bias;
+            float * pw = _weight.data;
+            for (size_t g = 0; g < p.group; ++g)
+            {
+                if (p.trans)
+                {
+                    for (size_t k = 0; k < _K; ++k)
+                        for (size_t n = 0; n < _N; ++n)
+                            *pw++ = weight[n * p.srcC + g * _K + k];
+                }
+                else
+                {
+                    for (size_t m = 0; m < _M; ++m)
+                        for (size_t k = 0; k < _K; ++k)
+                            *pw++ = weight[(g * _K + k) * _M + m];
+                }
+            }
+        }
+
+        void DeconvolutionGemm::Forward(const float * src, float * buf, float * dst)
+        {
+            const DeconvParam & p = _param;
+            buf = Buffer(buf);
+            for (size_t b = 0; b < p.batch; ++b)
+            {
+                if (p.trans)
+                {
+                    _gemm->RunBatched(p.group, &_1, src, p.srcC, _K, _weight.data, _N, _K * _N, &_0, buf, _N, _M * _N);
+                    RowToImg(buf, p, dst);
+                }
+                else
+                {
+                    _gemm->RunBatched(p.group, &_1, _weight.data, _K, _M * _K, src, _N, _K * _N, &_0, buf, _N, _M * _N);
+                    ColToImg(buf, p, dst);
+                }
+                ApplyEpilogue(dst);
+                src += p.SrcSize();
+                dst += p.DstSize();
+            }
+        }
+
+        void DeconvolutionGemm::ColToImg(const float * src, const DeconvParam & p, float * dst)
+        {
+            memset(dst, 0, p.DstSize() * sizeof(float));
+            for (size_t c = 0; c < p.dstC; ++c)
+            {
+                for (size_t ky = 0; ky < p.kernelY; ++ky)
+                {
+                    for (size_t kx = 0; kx < p.kernelX; ++kx)
+                    {
+                        for (size_t sy = 0; sy < p.srcH; ++sy, src += p.srcW)
+                        {
+                            size_t dy = sy * p.strideY + ky * p.dilationY - p.padY;
+                            if (dy >= p.dstH)
+                                continue;
+                            float * pd = dst + dy * p.dstW;
+                            for (size_t sx = 0; sx < p.srcW; ++sx)
+                            {
+                                size_t dx = sx * p.strideX + kx * p.dilationX - p.padX;
+                                if (dx < p.dstW)
+                                    pd[dx] += src[sx];
+                            }
+                        }
+                    }
+                }
+                dst += p.dstH * p.dstW;
+            }
+        }
+
+        void DeconvolutionGemm::RowToImg(const float * src, const DeconvParam & p, float * dst)
+        {
+            size_t dstC = p.dstC / p.group;
+            memset(dst, 0, p.DstSize() * sizeof(float));
+            for (size_t g = 0; g < p.group; ++g)
+            {
+                for (size_t sy = 0; sy < p.srcH; ++sy)
+                {
+                    for (size_t sx = 0; sx < p.srcW; ++sx)
+                    {
+                        for (size_t ky = 0; ky < p.kernelY; ++ky)
+                        {
+                            size_t dy = sy * p.strideY + ky * p.dilationY - p.padY;
+                            for (size_t kx = 0; kx < p.kernelX; ++kx, src += dstC)
+                            {
+                                size_t dx = sx * p.strideX + kx * p.dilationX - p.padX;
+                                if (dy < p.dstH && dx < p.dstW)
+                                {
+                                    float * pd = dst + (dy * p.dstW + dx) * p.dstC + g * dstC;
+                                    for (size_t c = 0; c < dstC; ++c)
+                                        pd[c] += src[c];
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        //---------------------------------------------------------------------
+
+        DeconvolutionStride2::DeconvolutionStride2(const DeconvParam & p)
+            : Deconvolution(p)
+        {
+            if (p.trans)
+            {
+                _M = p.srcW;
+                _N = p.kernelX * p.dstC;
+            }
+            else
+            {
+                _M = p.kernelY * p.kernelX * p.dstC;
+                _N = p.srcH * p.srcW;
+            }
+            _K = p.srcC;
+            SetGemm(Base::Gemm32fInit(SimdFalse, SimdFalse, _M, _N, _K));
+        }
+
+        size_t DeconvolutionStride2::BufferSize() const
+        {
+            return _param.trans ? 1 : _M * _N;
+        }
+
+        void DeconvolutionStride2::SetWeight(const float * weight, const float * bias)
+        {
+            const DeconvParam & p = _param;
+            size_t size = p.kernelY * p.kernelX * p.dstC;
+            _weight.Resize(size * p.srcC);
+            _bias = bias;
+            for (size_t k = 0; k < p.srcC; ++k)
+                for (size_t n = 0; n < size; ++n)
+                {
+                    if (p.trans)
+                        _weight[k * size + n] = weight[n * p.srcC + k];
+                    else
+                        _weight[n * p.srcC + k] = weight[k * size + n];
+                }
+        }
+
+        void DeconvolutionStride2::Forward(const float * src, float * buf, float * dst)
+        {
+            const DeconvParam & p = _param;
+            if (!p.trans)
+                buf = Buffer(buf);
+            for (size_t b = 0; b < p.batch; ++b)
+            {
+                if (p.trans)
+                {
+                    for (size_t ky = 0; ky < p.kernelY; ++ky)
+                        _gemm->RunBatched(p.srcH, &_1, src, p.srcC, p.srcW * p.srcC, _weight.data + ky * _N, p.kernelY * _N, 0,
+                            &_0, dst + ky * p.dstW * p.dstC, _N, p.strideY * p.dstW * p.dstC);
+                }
+                else
+                {
+                    _gemm->Run(&_1, _weight.data, _K, src, _N, &_0, buf, _N);
+                    const float * col = buf;
+                    for (size_t c = 0; c < p.dstC; ++c)
+                    {
+                        for (size_t ky = 0; ky < p.kernelY; ++ky)
+                        {
+                            for (size_t kx = 0; kx < p.kernelX; ++kx)
+                            {
+                                float * pd = dst + (c * p.dstH + ky) * p.dstW + kx;
+                                for (size_t sy = 0; sy < p.srcH; ++sy, col += p.srcW, pd += p.strideY * p.dstW)
+                                    for (size_t sx = 0; sx < p.srcW; ++sx)
+                                        pd[sx * p.strideX] = col[sx];
+                            }
+                        }
+                    }
+                }
+                ApplyEpilogue(dst);
+                src += p.SrcSize();
+                dst += p.DstSize();
+            }
+        }
+
+        bool DeconvolutionStride2::Preferable(const DeconvParam & p)
+        {
+            return p.IsKernel(2) && p.IsStride(2) && p.IsDilation(1) && p.IsPad(0) && p.group == 1;
+        }
+
+        //---------------------------------------------------------------------
+
+        void * DeconvolutionInit(SimdBool trans, size_t batch, size_t srcC, size_t srcH, size_t srcW, size_t dstC, size_t kernelY, size_t kernelX, size_t dilationY, size_t dilationX, size_t strideY, size_t strideX, size_t padY, size_t padX, size_t padH, size_t padW, size_t group, SimdConvolutionActivationType activation, const float * activationParams)
+        {
+            DeconvParam param(trans, batch, srcC, srcH, srcW, dstC, kernelY, kernelX, dilationY, dilationX, strideY, strideX, padY, padX, padH, padW, group, activation, activationParams);
+            if (DeconvolutionStride2::Preferable(param))
+                return new DeconvolutionStride2(param);
+            else
+                return new DeconvolutionGemm(param);
+        }
+    }
+}
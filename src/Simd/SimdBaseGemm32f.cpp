@@ -22,6 +22,7 @@
 * SOFTWARE.
 */
 #include "Simd/SimdDefs.h"
+#include "Simd/SimdGemm.h"
 
 namespace Simd
 {
@@ -55,8 +56,8 @@ namespace Simd
                     pC[j] = b * pC[j];
                 for (size_t j = 0; j < N; ++j)
                 {
-                    const float * pA = A + i * K;
-                    const float * pB = B + j * K;
+                    const float * pA = A + i * lda;
+                    const float * pB = B + j * ldb;
                     float sum = 0;
                     for (size_t k = 0; k < K; ++k)
                         sum += pA[k] * pB[k];
@@ -64,5 +65,161 @@ namespace Simd
                 }
             }
         }
+
+        void Gemm32fTN(size_t M, size_t N, size_t K, const float * alpha, const float * A, size_t lda, const float * B, size_t ldb, const float * beta, float * C, size_t ldc)
+        {
+            float b = beta[0];
+            for (size_t i = 0; i < M; ++i)
+            {
+                float * pC = C + i * ldc;
+                for (size_t j = 0; j < N; ++j)
+                    pC[j] = b * pC[j];
+                for (size_t k = 0; k < K; ++k)
+                {
+                    const float * pB = B + k * ldb;
+                    float a = alpha[0] * A[k*lda + i];
+                    for (size_t j = 0; j < N; ++j)
+                        pC[j] = a * pB[j] + pC[j];
+                }
+            }
+        }
+
+        void Gemm32fTT(size_t M, size_t N, size_t K, const float * alpha, const float * A, size_t lda, const float * B, size_t ldb, const float * beta, float * C, size_t ldc)
+        {
+            float b = beta[0];
+            for (size_t i = 0; i < M; ++i)
+            {
+                float * pC = C + i * ldc;
+                for (size_t j = 0; j < N; ++j)
+                {
+                    const float * pB = B + j * ldb;
+                    float sum = 0;
+                    for (size_t k = 0; k < K; ++k)
+                        sum += A[k * lda + i] * pB[k];
+                    pC[j] = b * pC[j] + sum * alpha[0];
+                }
+            }
+        }
+
+        void GemmPackAT(const float * A, size_t lda, size_t M, size_t K, float * pA)
+        {
+            for (size_t i = 0; i < M; ++i)
+                for (size_t k = 0; k < K; ++k)
+                    pA[i * K + k] = A[k * lda + i];
+        }
+
+        void GemmPackBT(const float * B, size_t ldb, size_t K, size_t N, size_t microN, float * pB)
+        {
+            for (size_t j = 0; j < N; j += microN)
+            {
+                size_t n = Simd::Min(microN, N - j);
+                for (size_t k = 0; k < K; ++k, pB += microN)
+                {
+                    size_t jj = 0;
+                    for (; jj < n; ++jj)
+                        pB[jj] = B[(j + jj) * ldb + k];
+                    for (; jj < microN; ++jj)
+                        pB[jj] = 0;
+                }
+            }
+        }
+
+        template<SimdConvolutionActivationType type> void GemmApplyEpilogue(const GemmEpilogue & epilogue, size_t row, size_t col, size_t M, size_t N, float * C, size_t ldc)
+        {
+            const float * bias = epilogue.bias;
+            const float * slope = epilogue.params;
+            float leaky = type == SimdConvolutionActivationLeakyRelu ? slope[0] : 0.0f;
+            for (size_t i = 0; i < M; ++i, C += ldc)
+            {
+                if (epilogue.perColumn)
+                {
+                    for (size_t j = 0; j < N; ++j)
+                    {
+                        float value = bias ? C[j] + bias[col + j] : C[j];
+                        C[j] = GemmActivate<type>(value, type == SimdConvolutionActivationPrelu ? slope[col + j] : leaky);
+                    }
+                }
+                else
+                {
+                    float b = bias ? bias[row + i] : 0.0f;
+                    float s = type == SimdConvolutionActivationPrelu ? slope[row + i] : leaky;
+                    for (size_t j = 0; j < N; ++j)
+                        C[j] = GemmActivate<type>(C[j] + b, s);
+                }
+            }
+        }
+
+        void GemmApplyEpilogue(const GemmEpilogue & epilogue, size_t row, size_t col, size_t M, size_t N, float * C, size_t ldc)
+        {
+            switch (epilogue.activation)
+            {
+            case SimdConvolutionActivationIdentity: GemmApplyEpilogue<SimdConvolutionActivationIdentity>(epilogue, row, col, M, N, C, ldc); break;
+            case SimdConvolutionActivationRelu: GemmApplyEpilogue<SimdConvolutionActivationRelu>(epilogue, row, col, M, N, C, ldc); break;
+            case SimdConvolutionActivationLeakyRelu: GemmApplyEpilogue<SimdConvolutionActivationLeakyRelu>(epilogue, row, col, M, N, C, ldc); break;
+            case SimdConvolutionActivationPrelu: GemmApplyEpilogue<SimdConvolutionActivationPrelu>(epilogue, row, col, M, N, C, ldc); break;
+            case SimdConvolutionActivationSigmoid: GemmApplyEpilogue<SimdConvolutionActivationSigmoid>(epilogue, row, col, M, N, C, ldc); break;
+            default: assert(0);
+            }
+        }
+
+        union GemmBits
+        {
+            float f;
+            uint32_t u;
+        };
+
+        void GemmConvertA16(const float * src, size_t size, SimdGemmFormatType format, uint16_t * dst)
+        {
+            if (format == SimdGemmFormat16f)
+                Float32ToFloat16(src, size, dst);
+            else
+            {
+                for (size_t i = 0; i < size; ++i)
+                {
+                    GemmBits bits;
+                    bits.f = src[i];
+                    dst[i] = uint16_t((bits.u + 0x7FFF + ((bits.u >> 16) & 1)) >> 16);
+                }
+            }
+        }
+
+        SIMD_INLINE void GemmUnpack16(const uint16_t * src, size_t size, SimdGemmFormatType format, float * dst)
+        {
+            if (format == SimdGemmFormat16f)
+                Float16ToFloat32(src, size, dst);
+            else
+            {
+                for (size_t i = 0; i < size; ++i)
+                {
+                    GemmBits bits;
+                    bits.u = uint32_t(src[i]) << 16;
+                    dst[i] = bits.f;
+                }
+            }
+        }
+
+        void GemmPackA16(const uint16_t * A, size_t lda, size_t M, size_t K, SimdGemmFormatType format, bool trans, float * pA)
+        {
+            if (trans)
+            {
+                for (size_t k = 0; k < K; ++k)
+                    for (size_t i = 0; i < M; ++i)
+                        GemmUnpack16(A + k * lda + i, 1, format, pA + i * K + k);
+            }
+            else
+            {
+                for (size_t i = 0; i < M; ++i)
+                    GemmUnpack16(A + i * lda, K, format, pA + i * K);
+            }
+        }
+
+        void * Gemm32fInit(SimdBool transA, SimdBool transB, size_t M, size_t N, size_t K)
+        {
+            if (transA)
+                return new GemmFunc<float>(M, N, K, transB == SimdTrue, transB ? Gemm32fTT : Gemm32fTN, true);
+            if (transB)
+                return new GemmFunc<float>(M, N, K, true, Gemm32fNT);
+            return new GemmFunc<float>(M, N, K, false, Gemm32fNN);
+        }
     }
 }
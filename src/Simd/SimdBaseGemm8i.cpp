@@ -0,0 +1,105 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2018 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdDefs.h"
+#include "Simd/SimdGemm.h"
+
+namespace Simd
+{
+    namespace Base
+    {
+        void Gemm8iPackA(const uint8_t * A, size_t lda, size_t M, size_t K, size_t group, int32_t * pA)
+        {
+            size_t KG = AlignHiAny(K, group) / group;
+            for (size_t i = 0; i < M; ++i, A += lda, pA += KG)
+            {
+                if (group == 4)
+                {
+                    pA[KG - 1] = 0;
+                    memcpy(pA, A, K);
+                }
+                else
+                {
+                    uint16_t * pa = (uint16_t*)pA;
+                    for (size_t k = 0; k < K; ++k)
+                        pa[k] = A[k];
+                    if (K & 1)
+                        pa[K] = 0;
+                }
+            }
+        }
+
+        void Gemm8iPackB(const int8_t * B, size_t ldb, size_t K, size_t N, size_t microN, size_t group, int8_t * pB)
+        {
+            for (size_t j = 0; j < N; j += microN)
+            {
+                size_t n = Simd::Min(N, j + microN) - j;
+                for (size_t k = 0; k < K; k += group)
+                {
+                    size_t g = Simd::Min(K, k + group) - k;
+                    for (size_t c = 0; c < microN; ++c)
+                    {
+                        for (size_t i = 0; i < group; ++i)
+                        {
+                            int8_t value = c < n && i < g ? B[(k + i)*ldb + j + c] : 0;
+                            if (group == 2)
+                                ((int16_t*)pB)[c * 2 + i] = value;
+                            else
+                                pB[c * 4 + i] = value;
+                        }
+                    }
+                    pB += 4 * microN;
+                }
+            }
+        }
+
+        void Gemm8u8i32iNN(size_t M, size_t N, size_t K, const uint8_t * A, size_t lda, const int8_t * B, size_t ldb, int32_t * C, size_t ldc)
+        {
+            for (size_t i = 0; i < M; ++i)
+            {
+                int32_t * pC = C + i * ldc;
+                for (size_t j = 0; j < N; ++j)
+                    pC[j] = 0;
+                for (size_t k = 0; k < K; ++k)
+                {
+                    const int8_t * pB = B + k * ldb;
+                    int32_t a = A[i*lda + k];
+                    for (size_t j = 0; j < N; ++j)
+                        pC[j] += a * pB[j];
+                }
+            }
+        }
+
+        void Gemm8u8i8uNN(size_t M, size_t N, size_t K, const uint8_t * A, size_t lda, const int8_t * B, size_t ldb, const int32_t * bias, const float * scale, uint8_t zero, uint8_t * C, size_t ldc)
+        {
+            GemmRequant requant(bias, scale, zero);
+            std::vector<int32_t> sum(N);
+            for (size_t i = 0; i < M; ++i)
+            {
+                Gemm8u8i32iNN(1, N, K, A + i * lda, lda, B, ldb, sum.data(), N);
+                for (size_t j = 0; j < N; ++j)
+                    C[i*ldc + j] = GemmRequantize(sum[j], requant, j);
+            }
+        }
+    }
+}
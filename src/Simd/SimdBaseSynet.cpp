@@ -132,6 +132,27 @@ namespace Simd
             }
         }
 
+        void SynetElu32f(const float * src, size_t size, const float * alpha, float * dst)
+        {
+            float _alpha = alpha[0];
+            for (size_t i = 0; i < size; ++i)
+                dst[i] = SynetElu32f(src[i], _alpha);
+        }
+
+        void SynetGelu32f(const float * src, size_t size, float * dst)
+        {
+            for (size_t i = 0; i < size; ++i)
+                dst[i] = SynetGelu32f(src[i]);
+        }
+
+        void SynetHswish32f(const float * src, size_t size, const float * shift, const float * scale, float * dst)
+        {
+            float _shift = shift[0];
+            float _scale = scale[0];
+            for (size_t i = 0; i < size; ++i)
+                dst[i] = SynetHswish32f(src[i], _shift, _scale);
+        }
+
         void SynetLrnLayerCrossChannels(const float * src, size_t half, size_t count, size_t size, const float * k, float * dst)
         {
             float k0 = k[0], k1 = k[1], k2 = k[2];
@@ -202,5 +223,54 @@ namespace Simd
                 }
             }
         }
+
+        void SynetSigmoid32f(const float * src, size_t size, float * dst)
+        {
+            for (size_t i = 0; i < size; ++i)
+                dst[i] = SynetSigmoid32f(src[i]);
+        }
+
+        void SynetSoftmaxLayerForward(const float * src, size_t outer, size_t count, size_t inner, float * dst)
+        {
+            Array32f buffer(inner * 2);
+            float * max = buffer.data, * sum = buffer.data + inner;
+            for (size_t o = 0; o < outer; ++o)
+            {
+                for (size_t j = 0; j < inner; ++j)
+                    max[j] = src[j];
+                for (size_t c = 1; c < count; ++c)
+                {
+                    const float * s = src + c * inner;
+                    for (size_t j = 0; j < inner; ++j)
+                        max[j] = Simd::Max(max[j], s[j]);
+                }
+                for (size_t j = 0; j < inner; ++j)
+                    sum[j] = 0.0f;
+                for (size_t c = 0; c < count; ++c)
+                {
+                    const float * s = src + c * inner;
+                    float * d = dst + c * inner;
+                    for (size_t j = 0; j < inner; ++j)
+                    {
+                        d[j] = ::expf(s[j] - max[j]);
+                        sum[j] += d[j];
+                    }
+                }
+                for (size_t c = 0; c < count; ++c)
+                {
+                    float * d = dst + c * inner;
+                    for (size_t j = 0; j < inner; ++j)
+                        d[j] /= sum[j];
+                }
+                src += count * inner;
+                dst += count * inner;
+            }
+        }
+
+        void SynetTanh32f(const float * src, size_t size, float * dst)
+        {
+            for (size_t i = 0; i < size; ++i)
+                dst[i] = SynetTanh32f(src[i]);
+        }
     }
 }
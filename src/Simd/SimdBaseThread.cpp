@@ -23,6 +23,8 @@
 */
 #include "Simd/SimdMath.h"
 #include "Simd/SimdBase.h"
+#include "Simd/SimdParallel.hpp"
+#include "Simd/SimdContext.h"
 
 #include <thread>
 
@@ -32,14 +34,44 @@ namespace Simd
     {
         size_t g_threadNumber = 1;
 
+        static thread_local Context * g_context = NULL;
+
         size_t GetThreadNumber()
         {
-            return g_threadNumber;
+            return g_context ? g_context->threadNumber : g_threadNumber;
         }
 
         void SetThreadNumber(size_t threadNumber)
         {
             g_threadNumber = Simd::RestrictRange<size_t>(threadNumber, 1, std::thread::hardware_concurrency());
+            ThreadPool::Global().Reserve(g_threadNumber);
+        }
+
+        Context * GetContext()
+        {
+            return g_context;
+        }
+
+        void SetContext(Context * context)
+        {
+            if (context)
+                context->pool.Reserve(context->threadNumber);
+            g_context = context;
+            ThreadPool::Current() = context ? &context->pool : NULL;
+        }
+
+        void SetThreadNumber(Context * context, size_t threadNumber)
+        {
+            context->threadNumber = Simd::RestrictRange<size_t>(threadNumber, 1, std::thread::hardware_concurrency());
+            if (context == g_context)
+                context->pool.Reserve(context->threadNumber);
+        }
+
+        void * ContextInit(size_t threadNumber)
+        {
+            Context * context = new Context(1);
+            SetThreadNumber(context, threadNumber);
+            return context;
         }
     }
 }
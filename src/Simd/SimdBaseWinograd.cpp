@@ -163,11 +163,10 @@ namespace Simd
             Winograd2x3pSetInput1(tmp, 4, dst, dstStride);
         }
 
-        void Winograd2x3pSetInput(const float * src, size_t srcChannels, size_t srcHeight, size_t srcWidth, float * dst, int pad)
+        static void Winograd2x3pSetInput(const float * src, size_t srcChannels, size_t srcHeight, size_t srcWidth, float * dst, size_t dstStride, int pad)
         {
             size_t dstHeight = pad ? srcHeight : srcHeight - 2;
             size_t dstWidth = pad ? srcWidth : srcWidth - 2;
-            size_t dstStride = ((dstHeight + 1) / 2) * ((dstWidth + 1) / 2)*srcChannels;
             size_t dstHeightFull = AlignLo(dstHeight, 2);
             size_t dstWidthFull = AlignLo(dstWidth, 2);
             size_t noseW = Simd::Min<size_t>(4, dstWidth + 1);
@@ -217,6 +216,11 @@ namespace Simd
             }
         }
 
+        void Winograd2x3pSetInput(const float * src, size_t srcChannels, size_t srcHeight, size_t srcWidth, float * dst, int pad)
+        {
+            WinogradSetInput(Winograd2x3pSetInput, 2, src, srcChannels, srcHeight, srcWidth, dst, pad);
+        }
+
         SIMD_INLINE void Winograd2x3pSetOutput1(const float * src, size_t srcStride, float * dst, size_t dstStride)
         {
             float c1[16];
@@ -262,9 +266,8 @@ namespace Simd
                     dst[row*dstStride + col] = tmp[row * 2 + col];
         }
 
-        void Winograd2x3pSetOutput(const float * src, float * dst, size_t dstChannels, size_t dstHeight, size_t dstWidth)
+        static void Winograd2x3pSetOutput(const float * src, size_t srcStride, float * dst, size_t dstChannels, size_t dstHeight, size_t dstWidth)
         {
-            size_t srcStride = ((dstHeight + 1) / 2) * ((dstWidth + 1) / 2)*dstChannels;
             size_t dstHeightFull = AlignLo(dstHeight, 2);
             size_t dstWidthFull = AlignLo(dstWidth, 2);
             for (size_t c = 0; c < dstChannels; ++c)
@@ -288,6 +291,11 @@ namespace Simd
             }
         }
 
+        void Winograd2x3pSetOutput(const float * src, float * dst, size_t dstChannels, size_t dstHeight, size_t dstWidth)
+        {
+            WinogradSetOutput(Winograd2x3pSetOutput, 2, src, dst, dstChannels, dstHeight, dstWidth);
+        }
+
         void Winograd4x3pSetFilter(const float * src, size_t size, float * dst)
         {
             for (size_t i = 0; i < size; i += 1, src += 9, dst += 1)
@@ -419,11 +427,10 @@ namespace Simd
             Winograd4x3pSetInput1(tmp, 6, dst, dstStride);
         }
 
-        void Winograd4x3pSetInput(const float * src, size_t srcChannels, size_t srcHeight, size_t srcWidth, float * dst, int pad)
+        static void Winograd4x3pSetInput(const float * src, size_t srcChannels, size_t srcHeight, size_t srcWidth, float * dst, size_t dstStride, int pad)
         {
             size_t dstHeight = pad ? srcHeight : srcHeight - 2;
             size_t dstWidth = pad ? srcWidth : srcWidth - 2;
-            size_t dstStride = ((dstHeight + 3) / 4) * ((dstWidth + 3) / 4)*srcChannels;
             size_t dstHeightFull = dstHeight / 4 * 4;
             size_t dstWidthFull = dstWidth / 4 * 4;
             size_t noseW = Simd::Min<size_t>(6, dstWidth + 1);
@@ -473,6 +480,11 @@ namespace Simd
             }
         }
 
+        void Winograd4x3pSetInput(const float * src, size_t srcChannels, size_t srcHeight, size_t srcWidth, float * dst, int pad)
+        {
+            WinogradSetInput(Winograd4x3pSetInput, 4, src, srcChannels, srcHeight, srcWidth, dst, pad);
+        }
+
         void Winograd4x3pSetOutput1(const float * src, size_t srcStride, float * dst, size_t dstStride)
         {
             float c1[36];
@@ -566,9 +578,8 @@ namespace Simd
                     dst[row*dstStride + col] = tmp[row * 4 + col];
         }
 
-        void Winograd4x3pSetOutput(const float * src, float * dst, size_t dstChannels, size_t dstHeight, size_t dstWidth)
+        static void Winograd4x3pSetOutput(const float * src, size_t srcStride, float * dst, size_t dstChannels, size_t dstHeight, size_t dstWidth)
         {
-            size_t srcStride = ((dstHeight + 3) / 4) * ((dstWidth + 3) / 4)*dstChannels;
             size_t dstHeightFull = dstHeight / 4 * 4;
             size_t dstWidthFull = dstWidth / 4 * 4;
             for (size_t c = 0; c < dstChannels; ++c)
@@ -591,5 +602,10 @@ namespace Simd
                 dst += dstHeight * dstWidth;
             }
         }
+
+        void Winograd4x3pSetOutput(const float * src, float * dst, size_t dstChannels, size_t dstHeight, size_t dstWidth)
+        {
+            WinogradSetOutput(Winograd4x3pSetOutput, 4, src, dst, dstChannels, dstHeight, dstWidth);
+        }
     }
 }
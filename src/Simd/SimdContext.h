@@ -0,0 +1,73 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2018 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#ifndef __SimdContext_h__
+#define __SimdContext_h__
+
+#include "Simd/SimdArray.h"
+#include "Simd/SimdParallel.hpp"
+
+#include <map>
+
+namespace Simd
+{
+    struct Context : public Deletable
+    {
+        size_t threadNumber;
+        ThreadPool pool;
+
+        Context(size_t threadNumber_)
+            : threadNumber(threadNumber_)
+        {
+        }
+
+        uint8_t * Scratch(size_t size)
+        {
+            Array<uint8_t> * scratch;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                scratch = &_scratch[std::this_thread::get_id()];
+            }
+            if (size > scratch->size)
+                scratch->Resize(size);
+            return scratch->data;
+        }
+
+    private:
+        std::mutex _mutex;
+        std::map<std::thread::id, Array<uint8_t>> _scratch;
+    };
+
+    namespace Base
+    {
+        Context * GetContext();
+
+        void SetContext(Context * context);
+
+        void SetThreadNumber(Context * context, size_t threadNumber);
+
+        void * ContextInit(size_t threadNumber);
+    }
+}
+
+#endif//__SimdContext_h__
@@ -25,6 +25,8 @@
 #define __SimdConvolution_h__
 
 #include "Simd/SimdArray.h"
+#include "Simd/SimdContext.h"
+#include "Simd/SimdGemm.h"
 
 #ifdef _N
 #define _N_OLD _N
@@ -35,11 +37,16 @@ namespace Simd
 {
     struct ConvParam
     {
-        size_t srcC, srcH, srcW, dstC, dstH, dstW, kernelY, kernelX, dilationY, dilationX, strideY, strideX, padY, padX, padH, padW, group;
+        size_t batch, srcC, srcH, srcW, dstC, dstH, dstW, kernelY, kernelX, dilationY, dilationX, strideY, strideX, padY, padX, padH, padW, group;
+        bool trans;
+        SimdConvolutionActivationType activation;
+        const float * activationParams;
 
-        ConvParam(size_t srcC, size_t srcH, size_t srcW, size_t dstC, size_t kernelY, size_t kernelX, size_t dilationY, size_t dilationX,
-            size_t strideY, size_t strideX, size_t padY, size_t padX, size_t padH, size_t padW, size_t group)
+        ConvParam(SimdBool trans, size_t batch, size_t srcC, size_t srcH, size_t srcW, size_t dstC, size_t kernelY, size_t kernelX, size_t dilationY, size_t dilationX,
+            size_t strideY, size_t strideX, size_t padY, size_t padX, size_t padH, size_t padW, size_t group, SimdConvolutionActivationType activation, const float * activationParams)
         {
+            this->trans = trans == SimdTrue;
+            this->batch = batch;
             this->srcC = srcC;
             this->srcH = srcH;
             this->srcW = srcW;
@@ -57,6 +64,18 @@ namespace Simd
             this->padH = padH;
             this->padW = padW;
             this->group = group;
+            this->activation = activation;
+            this->activationParams = activationParams;
+        }
+
+        SIMD_INLINE size_t ActivationParamsSize() const
+        {
+            switch (activation)
+            {
+            case SimdConvolutionActivationLeakyRelu: return 1;
+            case SimdConvolutionActivationPrelu: return dstC;
+            default: return 0;
+            }
         }
 
         SIMD_INLINE bool IsKernel(size_t value) const
@@ -78,20 +97,57 @@ namespace Simd
         {
             return padY == value && padX == value && padH == value && padW == value;
         }
+
+        SIMD_INLINE size_t SrcSize() const
+        {
+            return srcC * srcH * srcW;
+        }
+
+        SIMD_INLINE size_t DstSize() const
+        {
+            return dstC * dstH * dstW;
+        }
+    };
+
+    enum ConvolutionAlgorithm
+    {
+        ConvolutionAlgorithmImgToCol,
+        ConvolutionAlgorithmImgToRow,
+        ConvolutionAlgorithmWinograd2x3p,
+        ConvolutionAlgorithmWinograd4x3p,
+        ConvolutionAlgorithmDirect,
+        ConvolutionAlgorithmDepthwise,
+        ConvolutionAlgorithmNhwcGemm,
+        ConvolutionAlgorithmNhwcDirect,
+        ConvolutionAlgorithmNhwcDepthwise,
+        ConvolutionAlgorithmSize
     };
 
     class Convolution : public Deletable
     {
     public:
-        Convolution(const ConvParam & p) : _param(p), _0(0.0f), _1(1.0f) {}
+        Convolution(const ConvParam & p) 
+            : _param(p)
+            , _0(0.0f)
+            , _1(1.0f)
+            , _applyEpilogue(Base::GemmApplyEpilogue)
+        {
+            _activationParams.Resize(p.ActivationParamsSize());
+            if (_activationParams.size)
+                memcpy(_activationParams.data, p.activationParams, _activationParams.size * sizeof(float));
+            _param.activationParams = _activationParams.data;
+        }
+
         virtual size_t BufferSize() const = 0;
-        virtual void SetWeight(const float * weight, const float * bias) = 0;
+        virtual void SetWeight(const float * weight, const float * bias, SimdGemmFormatType format) = 0;
         virtual void Forward(const float * src, float * buf, float * dst) = 0;
 
         float * Buffer(float * buffer)
         {
             if (buffer)
                 return buffer;
+            else if (Context * context = Base::GetContext())
+                return (float*)context->Scratch(BufferSize() * sizeof(float));
             else
             {
                 _buffer.Resize(BufferSize());
@@ -100,9 +156,28 @@ namespace Simd
         }
 
     protected:
+        GemmEpilogue Epilogue(const float * bias, bool perColumn = false) const
+        {
+            return GemmEpilogue(bias, _param.activation, _activationParams.data, perColumn);
+        }
+
+        void ApplyEpilogue(const float * bias, float * dst) const
+        {
+            const ConvParam & p = _param;
+            GemmEpilogue epilogue = Epilogue(bias);
+            if (epilogue.Empty())
+                return;
+            size_t size = p.dstH * p.dstW;
+            Simd::Parallel(0, p.dstC, [&](size_t thread, size_t begin, size_t end)
+            {
+                _applyEpilogue(epilogue, begin, 0, end - begin, size, dst + begin * size, size);
+            }, ConvolutionThreads(p.dstC * size));
+        }
+
         ConvParam _param;
-        Array32f _buffer;
+        Array32f _buffer, _activationParams;
         float _0, _1;
+        GemmEpilogue::Func _applyEpilogue;
     };
 
     namespace Base
@@ -111,17 +186,25 @@ namespace Simd
         {
         public:
             ConvolutionImgToCol(const ConvParam & p);
+            virtual ~ConvolutionImgToCol();
             virtual size_t BufferSize() const;
-            virtual void SetWeight(const float * weight, const float * bias);
+            virtual void SetWeight(const float * weight, const float * bias, SimdGemmFormatType format);
             virtual void Forward(const float * src, float * buf, float * dst);
 
         protected:
             virtual void GemmAndBias(const float * src, float * dst);
 
+            void SetGemm(void * gemm);
+            void RunGemm(Gemm<float> * gemm, const float * src, float * dst);
+
             static void ImgToCol(const float * src, const ConvParam & p, float * dst);
+            static void ImgToCol(const float * src, const ConvParam & p, size_t channels, float * dst);
 
             bool _is1x1;
             const float * _weight, * _bias;
+            Array<uint16_t> _weight16;
+            Gemm<float> * _gemm;
+            SimdGemmFormatType _format;
             size_t _weightStep, _srcStep, _dstStep, _M, _N, _K;
         };
 
@@ -129,8 +212,9 @@ namespace Simd
         {
         public:
             ConvolutionImgToRow(const ConvParam & p);
+            virtual ~ConvolutionImgToRow();
             virtual size_t BufferSize() const;
-            virtual void SetWeight(const float * weight, const float * bias);
+            virtual void SetWeight(const float * weight, const float * bias, SimdGemmFormatType format);
             virtual void Forward(const float * src, float * buf, float * dst);
 
             static bool Preferable(const ConvParam & p);
@@ -138,9 +222,15 @@ namespace Simd
         protected:
             virtual void GemmAndBias(const float * src, float * dst);
 
+            void SetGemm(void * gemm);
+            void RunGemm(Gemm<float> * gemm, const float * src, float * dst);
+
             static void ImgToRow(const float * src, const ConvParam & p, float * dst);
 
             const float * _weight, *_bias;
+            Array<uint16_t> _weight16;
+            Gemm<float> * _gemm;
+            SimdGemmFormatType _format;
             size_t _weightStep, _srcStep, _dstStep, _M, _N, _K;
         };
 
@@ -149,7 +239,7 @@ namespace Simd
         public:
             ConvolutionWinograd2x3p(const ConvParam & p);
             virtual size_t BufferSize() const;
-            virtual void SetWeight(const float * weight, const float * bias);
+            virtual void SetWeight(const float * weight, const float * bias, SimdGemmFormatType format);
             virtual void Forward(const float * src, float * buf, float * dst);
 
             static bool Preferable(const ConvParam & p);
@@ -161,12 +251,33 @@ namespace Simd
             const float * _bias;
         };
 
+        class ConvolutionWinograd4x3p : public Convolution
+        {
+        public:
+            ConvolutionWinograd4x3p(const ConvParam & p);
+            virtual ~ConvolutionWinograd4x3p();
+            virtual size_t BufferSize() const;
+            virtual void SetWeight(const float * weight, const float * bias, SimdGemmFormatType format);
+            virtual void Forward(const float * src, float * buf, float * dst);
+
+            static bool Preferable(const ConvParam & p);
+
+        protected:
+            void SetGemm(void * gemm);
+
+            size_t _count, _block, _tileH, _tileW, _strideW, _strideS, _strideD, _M, _N, _K;
+            int _pad;
+            Array32f _weight;
+            const float * _bias;
+            Gemm<float> * _gemm;
+        };
+
         class ConvolutionDirect : public Convolution
         {
         public:
             ConvolutionDirect(const ConvParam & p);
             virtual size_t BufferSize() const;
-            virtual void SetWeight(const float * weight, const float * bias);
+            virtual void SetWeight(const float * weight, const float * bias, SimdGemmFormatType format);
             virtual void Forward(const float * src, float * buf, float * dst);
 
             static bool Preferable(const ConvParam & p);
@@ -181,7 +292,92 @@ namespace Simd
             const float * _weight, * _bias;
         };
 
-        void * ConvolutionInit(size_t srcC, size_t srcH, size_t srcW, size_t dstC, size_t kernelY, size_t kernelX, size_t dilationY, size_t dilationX, size_t strideY, size_t strideX, size_t padY, size_t padX, size_t padH, size_t padW, size_t group);
+        class ConvolutionDepthwise : public Convolution
+        {
+        public:
+            ConvolutionDepthwise(const ConvParam & p);
+            virtual size_t BufferSize() const;
+            virtual void SetWeight(const float * weight, const float * bias, SimdGemmFormatType format);
+            virtual void Forward(const float * src, float * buf, float * dst);
+
+            static bool Preferable(const ConvParam & p);
+
+        protected:
+            void Pad(const float * src, float * dst) const;
+            virtual void ConvolveChannel(const float * src, const float * weight, float bias, float * dst);
+
+            size_t _srcH, _srcW;
+            bool _pad;
+            const float * _weight, * _bias;
+        };
+
+        class ConvolutionNhwcGemm : public Convolution
+        {
+        public:
+            ConvolutionNhwcGemm(const ConvParam & p);
+            virtual ~ConvolutionNhwcGemm();
+            virtual size_t BufferSize() const;
+            virtual void SetWeight(const float * weight, const float * bias, SimdGemmFormatType format);
+            virtual void Forward(const float * src, float * buf, float * dst);
+
+            static bool Preferable(const ConvParam & p);
+
+        protected:
+            void SetGemm(void * gemm);
+
+            static void ImgToRow(const float * src, const ConvParam & p, size_t batch, float * dst);
+
+            bool _is1x1;
+            size_t _batch, _M, _N, _K;
+            const float * _weight, * _bias;
+            Array32f _packedB;
+            Gemm<float> * _gemm;
+        };
+
+        class ConvolutionNhwcDirect : public Convolution
+        {
+        public:
+            ConvolutionNhwcDirect(const ConvParam & p);
+            virtual size_t BufferSize() const;
+            virtual void SetWeight(const float * weight, const float * bias, SimdGemmFormatType format);
+            virtual void Forward(const float * src, float * buf, float * dst);
+
+            static bool Preferable(const ConvParam & p);
+
+        protected:
+            virtual void ConvolvePixel(const float * src, size_t dy, size_t dx, float * dst);
+
+            static void BodyRange(size_t srcS, size_t dstS, size_t kernel, size_t dilation, size_t stride, size_t pad, size_t & beg, size_t & end);
+
+            size_t _srcC, _dstC;
+            const float * _weight, * _bias;
+        };
+
+        class ConvolutionNhwcDepthwise : public Convolution
+        {
+        public:
+            ConvolutionNhwcDepthwise(const ConvParam & p);
+            virtual size_t BufferSize() const;
+            virtual void SetWeight(const float * weight, const float * bias, SimdGemmFormatType format);
+            virtual void Forward(const float * src, float * buf, float * dst);
+
+            static bool Preferable(const ConvParam & p);
+
+        protected:
+            virtual void ConvolvePixel(const float * src, size_t dy, size_t dx, float * dst);
+
+            const float * _weight, * _bias;
+        };
+
+        Convolution * ConvolutionCreate(const ConvParam & p, ConvolutionAlgorithm algorithm);
+
+        typedef Convolution * (*ConvolutionCreatePtr)(const ConvParam & p, ConvolutionAlgorithm algorithm);
+
+        void ConvolutionSetTuning(bool enable, const char * cache);
+
+        Convolution * ConvolutionTune(const ConvParam & p, const char * isa, ConvolutionCreatePtr create);
+
+        void * ConvolutionInit(SimdBool trans, size_t batch, size_t srcC, size_t srcH, size_t srcW, size_t dstC, size_t kernelY, size_t kernelX, size_t dilationY, size_t dilationX, size_t strideY, size_t strideX, size_t padY, size_t padX, size_t padH, size_t padW, size_t group, SimdConvolutionActivationType activation, const float * activationParams);
     }
 
 #ifdef SIMD_SSE_ENABLE    
@@ -199,11 +395,53 @@ namespace Simd
         {
         public:
             ConvolutionWinograd2x3p(const ConvParam & p);
-            virtual void SetWeight(const float * weight, const float * bias);
+            virtual void SetWeight(const float * weight, const float * bias, SimdGemmFormatType format);
+            virtual void Forward(const float * src, float * buf, float * dst);
+        };
+
+        class ConvolutionWinograd4x3p : public Base::ConvolutionWinograd4x3p
+        {
+        public:
+            ConvolutionWinograd4x3p(const ConvParam & p);
+            virtual void SetWeight(const float * weight, const float * bias, SimdGemmFormatType format);
+            virtual void Forward(const float * src, float * buf, float * dst);
+        };
+
+        class ConvolutionDepthwise : public Base::ConvolutionDepthwise
+        {
+        public:
+            ConvolutionDepthwise(const ConvParam & p);
+        protected:
+            virtual void ConvolveChannel(const float * src, const float * weight, float bias, float * dst);
+        };
+
+        class ConvolutionNhwcGemm : public Base::ConvolutionNhwcGemm
+        {
+        public:
+            ConvolutionNhwcGemm(const ConvParam & p);
+        };
+
+        class ConvolutionNhwcDirect : public Base::ConvolutionNhwcDirect
+        {
+        public:
+            ConvolutionNhwcDirect(const ConvParam & p);
             virtual void Forward(const float * src, float * buf, float * dst);
+        protected:
+            virtual void ConvolvePixel(const float * src, size_t dy, size_t dx, float * dst);
+            void ConvolveBody(const float * src, size_t dy, size_t dx, size_t n, float * dst);
         };
 
-        void * ConvolutionInit(size_t srcC, size_t srcH, size_t srcW, size_t dstC, size_t kernelY, size_t kernelX, size_t dilationY, size_t dilationX, size_t strideY, size_t strideX, size_t padY, size_t padX, size_t padH, size_t padW, size_t group);
+        class ConvolutionNhwcDepthwise : public Base::ConvolutionNhwcDepthwise
+        {
+        public:
+            ConvolutionNhwcDepthwise(const ConvParam & p);
+        protected:
+            virtual void ConvolvePixel(const float * src, size_t dy, size_t dx, float * dst);
+        };
+
+        Convolution * ConvolutionCreate(const ConvParam & p, ConvolutionAlgorithm algorithm);
+
+        void * ConvolutionInit(SimdBool trans, size_t batch, size_t srcC, size_t srcH, size_t srcW, size_t dstC, size_t kernelY, size_t kernelX, size_t dilationY, size_t dilationX, size_t strideY, size_t strideX, size_t padY, size_t padX, size_t padH, size_t padW, size_t group, SimdConvolutionActivationType activation, const float * activationParams);
     }
 #endif//SIMD_SSE_ENABLE
 
@@ -221,7 +459,9 @@ namespace Simd
             virtual void GemmAndBias(const float * src, float * dst);
         };
 
-        void * ConvolutionInit(size_t srcC, size_t srcH, size_t srcW, size_t dstC, size_t kernelY, size_t kernelX, size_t dilationY, size_t dilationX, size_t strideY, size_t strideX, size_t padY, size_t padX, size_t padH, size_t padW, size_t group);
+        Convolution * ConvolutionCreate(const ConvParam & p, ConvolutionAlgorithm algorithm);
+
+        void * ConvolutionInit(SimdBool trans, size_t batch, size_t srcC, size_t srcH, size_t srcW, size_t dstC, size_t kernelY, size_t kernelX, size_t dilationY, size_t dilationX, size_t strideY, size_t strideX, size_t padY, size_t padX, size_t padH, size_t padW, size_t group, SimdConvolutionActivationType activation, const float * activationParams);
     }
 #endif//SIMD_SSE3_ENABLE
 
@@ -251,7 +491,50 @@ namespace Simd
             virtual void Forward(const float * src, float * buf, float * dst);
         };
 
-        void * ConvolutionInit(size_t srcC, size_t srcH, size_t srcW, size_t dstC, size_t kernelY, size_t kernelX, size_t dilationY, size_t dilationX, size_t strideY, size_t strideX, size_t padY, size_t padX, size_t padH, size_t padW, size_t group);
+        class ConvolutionWinograd4x3p : public Sse::ConvolutionWinograd4x3p
+        {
+        public:
+            ConvolutionWinograd4x3p(const ConvParam & p);
+            virtual void Forward(const float * src, float * buf, float * dst);
+
+            static bool Preferable(const ConvParam & p);
+        };
+
+        class ConvolutionDepthwise : public Sse::ConvolutionDepthwise
+        {
+        public:
+            ConvolutionDepthwise(const ConvParam & p);
+        protected:
+            virtual void ConvolveChannel(const float * src, const float * weight, float bias, float * dst);
+        };
+
+        class ConvolutionNhwcGemm : public Sse::ConvolutionNhwcGemm
+        {
+        public:
+            ConvolutionNhwcGemm(const ConvParam & p);
+        };
+
+        class ConvolutionNhwcDirect : public Sse::ConvolutionNhwcDirect
+        {
+        public:
+            ConvolutionNhwcDirect(const ConvParam & p);
+            virtual void Forward(const float * src, float * buf, float * dst);
+        protected:
+            virtual void ConvolvePixel(const float * src, size_t dy, size_t dx, float * dst);
+            void ConvolveBody(const float * src, size_t dy, size_t dx, size_t n, float * dst);
+        };
+
+        class ConvolutionNhwcDepthwise : public Sse::ConvolutionNhwcDepthwise
+        {
+        public:
+            ConvolutionNhwcDepthwise(const ConvParam & p);
+        protected:
+            virtual void ConvolvePixel(const float * src, size_t dy, size_t dx, float * dst);
+        };
+
+        Convolution * ConvolutionCreate(const ConvParam & p, ConvolutionAlgorithm algorithm);
+
+        void * ConvolutionInit(SimdBool trans, size_t batch, size_t srcC, size_t srcH, size_t srcW, size_t dstC, size_t kernelY, size_t kernelX, size_t dilationY, size_t dilationX, size_t strideY, size_t strideX, size_t padY, size_t padX, size_t padH, size_t padW, size_t group, SimdConvolutionActivationType activation, const float * activationParams);
 }
 #endif//SIMD_AVX_ENABLE
 
@@ -281,7 +564,47 @@ namespace Simd
             virtual void Forward(const float * src, float * buf, float * dst);
         };
 
-        void * ConvolutionInit(size_t srcC, size_t srcH, size_t srcW, size_t dstC, size_t kernelY, size_t kernelX, size_t dilationY, size_t dilationX, size_t strideY, size_t strideX, size_t padY, size_t padX, size_t padH, size_t padW, size_t group);
+        class ConvolutionWinograd4x3p : public Avx::ConvolutionWinograd4x3p
+        {
+        public:
+            ConvolutionWinograd4x3p(const ConvParam & p);
+        };
+
+        class ConvolutionDepthwise : public Avx::ConvolutionDepthwise
+        {
+        public:
+            ConvolutionDepthwise(const ConvParam & p);
+        protected:
+            virtual void ConvolveChannel(const float * src, const float * weight, float bias, float * dst);
+        };
+
+        class ConvolutionNhwcGemm : public Avx::ConvolutionNhwcGemm
+        {
+        public:
+            ConvolutionNhwcGemm(const ConvParam & p);
+        };
+
+        class ConvolutionNhwcDirect : public Avx::ConvolutionNhwcDirect
+        {
+        public:
+            ConvolutionNhwcDirect(const ConvParam & p);
+            virtual void Forward(const float * src, float * buf, float * dst);
+        protected:
+            virtual void ConvolvePixel(const float * src, size_t dy, size_t dx, float * dst);
+            void ConvolveBody(const float * src, size_t dy, size_t dx, size_t n, float * dst);
+        };
+
+        class ConvolutionNhwcDepthwise : public Avx::ConvolutionNhwcDepthwise
+        {
+        public:
+            ConvolutionNhwcDepthwise(const ConvParam & p);
+        protected:
+            virtual void ConvolvePixel(const float * src, size_t dy, size_t dx, float * dst);
+        };
+
+        Convolution * ConvolutionCreate(const ConvParam & p, ConvolutionAlgorithm algorithm);
+
+        void * ConvolutionInit(SimdBool trans, size_t batch, size_t srcC, size_t srcH, size_t srcW, size_t dstC, size_t kernelY, size_t kernelX, size_t dilationY, size_t dilationX, size_t strideY, size_t strideX, size_t padY, size_t padX, size_t padH, size_t padW, size_t group, SimdConvolutionActivationType activation, const float * activationParams);
 }
 #endif//SIMD_AVX2_ENABLE
 
@@ -311,7 +634,50 @@ namespace Simd
             virtual void Forward(const float * src, float * buf, float * dst);
         };
 
-        void * ConvolutionInit(size_t srcC, size_t srcH, size_t srcW, size_t dstC, size_t kernelY, size_t kernelX, size_t dilationY, size_t dilationX, size_t strideY, size_t strideX, size_t padY, size_t padX, size_t padH, size_t padW, size_t group);
+        class ConvolutionWinograd4x3p : public Avx2::ConvolutionWinograd4x3p
+        {
+        public:
+            ConvolutionWinograd4x3p(const ConvParam & p);
+            virtual void Forward(const float * src, float * buf, float * dst);
+
+            static bool Preferable(const ConvParam & p);
+        };
+
+        class ConvolutionDepthwise : public Avx2::ConvolutionDepthwise
+        {
+        public:
+            ConvolutionDepthwise(const ConvParam & p);
+        protected:
+            virtual void ConvolveChannel(const float * src, const float * weight, float bias, float * dst);
+        };
+
+        class ConvolutionNhwcGemm : public Avx2::ConvolutionNhwcGemm
+        {
+        public:
+            ConvolutionNhwcGemm(const ConvParam & p);
+        };
+
+        class ConvolutionNhwcDirect : public Avx2::ConvolutionNhwcDirect
+        {
+        public:
+            ConvolutionNhwcDirect(const ConvParam & p);
+            virtual void Forward(const float * src, float * buf, float * dst);
+        protected:
+            virtual void ConvolvePixel(const float * src, size_t dy, size_t dx, float * dst);
+            void ConvolveBody(const float * src, size_t dy, size_t dx, size_t n, float * dst);
+        };
+
+        class ConvolutionNhwcDepthwise : public Avx2::ConvolutionNhwcDepthwise
+        {
+        public:
+            ConvolutionNhwcDepthwise(const ConvParam & p);
+        protected:
+            virtual void ConvolvePixel(const float * src, size_t dy, size_t dx, float * dst);
+        };
+
+        Convolution * ConvolutionCreate(const ConvParam & p, ConvolutionAlgorithm algorithm);
+
+        void * ConvolutionInit(SimdBool trans, size_t batch, size_t srcC, size_t srcH, size_t srcW, size_t dstC, size_t kernelY, size_t kernelX, size_t dilationY, size_t dilationX, size_t strideY, size_t strideX, size_t padY, size_t padX, size_t padH, size_t padW, size_t group, SimdConvolutionActivationType activation, const float * activationParams);
     }
 #endif//SIMD_AVX512F_ENABLE
 }
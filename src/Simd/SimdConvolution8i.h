@@ -0,0 +1,116 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2018 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#ifndef __SimdConvolution8i_h__
+#define __SimdConvolution8i_h__
+
+#include "Simd/SimdConvolution.h"
+
+namespace Simd
+{
+    class Convolution8i : public Deletable
+    {
+    public:
+        typedef void(*Gemm32iPtr)(size_t M, size_t N, size_t K, const uint8_t * A, size_t lda, const int8_t * B, size_t ldb, int32_t * C, size_t ldc);
+        typedef void(*Gemm8uPtr)(size_t M, size_t N, size_t K, const uint8_t * A, size_t lda, const int8_t * B, size_t ldb, const int32_t * bias, const float * scale, uint8_t zero, uint8_t * C, size_t ldc);
+
+        Convolution8i(const ConvParam & p, bool dst8u)
+            : _param(p)
+            , _dst8u(dst8u)
+        {
+        }
+
+        virtual size_t BufferSize() const = 0;
+        virtual void SetWeight(const float * weight, const float * bias, float srcScale, uint8_t srcZero, float dstScale, uint8_t dstZero) = 0;
+        virtual void Forward(const uint8_t * src, uint8_t * buf, uint8_t * dst) = 0;
+
+        uint8_t * Buffer(uint8_t * buffer)
+        {
+            if (buffer)
+                return buffer;
+            else if (Context * context = Base::GetContext())
+                return (uint8_t*)context->Scratch(BufferSize());
+            else
+            {
+                _buffer.Resize(BufferSize());
+                return _buffer.data;
+            }
+        }
+
+    protected:
+        ConvParam _param;
+        bool _dst8u;
+        Array8u _buffer;
+    };
+
+    namespace Base
+    {
+        void Convolution8iQuantizeWeight(const float * weight, size_t K, size_t N, int8_t * quantized, float * scale);
+
+        class Convolution8iNhwcGemm : public Convolution8i
+        {
+        public:
+            Convolution8iNhwcGemm(const ConvParam & p, bool dst8u, Gemm32iPtr gemm32i, Gemm8uPtr gemm8u);
+            virtual size_t BufferSize() const;
+            virtual void SetWeight(const float * weight, const float * bias, float srcScale, uint8_t srcZero, float dstScale, uint8_t dstZero);
+            virtual void Forward(const uint8_t * src, uint8_t * buf, uint8_t * dst);
+
+        protected:
+            static void ImgToRow(const uint8_t * src, const ConvParam & p, size_t batch, uint8_t zero, uint8_t * dst);
+
+            bool _is1x1;
+            uint8_t _srcZero, _dstZero;
+            size_t _batch, _M, _N, _K;
+            Array8i _weight;
+            Array32i _bias;
+            Array32f _scale;
+            Gemm32iPtr _gemm32i;
+            Gemm8uPtr _gemm8u;
+        };
+
+        void * Convolution8iInit(size_t batch, size_t srcC, size_t srcH, size_t srcW, size_t dstC, size_t kernelY, size_t kernelX, size_t dilationY, size_t dilationX, size_t strideY, size_t strideX, size_t padY, size_t padX, size_t padH, size_t padW, size_t group, SimdConvolutionActivationType activation, SimdBool dst8u);
+    }
+
+#ifdef SIMD_AVX2_ENABLE
+    namespace Avx2
+    {
+        void * Convolution8iInit(size_t batch, size_t srcC, size_t srcH, size_t srcW, size_t dstC, size_t kernelY, size_t kernelX, size_t dilationY, size_t dilationX, size_t strideY, size_t strideX, size_t padY, size_t padX, size_t padH, size_t padW, size_t group, SimdConvolutionActivationType activation, SimdBool dst8u);
+    }
+#endif//SIMD_AVX2_ENABLE
+
+#ifdef SIMD_AVX512BW_ENABLE
+    namespace Avx512bw
+    {
+        void * Convolution8iInit(size_t batch, size_t srcC, size_t srcH, size_t srcW, size_t dstC, size_t kernelY, size_t kernelX, size_t dilationY, size_t dilationX, size_t strideY, size_t strideX, size_t padY, size_t padX, size_t padH, size_t padW, size_t group, SimdConvolutionActivationType activation, SimdBool dst8u);
+    }
+#endif//SIMD_AVX512BW_ENABLE
+
+#ifdef SIMD_AVX512VNNI_ENABLE
+    namespace Avx512vnni
+    {
+        void * Convolution8iInit(size_t batch, size_t srcC, size_t srcH, size_t srcW, size_t dstC, size_t kernelY, size_t kernelX, size_t dilationY, size_t dilationX, size_t strideY, size_t strideX, size_t padY, size_t padX, size_t padH, size_t padW, size_t group, SimdConvolutionActivationType activation, SimdBool dst8u);
+    }
+#endif//SIMD_AVX512VNNI_ENABLE
+}
+
+#endif//__SimConvolution8i_h__
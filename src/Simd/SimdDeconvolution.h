@@ -0,0 +1,299 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2018 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#ifndef __SimdDeconvolution_h__
+#define __SimdDeconvolution_h__
+
+#include "Simd/SimdArray.h"
+#include "Simd/SimdContext.h"
+#include "Simd/SimdGemm.h"
+
+#ifdef _N
+#define _N_OLD _N
+#undef _N
+#endif
+
+namespace Simd
+{
+    struct DeconvParam
+    {
+        size_t batch, srcC, srcH, srcW, dstC, dstH, dstW, kernelY, kernelX, dilationY, dilationX, strideY, strideX, padY, padX, padH, padW, group;
+        bool trans;
+        SimdConvolutionActivationType activation;
+        const float * activationParams;
+
+        DeconvParam(SimdBool trans, size_t batch, size_t srcC, size_t srcH, size_t srcW, size_t dstC, size_t kernelY, size_t kernelX, size_t dilationY, size_t dilationX,
+            size_t strideY, size_t strideX, size_t padY, size_t padX, size_t padH, size_t padW, size_t group, SimdConvolutionActivationType activation, const float * activationParams)
+        {
+            this->trans = trans == SimdTrue;
+            this->batch = batch;
+            this->srcC = srcC;
+            this->srcH = srcH;
+            this->srcW = srcW;
+            this->dstC = dstC;
+            this->dstH = strideY * (srcH - 1) + dilationY * (kernelY - 1) + 1 - padY - padH;
+            this->dstW = strideX * (srcW - 1) + dilationX * (kernelX - 1) + 1 - padX - padW;
+            this->kernelY = kernelY;
+            this->kernelX = kernelX;
+            this->dilationY = dilationY;
+            this->dilationX = dilationX;
+            this->strideY = strideY;
+            this->strideX = strideX;
+            this->padY = padY;
+            this->padX = padX;
+            this->padH = padH;
+            this->padW = padW;
+            this->group = group;
+            this->activation = activation;
+            this->activationParams = activationParams;
+        }
+
+        SIMD_INLINE size_t ActivationParamsSize() const
+        {
+            switch (activation)
+            {
+            case SimdConvolutionActivationLeakyRelu: return 1;
+            case SimdConvolutionActivationPrelu: return dstC;
+            default: return 0;
+            }
+        }
+
+        SIMD_INLINE bool IsKernel(size_t value) const
+        {
+            return kernelY == value && kernelX == value;
+        }
+
+        SIMD_INLINE bool IsDilation(size_t value) const
+        {
+            return dilationY == value && dilationX == value;
+        }
+
+        SIMD_INLINE bool IsStride(size_t value) const
+        {
+            return strideY == value && strideX == value;
+        }
+
+        SIMD_INLINE bool IsPad(size_t value) const
+        {
+            return padY == value && padX == value && padH == value && padW == value;
+        }
+
+        SIMD_INLINE size_t SrcSize() const
+        {
+            return srcC * srcH * srcW;
+        }
+
+        SIMD_INLINE size_t DstSize() const
+        {
+            return dstC * dstH * dstW;
+        }
+    };
+
+    class Deconvolution : public Deletable
+    {
+    public:
+        Deconvolution(const DeconvParam & p)
+            : _param(p)
+            , _gemm(NULL)
+            , _bias(NULL)
+            , _0(0.0f)
+            , _1(1.0f)
+            , _applyEpilogue(Base::GemmApplyEpilogue)
+        {
+            _activationParams.Resize(p.ActivationParamsSize());
+            if (_activationParams.size)
+                memcpy(_activationParams.data, p.activationParams, _activationParams.size * sizeof(float));
+            _param.activationParams = _activationParams.data;
+        }
+
+        virtual ~Deconvolution()
+        {
+            delete _gemm;
+        }
+
+        virtual size_t BufferSize() const = 0;
+        virtual void SetWeight(const float * weight, const float * bias) = 0;
+        virtual void Forward(const float * src, float * buf, float * dst) = 0;
+
+        float * Buffer(float * buffer)
+        {
+            if (buffer)
+                return buffer;
+            else if (Context * context = Base::GetContext())
+                return (float*)context->Scratch(BufferSize() * sizeof(float));
+            else
+            {
+                _buffer.Resize(BufferSize());
+                return _buffer.data;
+            }
+        }
+
+    protected:
+        GemmEpilogue Epilogue(const float * bias) const
+        {
+            return GemmEpilogue(bias, _param.activation, _activationParams.data, _param.trans);
+        }
+
+        void SetGemm(void * gemm)
+        {
+            delete _gemm;
+            _gemm = (Gemm<float>*)gemm;
+        }
+
+        void ApplyEpilogue(float * dst) const
+        {
+            const DeconvParam & p = _param;
+            GemmEpilogue epilogue = Epilogue(_bias);
+            if (epilogue.Empty())
+                return;
+            if (p.trans)
+                _applyEpilogue(epilogue, 0, 0, p.dstH * p.dstW, p.dstC, dst, p.dstC);
+            else
+                _applyEpilogue(epilogue, 0, 0, p.dstC, p.dstH * p.dstW, dst, p.dstH * p.dstW);
+        }
+
+        DeconvParam _param;
+        Gemm<float> * _gemm;
+        Array32f _buffer, _activationParams, _weight;
+        const float * _bias;
+        float _0, _1;
+        GemmEpilogue::Func _applyEpilogue;
+    };
+
+    namespace Base
+    {
+        class DeconvolutionGemm : public Deconvolution
+        {
+        public:
+            DeconvolutionGemm(const DeconvParam & p);
+            virtual size_t BufferSize() const;
+            virtual void SetWeight(const float * weight, const float * bias);
+            virtual void Forward(const float * src, float * buf, float * dst);
+
+        protected:
+            static void ColToImg(const float * src, const DeconvParam & p, float * dst);
+            static void RowToImg(const float * src, const DeconvParam & p, float * dst);
+
+            size_t _M, _N, _K;
+        };
+
+        class DeconvolutionStride2 : public Deconvolution
+        {
+        public:
+            DeconvolutionStride2(const DeconvParam & p);
+            virtual size_t BufferSize() const;
+            virtual void SetWeight(const float * weight, const float * bias);
+            virtual void Forward(const float * src, float * buf, float * dst);
+
+            static bool Preferable(const DeconvParam & p);
+
+        protected:
+            size_t _M, _N, _K;
+        };
+
+        void * DeconvolutionInit(SimdBool trans, size_t batch, size_t srcC, size_t srcH, size_t srcW, size_t dstC, size_t kernelY, size_t kernelX, size_t dilationY, size_t dilationX, size_t strideY, size_t strideX, size_t padY, size_t padX, size_t padH, size_t padW, size_t group, SimdConvolutionActivationType activation, const float * activationParams);
+    }
+
+#ifdef SIMD_SSE_ENABLE    
+    namespace Sse
+    {
+        class DeconvolutionGemm : public Base::DeconvolutionGemm
+        {
+        public:
+            DeconvolutionGemm(const DeconvParam & p);
+        };
+
+        class DeconvolutionStride2 : public Base::DeconvolutionStride2
+        {
+        public:
+            DeconvolutionStride2(const DeconvParam & p);
+        };
+
+        void * DeconvolutionInit(SimdBool trans, size_t batch, size_t srcC, size_t srcH, size_t srcW, size_t dstC, size_t kernelY, size_t kernelX, size_t dilationY, size_t dilationX, size_t strideY, size_t strideX, size_t padY, size_t padX, size_t padH, size_t padW, size_t group, SimdConvolutionActivationType activation, const float * activationParams);
+    }
+#endif//SIMD_SSE_ENABLE
+
+#ifdef SIMD_AVX_ENABLE    
+    namespace Avx
+    {
+        class DeconvolutionGemm : public Base::DeconvolutionGemm
+        {
+        public:
+            DeconvolutionGemm(const DeconvParam & p);
+        };
+
+        class DeconvolutionStride2 : public Base::DeconvolutionStride2
+        {
+        public:
+            DeconvolutionStride2(const DeconvParam & p);
+        };
+
+        void * DeconvolutionInit(SimdBool trans, size_t batch, size_t srcC, size_t srcH, size_t srcW, size_t dstC, size_t kernelY, size_t kernelX, size_t dilationY, size_t dilationX, size_t strideY, size_t strideX, size_t padY, size_t padX, size_t padH, size_t padW, size_t group, SimdConvolutionActivationType activation, const float * activationParams);
+    }
+#endif//SIMD_AVX_ENABLE
+
+#ifdef SIMD_AVX2_ENABLE    
+    namespace Avx2
+    {
+        class DeconvolutionGemm : public Base::DeconvolutionGemm
+        {
+        public:
+            DeconvolutionGemm(const DeconvParam & p);
+        };
+
+        class DeconvolutionStride2 : public Base::DeconvolutionStride2
+        {
+        public:
+            DeconvolutionStride2(const DeconvParam & p);
+        };
+
+        void * DeconvolutionInit(SimdBool trans, size_t batch, size_t srcC, size_t srcH, size_t srcW, size_t dstC, size_t kernelY, size_t kernelX, size_t dilationY, size_t dilationX, size_t strideY, size_t strideX, size_t padY, size_t padX, size_t padH, size_t padW, size_t group, SimdConvolutionActivationType activation, const float * activationParams);
+    }
+#endif//SIMD_AVX2_ENABLE
+
+#ifdef SIMD_AVX512F_ENABLE    
+    namespace Avx512f
+    {
+        class DeconvolutionGemm : public Base::DeconvolutionGemm
+        {
+        public:
+            DeconvolutionGemm(const DeconvParam & p);
+        };
+
+        class DeconvolutionStride2 : public Base::DeconvolutionStride2
+        {
+        public:
+            DeconvolutionStride2(const DeconvParam & p);
+        };
+
+        void * DeconvolutionInit(SimdBool trans, size_t batch, size_t srcC, size_t srcH, size_t srcW, size_t dstC, size_t kernelY, size_t kernelX, size_t dilationY, size_t dilationX, size_t strideY, size_t strideX, size_t padY, size_t padX, size_t padH, size_t padW, size_t group, SimdConvolutionActivationType activation, const float * activationParams);
+    }
+#endif//SIMD_AVX512F_ENABLE
+}
+
+#ifdef _N_OLD
+#define _N _N_OLD
+#undef _N_OLD
+#endif
+
+#endif//__SimdDeconvolution_h__
@@ -99,6 +99,10 @@
 #define SIMD_AVX512BW_ENABLE
 #endif
 
+#if !defined(SIMD_AVX512VNNI_DISABLE) && _MSC_VER >= 1920
+#define SIMD_AVX512VNNI_ENABLE
+#endif
+
 #endif//defined(SIMD_X64_ENABLE) || defined(SIMD_X86_ENABLE)
 
 #if defined(SIMD_ARM_ENABLE)
@@ -191,6 +195,10 @@
 #if !defined(SIMD_AVX512BW_DISABLE) && defined(__AVX512BW__)
 #define SIMD_AVX512BW_ENABLE
 #endif
+
+#if !defined(SIMD_AVX512VNNI_DISABLE) && defined(__AVX512VNNI__)
+#define SIMD_AVX512VNNI_ENABLE
+#endif
 #endif
 
 #endif//defined(SIMD_X86_ENABLE) || defined(SIMD_X64_ENABLE)
@@ -243,7 +243,8 @@ namespace Simd
             \param [in] sizeMax - a maximal size of detected objects.
             \param [in] roi - a 8-bit image mask which defines Region Of Interest. User can restricts detection region with using this mask.
                               The mask affects to the center of detected object.
-            \param [in] threadNumber - a number of work threads. It useful for multi core CPU. Use value -1 to auto choose of thread number.
+            \param [in] threadNumber - a number of work threads. It useful for multi core CPU. Use value -1 to auto choose of thread number
+                                       (the thread number of the execution context attached to calling thread (see ::SimdSetContext) or the number of CPU cores).
             \return a result of this operation.
         */
         bool Init(const Size & imageSize, double scaleFactor = 1.1, const Size & sizeMin = Size(0, 0),
@@ -253,6 +254,9 @@ namespace Simd
                 return false;
             _imageSize = imageSize;
             ptrdiff_t threadNumberMax = std::thread::hardware_concurrency();
+            void * context = ::SimdGetContext();
+            if (threadNumber <= 0 && context)
+                threadNumber = ::SimdContextGetThreadNumber(context);
             _threadNumber = (threadNumber <= 0 || threadNumber > threadNumberMax) ? threadNumberMax : threadNumber;
             return InitLevels(scaleFactor, sizeMin, sizeMax, roi);
         }
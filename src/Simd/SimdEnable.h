@@ -98,6 +98,7 @@ namespace Simd
 
             // Ecx:
             AVX512VBMI = 1 << 1,
+            AVX512VNNI = 1 << 11,
         };
 
         SIMD_INLINE bool CheckBit(Level level, Register index, Bit bit)
@@ -462,6 +463,38 @@ namespace Simd
     }
 #endif
 
+#ifdef SIMD_AVX512VNNI_ENABLE
+    namespace Avx512vnni
+    {
+        SIMD_INLINE bool SupportedByCPU()
+        {
+            return
+                Cpuid::CheckBit(Cpuid::Extended, Cpuid::Ebx, Cpuid::AVX512F) &&
+                Cpuid::CheckBit(Cpuid::Extended, Cpuid::Ebx, Cpuid::AVX512BW) &&
+                Cpuid::CheckBit(Cpuid::Extended, Cpuid::Ecx, Cpuid::AVX512VNNI);
+        }
+
+        SIMD_INLINE bool SupportedByOS()
+        {
+#if defined(_MSC_VER)
+            __try
+            {
+                __m512i value = _mm512_dpbusd_epi32(_mm512_setzero_si512(), _mm512_set1_epi8(1), _mm512_set1_epi8(1));// try to execute of AVX-512-VNNI instructions;
+                return true;
+            }
+            __except (EXCEPTION_EXECUTE_HANDLER)
+            {
+                return false;
+            }
+#else
+            return true;
+#endif
+        }
+
+        const bool Enable = SupportedByCPU() && SupportedByOS();
+    }
+#endif
+
 #ifdef SIMD_VMX_ENABLE
     namespace Vmx
     {
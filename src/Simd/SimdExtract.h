@@ -122,6 +122,14 @@ namespace Simd
             return _a[0] + _a[4];
         }
 
+        SIMD_INLINE float ExtractMax(__m256 a)
+        {
+            __m128 m = _mm_max_ps(_mm256_castps256_ps128(a), _mm256_extractf128_ps(a, 1));
+            m = _mm_max_ps(m, _mm_movehl_ps(m, m));
+            m = _mm_max_ss(m, _mm_shuffle_ps(m, m, 1));
+            return _mm_cvtss_f32(m);
+        }
+
         SIMD_INLINE __m128 Extract4Sums(const __m256 a[4])
         {
             __m256 b = _mm256_hadd_ps(_mm256_hadd_ps(a[0], a[1]), _mm256_hadd_ps(a[2], a[3]));
@@ -26,6 +26,7 @@
 
 #include "Simd/SimdArray.h"
 #include "Simd/SimdBase.h"
+#include "Simd/SimdMath.h"
 #include "Simd/SimdParallel.hpp"
 
 #ifdef _N
@@ -35,17 +36,200 @@
 
 namespace Simd
 {
-    template <class T, class TM> class GemmNN
+    struct GemmEpilogue
+    {
+        typedef void(*Func)(const GemmEpilogue & epilogue, size_t row, size_t col, size_t M, size_t N, float * C, size_t ldc);
+
+        const float * bias;
+        const float * params;
+        SimdConvolutionActivationType activation;
+        bool perColumn;
+
+        GemmEpilogue(const float * bias = NULL, SimdConvolutionActivationType activation = SimdConvolutionActivationIdentity, const float * params = NULL, bool perColumn = false)
+        {
+            this->bias = bias;
+            this->params = params;
+            this->activation = activation;
+            this->perColumn = perColumn;
+        }
+
+        SIMD_INLINE bool Empty() const
+        {
+            return bias == NULL && activation == SimdConvolutionActivationIdentity;
+        }
+
+        SIMD_INLINE GemmEpilogue Batch(size_t index, size_t M, size_t N) const
+        {
+            size_t shift = index * (perColumn ? N : M);
+            return GemmEpilogue(bias ? bias + shift : NULL, activation, activation == SimdConvolutionActivationPrelu ? params + shift : params, perColumn);
+        }
+    };
+
+    namespace Base
+    {
+        template<SimdConvolutionActivationType type> SIMD_INLINE float GemmActivate(float value, float slope)
+        {
+            return value;
+        }
+
+        template<> SIMD_INLINE float GemmActivate<SimdConvolutionActivationRelu>(float value, float slope)
+        {
+            return Simd::Max(0.0f, value);
+        }
+
+        template<> SIMD_INLINE float GemmActivate<SimdConvolutionActivationLeakyRelu>(float value, float slope)
+        {
+            return Simd::Max(0.0f, value) + slope * Simd::Min(0.0f, value);
+        }
+
+        template<> SIMD_INLINE float GemmActivate<SimdConvolutionActivationPrelu>(float value, float slope)
+        {
+            return Simd::Max(0.0f, value) + slope * Simd::Min(0.0f, value);
+        }
+
+        template<> SIMD_INLINE float GemmActivate<SimdConvolutionActivationSigmoid>(float value, float slope)
+        {
+            return Base::Sigmoid(value);
+        }
+
+        void GemmApplyEpilogue(const GemmEpilogue & epilogue, size_t row, size_t col, size_t M, size_t N, float * C, size_t ldc);
+
+        void GemmConvertA16(const float * src, size_t size, SimdGemmFormatType format, uint16_t * dst);
+
+        void GemmPackA16(const uint16_t * A, size_t lda, size_t M, size_t K, SimdGemmFormatType format, bool trans, float * pA);
+    }
+
+    template <class T> class Gemm : public Deletable
+    {
+    public:
+        virtual void Run(const T * alpha, const T * A, size_t lda, const T * B, size_t ldb, const T * beta, T * C, size_t ldc, const GemmEpilogue * epilogue = NULL) = 0;
+
+        virtual size_t PackedBSize() const = 0;
+
+        virtual void PackMatrixB(const T * B, size_t ldb, T * pB) const = 0;
+
+        virtual void RunPackedB(const T * alpha, const T * A, size_t lda, const T * pB, const T * beta, T * C, size_t ldc, const GemmEpilogue * epilogue = NULL) = 0;
+
+        virtual void RunBatched(size_t batch, const T * alpha, const T * A, size_t lda, size_t strideA, const T * B, size_t ldb, size_t strideB,
+            const T * beta, T * C, size_t ldc, size_t strideC, const GemmEpilogue * epilogue = NULL) = 0;
+
+        virtual void RunBatched16(SimdGemmFormatType format, size_t batch, const T * alpha, const uint16_t * A, size_t lda, size_t strideA, 
+            const T * B, size_t ldb, size_t strideB, const T * beta, T * C, size_t ldc, size_t strideC, const GemmEpilogue * epilogue = NULL) = 0;
+    };
+
+    template <class T> SIMD_INLINE void GemmCopyB(const T * B, size_t ldb, size_t rows, size_t cols, T * pB)
+    {
+        for (size_t row = 0; row < rows; ++row, B += ldb, pB += cols)
+            memcpy(pB, B, cols * sizeof(T));
+    }
+
+    template <class T> SIMD_INLINE void GemmUnpackA16(SimdGemmFormatType format, size_t batch, const uint16_t * A, size_t lda, size_t strideA, 
+        size_t rows, size_t cols, Array<T> & buffer)
+    {
+        buffer.Resize(batch * rows * cols);
+        for (size_t b = 0; b < batch; ++b)
+            Base::GemmPackA16(A + b * strideA, lda, rows, cols, format, false, buffer.data + b * rows * cols);
+    }
+
+    SIMD_INLINE size_t ConvolutionThreads(size_t size)
+    {
+        return size < 64 * 1024 ? 1 : Base::GetThreadNumber();
+    }
+
+    SIMD_INLINE size_t GemmBatchThreads(size_t batch, size_t M, size_t N, size_t K)
+    {
+        return batch * M * N * K < 256 * 256 * 256 * 2 ? 1 : Base::GetThreadNumber();
+    }
+
+    SIMD_INLINE void GemmBatchTiles(size_t batch, size_t N, size_t microN, size_t threadNumber, size_t & tiles, size_t & tileN)
+    {
+        tiles = Simd::Min((threadNumber + batch - 1) / batch, (N + microN - 1) / microN);
+        tileN = AlignHiAny((N + tiles - 1) / tiles, microN);
+        tiles = (N + tileN - 1) / tileN;
+    }
+
+    template <class T> class GemmFunc : public Gemm<T>
+    {
+    public:
+        typedef void(*Func)(size_t M, size_t N, size_t K, const T * alpha, const T * A, size_t lda, const T * B, size_t ldb, const T * beta, T * C, size_t ldc);
+
+        GemmFunc(size_t M, size_t N, size_t K, bool transB, Func func, bool transA = false)
+            : _M(M)
+            , _N(N)
+            , _K(K)
+            , _transA(transA)
+            , _transB(transB)
+            , _func(func)
+        {
+        }
+
+        virtual void Run(const T * alpha, const T * A, size_t lda, const T * B, size_t ldb, const T * beta, T * C, size_t ldc, const GemmEpilogue * epilogue = NULL)
+        {
+            _func(_M, _N, _K, alpha, A, lda, B, ldb, beta, C, ldc);
+            if (epilogue && !epilogue->Empty())
+                Base::GemmApplyEpilogue(*epilogue, 0, 0, _M, _N, C, ldc);
+        }
+
+        virtual size_t PackedBSize() const
+        {
+            return _N * _K;
+        }
+
+        virtual void PackMatrixB(const T * B, size_t ldb, T * pB) const
+        {
+            if (_transB)
+                GemmCopyB(B, ldb, _N, _K, pB);
+            else
+                GemmCopyB(B, ldb, _K, _N, pB);
+        }
+
+        virtual void RunPackedB(const T * alpha, const T * A, size_t lda, const T * pB, const T * beta, T * C, size_t ldc, const GemmEpilogue * epilogue = NULL)
+        {
+            Run(alpha, A, lda, pB, _transB ? _K : _N, beta, C, ldc, epilogue);
+        }
+
+        virtual void RunBatched(size_t batch, const T * alpha, const T * A, size_t lda, size_t strideA, const T * B, size_t ldb, size_t strideB,
+            const T * beta, T * C, size_t ldc, size_t strideC, const GemmEpilogue * epilogue = NULL)
+        {
+            Simd::Parallel(0, batch, [&](size_t thread, size_t begin, size_t end)
+            {
+                for (size_t b = begin; b < end; ++b)
+                {
+                    GemmEpilogue item = epilogue ? epilogue->Batch(b, _M, _N) : GemmEpilogue();
+                    Run(alpha, A + b * strideA, lda, B + b * strideB, ldb, beta, C + b * strideC, ldc, epilogue ? &item : NULL);
+                }
+            }, Base::GetThreadNumber());
+        }
+
+        virtual void RunBatched16(SimdGemmFormatType format, size_t batch, const T * alpha, const uint16_t * A, size_t lda, size_t strideA,
+            const T * B, size_t ldb, size_t strideB, const T * beta, T * C, size_t ldc, size_t strideC, const GemmEpilogue * epilogue = NULL)
+        {
+            size_t rows = _transA ? _K : _M, cols = _transA ? _M : _K;
+            GemmUnpackA16(format, batch, A, lda, strideA, rows, cols, _A);
+            RunBatched(batch, alpha, _A.data, cols, rows * cols, B, ldb, strideB, beta, C, ldc, strideC, epilogue);
+        }
+
+    private:
+        size_t _M, _N, _K;
+        bool _transA, _transB;
+        Func _func;
+        Array<T> _A;
+    };
+
+    template <class T, class TM> class GemmNN : public Gemm<T>
     {
     public:
         typedef void(*Main)(size_t K, T alpha, const T * A, size_t lda, const T * B, size_t ldb, T * C, size_t ldc, TM tail);
         typedef void(*Tail)(size_t M, size_t N, size_t K, T alpha, const T * A, size_t lda, const T * B, size_t ldb, T * C, size_t ldc, TM tail);
         typedef void(*ScaleC)(size_t M, size_t N, T beta, T * C, size_t ldc);
         typedef void(*PackB)(const T * B, size_t ldb, size_t K, size_t N, size_t microN, T * pB);
+        typedef void(*PackA)(const T * A, size_t lda, size_t M, size_t K, T * pA);
+        typedef void(*PackA16)(const uint16_t * A, size_t lda, size_t M, size_t K, SimdGemmFormatType format, bool trans, T * pA);
         typedef TM(*TailMask)(ptrdiff_t tail);
 
         GemmNN(size_t M, size_t N, size_t K, size_t microM, size_t microN, size_t L1, size_t L2, size_t L3, size_t F,
-            Main kernelMM, Main kernelMT, Tail kernelTM, Tail kernelTT, ScaleC scaleC, PackB packB, TailMask tailMask)
+            Main kernelMM, Main kernelMT, Tail kernelTM, Tail kernelTT, ScaleC scaleC, PackB packB, TailMask tailMask, GemmEpilogue::Func epilogue, 
+            PackA packAT = NULL, PackB packBT = NULL, PackA16 packA16 = NULL)
             : _M(M)
             , _N(N)
             , _K(K)
@@ -59,6 +243,11 @@ namespace Simd
             , _kernelTT(kernelTT)
             , _scaleC(scaleC)
             , _packB(packB)
+            , _epilogue(epilogue)
+            , _packAT(packAT)
+            , _packBT(packBT)
+            , _packA16(packA16)
+            , _formatA(SimdGemmFormat32f)
         {
 
             _macroK = L1 / sizeof(T) / _microN;
@@ -86,17 +275,89 @@ namespace Simd
             }
         }
 
-        void Run(const T * alpha, const T * A, size_t lda, const T * B, size_t ldb, const T * beta, T * C, size_t ldc)
+        virtual void Run(const T * alpha, const T * A, size_t lda, const T * B, size_t ldb, const T * beta, T * C, size_t ldc, const GemmEpilogue * epilogue = NULL)
         {
+            if (epilogue && epilogue->Empty())
+                epilogue = NULL;
             Simd::Parallel(0, _N, [&](size_t thread, size_t begin, size_t end)
             {
-                ThreadKernel(end - begin, *alpha, A, lda, B + begin, ldb, *beta, C + begin, ldc, thread);
+                ThreadKernel(end - begin, *alpha, A, lda, B + OffsetB(0, begin, ldb), ldb, *beta, C + begin, ldc, false, epilogue, begin, thread);
             }, _threadNumber, _microN);
         }
 
+        virtual size_t PackedBSize() const
+        {
+            return AlignHiAny(_N, _microN) * _K;
+        }
+
+        virtual void PackMatrixB(const T * B, size_t ldb, T * pB) const
+        {
+            if (_packBT)
+                _packBT(B, ldb, _K, _N, _microN, pB);
+            else
+                _packB(B, ldb, _K, _N, _microN, pB);
+        }
+
+        virtual void RunPackedB(const T * alpha, const T * A, size_t lda, const T * pB, const T * beta, T * C, size_t ldc, const GemmEpilogue * epilogue = NULL)
+        {
+            if (epilogue && epilogue->Empty())
+                epilogue = NULL;
+            Simd::Parallel(0, _N, [&](size_t thread, size_t begin, size_t end)
+            {
+                ThreadKernel(end - begin, *alpha, A, lda, pB + begin * _K, _microN, *beta, C + begin, ldc, true, epilogue, begin, thread);
+            }, _threadNumber, _microN);
+        }
+
+        virtual void RunBatched(size_t batch, const T * alpha, const T * A, size_t lda, size_t strideA, const T * B, size_t ldb, size_t strideB,
+            const T * beta, T * C, size_t ldc, size_t strideC, const GemmEpilogue * epilogue = NULL)
+        {
+            RunBatched<T>(batch, alpha, A, lda, strideA, B, ldb, strideB, beta, C, ldc, strideC, epilogue);
+        }
+
+        virtual void RunBatched16(SimdGemmFormatType format, size_t batch, const T * alpha, const uint16_t * A, size_t lda, size_t strideA,
+            const T * B, size_t ldb, size_t strideB, const T * beta, T * C, size_t ldc, size_t strideC, const GemmEpilogue * epilogue = NULL)
+        {
+            _formatA = format;
+            RunBatched<uint16_t>(batch, alpha, A, lda, strideA, B, ldb, strideB, beta, C, ldc, strideC, epilogue);
+        }
+
     private:
 
-        void ThreadKernel(size_t N, T alpha, const T * A, size_t lda, const T * B, size_t ldb, T beta, T * C, size_t ldc, size_t thread)
+        template<class TA> void RunBatched(size_t batch, const T * alpha, const TA * A, size_t lda, size_t strideA, const T * B, size_t ldb, size_t strideB,
+            const T * beta, T * C, size_t ldc, size_t strideC, const GemmEpilogue * epilogue)
+        {
+            if (epilogue && epilogue->Empty())
+                epilogue = NULL;
+            size_t threadNumber = GemmBatchThreads(batch, _M, _N, _K), tiles, tileN;
+            GemmBatchTiles(batch, _N, _microN, threadNumber, tiles, tileN);
+            Reserve(threadNumber);
+            Simd::Parallel(0, batch * tiles, [&](size_t thread, size_t begin, size_t end)
+            {
+                for (size_t item = begin; item < end; ++item)
+                {
+                    size_t b = item / tiles, col = item % tiles * tileN;
+                    GemmEpilogue local = epilogue ? epilogue->Batch(b, _M, _N) : GemmEpilogue();
+                    ThreadKernel(Simd::Min(_N, col + tileN) - col, *alpha, A + b * strideA, lda, B + b * strideB + OffsetB(0, col, ldb), ldb, *beta, 
+                        C + b * strideC + col, ldc, false, epilogue ? &local : NULL, col, thread);
+                }
+            }, threadNumber);
+        }
+
+        void Reserve(size_t threadNumber)
+        {
+            if (_pB.size() >= threadNumber)
+                return;
+            Arrays pA(threadNumber), pB(threadNumber);
+            for (size_t t = 0; t < threadNumber; ++t)
+            {
+                pA[t].Resize(_macroM * _macroK);
+                pB[t].Resize(_macroN * _macroK);
+            }
+            _pA.swap(pA);
+            _pB.swap(pB);
+        }
+
+        template<class TA> void ThreadKernel(size_t N, T alpha, const TA * A, size_t lda, const T * B, size_t ldb, T beta, T * C, size_t ldc, bool packedB, const GemmEpilogue * epilogue, size_t col, size_t thread)
         {
             for (size_t j = 0; j < N; j += _macroN)
             {
@@ -104,44 +365,100 @@ namespace Simd
                 for (size_t k = 0; k < _K; k += _macroK)
                 {
                     size_t macroK = Simd::Min(_K, k + _macroK) - k;
-                    //PackA(A + i * lda, lda, macroM, K, _microM, _A.data);
+                    const T * pB = packedB ? B + j * _K + k * _microN : B + OffsetB(k, j, ldb);
+                    const GemmEpilogue * last = k + macroK == _K ? epilogue : NULL;
                     for (size_t i = 0; i < _M; i += _macroM)
                     {
                         size_t macroM = Simd::Min(_M, i + _macroM) - i;
                         if (k == 0)
                             _scaleC(macroM, macroN, beta, C + i * ldc + j, ldc);
-                        MacroKernel(macroM, macroN, macroK, alpha, A + i * lda + k, lda, B + k * ldb + j, ldb, beta, C + i * ldc + j, ldc, i == 0, thread);
+                        size_t ldp;
+                        const T * pA = MacroA(A, lda, i, k, macroM, macroK, thread, ldp);
+                        MacroKernel(macroM, macroN, macroK, alpha, pA, ldp, pB, ldb, beta, C + i * ldc + j, ldc, i == 0, packedB, last, i, col + j, thread);
                     }
                 }
             }
         }
 
-        void MacroKernel(size_t M, size_t N, size_t K, T alpha, const T * A, size_t lda, const T * B, size_t ldb, T beta, T * C, size_t ldc, bool packB, size_t thread)
+        SIMD_INLINE const T * MacroA(const T * A, size_t lda, size_t i, size_t k, size_t M, size_t K, size_t thread, size_t & ldp)
+        {
+            if (_packAT == NULL)
+            {
+                ldp = lda;
+                return A + i * lda + k;
+            }
+            ldp = K;
+            _packAT(A + k * lda + i, lda, M, K, _pA[thread].data);
+            return _pA[thread].data;
+        }
+
+        SIMD_INLINE const T * MacroA(const uint16_t * A, size_t lda, size_t i, size_t k, size_t M, size_t K, size_t thread, size_t & ldp)
+        {
+            bool trans = _packAT != NULL;
+            ldp = K;
+            _packA16(trans ? A + k * lda + i : A + i * lda + k, lda, M, K, _formatA, trans, _pA[thread].data);
+            return _pA[thread].data;
+        }
+
+        SIMD_INLINE const T * MicroB(const T * B, size_t ldb, size_t K, size_t N, size_t j, bool packB, bool packedB, size_t thread)
+        {
+            if (packedB)
+                return B + j * _K;
+            T * pB = _pB[thread].data + j * _macroK;
+            if (packB)
+            {
+                if (_packBT)
+                    _packBT(B + j * ldb, ldb, K, N, _microN, pB);
+                else
+                    _packB(B + j, ldb, K, N, _microN, pB);
+            }
+            return pB;
+        }
+
+        SIMD_INLINE size_t OffsetB(size_t k, size_t j, size_t ldb) const
+        {
+            return _packBT ? j * ldb + k : k * ldb + j;
+        }
+
+        void MacroKernel(size_t M, size_t N, size_t K, T alpha, const T * A, size_t lda, const T * B, size_t ldb, T beta, T * C, size_t ldc, 
+            bool packB, bool packedB, const GemmEpilogue * epilogue, size_t row, size_t col, size_t thread)
         {
             size_t MA = AlignLoAny(M, _microM);
             size_t NA = AlignLoAny(N, _microN);
             size_t j = 0;
             for (; j < NA; j += _microN)
             {
-                T * pB = _pB[thread].data + j * _macroK;
-                if (packB)
-                    _packB(B + j, ldb, K, _microN, _microN, pB);
+                const T * pB = MicroB(B, ldb, K, _microN, j, packB, packedB, thread);
                 size_t i = 0;
                 for (; i < MA; i += _microM)
+                {
                     _kernelMM(K, alpha, A + i * lda, lda, pB, _microN, C + i * ldc + j, ldc, _main);
+                    if (epilogue)
+                        _epilogue(*epilogue, row + i, col + j, _microM, _microN, C + i * ldc + j, ldc);
+                }
                 if (i < M)
+                {
                     _kernelTM(M - i, _microN, K, alpha, A + i * lda, lda, pB, _microN, C + i * ldc + j, ldc, _main);
+                    if (epilogue)
+                        _epilogue(*epilogue, row + i, col + j, M - i, _microN, C + i * ldc + j, ldc);
+                }
             }
             if (j < N)
             {
-                T * pB = _pB[thread].data + j * _macroK;
-                if (packB)
-                    _packB(B + j, ldb, K, N - j, _microN, pB);
+                const T * pB = MicroB(B, ldb, K, N - j, j, packB, packedB, thread);
                 size_t i = 0;
                 for (; i < MA; i += _microM)
+                {
                     _kernelMT(K, alpha, A + i * lda, lda, pB, _microN, C + i * ldc + j, ldc, _tail);
+                    if (epilogue)
+                        _epilogue(*epilogue, row + i, col + j, _microM, N - j, C + i * ldc + j, ldc);
+                }
                 if (i < M)
+                {
                     _kernelTT(M - i, NA - j, K, alpha, A + i * lda, lda, pB, _microN, C + i * ldc + j, ldc, _tail);
+                    if (epilogue)
+                        _epilogue(*epilogue, row + i, col + j, M - i, N - j, C + i * ldc + j, ldc);
+                }
             }
         }
 
@@ -154,16 +471,21 @@ namespace Simd
         Tail _kernelTM, _kernelTT;
         ScaleC _scaleC;
         PackB _packB;
+        GemmEpilogue::Func _epilogue;
+        PackA _packAT;
+        PackB _packBT;
+        PackA16 _packA16;
+        SimdGemmFormatType _formatA;
     };
 
-    template <class T> class GemmNT
+    template <class T> class GemmNT : public Gemm<T>
     {
     public:
         typedef void(*Kernel)(size_t K, float alpha, const float * A, size_t lda, const float * B, size_t ldb, float * C, size_t ldc);
         typedef void(*ScaleC)(size_t M, size_t N, T beta, T * C, size_t ldc);
 
         GemmNT(size_t M, size_t N, size_t K, size_t L1, size_t L2, size_t L3, size_t F, ScaleC scaleC,
-            Kernel k1x1, Kernel k1x4, Kernel k2x1, Kernel k2x4, Kernel k3x1, Kernel k3x4, Kernel k6x1, Kernel k6x4)
+            Kernel k1x1, Kernel k1x4, Kernel k2x1, Kernel k2x4, Kernel k3x1, Kernel k3x4, Kernel k6x1, Kernel k6x4, GemmEpilogue::Func epilogue)
             : _M(M)
             , _N(N)
             , _K(K)
@@ -178,6 +500,7 @@ namespace Simd
             , _k3x4(k3x4)
             , _k6x1(k6x1)
             , _k6x4(k6x4)
+            , _epilogue(epilogue)
         {
             _microN = 4;
             _microM = _k6x4 ? 6 : 3;
@@ -188,17 +511,60 @@ namespace Simd
                 _threadNumber = 1;
         }
 
-        void Run(const T * alpha, const T * A, size_t lda, const T * B, size_t ldb, const T * beta, T * C, size_t ldc)
+        virtual void Run(const T * alpha, const T * A, size_t lda, const T * B, size_t ldb, const T * beta, T * C, size_t ldc, const GemmEpilogue * epilogue = NULL)
         {
+            if (epilogue && epilogue->Empty())
+                epilogue = NULL;
             Simd::Parallel(0, _N, [&](size_t thread, size_t begin, size_t end)
             {
-                ThreadKernel(end - begin, *alpha, A, lda, B + begin*ldb, ldb, *beta, C + begin, ldc, thread);
+                ThreadKernel(end - begin, *alpha, A, lda, B + begin*ldb, ldb, *beta, C + begin, ldc, epilogue, begin, thread);
             }, _threadNumber, _microN);
         }
 
+        virtual size_t PackedBSize() const
+        {
+            return _N * _K;
+        }
+
+        virtual void PackMatrixB(const T * B, size_t ldb, T * pB) const
+        {
+            GemmCopyB(B, ldb, _N, _K, pB);
+        }
+
+        virtual void RunPackedB(const T * alpha, const T * A, size_t lda, const T * pB, const T * beta, T * C, size_t ldc, const GemmEpilogue * epilogue = NULL)
+        {
+            Run(alpha, A, lda, pB, _K, beta, C, ldc, epilogue);
+        }
+
+        virtual void RunBatched(size_t batch, const T * alpha, const T * A, size_t lda, size_t strideA, const T * B, size_t ldb, size_t strideB,
+            const T * beta, T * C, size_t ldc, size_t strideC, const GemmEpilogue * epilogue = NULL)
+        {
+            if (epilogue && epilogue->Empty())
+                epilogue = NULL;
+            size_t threadNumber = GemmBatchThreads(batch, _M, _N, _K), tiles, tileN;
+            GemmBatchTiles(batch, _N, _microN, threadNumber, tiles, tileN);
+            Simd::Parallel(0, batch * tiles, [&](size_t thread, size_t begin, size_t end)
+            {
+                for (size_t item = begin; item < end; ++item)
+                {
+                    size_t b = item / tiles, col = item % tiles * tileN;
+                    GemmEpilogue local = epilogue ? epilogue->Batch(b, _M, _N) : GemmEpilogue();
+                    ThreadKernel(Simd::Min(_N, col + tileN) - col, *alpha, A + b * strideA, lda, B + b * strideB + col * ldb, ldb, *beta, 
+                        C + b * strideC + col, ldc, epilogue ? &local : NULL, col, thread);
+                }
+            }, threadNumber);
+        }
+
+        virtual void RunBatched16(SimdGemmFormatType format, size_t batch, const T * alpha, const uint16_t * A, size_t lda, size_t strideA,
+            const T * B, size_t ldb, size_t strideB, const T * beta, T * C, size_t ldc, size_t strideC, const GemmEpilogue * epilogue = NULL)
+        {
+            GemmUnpackA16(format, batch, A, lda, strideA, _M, _K, _A);
+            RunBatched(batch, alpha, _A.data, _K, _M * _K, B, ldb, strideB, beta, C, ldc, strideC, epilogue);
+        }
+
     private:
 
-        void ThreadKernel(size_t N, T alpha, const T * A, size_t lda, const T * B, size_t ldb, T beta, T * C, size_t ldc, size_t thread)
+        void ThreadKernel(size_t N, T alpha, const T * A, size_t lda, const T * B, size_t ldb, T beta, T * C, size_t ldc, const GemmEpilogue * epilogue, size_t col, size_t thread)
         {
             for (size_t j = 0; j < N; j += _macroN)
             {
@@ -212,6 +578,8 @@ namespace Simd
                         if (k == 0)
                             _scaleC(macroM, macroN, beta, C + i * ldc + j, ldc);
                         MacroKernel(macroM, macroN, macroK, alpha, A + i * lda + k, lda, B + j * ldb + k, ldb, beta, C + i * ldc + j, ldc);
+                        if (epilogue && k + macroK == _K)
+                            _epilogue(*epilogue, i, col + j, macroM, macroN, C + i * ldc + j, ldc);
                     }
                 }
             }
@@ -272,25 +640,225 @@ namespace Simd
         }
 
         size_t _M, _N, _K, _microM, _microN, _macroM, _macroN, _macroK, _F, _threadNumber;
+        Array<T> _A;
         ScaleC _scaleC;
         Kernel _k1x1, _k1x4, _k2x1, _k2x4, _k3x1, _k3x4, _k6x1, _k6x4;
+        GemmEpilogue::Func _epilogue;
+    };
+
+    struct GemmRequant
+    {
+        const int32_t * bias;
+        const float * scale;
+        int32_t zero;
+
+        GemmRequant(const int32_t * bias = NULL, const float * scale = NULL, int32_t zero = 0)
+        {
+            this->bias = bias;
+            this->scale = scale;
+            this->zero = zero;
+        }
     };
 
+    namespace Base
+    {
+        SIMD_INLINE uint8_t GemmRequantize(int32_t sum, const GemmRequant & requant, size_t col)
+        {
+            float value = float(requant.bias ? sum + requant.bias[col] : sum) * requant.scale[col];
+            return (uint8_t)RestrictRange(int(std::nearbyint(value)) + requant.zero, 0, 255);
+        }
+
+        void Gemm8iPackA(const uint8_t * A, size_t lda, size_t M, size_t K, size_t group, int32_t * pA);
+
+        void Gemm8iPackB(const int8_t * B, size_t ldb, size_t K, size_t N, size_t microN, size_t group, int8_t * pB);
+    }
+
+    template <class TC> class Gemm8u8iNN
+    {
+    public:
+        typedef void(*Kernel)(size_t M, size_t N, size_t KG, const int32_t * pA, const int8_t * pB, const GemmRequant & requant, size_t col, TC * C, size_t ldc);
+        typedef void(*PackA)(const uint8_t * A, size_t lda, size_t M, size_t K, size_t group, int32_t * pA);
+        typedef void(*PackB)(const int8_t * B, size_t ldb, size_t K, size_t N, size_t microN, size_t group, int8_t * pB);
+
+        Gemm8u8iNN(size_t M, size_t N, size_t K, size_t microM, size_t microN, size_t group, size_t L2, Kernel kernel, PackA packA, PackB packB)
+            : _M(M)
+            , _N(N)
+            , _K(K)
+            , _microM(microM)
+            , _microN(microN)
+            , _group(group)
+            , _threadNumber(Base::GetThreadNumber())
+            , _kernel(kernel)
+            , _packA(packA)
+            , _packB(packB)
+        {
+            _KG = AlignHiAny(_K, _group) / _group;
+            _panel = _KG * 4 * _microN;
+            _macroN = Simd::Max(AlignLoAny(L2 / 2 / (_KG * 4), _microN), _microN);
+            if (_N * _M * _K < 256 * 256 * 256 * 2)
+                _threadNumber = 1;
+            _pA.resize(_threadNumber);
+            _pB.resize(_threadNumber);
+            for (size_t t = 0; t < _threadNumber; ++t)
+            {
+                _pA[t].Resize(_KG * _microM);
+                _pB[t].Resize(_macroN / _microN * _panel);
+            }
+        }
+
+        void Run(const uint8_t * A, size_t lda, const int8_t * B, size_t ldb, const GemmRequant & requant, TC * C, size_t ldc)
+        {
+            Simd::Parallel(0, _N, [&](size_t thread, size_t begin, size_t end)
+            {
+                ThreadKernel(begin, end, A, lda, B, ldb, requant, C, ldc, thread);
+            }, _threadNumber, _microN);
+        }
+
+    private:
+
+        void ThreadKernel(size_t begin, size_t end, const uint8_t * A, size_t lda, const int8_t * B, size_t ldb, const GemmRequant & requant, TC * C, size_t ldc, size_t thread)
+        {
+            int32_t * pA = _pA[thread].data;
+            int8_t * pB = _pB[thread].data;
+            for (size_t j = begin; j < end; j += _macroN)
+            {
+                size_t macroN = Simd::Min(end, j + _macroN) - j;
+                _packB(B + j, ldb, _K, macroN, _microN, _group, pB);
+                for (size_t i = 0; i < _M; i += _microM)
+                {
+                    size_t microM = Simd::Min(_M, i + _microM) - i;
+                    _packA(A + i * lda, lda, microM, _K, _group, pA);
+                    for (size_t jj = 0; jj < macroN; jj += _microN)
+                    {
+                        size_t microN = Simd::Min(macroN, jj + _microN) - jj;
+                        _kernel(microM, microN, _KG, pA, pB + jj / _microN * _panel, requant, j + jj, C + i * ldc + j + jj, ldc);
+                    }
+                }
+            }
+        }
+
+        typedef std::vector<Simd::Array<int32_t>> Arrays32i;
+        typedef std::vector<Simd::Array<int8_t>> Arrays8i;
+
+        Arrays32i _pA;
+        Arrays8i _pB;
+        size_t _M, _N, _K, _KG, _microM, _microN, _macroN, _group, _panel, _threadNumber;
+        Kernel _kernel;
+        PackA _packA;
+        PackB _packB;
+    };
+
+#ifdef SIMD_AVX512BW_ENABLE
+    namespace Avx512bw
+    {
+        SIMD_INLINE void Gemm8u8iSave(const __m512i & sum, const GemmRequant & requant, size_t col, __mmask16 tail, int32_t * C)
+        {
+            _mm512_mask_storeu_epi32(C, tail, sum);
+        }
+
+        SIMD_INLINE void Gemm8u8iSave(const __m512i & sum, const GemmRequant & requant, size_t col, __mmask16 tail, uint8_t * C)
+        {
+            __m512i value = requant.bias ? _mm512_add_epi32(sum, _mm512_maskz_loadu_epi32(tail, requant.bias + col)) : sum;
+            __m512 scaled = _mm512_mul_ps(_mm512_cvtepi32_ps(value), _mm512_maskz_loadu_ps(tail, requant.scale + col));
+            value = _mm512_add_epi32(_mm512_cvtps_epi32(scaled), _mm512_set1_epi32(requant.zero));
+            _mm512_mask_cvtusepi32_storeu_epi8(C, tail, _mm512_max_epi32(value, _mm512_setzero_si512()));
+        }
+    }
+#endif//SIMD_AVX512BW_ENABLE
+
+    namespace Base
+    {
+        void GemmPackAT(const float * A, size_t lda, size_t M, size_t K, float * pA);
+
+        void GemmPackBT(const float * B, size_t ldb, size_t K, size_t N, size_t microN, float * pB);
+
+        void * Gemm32fInit(SimdBool transA, SimdBool transB, size_t M, size_t N, size_t K);
+
+        void Gemm8u8i32iNN(size_t M, size_t N, size_t K, const uint8_t * A, size_t lda, const int8_t * B, size_t ldb, int32_t * C, size_t ldc);
+
+        void Gemm8u8i8uNN(size_t M, size_t N, size_t K, const uint8_t * A, size_t lda, const int8_t * B, size_t ldb, const int32_t * bias, const float * scale, uint8_t zero, uint8_t * C, size_t ldc);
+    }
+
 #ifdef SIMD_SSE_ENABLE
     namespace Sse
     {
         void GemmScaleC(size_t M, size_t N, float beta, float * C, size_t ldc);
+
+        void GemmPackAT(const float * A, size_t lda, size_t M, size_t K, float * pA);
+
+        void GemmPackBT(const float * B, size_t ldb, size_t K, size_t N, size_t microN, float * pB);
+
+        void GemmApplyEpilogue(const GemmEpilogue & epilogue, size_t row, size_t col, size_t M, size_t N, float * C, size_t ldc);
+
+        void * Gemm32fInit(SimdBool transA, SimdBool transB, size_t M, size_t N, size_t K);
     }
 #endif//SIMD_SSE_ENABLE
 
+#ifdef SIMD_SSE3_ENABLE
+    namespace Sse3
+    {
+        void * Gemm32fInit(SimdBool transA, SimdBool transB, size_t M, size_t N, size_t K);
+    }
+#endif//SIMD_SSE3_ENABLE
+
 #ifdef SIMD_AVX_ENABLE
     namespace Avx
     {
         void GemmScaleC(size_t M, size_t N, float beta, float * C, size_t ldc);
 
         void GemmPackB(const float * B, size_t ldb, size_t K, size_t N, size_t microN, float * pB);
+
+        void GemmApplyEpilogue(const GemmEpilogue & epilogue, size_t row, size_t col, size_t M, size_t N, float * C, size_t ldc);
+
+        void * Gemm32fInit(SimdBool transA, SimdBool transB, size_t M, size_t N, size_t K);
     }
 #endif//SIMD_AVX_ENABLE
+
+#ifdef SIMD_AVX2_ENABLE
+    namespace Avx2
+    {
+        void GemmApplyEpilogue(const GemmEpilogue & epilogue, size_t row, size_t col, size_t M, size_t N, float * C, size_t ldc);
+
+        void GemmPackA16(const uint16_t * A, size_t lda, size_t M, size_t K, SimdGemmFormatType format, bool trans, float * pA);
+
+        void * Gemm32fInit(SimdBool transA, SimdBool transB, size_t M, size_t N, size_t K);
+
+        void Gemm8iPackA(const uint8_t * A, size_t lda, size_t M, size_t K, size_t group, int32_t * pA);
+
+        void Gemm8iPackB(const int8_t * B, size_t ldb, size_t K, size_t N, size_t microN, size_t group, int8_t * pB);
+
+        void Gemm8u8i32iNN(size_t M, size_t N, size_t K, const uint8_t * A, size_t lda, const int8_t * B, size_t ldb, int32_t * C, size_t ldc);
+
+        void Gemm8u8i8uNN(size_t M, size_t N, size_t K, const uint8_t * A, size_t lda, const int8_t * B, size_t ldb, const int32_t * bias, const float * scale, uint8_t zero, uint8_t * C, size_t ldc);
+    }
+#endif//SIMD_AVX2_ENABLE
+
+#ifdef SIMD_AVX512F_ENABLE
+    namespace Avx512f
+    {
+        void GemmApplyEpilogue(const GemmEpilogue & epilogue, size_t row, size_t col, size_t M, size_t N, float * C, size_t ldc);
+
+        void * Gemm32fInit(SimdBool transA, SimdBool transB, size_t M, size_t N, size_t K);
+    }
+#endif//SIMD_AVX512F_ENABLE
+
+#ifdef SIMD_AVX512BW_ENABLE
+    namespace Avx512bw
+    {
+        void Gemm8u8i32iNN(size_t M, size_t N, size_t K, const uint8_t * A, size_t lda, const int8_t * B, size_t ldb, int32_t * C, size_t ldc);
+
+        void Gemm8u8i8uNN(size_t M, size_t N, size_t K, const uint8_t * A, size_t lda, const int8_t * B, size_t ldb, const int32_t * bias, const float * scale, uint8_t zero, uint8_t * C, size_t ldc);
+    }
+#endif//SIMD_AVX512BW_ENABLE
+
+#ifdef SIMD_AVX512VNNI_ENABLE
+    namespace Avx512vnni
+    {
+        void Gemm8u8i32iNN(size_t M, size_t N, size_t K, const uint8_t * A, size_t lda, const int8_t * B, size_t ldb, int32_t * C, size_t ldc);
+
+        void Gemm8u8i8uNN(size_t M, size_t N, size_t K, const uint8_t * A, size_t lda, const int8_t * B, size_t ldb, const int32_t * bias, const float * scale, uint8_t zero, uint8_t * C, size_t ldc);
+    }
+#endif//SIMD_AVX512VNNI_ENABLE
 }
 
 #ifdef _N_OLD
@@ -54,6 +54,10 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD dwReasonForCall, LPVOID lpReserved)
 
 #include "Simd/SimdResizer.h"
 #include "Simd/SimdConvolution.h"
+#include "Simd/SimdConvolution8i.h"
+#include "Simd/SimdDeconvolution.h"
+#include "Simd/SimdGemm.h"
+#include "Simd/SimdContext.h"
 
 #include "Simd/SimdBase.h"
 #include "Simd/SimdSse1.h"
@@ -126,10 +130,23 @@ SIMD_API int SimdCpuInfo()
 #endif
 #ifdef SIMD_MSA_ENABLE
     info |= Msa::Enable ? (1 << SimdCpuInfoMsa) : 0;
+#endif
+#ifdef SIMD_AVX512VNNI_ENABLE
+    info |= Avx512vnni::Enable ? (1 << SimdCpuInfoAvx512vnni) : 0;
 #endif
     return info;
 }
 
+SIMD_API size_t SimdCpuCacheSize(size_t level)
+{
+    return Base::CpuCacheSize(level);
+}
+
+SIMD_API size_t SimdCpuCacheSharing(size_t level)
+{
+    return Base::CpuCacheSharing(level);
+}
+
 SIMD_API void * SimdAllocate(size_t size, size_t align)
 {
     return Allocate(size, align);
@@ -165,6 +182,31 @@ SIMD_API void SimdSetThreadNumber(size_t threadNumber)
     Base::SetThreadNumber(threadNumber);
 }
 
+SIMD_API void * SimdContextInit(size_t threadNumber)
+{
+    return Base::ContextInit(threadNumber);
+}
+
+SIMD_API size_t SimdContextGetThreadNumber(const void * context)
+{
+    return ((Context*)context)->threadNumber;
+}
+
+SIMD_API void SimdContextSetThreadNumber(void * context, size_t threadNumber)
+{
+    Base::SetThreadNumber((Context*)context, threadNumber);
+}
+
+SIMD_API void * SimdGetContext()
+{
+    return Base::GetContext();
+}
+
+SIMD_API void SimdSetContext(void * context)
+{
+    Base::SetContext((Context*)context);
+}
+
 SIMD_API SimdBool SimdGetFlushToZero()
 {
 #ifdef SIMD_SSE_ENABLE
@@ -1404,35 +1446,36 @@ SIMD_API void SimdCopyFrame(const uint8_t * src, size_t srcStride, size_t width,
     Base::CopyFrame(src, srcStride, width, height, pixelSize, frameLeft, frameTop, frameRight, frameBottom, dst, dstStride);
 }
 
-SIMD_API void * SimdConvolutionInit(size_t srcC, size_t srcH, size_t srcW, size_t dstC, size_t kernelY, size_t kernelX,
-    size_t dilationY, size_t dilationX, size_t strideY, size_t strideX, size_t padY, size_t padX, size_t padH, size_t padW, size_t group)
+SIMD_API void * SimdConvolutionInit(SimdBool trans, size_t batch, size_t srcC, size_t srcH, size_t srcW, size_t dstC, size_t kernelY, size_t kernelX,
+    size_t dilationY, size_t dilationX, size_t strideY, size_t strideX, size_t padY, size_t padX, size_t padH, size_t padW, size_t group, 
+    SimdConvolutionActivationType activation, const float * activationParams)
 {
 #ifdef SIMD_AVX512F_ENABLE
     if (Avx512f::Enable)
-        return Avx512f::ConvolutionInit(srcC, srcH, srcW, dstC, kernelY, kernelX, dilationY, dilationX, strideY, strideX, padY, padX, padH, padW, group);
+        return Avx512f::ConvolutionInit(trans, batch, srcC, srcH, srcW, dstC, kernelY, kernelX, dilationY, dilationX, strideY, strideX, padY, padX, padH, padW, group, activation, activationParams);
     else
 #endif
 #ifdef SIMD_AVX2_ENABLE
     if (Avx2::Enable)
-        return Avx2::ConvolutionInit(srcC, srcH, srcW, dstC, kernelY, kernelX, dilationY, dilationX, strideY, strideX, padY, padX, padH, padW, group);
+        return Avx2::ConvolutionInit(trans, batch, srcC, srcH, srcW, dstC, kernelY, kernelX, dilationY, dilationX, strideY, strideX, padY, padX, padH, padW, group, activation, activationParams);
     else
 #endif
 #ifdef SIMD_AVX_ENABLE
     if (Avx::Enable)
-        return Avx::ConvolutionInit(srcC, srcH, srcW, dstC, kernelY, kernelX, dilationY, dilationX, strideY, strideX, padY, padX, padH, padW, group);
+        return Avx::ConvolutionInit(trans, batch, srcC, srcH, srcW, dstC, kernelY, kernelX, dilationY, dilationX, strideY, strideX, padY, padX, padH, padW, group, activation, activationParams);
     else
 #endif
 #ifdef SIMD_SSE3_ENABLE
     if (Sse3::Enable)
-        return Sse3::ConvolutionInit(srcC, srcH, srcW, dstC, kernelY, kernelX, dilationY, dilationX, strideY, strideX, padY, padX, padH, padW, group);
+        return Sse3::ConvolutionInit(trans, batch, srcC, srcH, srcW, dstC, kernelY, kernelX, dilationY, dilationX, strideY, strideX, padY, padX, padH, padW, group, activation, activationParams);
     else
 #endif
 #ifdef SIMD_SSE_ENABLE
     if (Sse::Enable)
-        return Sse::ConvolutionInit(srcC, srcH, srcW, dstC, kernelY, kernelX, dilationY, dilationX, strideY, strideX, padY, padX, padH, padW, group);
+        return Sse::ConvolutionInit(trans, batch, srcC, srcH, srcW, dstC, kernelY, kernelX, dilationY, dilationX, strideY, strideX, padY, padX, padH, padW, group, activation, activationParams);
     else
 #endif
-        return Base::ConvolutionInit(srcC, srcH, srcW, dstC, kernelY, kernelX, dilationY, dilationX, strideY, strideX, padY, padX, padH, padW, group);
+        return Base::ConvolutionInit(trans, batch, srcC, srcH, srcW, dstC, kernelY, kernelX, dilationY, dilationX, strideY, strideX, padY, padX, padH, padW, group, activation, activationParams);
 }
 
 SIMD_API size_t SimdConvolutionBufferSize(const void * convolution)
@@ -1442,7 +1485,12 @@ SIMD_API size_t SimdConvolutionBufferSize(const void * convolution)
 
 SIMD_API void SimdConvolutionSetWeight(void * convolution, const float * weight, const float * bias)
 {
-    ((Convolution*)convolution)->SetWeight(weight, bias);
+    ((Convolution*)convolution)->SetWeight(weight, bias, SimdGemmFormat32f);
+}
+
+SIMD_API void SimdConvolutionSetWeightFormat(void * convolution, const float * weight, const float * bias, SimdGemmFormatType format)
+{
+    ((Convolution*)convolution)->SetWeight(weight, bias, format);
 }
 
 SIMD_API void SimdConvolutionForward(void * convolution, const float * src, float * buf, float * dst)
@@ -1450,6 +1498,90 @@ SIMD_API void SimdConvolutionForward(void * convolution, const float * src, floa
     ((Convolution*)convolution)->Forward(src, buf, dst);
 }
 
+SIMD_API void SimdConvolutionSetTuning(SimdBool enable, const char * cache)
+{
+    Base::ConvolutionSetTuning(enable == SimdTrue, cache);
+}
+
+SIMD_API void * SimdConvolution8iInit(size_t batch, size_t srcC, size_t srcH, size_t srcW, size_t dstC, size_t kernelY, size_t kernelX,
+    size_t dilationY, size_t dilationX, size_t strideY, size_t strideX, size_t padY, size_t padX, size_t padH, size_t padW, size_t group,
+    SimdConvolutionActivationType activation, SimdBool dst8u)
+{
+#ifdef SIMD_AVX512VNNI_ENABLE
+    if (Avx512vnni::Enable)
+        return Avx512vnni::Convolution8iInit(batch, srcC, srcH, srcW, dstC, kernelY, kernelX, dilationY, dilationX, strideY, strideX, padY, padX, padH, padW, group, activation, dst8u);
+    else
+#endif
+#ifdef SIMD_AVX512BW_ENABLE
+    if (Avx512bw::Enable)
+        return Avx512bw::Convolution8iInit(batch, srcC, srcH, srcW, dstC, kernelY, kernelX, dilationY, dilationX, strideY, strideX, padY, padX, padH, padW, group, activation, dst8u);
+    else
+#endif
+#ifdef SIMD_AVX2_ENABLE
+    if (Avx2::Enable)
+        return Avx2::Convolution8iInit(batch, srcC, srcH, srcW, dstC, kernelY, kernelX, dilationY, dilationX, strideY, strideX, padY, padX, padH, padW, group, activation, dst8u);
+    else
+#endif
+        return Base::Convolution8iInit(batch, srcC, srcH, srcW, dstC, kernelY, kernelX, dilationY, dilationX, strideY, strideX, padY, padX, padH, padW, group, activation, dst8u);
+}
+
+SIMD_API size_t SimdConvolution8iBufferSize(const void * convolution)
+{
+    return ((Convolution8i*)convolution)->BufferSize();
+}
+
+SIMD_API void SimdConvolution8iSetWeight(void * convolution, const float * weight, const float * bias, float srcScale, uint8_t srcZero, float dstScale, uint8_t dstZero)
+{
+    ((Convolution8i*)convolution)->SetWeight(weight, bias, srcScale, srcZero, dstScale, dstZero);
+}
+
+SIMD_API void SimdConvolution8iForward(void * convolution, const uint8_t * src, uint8_t * buf, uint8_t * dst)
+{
+    ((Convolution8i*)convolution)->Forward(src, buf, dst);
+}
+
+SIMD_API void * SimdDeconvolutionInit(SimdBool trans, size_t batch, size_t srcC, size_t srcH, size_t srcW, size_t dstC, size_t kernelY, size_t kernelX,
+    size_t dilationY, size_t dilationX, size_t strideY, size_t strideX, size_t padY, size_t padX, size_t padH, size_t padW, size_t group,
+    SimdConvolutionActivationType activation, const float * activationParams)
+{
+#ifdef SIMD_AVX512F_ENABLE
+    if (Avx512f::Enable)
+        return Avx512f::DeconvolutionInit(trans, batch, srcC, srcH, srcW, dstC, kernelY, kernelX, dilationY, dilationX, strideY, strideX, padY, padX, padH, padW, group, activation, activationParams);
+    else
+#endif
+#ifdef SIMD_AVX2_ENABLE
+    if (Avx2::Enable)
+        return Avx2::DeconvolutionInit(trans, batch, srcC, srcH, srcW, dstC, kernelY, kernelX, dilationY, dilationX, strideY, strideX, padY, padX, padH, padW, group, activation, activationParams);
+    else
+#endif
+#ifdef SIMD_AVX_ENABLE
+    if (Avx::Enable)
+        return Avx::DeconvolutionInit(trans, batch, srcC, srcH, srcW, dstC, kernelY, kernelX, dilationY, dilationX, strideY, strideX, padY, padX, padH, padW, group, activation, activationParams);
+    else
+#endif
+#ifdef SIMD_SSE_ENABLE
+    if (Sse::Enable)
+        return Sse::DeconvolutionInit(trans, batch, srcC, srcH, srcW, dstC, kernelY, kernelX, dilationY, dilationX, strideY, strideX, padY, padX, padH, padW, group, activation, activationParams);
+    else
+#endif
+        return Base::DeconvolutionInit(trans, batch, srcC, srcH, srcW, dstC, kernelY, kernelX, dilationY, dilationX, strideY, strideX, padY, padX, padH, padW, group, activation, activationParams);
+}
+
+SIMD_API size_t SimdDeconvolutionBufferSize(const void * deconvolution)
+{
+    return ((Deconvolution*)deconvolution)->BufferSize();
+}
+
+SIMD_API void SimdDeconvolutionSetWeight(void * deconvolution, const float * weight, const float * bias)
+{
+    ((Deconvolution*)deconvolution)->SetWeight(weight, bias);
+}
+
+SIMD_API void SimdDeconvolutionForward(void * deconvolution, const float * src, float * buf, float * dst)
+{
+    ((Deconvolution*)deconvolution)->Forward(src, buf, dst);
+}
+
 SIMD_API void SimdDeinterleaveUv(const uint8_t * uv, size_t uvStride, size_t width, size_t height,
                     uint8_t * u, size_t uStride, uint8_t * v, size_t vStride)
 {
@@ -2179,6 +2311,122 @@ SIMD_API void SimdGemm32fNT(size_t M, size_t N, size_t K, const float * alpha, c
     simdGemm32fNT(M, N, K, alpha, A, lda, B, ldb, beta, C, ldc);
 }
 
+SimdGemm32fPtr simdGemm32fTN = SIMD_FUNC4(Gemm32fTN, SIMD_AVX512F_FUNC, SIMD_AVX2_FUNC, SIMD_AVX_FUNC, SIMD_SSE_FUNC);
+
+SIMD_API void SimdGemm32fTN(size_t M, size_t N, size_t K, const float * alpha, const float * A, size_t lda, const float * B, size_t ldb, const float * beta, float * C, size_t ldc)
+{
+    simdGemm32fTN(M, N, K, alpha, A, lda, B, ldb, beta, C, ldc);
+}
+
+SimdGemm32fPtr simdGemm32fTT = SIMD_FUNC4(Gemm32fTT, SIMD_AVX512F_FUNC, SIMD_AVX2_FUNC, SIMD_AVX_FUNC, SIMD_SSE_FUNC);
+
+SIMD_API void SimdGemm32fTT(size_t M, size_t N, size_t K, const float * alpha, const float * A, size_t lda, const float * B, size_t ldb, const float * beta, float * C, size_t ldc)
+{
+    simdGemm32fTT(M, N, K, alpha, A, lda, B, ldb, beta, C, ldc);
+}
+
+SIMD_API void * SimdGemm32fInit(SimdBool transA, SimdBool transB, size_t M, size_t N, size_t K)
+{
+#ifdef SIMD_AVX512F_ENABLE
+    if (Avx512f::Enable)
+        return Avx512f::Gemm32fInit(transA, transB, M, N, K);
+    else
+#endif
+#ifdef SIMD_AVX2_ENABLE
+    if (Avx2::Enable)
+        return Avx2::Gemm32fInit(transA, transB, M, N, K);
+    else
+#endif
+#ifdef SIMD_AVX_ENABLE
+    if (Avx::Enable)
+        return Avx::Gemm32fInit(transA, transB, M, N, K);
+    else
+#endif
+#ifdef SIMD_SSE3_ENABLE
+    if (Sse3::Enable)
+        return Sse3::Gemm32fInit(transA, transB, M, N, K);
+    else
+#endif
+#ifdef SIMD_SSE_ENABLE
+    if (Sse::Enable)
+        return Sse::Gemm32fInit(transA, transB, M, N, K);
+    else
+#endif
+        return Base::Gemm32fInit(transA, transB, M, N, K);
+}
+
+SIMD_API void SimdGemm32fRun(void * gemm, const float * alpha, const float * A, size_t lda, const float * B, size_t ldb, const float * beta, float * C, size_t ldc)
+{
+    ((Gemm<float>*)gemm)->Run(alpha, A, lda, B, ldb, beta, C, ldc);
+}
+
+SIMD_API size_t SimdGemm32fPackedBSize(const void * gemm)
+{
+    return ((Gemm<float>*)gemm)->PackedBSize();
+}
+
+SIMD_API void SimdGemm32fPackB(const void * gemm, const float * B, size_t ldb, float * pB)
+{
+    ((Gemm<float>*)gemm)->PackMatrixB(B, ldb, pB);
+}
+
+SIMD_API void SimdGemm32fRunPackedB(void * gemm, const float * alpha, const float * A, size_t lda, const float * pB, const float * beta, float * C, size_t ldc)
+{
+    ((Gemm<float>*)gemm)->RunPackedB(alpha, A, lda, pB, beta, C, ldc);
+}
+
+SIMD_API void SimdGemm32fRunBatched(void * gemm, size_t batch, const float * alpha, const float * A, size_t lda, size_t strideA,
+    const float * B, size_t ldb, size_t strideB, const float * beta, float * C, size_t ldc, size_t strideC)
+{
+    ((Gemm<float>*)gemm)->RunBatched(batch, alpha, A, lda, strideA, B, ldb, strideB, beta, C, ldc, strideC);
+}
+
+SIMD_API void SimdGemm32fRun16(void * gemm, SimdGemmFormatType formatA, const float * alpha, const uint16_t * A, size_t lda,
+    const float * B, size_t ldb, const float * beta, float * C, size_t ldc)
+{
+    ((Gemm<float>*)gemm)->RunBatched16(formatA, 1, alpha, A, lda, 0, B, ldb, 0, beta, C, ldc, 0);
+}
+
+SIMD_API void SimdGemm8u8i32iNN(size_t M, size_t N, size_t K, const uint8_t * A, size_t lda, const int8_t * B, size_t ldb, int32_t * C, size_t ldc)
+{
+#ifdef SIMD_AVX512VNNI_ENABLE
+    if (Avx512vnni::Enable)
+        Avx512vnni::Gemm8u8i32iNN(M, N, K, A, lda, B, ldb, C, ldc);
+    else
+#endif
+#ifdef SIMD_AVX512BW_ENABLE
+    if (Avx512bw::Enable)
+        Avx512bw::Gemm8u8i32iNN(M, N, K, A, lda, B, ldb, C, ldc);
+    else
+#endif
+#ifdef SIMD_AVX2_ENABLE
+    if (Avx2::Enable)
+        Avx2::Gemm8u8i32iNN(M, N, K, A, lda, B, ldb, C, ldc);
+    else
+#endif
+        Base::Gemm8u8i32iNN(M, N, K, A, lda, B, ldb, C, ldc);
+}
+
+SIMD_API void SimdGemm8u8i8uNN(size_t M, size_t N, size_t K, const uint8_t * A, size_t lda, const int8_t * B, size_t ldb, const int32_t * bias, const float * scale, uint8_t zero, uint8_t * C, size_t ldc)
+{
+#ifdef SIMD_AVX512VNNI_ENABLE
+    if (Avx512vnni::Enable)
+        Avx512vnni::Gemm8u8i8uNN(M, N, K, A, lda, B, ldb, bias, scale, zero, C, ldc);
+    else
+#endif
+#ifdef SIMD_AVX512BW_ENABLE
+    if (Avx512bw::Enable)
+        Avx512bw::Gemm8u8i8uNN(M, N, K, A, lda, B, ldb, bias, scale, zero, C, ldc);
+    else
+#endif
+#ifdef SIMD_AVX2_ENABLE
+    if (Avx2::Enable)
+        Avx2::Gemm8u8i8uNN(M, N, K, A, lda, B, ldb, bias, scale, zero, C, ldc);
+    else
+#endif
+        Base::Gemm8u8i8uNN(M, N, K, A, lda, B, ldb, bias, scale, zero, C, ldc);
+}
+
 SIMD_API void SimdGrayToBgr(const uint8_t * gray, size_t width, size_t height, size_t grayStride, uint8_t * bgr, size_t bgrStride)
 {
 #ifdef SIMD_AVX512BW_ENABLE
@@ -5013,6 +5261,30 @@ SIMD_API void SimdSynetEltwiseLayerForward(float const * const * src, const floa
     simdSynetEltwiseLayerForward(src, weight, count, size, type, dst);
 }
 
+typedef void(*SimdSynetElu32fPtr) (const float * src, size_t size, const float * alpha, float * dst);
+volatile SimdSynetElu32fPtr simdSynetElu32f = SIMD_FUNC2(SynetElu32f, SIMD_AVX512F_FUNC, SIMD_AVX2_FUNC);
+
+SIMD_API void SimdSynetElu32f(const float * src, size_t size, const float * alpha, float * dst)
+{
+    simdSynetElu32f(src, size, alpha, dst);
+}
+
+typedef void(*SimdSynetGelu32fPtr) (const float * src, size_t size, float * dst);
+volatile SimdSynetGelu32fPtr simdSynetGelu32f = SIMD_FUNC2(SynetGelu32f, SIMD_AVX512F_FUNC, SIMD_AVX2_FUNC);
+
+SIMD_API void SimdSynetGelu32f(const float * src, size_t size, float * dst)
+{
+    simdSynetGelu32f(src, size, dst);
+}
+
+typedef void(*SimdSynetHswish32fPtr) (const float * src, size_t size, const float * shift, const float * scale, float * dst);
+volatile SimdSynetHswish32fPtr simdSynetHswish32f = SIMD_FUNC2(SynetHswish32f, SIMD_AVX512F_FUNC, SIMD_AVX2_FUNC);
+
+SIMD_API void SimdSynetHswish32f(const float * src, size_t size, const float * shift, const float * scale, float * dst)
+{
+    simdSynetHswish32f(src, size, shift, scale, dst);
+}
+
 typedef void(*SimdSynetLrnLayerCrossChannelsPtr) (const float * src, size_t half, size_t count, size_t size, const float * k, float * dst);
 volatile SimdSynetLrnLayerCrossChannelsPtr simdSynetLrnLayerCrossChannels = SIMD_FUNC3(SynetLrnLayerCrossChannels, SIMD_AVX512F_FUNC, SIMD_AVX2_FUNC, SIMD_SSE2_FUNC);
 
@@ -5029,6 +5301,30 @@ SIMD_API void SimdSynetScaleLayerForward(const float * src, const float * scale,
     simdSynetScaleLayerForward(src, scale, bias, count, size, dst);
 }
 
+typedef void(*SimdSynetSigmoid32fPtr) (const float * src, size_t size, float * dst);
+volatile SimdSynetSigmoid32fPtr simdSynetSigmoid32f = SIMD_FUNC2(SynetSigmoid32f, SIMD_AVX512F_FUNC, SIMD_AVX2_FUNC);
+
+SIMD_API void SimdSynetSigmoid32f(const float * src, size_t size, float * dst)
+{
+    simdSynetSigmoid32f(src, size, dst);
+}
+
+typedef void(*SimdSynetSoftmaxLayerForwardPtr) (const float * src, size_t outer, size_t count, size_t inner, float * dst);
+volatile SimdSynetSoftmaxLayerForwardPtr simdSynetSoftmaxLayerForward = SIMD_FUNC2(SynetSoftmaxLayerForward, SIMD_AVX512F_FUNC, SIMD_AVX2_FUNC);
+
+SIMD_API void SimdSynetSoftmaxLayerForward(const float * src, size_t outer, size_t count, size_t inner, float * dst)
+{
+    simdSynetSoftmaxLayerForward(src, outer, count, inner, dst);
+}
+
+typedef void(*SimdSynetTanh32fPtr) (const float * src, size_t size, float * dst);
+volatile SimdSynetTanh32fPtr simdSynetTanh32f = SIMD_FUNC2(SynetTanh32f, SIMD_AVX512F_FUNC, SIMD_AVX2_FUNC);
+
+SIMD_API void SimdSynetTanh32f(const float * src, size_t size, float * dst)
+{
+    simdSynetTanh32f(src, size, dst);
+}
+
 SIMD_API void SimdTextureBoostedSaturatedGradient(const uint8_t * src, size_t srcStride, size_t width, size_t height,
                                      uint8_t saturation, uint8_t boost, uint8_t * dx, size_t dxStride, uint8_t * dy, size_t dyStride)
 {
@@ -5204,14 +5500,18 @@ SIMD_API void SimdWinograd4x3pSetFilter(const float * src, size_t size, float *
     simdWinograd4x3pSetFilter(src, size, dst);
 }
 
+volatile SimdWinogradSetInputPtr simdWinograd4x3pSetInput = SIMD_FUNC1(Winograd4x3pSetInput, SIMD_SSE_FUNC);
+
 SIMD_API void SimdWinograd4x3pSetInput(const float * src, size_t srcChannels, size_t srcHeight, size_t srcWidth, float * dst, int pad)
 {
-    Base::Winograd4x3pSetInput(src, srcChannels, srcHeight, srcWidth, dst, pad);
+    simdWinograd4x3pSetInput(src, srcChannels, srcHeight, srcWidth, dst, pad);
 }
 
+volatile SimdWinogradSetOutputPtr simdWinograd4x3pSetOutput = SIMD_FUNC1(Winograd4x3pSetOutput, SIMD_SSE_FUNC);
+
 SIMD_API void SimdWinograd4x3pSetOutput(const float * src, float * dst, size_t dstChannels, size_t dstHeight, size_t dstWidth)
 {
-    Base::Winograd4x3pSetOutput(src, dst, dstChannels, dstHeight, dstWidth);
+    simdWinograd4x3pSetOutput(src, dst, dstChannels, dstHeight, dstWidth);
 }
 
 SIMD_API void SimdYuv420pToBgr(const uint8_t * y, size_t yStride, const uint8_t * u, size_t uStride, const uint8_t * v, size_t vStride,
@@ -94,6 +94,7 @@ typedef enum
     SimdCpuInfoVsx, /*!< VSX (PowerPC). */
     SimdCpuInfoNeon, /*!< NEON (ARM). */
     SimdCpuInfoMsa, /*!< MSA (MIPS). */
+    SimdCpuInfoAvx512vnni, /*!< AVX-512VNNI (x86). */
 } SimdCpuInfoFlags;
 
 /*! @ingroup c_types
@@ -275,6 +276,7 @@ extern "C"
             std::cout << "PowerPC-VSX: " << (info&(1 << SimdCpuInfoVsx) ? "Yes" : "No") << std::endl;
             std::cout << "ARM-NEON: " << (info&(1 << SimdCpuInfoNeon) ? "Yes" : "No") << std::endl;
             std::cout << "MIPS-MSA: " << (info&(1 << SimdCpuInfoMsa) ? "Yes" : "No") << std::endl;
+            std::cout << "AVX-512VNNI: " << (info&(1 << SimdCpuInfoAvx512vnni) ? "Yes" : "No") << std::endl;
             return 0;
         }
         \endverbatim
@@ -283,6 +285,31 @@ extern "C"
     */
     SIMD_API int SimdCpuInfo();
 
+    /*! @ingroup info
+
+        \fn size_t SimdCpuCacheSize(size_t level);
+
+        \short Gets size of CPU data (or unified) cache of given level.
+
+        The cache topology is detected once at startup (with using of CPUID on x86 or sysfs on Linux).
+        It is used in order to choose block sizes of ::SimdGemm32fNN, ::SimdGemm32fNT and convolution algorithms.
+
+        \param [in] level - a level of cache (1, 2 or 3).
+        \return size of the cache in bytes (0 for unknown level).
+    */
+    SIMD_API size_t SimdCpuCacheSize(size_t level);
+
+    /*! @ingroup info
+
+        \fn size_t SimdCpuCacheSharing(size_t level);
+
+        \short Gets number of logical CPU cores which share CPU cache of given level.
+
+        \param [in] level - a level of cache (1, 2 or 3).
+        \return number of logical cores sharing the cache (0 for unknown level).
+    */
+    SIMD_API size_t SimdCpuCacheSharing(size_t level);
+
     /*! @ingroup memory
 
         \fn void * SimdAllocate(size_t size, size_t align);
@@ -361,10 +388,81 @@ extern "C"
 
         \short Sets number of threads used by Simd Library to parallelize some algorithms.
 
+        \note The library keeps a persistent pool of worker threads, so this function also starts the missing workers in advance.
+
         \param [in] threadNumber - a number of threads.
     */
     SIMD_API void SimdSetThreadNumber(size_t threadNumber);
 
+    /*! @ingroup thread
+
+        \fn void * SimdContextInit(size_t threadNumber);
+
+        \short Creates an execution context.
+
+        The context holds a number of threads, its own set of worker threads and scratch buffers. After it is attached to a calling thread with ::SimdSetContext,
+        the functions called from this thread use the context instead of the global settings, so independent pipelines
+        running in different threads can use different number of threads and run in parallel without affecting each other.
+
+        \note The context must be released with using of function ::SimdRelease after it is detached from all threads.
+            The workers of the context run one parallel job at a time: if the same context is attached to several threads
+            which call multithreaded functions simultaneously, the other calls start temporary threads for their work.
+            Use a separate context for each concurrent pipeline. Threads without attached context share the global workers in the same way.
+            The context does not control core affinity of the workers or the instruction set: functions are dispatched once when the library is loaded.
+
+        \param [in] threadNumber - a number of threads used by the context.
+        \return a pointer to the created context.
+    */
+    SIMD_API void * SimdContextInit(size_t threadNumber);
+
+    /*! @ingroup thread
+
+        \fn size_t SimdContextGetThreadNumber(const void * context);
+
+        \short Gets number of threads used by the execution context.
+
+        \param [in] context - a context created by function ::SimdContextInit.
+        \return current thread number of the context.
+    */
+    SIMD_API size_t SimdContextGetThreadNumber(const void * context);
+
+    /*! @ingroup thread
+
+        \fn void SimdContextSetThreadNumber(void * context, size_t threadNumber);
+
+        \short Sets number of threads used by the execution context.
+
+        \param [in, out] context - a context created by function ::SimdContextInit.
+        \param [in] threadNumber - a number of threads.
+    */
+    SIMD_API void SimdContextSetThreadNumber(void * context, size_t threadNumber);
+
+    /*! @ingroup thread
+
+        \fn void * SimdGetContext();
+
+        \short Gets the execution context attached to the calling thread.
+
+        \return a pointer to the attached context or NULL.
+    */
+    SIMD_API void * SimdGetContext();
+
+    /*! @ingroup thread
+
+        \fn void SimdSetContext(void * context);
+
+        \short Attaches the execution context to the calling thread.
+
+        All following calls of ::SimdGemm32fNN, ::SimdGemm32fNT, ::SimdConvolutionForward and other functions from this thread use
+        the number of threads and the workers of the context. ::SimdConvolutionForward also uses the scratch buffer of the context when external buffer is not passed.
+        Each thread attached to the context gets its own scratch buffer, so several threads can share one context.
+
+        \note Single-threaded functions, for example ::SimdResizerRun and Simd::Motion::Detector, do not use the context.
+
+        \param [in] context - a context created by function ::SimdContextInit. Use NULL to detach current context.
+    */
+    SIMD_API void SimdSetContext(void * context);
+
     /*! @ingroup cpu_flags
 
         \fn SimdBool SimdGetFlushToZero();
@@ -1566,12 +1664,39 @@ extern "C"
     SIMD_API void SimdCopyFrame(const uint8_t * src, size_t srcStride, size_t width, size_t height, size_t pixelSize,
         size_t frameLeft, size_t frameTop, size_t frameRight, size_t frameBottom, uint8_t * dst, size_t dstStride);
 
+    /*! @ingroup synet
+        Describes type of activation function which can be fused with convolution and matrix multiplication.
+    */
+    typedef enum
+    {
+        SimdConvolutionActivationIdentity = 0, /*!< Identity (no activation): y = x. */
+        SimdConvolutionActivationRelu, /*!< ReLU: y = max(0, x). */
+        SimdConvolutionActivationLeakyRelu, /*!< Leaky ReLU: y = max(0, x) + params[0]*min(0, x). */
+        SimdConvolutionActivationPrelu, /*!< PReLU: y = max(0, x) + params[c]*min(0, x), where c is an output channel. */
+        SimdConvolutionActivationSigmoid, /*!< Sigmoid: y = 1/(1 + exp(-x)). */
+    } SimdConvolutionActivationType;
+
+    /*! @ingroup matrix
+        Describes storage format of matrix elements (see functions ::SimdGemm32fRun16 and ::SimdConvolutionSetWeightFormat).
+    */
+    typedef enum
+    {
+        SimdGemmFormat32f = 0, /*!< 32-bit float (IEEE 754 single precision). */
+        SimdGemmFormat16f, /*!< 16-bit float (IEEE 754 half precision), see function ::SimdFloat32ToFloat16. */
+        SimdGemmFormat16b, /*!< 16-bit brain float (bfloat16): the upper half of 32-bit float. */
+    } SimdGemmFormatType;
+
     /*! @ingroup synet
 
-        \fn void * SimdConvolutionInit(size_t srcC, size_t srcH, size_t srcW, size_t dstC, size_t kernelY, size_t kernelX, size_t dilationY, size_t dilationX, size_t strideY, size_t strideX, size_t padY, size_t padX, size_t padH, size_t padW, size_t group);
+        \fn void * SimdConvolutionInit(SimdBool trans, size_t batch, size_t srcC, size_t srcH, size_t srcW, size_t dstC, size_t kernelY, size_t kernelX, size_t dilationY, size_t dilationX, size_t strideY, size_t strideX, size_t padY, size_t padX, size_t padH, size_t padW, size_t group, SimdConvolutionActivationType activation, const float * activationParams);
         
         \short Initilizes convolution algorithm.
 
+        \param [in] trans - a flag of transposed (NHWC, channels-last) layout of tensors. 
+            If it is ::SimdFalse then input and output images have CHW layout and weights have layout [dstC, srcC/group, kernelY, kernelX].
+            If it is ::SimdTrue then input and output images have HWC layout (interleaved channels) and weights have layout [kernelY, kernelX, srcC/group, dstC].
+        \param [in] batch - a number of images processed by one call of ::SimdConvolutionForward. The images are stored one after another.
+            Algorithms based on GEMM for NHWC layout merge several images into one matrix multiplication.
         \param [in] srcC - a number of input channels.
         \param [in] srcH - an input height.
         \param [in] srcW - an input width.
@@ -1587,11 +1712,15 @@ extern "C"
         \param [in] padH - a pad to the bottom of the input image.
         \param [in] padW - a pad to the right of the input image.
         \param [in] group - a size of convolution group.
+        \param [in] activation - a type of activation function which is applied to the output (together with bias) while it is still in cache.
+        \param [in] activationParams - a pointer to parameters of activation function: one slope for ::SimdConvolutionActivationLeakyRelu, 
+            dstC slopes for ::SimdConvolutionActivationPrelu. The parameters are copied into convolution context. Can be NULL for other activation types.
         \return a pointer to convolution context. On error it returns NULL. It must be released with using of function ::SimdRelease.
             This pointer is used in functions ::SimdConvolutionBufferSize, ::SimdConvolutionSetWeight and ::SimdConvolutionForward.
     */
-    SIMD_API void * SimdConvolutionInit(size_t srcC, size_t srcH, size_t srcW, size_t dstC, size_t kernelY, size_t kernelX, 
-        size_t dilationY, size_t dilationX, size_t strideY, size_t strideX, size_t padY, size_t padX, size_t padH, size_t padW, size_t group);
+    SIMD_API void * SimdConvolutionInit(SimdBool trans, size_t batch, size_t srcC, size_t srcH, size_t srcW, size_t dstC, size_t kernelY, size_t kernelX, 
+        size_t dilationY, size_t dilationX, size_t strideY, size_t strideX, size_t padY, size_t padX, size_t padH, size_t padW, size_t group, 
+        SimdConvolutionActivationType activation, const float * activationParams);
 
     /*! @ingroup synet
 
@@ -1616,6 +1745,23 @@ extern "C"
     */
     SIMD_API void SimdConvolutionSetWeight(void * convolution, const float * weight, const float * bias);
 
+    /*! @ingroup synet
+
+        \fn void SimdConvolutionSetWeightFormat(void * convolution, const float * weight, const float * bias, SimdGemmFormatType format);
+
+        \short Sets weights and beases required for convolution algorithm and chooses format of internal storage of weights.
+
+        In case of 16-bit formats (::SimdGemmFormat16f and ::SimdGemmFormat16b) the weights are converted and copied into internal buffer, 
+        so GEMM based algorithms read twice less weight data. Algorithms which transform weights (Winograd, direct) and algorithms for NHWC layout keep them in 32-bit format. 
+        The call with ::SimdGemmFormat32f is equal to ::SimdConvolutionSetWeight.
+
+        \param [in, out] convolution - a pointer to convolution context. It must be created by function ::SimdConvolutionInit and released by function ::SimdRelease.
+        \param [in] weight - a pointer to convolution weights.
+        \param [in] bias - a pointer to bias. Can be NULL.
+        \param [in] format - a format of internal storage of weights.
+    */
+    SIMD_API void SimdConvolutionSetWeightFormat(void * convolution, const float * weight, const float * bias, SimdGemmFormatType format);
+
     /*! @ingroup synet
 
         \fn void SimdConvolutionForward(void * convolution, const float * src, float * buf, float * dst);
@@ -1623,12 +1769,185 @@ extern "C"
         \short Performs forward propagation of convolution algorithm.
 
         \param [in] convolution - a pointer to convolution context. It must be created by function ::SimdConvolutionInit and released by function ::SimdRelease.
-        \param [in] src - a pointer to input image.
+        \param [in] src - a pointer to input images (batch images one after another).
         \param [out] buf - a pointer to temporary buffer. The size of the temporary buffer is determined by function ::SimdConvolutionBufferSize. Can be NULL.
-        \param [out] dst - a pointer to output image.
+        \param [out] dst - a pointer to output images (batch images one after another).
     */
     SIMD_API void SimdConvolutionForward(void * convolution, const float * src, float * buf, float * dst);
 
+    /*! @ingroup synet
+
+        \fn void SimdConvolutionSetTuning(SimdBool enable, const char * cache);
+
+        \short Enables or disables measured selection of convolution algorithm.
+
+        In tuning mode ::SimdConvolutionInit runs every applicable convolution algorithm on dummy data and chooses the fastest one 
+        instead of using of built-in heuristics. The decisions are keyed by convolution parameters, CPU model, instruction set and number of threads.
+        They are appended to the cache file, so later processes which use the same file start up without re-tuning.
+
+        \note Tuning increases the time of ::SimdConvolutionInit. Convolutions created before the call are not affected.
+
+        \param [in] enable - a flag to enable tuning mode. It is disabled by default.
+        \param [in] cache - a path to text file with cached decisions. It is loaded at this call. Can be NULL (decisions are kept in memory only).
+    */
+    SIMD_API void SimdConvolutionSetTuning(SimdBool enable, const char * cache);
+
+    /*! @ingroup synet
+
+        \fn void * SimdConvolution8iInit(size_t batch, size_t srcC, size_t srcH, size_t srcW, size_t dstC, size_t kernelY, size_t kernelX, size_t dilationY, size_t dilationX, size_t strideY, size_t strideX, size_t padY, size_t padX, size_t padH, size_t padW, size_t group, SimdConvolutionActivationType activation, SimdBool dst8u);
+
+        \short Initializes quantized (8-bit integer) convolution algorithm.
+
+        Input and output images are stored in NHWC format, weights are stored in [kernelY, kernelX, srcC/group, dstC] format.
+        Input image is unsigned 8-bit with scale and zero point: x = srcScale*(q - srcZero). Weights are quantized to signed 8-bit 
+        with a scale per output channel at call of ::SimdConvolution8iSetWeight, products are accumulated in 32-bit integers.
+
+        \param [in] batch - a number of images processed by one call of ::SimdConvolution8iForward. The images are stored one after another.
+        \param [in] srcC - a number of input channels.
+        \param [in] srcH - an input height.
+        \param [in] srcW - an input width.
+        \param [in] dstC - a number of output channels.
+        \param [in] kernelY - a height of the convolution kernel.
+        \param [in] kernelX - a width of the convolution kernel.
+        \param [in] dilationY - a y-dilation of the convolution.
+        \param [in] dilationX - a x-dilation of the convolution.
+        \param [in] strideY - a y-stride of the convolution.
+        \param [in] strideX - a x-stride of the convolution.
+        \param [in] padY - an additional zero padding of input image at the beginning of y-axis.
+        \param [in] padX - an additional zero padding of input image at the beginning of x-axis.
+        \param [in] padH - an additional zero padding of input image at the end of y-axis.
+        \param [in] padW - an additional zero padding of input image at the end of x-axis.
+        \param [in] group - a number of convolution groups.
+        \param [in] activation - an activation function type. Only ::SimdConvolutionActivationIdentity and ::SimdConvolutionActivationRelu are supported.
+        \param [in] dst8u - a type of output image: unsigned 8-bit integers (::SimdTrue) or 32-bit float numbers (::SimdFalse).
+        \return a pointer to quantized convolution context or NULL if the parameters are not supported. 
+            This pointer is used in functions ::SimdConvolution8iBufferSize, ::SimdConvolution8iSetWeight and ::SimdConvolution8iForward.
+            It must be released with using of function ::SimdRelease.
+    */
+    SIMD_API void * SimdConvolution8iInit(size_t batch, size_t srcC, size_t srcH, size_t srcW, size_t dstC, size_t kernelY, size_t kernelX, 
+        size_t dilationY, size_t dilationX, size_t strideY, size_t strideX, size_t padY, size_t padX, size_t padH, size_t padW, size_t group, 
+        SimdConvolutionActivationType activation, SimdBool dst8u);
+
+    /*! @ingroup synet
+
+        \fn size_t SimdConvolution8iBufferSize(const void * convolution);
+
+        \short Gets size in bytes of external temporary buffer required for quantized convolution algorithm.
+
+        \param [in] convolution - a pointer to quantized convolution context. It must be created by function ::SimdConvolution8iInit and released by function ::SimdRelease.
+        \return size of external temporary buffer in bytes.
+    */
+    SIMD_API size_t SimdConvolution8iBufferSize(const void * convolution);
+
+    /*! @ingroup synet
+
+        \fn void SimdConvolution8iSetWeight(void * convolution, const float * weight, const float * bias, float srcScale, uint8_t srcZero, float dstScale, uint8_t dstZero);
+
+        \short Quantizes and sets weights and bias of quantized convolution algorithm.
+
+        Weights are quantized to signed 8-bit integers with a symmetric scale per output channel. Bias and the input zero point are folded 
+        into 32-bit integer bias, so the original arrays can be released after the call.
+
+        \param [in, out] convolution - a pointer to quantized convolution context. It must be created by function ::SimdConvolution8iInit and released by function ::SimdRelease.
+        \param [in] weight - a pointer to 32-bit float convolution weights.
+        \param [in] bias - a pointer to 32-bit float bias. Can be NULL.
+        \param [in] srcScale - a scale of input image.
+        \param [in] srcZero - a zero point of input image. It is also used as value of padding.
+        \param [in] dstScale - a scale of output image. It is used only for unsigned 8-bit output.
+        \param [in] dstZero - a zero point of output image. It is used only for unsigned 8-bit output.
+    */
+    SIMD_API void SimdConvolution8iSetWeight(void * convolution, const float * weight, const float * bias, float srcScale, uint8_t srcZero, float dstScale, uint8_t dstZero);
+
+    /*! @ingroup synet
+
+        \fn void SimdConvolution8iForward(void * convolution, const uint8_t * src, uint8_t * buf, uint8_t * dst);
+
+        \short Performs forward propagation of quantized convolution algorithm.
+
+        \note This function supports multithreading (See functions ::SimdGetThreadNumber and ::SimdSetThreadNumber).
+
+        \param [in] convolution - a pointer to quantized convolution context. It must be created by function ::SimdConvolution8iInit and released by function ::SimdRelease.
+        \param [in] src - a pointer to unsigned 8-bit input images (batch images one after another).
+        \param [out] buf - a pointer to temporary buffer. The size of the temporary buffer is determined by function ::SimdConvolution8iBufferSize. Can be NULL.
+        \param [out] dst - a pointer to output images: unsigned 8-bit or 32-bit float numbers depending on parameter dst8u of ::SimdConvolution8iInit.
+    */
+    SIMD_API void SimdConvolution8iForward(void * convolution, const uint8_t * src, uint8_t * buf, uint8_t * dst);
+
+    /*! @ingroup synet
+
+        \fn void * SimdDeconvolutionInit(SimdBool trans, size_t batch, size_t srcC, size_t srcH, size_t srcW, size_t dstC, size_t kernelY, size_t kernelX, size_t dilationY, size_t dilationX, size_t strideY, size_t strideX, size_t padY, size_t padX, size_t padH, size_t padW, size_t group, SimdConvolutionActivationType activation, const float * activationParams);
+
+        \short Initilizes deconvolution (transposed convolution) algorithm.
+
+        The output size is dstH = strideY*(srcH - 1) + dilationY*(kernelY - 1) + 1 - padY - padH (and the same for dstW).
+
+        \param [in] trans - a flag of transposed (NHWC, channels-last) layout of tensors. 
+            If it is ::SimdFalse then input and output images have CHW layout and weights have layout [srcC, dstC/group, kernelY, kernelX].
+            If it is ::SimdTrue then input and output images have HWC layout (interleaved channels) and weights have layout [kernelY, kernelX, dstC/group, srcC].
+        \param [in] batch - a number of images processed by one call of ::SimdDeconvolutionForward. The images are stored one after another.
+        \param [in] srcC - a number of input channels.
+        \param [in] srcH - an input height.
+        \param [in] srcW - an input width.
+        \param [in] dstC - a number of output channels.
+        \param [in] kernelY - a height of the deconvolution kernel.
+        \param [in] kernelX - a width of the deconvolution kernel.
+        \param [in] dilationY - a y-dilation of the deconvolution.
+        \param [in] dilationX - a x-dilation of the deconvolution.
+        \param [in] strideY - a y-stride of the deconvolution.
+        \param [in] strideX - a x-stride of the deconvolution.
+        \param [in] padY - a pad (crop) to the top of the output image.
+        \param [in] padX - a pad (crop) to the left of the output image.
+        \param [in] padH - a pad (crop) to the bottom of the output image.
+        \param [in] padW - a pad (crop) to the right of the output image.
+        \param [in] group - a size of deconvolution group.
+        \param [in] activation - a type of activation function which is applied to the output (together with bias).
+        \param [in] activationParams - a pointer to parameters of activation function: one slope for ::SimdConvolutionActivationLeakyRelu, 
+            dstC slopes for ::SimdConvolutionActivationPrelu. The parameters are copied into deconvolution context. Can be NULL for other activation types.
+        \return a pointer to deconvolution context. On error it returns NULL. It must be released with using of function ::SimdRelease.
+            This pointer is used in functions ::SimdDeconvolutionBufferSize, ::SimdDeconvolutionSetWeight and ::SimdDeconvolutionForward.
+    */
+    SIMD_API void * SimdDeconvolutionInit(SimdBool trans, size_t batch, size_t srcC, size_t srcH, size_t srcW, size_t dstC, size_t kernelY, size_t kernelX, 
+        size_t dilationY, size_t dilationX, size_t strideY, size_t strideX, size_t padY, size_t padX, size_t padH, size_t padW, size_t group, 
+        SimdConvolutionActivationType activation, const float * activationParams);
+
+    /*! @ingroup synet
+
+        \fn size_t SimdDeconvolutionBufferSize(const void * deconvolution);
+
+        \short Gets size of external buffer (in 32-bit floats) required for deconvolution algorithm.
+
+        \param [in] deconvolution - a pointer to deconvolution context. It must be created by function ::SimdDeconvolutionInit and released by function ::SimdRelease. 
+        \return size of external buffer required for deconvolution algorithm.
+    */
+    SIMD_API size_t SimdDeconvolutionBufferSize(const void * deconvolution);
+
+    /*! @ingroup synet
+
+        \fn void SimdDeconvolutionSetWeight(void * deconvolution, const float * weight, const float * bias);
+
+        \short Sets weights and beases required for deconvolution algorithm.
+
+        The weights are copied (and reordered) into deconvolution context, the bias is used by reference.
+
+        \param [in, out] deconvolution - a pointer to deconvolution context. It must be created by function ::SimdDeconvolutionInit and released by function ::SimdRelease.
+        \param [in] weight - a pointer to deconvolution weights.
+        \param [in] bias - a pointer to bias. Can be NULL.
+    */
+    SIMD_API void SimdDeconvolutionSetWeight(void * deconvolution, const float * weight, const float * bias);
+
+    /*! @ingroup synet
+
+        \fn void SimdDeconvolutionForward(void * deconvolution, const float * src, float * buf, float * dst);
+
+        \short Performs forward propagation of deconvolution algorithm.
+
+        \param [in] deconvolution - a pointer to deconvolution context. It must be created by function ::SimdDeconvolutionInit and released by function ::SimdRelease.
+        \param [in] src - a pointer to input images (batch images one after another).
+        \param [out] buf - a pointer to temporary buffer. The size of the temporary buffer is determined by function ::SimdDeconvolutionBufferSize. Can be NULL.
+        \param [out] dst - a pointer to output images (batch images one after another).
+    */
+    SIMD_API void SimdDeconvolutionForward(void * deconvolution, const float * src, float * buf, float * dst);
+
     /*! @ingroup other_conversion
 
         \fn void SimdDeinterleaveUv(const uint8_t * uv, size_t uvStride, size_t width, size_t height, uint8_t * u, size_t uStride, uint8_t * v, size_t vStride);
@@ -2420,6 +2739,242 @@ extern "C"
     */
     SIMD_API void SimdGemm32fNT(size_t M, size_t N, size_t K, const float * alpha, const float * A, size_t lda, const float * B, size_t ldb, const float * beta, float * C, size_t ldc);
 
+    /*! @ingroup matrix
+
+        \fn void SimdGemm32fTN(size_t M, size_t N, size_t K, const float * alpha, const float * A, size_t lda, const float * B, size_t ldb, const float * beta, float * C, size_t ldc);
+
+        \short Performs general matrix multiplication (for 32-bit float numbers).
+
+        C(M, N) = alpha*Trans(A(K, M))*B(K, N) + beta*C(M, N);
+
+        \note This function supports multithreading (See functions ::SimdGetThreadNumber and ::SimdSetThreadNumber).
+
+        \param [in] M - a width of A and height of C matrices.
+        \param [in] N - a width of B and width of C matrices.
+        \param [in] K - a height of A and height of B matrices.
+        \param [in] alpha - a pointer to multiplier of the first term.
+        \param [in] A - a pointer to input A matrix.
+        \param [in] lda - a leading dimension of A matrix.
+        \param [in] B - a pointer to input B matrix.
+        \param [in] ldb - a leading dimension of B matrix.
+        \param [in] beta - a pointer to multiplier of the second term.
+        \param [out] C - a pointer to output C matrix.
+        \param [in] ldc - a leading dimension of C matrix.
+    */
+    SIMD_API void SimdGemm32fTN(size_t M, size_t N, size_t K, const float * alpha, const float * A, size_t lda, const float * B, size_t ldb, const float * beta, float * C, size_t ldc);
+
+    /*! @ingroup matrix
+
+        \fn void SimdGemm32fTT(size_t M, size_t N, size_t K, const float * alpha, const float * A, size_t lda, const float * B, size_t ldb, const float * beta, float * C, size_t ldc);
+
+        \short Performs general matrix multiplication (for 32-bit float numbers).
+
+        C(M, N) = alpha*Trans(A(K, M))*Trans(B(N, K)) + beta*C(M, N);
+
+        \note This function supports multithreading (See functions ::SimdGetThreadNumber and ::SimdSetThreadNumber).
+
+        \param [in] M - a width of A and height of C matrices.
+        \param [in] N - a height of B and width of C matrices.
+        \param [in] K - a height of A and width of B matrices.
+        \param [in] alpha - a pointer to multiplier of the first term.
+        \param [in] A - a pointer to input A matrix.
+        \param [in] lda - a leading dimension of A matrix.
+        \param [in] B - a pointer to input B matrix.
+        \param [in] ldb - a leading dimension of B matrix.
+        \param [in] beta - a pointer to multiplier of the second term.
+        \param [out] C - a pointer to output C matrix.
+        \param [in] ldc - a leading dimension of C matrix.
+    */
+    SIMD_API void SimdGemm32fTT(size_t M, size_t N, size_t K, const float * alpha, const float * A, size_t lda, const float * B, size_t ldb, const float * beta, float * C, size_t ldc);
+
+    /*! @ingroup matrix
+
+        \fn void * SimdGemm32fInit(SimdBool transA, SimdBool transB, size_t M, size_t N, size_t K);
+
+        \short Creates context of general matrix multiplication (for 32-bit float numbers) with fixed sizes.
+
+        It selects kernels and block sizes and allocates packing buffers once, so repeated calls of ::SimdGemm32fRun 
+        for the same M, N and K do not repeat this work (unlike ::SimdGemm32fNN, ::SimdGemm32fNT, ::SimdGemm32fTN and ::SimdGemm32fTT).
+
+        \note The number of threads is fixed at creation of the context (See functions ::SimdGetThreadNumber and ::SimdSetThreadNumber).
+            The context must not be used in several threads at the same time.
+
+        \param [in] transA - a flag of transposed A matrix: Trans(A) is used instead of A if it is ::SimdTrue.
+        \param [in] transB - a flag of transposed B matrix: Trans(B) is used instead of B if it is ::SimdTrue.
+        \param [in] M - a height of C matrix (and a height of A matrix or its width if A is transposed).
+        \param [in] N - a width of C matrix.
+        \param [in] K - a width of A matrix (or its height if A is transposed).
+        \return a pointer to GEMM context. On error it returns NULL. 
+                This pointer is used in functions ::SimdGemm32fRun. 
+                It must be released with using of function ::SimdRelease.
+    */
+    SIMD_API void * SimdGemm32fInit(SimdBool transA, SimdBool transB, size_t M, size_t N, size_t K);
+
+    /*! @ingroup matrix
+
+        \fn void SimdGemm32fRun(void * gemm, const float * alpha, const float * A, size_t lda, const float * B, size_t ldb, const float * beta, float * C, size_t ldc);
+
+        \short Performs general matrix multiplication (for 32-bit float numbers) with using of GEMM context.
+
+        \param [in, out] gemm - a GEMM context. It must be created by function ::SimdGemm32fInit and released by function ::SimdRelease.
+        \param [in] alpha - a pointer to multiplier of the first term.
+        \param [in] A - a pointer to input A matrix.
+        \param [in] lda - a leading dimension of A matrix.
+        \param [in] B - a pointer to input B matrix.
+        \param [in] ldb - a leading dimension of B matrix.
+        \param [in] beta - a pointer to multiplier of the second term.
+        \param [out] C - a pointer to output C matrix.
+        \param [in] ldc - a leading dimension of C matrix.
+    */
+    SIMD_API void SimdGemm32fRun(void * gemm, const float * alpha, const float * A, size_t lda, const float * B, size_t ldb, const float * beta, float * C, size_t ldc);
+
+    /*! @ingroup matrix
+
+        \fn size_t SimdGemm32fPackedBSize(const void * gemm);
+
+        \short Gets size (in floats) of buffer for B matrix packed with using of function ::SimdGemm32fPackB.
+
+        \param [in] gemm - a GEMM context. It must be created by function ::SimdGemm32fInit and released by function ::SimdRelease.
+        \return size of packed B matrix (in floats).
+    */
+    SIMD_API size_t SimdGemm32fPackedBSize(const void * gemm);
+
+    /*! @ingroup matrix
+
+        \fn void SimdGemm32fPackB(const void * gemm, const float * B, size_t ldb, float * pB);
+
+        \short Packs constant B matrix into internal format of GEMM context.
+
+        Packed B matrix is used in function ::SimdGemm32fRunPackedB. It allows to skip packing of B matrix at every call 
+        (for example, when B matrix contains weights of a neural network layer).
+
+        \param [in] gemm - a GEMM context. It must be created by function ::SimdGemm32fInit and released by function ::SimdRelease.
+        \param [in] B - a pointer to input B matrix.
+        \param [in] ldb - a leading dimension of B matrix.
+        \param [out] pB - a pointer to output packed B matrix. Its size is returned by function ::SimdGemm32fPackedBSize.
+    */
+    SIMD_API void SimdGemm32fPackB(const void * gemm, const float * B, size_t ldb, float * pB);
+
+    /*! @ingroup matrix
+
+        \fn void SimdGemm32fRunPackedB(void * gemm, const float * alpha, const float * A, size_t lda, const float * pB, const float * beta, float * C, size_t ldc);
+
+        \short Performs general matrix multiplication (for 32-bit float numbers) with using of GEMM context and packed B matrix.
+
+        \param [in, out] gemm - a GEMM context. It must be created by function ::SimdGemm32fInit and released by function ::SimdRelease.
+        \param [in] alpha - a pointer to multiplier of the first term.
+        \param [in] A - a pointer to input A matrix.
+        \param [in] lda - a leading dimension of A matrix.
+        \param [in] pB - a pointer to B matrix packed by function ::SimdGemm32fPackB for the same GEMM context.
+        \param [in] beta - a pointer to multiplier of the second term.
+        \param [out] C - a pointer to output C matrix.
+        \param [in] ldc - a leading dimension of C matrix.
+    */
+    SIMD_API void SimdGemm32fRunPackedB(void * gemm, const float * alpha, const float * A, size_t lda, const float * pB, const float * beta, float * C, size_t ldc);
+
+    /*! @ingroup matrix
+
+        \fn void SimdGemm32fRunBatched(void * gemm, size_t batch, const float * alpha, const float * A, size_t lda, size_t strideA, const float * B, size_t ldb, size_t strideB, const float * beta, float * C, size_t ldc, size_t strideC);
+
+        \short Performs a batch of general matrix multiplications (for 32-bit float numbers) with the same sizes with using of GEMM context.
+
+        For every i in [0, batch): C[i] = alpha*A[i]*B[i] + beta*C[i], where A[i] = A + i*strideA, B[i] = B + i*strideB and C[i] = C + i*strideC.
+        The work is distributed between threads across the batch and across columns of C matrices, so it is much faster 
+        than a loop of calls of ::SimdGemm32fRun for small matrices.
+
+        \note A zero stride allows to share the same matrix between all problems of the batch.
+
+        \param [in, out] gemm - a GEMM context. It must be created by function ::SimdGemm32fInit and released by function ::SimdRelease.
+        \param [in] batch - a number of matrix multiplications.
+        \param [in] alpha - a pointer to multiplier of the first term.
+        \param [in] A - a pointer to the first input A matrix.
+        \param [in] lda - a leading dimension of A matrices.
+        \param [in] strideA - a distance (in floats) between neighboring A matrices.
+        \param [in] B - a pointer to the first input B matrix.
+        \param [in] ldb - a leading dimension of B matrices.
+        \param [in] strideB - a distance (in floats) between neighboring B matrices.
+        \param [in] beta - a pointer to multiplier of the second term.
+        \param [out] C - a pointer to the first output C matrix.
+        \param [in] ldc - a leading dimension of C matrices.
+        \param [in] strideC - a distance (in floats) between neighboring C matrices.
+    */
+    SIMD_API void SimdGemm32fRunBatched(void * gemm, size_t batch, const float * alpha, const float * A, size_t lda, size_t strideA, 
+        const float * B, size_t ldb, size_t strideB, const float * beta, float * C, size_t ldc, size_t strideC);
+
+    /*! @ingroup matrix
+
+        \fn void SimdGemm32fRun16(void * gemm, SimdGemmFormatType formatA, const float * alpha, const uint16_t * A, size_t lda, const float * B, size_t ldb, const float * beta, float * C, size_t ldc);
+
+        \short Performs general matrix multiplication with using of GEMM context, where A matrix is stored in 16-bit format.
+
+        A matrix (usually weights) is converted to 32-bit float while it is packed by blocks, so it is read from memory in 16-bit format 
+        and the computations and accumulation are performed in 32-bit float. 
+
+        \param [in, out] gemm - a GEMM context. It must be created by function ::SimdGemm32fInit and released by function ::SimdRelease.
+        \param [in] formatA - a format of A matrix elements (::SimdGemmFormat16f or ::SimdGemmFormat16b).
+        \param [in] alpha - a pointer to multiplier of the first term.
+        \param [in] A - a pointer to input A matrix in 16-bit format.
+        \param [in] lda - a leading dimension of A matrix.
+        \param [in] B - a pointer to input B matrix.
+        \param [in] ldb - a leading dimension of B matrix.
+        \param [in] beta - a pointer to multiplier of the second term.
+        \param [out] C - a pointer to output C matrix.
+        \param [in] ldc - a leading dimension of C matrix.
+    */
+    SIMD_API void SimdGemm32fRun16(void * gemm, SimdGemmFormatType formatA, const float * alpha, const uint16_t * A, size_t lda, 
+        const float * B, size_t ldb, const float * beta, float * C, size_t ldc);
+
+    /*! @ingroup matrix
+
+        \fn void SimdGemm8u8i32iNN(size_t M, size_t N, size_t K, const uint8_t * A, size_t lda, const int8_t * B, size_t ldb, int32_t * C, size_t ldc);
+
+        \short Performs general matrix multiplication of unsigned 8-bit matrix A by signed 8-bit matrix B with 32-bit integer result.
+
+        C(M, N) = A(M, K)*B(K, N);
+
+        Products are accumulated in 32-bit integers without intermediate saturation, so the result is exact for any K < 2^16.
+
+        \note This function supports multithreading (See functions ::SimdGetThreadNumber and ::SimdSetThreadNumber).
+
+        \param [in] M - a height of A and height of C matrices.
+        \param [in] N - a width of B and width of C matrices.
+        \param [in] K - a width of A and height of B matrices.
+        \param [in] A - a pointer to input A matrix (unsigned 8-bit integers).
+        \param [in] lda - a leading dimension of A matrix.
+        \param [in] B - a pointer to input B matrix (signed 8-bit integers).
+        \param [in] ldb - a leading dimension of B matrix.
+        \param [out] C - a pointer to output C matrix (32-bit integers).
+        \param [in] ldc - a leading dimension of C matrix.
+    */
+    SIMD_API void SimdGemm8u8i32iNN(size_t M, size_t N, size_t K, const uint8_t * A, size_t lda, const int8_t * B, size_t ldb, int32_t * C, size_t ldc);
+
+    /*! @ingroup matrix
+
+        \fn void SimdGemm8u8i8uNN(size_t M, size_t N, size_t K, const uint8_t * A, size_t lda, const int8_t * B, size_t ldb, const int32_t * bias, const float * scale, uint8_t zero, uint8_t * C, size_t ldc);
+
+        \short Performs general matrix multiplication of unsigned 8-bit matrix A by signed 8-bit matrix B with requantization of result to unsigned 8-bit.
+
+        For every column j: C(i, j) = Saturate(Round((A(i, :)*B(:, j) + bias[j])*scale[j]) + zero);
+
+        Requantization is fused into the store path of the micro-kernel, so no intermediate 32-bit matrix is written to memory.
+
+        \note This function supports multithreading (See functions ::SimdGetThreadNumber and ::SimdSetThreadNumber).
+
+        \param [in] M - a height of A and height of C matrices.
+        \param [in] N - a width of B and width of C matrices.
+        \param [in] K - a width of A and height of B matrices.
+        \param [in] A - a pointer to input A matrix (unsigned 8-bit integers).
+        \param [in] lda - a leading dimension of A matrix.
+        \param [in] B - a pointer to input B matrix (signed 8-bit integers).
+        \param [in] ldb - a leading dimension of B matrix.
+        \param [in] bias - a pointer to 32-bit integer bias (N values). Can be NULL.
+        \param [in] scale - a pointer to requantization scale (N values).
+        \param [in] zero - a zero point of output.
+        \param [out] C - a pointer to output C matrix (unsigned 8-bit integers).
+        \param [in] ldc - a leading dimension of C matrix.
+    */
+    SIMD_API void SimdGemm8u8i8uNN(size_t M, size_t N, size_t K, const uint8_t * A, size_t lda, const int8_t * B, size_t ldb, const int32_t * bias, const float * scale, uint8_t zero, uint8_t * C, size_t ldc);
+
     /*! @ingroup gray_conversion
 
         \fn void SimdGrayToBgr(const uint8_t * gray, size_t width, size_t height, size_t grayStride, uint8_t * bgr, size_t bgrStride);
@@ -5229,6 +5784,69 @@ extern "C"
     */
     SIMD_API void SimdSynetEltwiseLayerForward(float const * const * src, const float * weight, size_t count, size_t size, SimdSynetEltwiseOperationType type, float * dst);
 
+    /*! @ingroup synet
+
+        \fn void SimdSynetElu32f(const float * src, size_t size, const float * alpha, float * dst);
+
+        \short This function is used for forward propagation of EluLayer (ELU activation function).
+
+        Algorithm's details:
+        \verbatim
+        for(i = 0; i < size; ++i)
+            dst[i] = src[i] >= 0 ? src[i] : alpha*(exp(src[i]) - 1);
+        \endverbatim
+
+        \note This function is used in <a href="http://github.com/ermig1979/Synet">Synet Framework</a>.
+
+        \param [in] src - a pointer to the input 32-bit float array.
+        \param [in] size - a size of input and output arrays.
+        \param [in] alpha - a pointer to alpha parameter.
+        \param [out] dst - a pointer to the output 32-bit float array.
+    */
+    SIMD_API void SimdSynetElu32f(const float * src, size_t size, const float * alpha, float * dst);
+
+    /*! @ingroup synet
+
+        \fn void SimdSynetGelu32f(const float * src, size_t size, float * dst);
+
+        \short This function is used for forward propagation of GeluLayer (GELU activation function, tanh approximation).
+
+        Algorithm's details:
+        \verbatim
+        for(i = 0; i < size; ++i)
+            dst[i] = 0.5*src[i]*(1 + tanh(sqrt(2/pi)*(src[i] + 0.044715*src[i]^3)));
+        \endverbatim
+
+        \note This function is used in <a href="http://github.com/ermig1979/Synet">Synet Framework</a>.
+
+        \param [in] src - a pointer to the input 32-bit float array.
+        \param [in] size - a size of input and output arrays.
+        \param [out] dst - a pointer to the output 32-bit float array.
+    */
+    SIMD_API void SimdSynetGelu32f(const float * src, size_t size, float * dst);
+
+    /*! @ingroup synet
+
+        \fn void SimdSynetHswish32f(const float * src, size_t size, const float * shift, const float * scale, float * dst);
+
+        \short This function is used for forward propagation of HswishLayer (H-swish activation function).
+
+        Algorithm's details:
+        \verbatim
+        for(i = 0; i < size; ++i)
+            dst[i] = max(min(src[i], shift) + shift, 0)*scale*src[i];
+        \endverbatim
+
+        \note This function is used in <a href="http://github.com/ermig1979/Synet">Synet Framework</a>.
+
+        \param [in] src - a pointer to the input 32-bit float array.
+        \param [in] size - a size of input and output arrays.
+        \param [in] shift - a pointer to shift parameter. It is equal to 3 in original paper.
+        \param [in] scale - a pointer to scale parameter. It is equal to 1/6 in original paper.
+        \param [out] dst - a pointer to the output 32-bit float array.
+    */
+    SIMD_API void SimdSynetHswish32f(const float * src, size_t size, const float * shift, const float * scale, float * dst);
+
     /*! @ingroup synet
 
         \fn void SimdSynetLrnLayerCrossChannels(const float * src, size_t half, size_t count, size_t size, const float * k, float * dst);
@@ -5284,6 +5902,80 @@ extern "C"
     */
     SIMD_API void SimdSynetScaleLayerForward(const float * src, const float * scale, const float * bias, size_t count, size_t size, float * dst);
 
+    /*! @ingroup synet
+
+        \fn void SimdSynetSigmoid32f(const float * src, size_t size, float * dst);
+
+        \short This function is used for forward propagation of SigmoidLayer.
+
+        Algorithm's details:
+        \verbatim
+        for(i = 0; i < size; ++i)
+            dst[i] = 1/(1 + exp(-src[i]));
+        \endverbatim
+
+        \note This function is used in <a href="http://github.com/ermig1979/Synet">Synet Framework</a>.
+
+        \param [in] src - a pointer to the input 32-bit float array.
+        \param [in] size - a size of input and output arrays.
+        \param [out] dst - a pointer to the output 32-bit float array.
+    */
+    SIMD_API void SimdSynetSigmoid32f(const float * src, size_t size, float * dst);
+
+    /*! @ingroup synet
+
+        \fn void SimdSynetSoftmaxLayerForward(const float * src, size_t outer, size_t count, size_t inner, float * dst);
+
+        \short This function is used for forward propagation of SoftmaxLayer.
+
+        The softmax is computed along the axis of size count. For tensor in CHW format outer is a batch size and inner is equal to H*W.
+        For tensor in HWC format outer is equal to N*H*W and inner is equal to 1.
+
+        Algorithm's details:
+        \verbatim
+        for(o = 0; o < outer; ++o)
+            for(j = 0; j < inner; ++j)
+            {
+                max = src[(o*count + 0)*inner + j], sum = 0;
+                for(c = 1; c < count; ++c)
+                    max = Max(max, src[(o*count + c)*inner + j]);
+                for(c = 0; c < count; ++c)
+                    sum += dst[(o*count + c)*inner + j] = exp(src[(o*count + c)*inner + j] - max);
+                for(c = 0; c < count; ++c)
+                    dst[(o*count + c)*inner + j] /= sum;
+            }
+        \endverbatim
+
+        \note This function is used in <a href="http://github.com/ermig1979/Synet">Synet Framework</a>.
+
+        \param [in] src - a pointer to the input 32-bit float array. The size of the array must be equal to outer*count*inner.
+        \param [in] outer - an outer size of the operation.
+        \param [in] count - a size of softmax axis.
+        \param [in] inner - an inner size of the operation.
+        \param [out] dst - a pointer to the output 32-bit float array. The size of the array must be equal to outer*count*inner.
+    */
+    SIMD_API void SimdSynetSoftmaxLayerForward(const float * src, size_t outer, size_t count, size_t inner, float * dst);
+
+    /*! @ingroup synet
+
+        \fn void SimdSynetTanh32f(const float * src, size_t size, float * dst);
+
+        \short This function is used for forward propagation of TanhLayer.
+
+        Algorithm's details:
+        \verbatim
+        for(i = 0; i < size; ++i)
+            dst[i] = tanh(src[i]);
+        \endverbatim
+
+        \note This function is used in <a href="http://github.com/ermig1979/Synet">Synet Framework</a>.
+
+        \param [in] src - a pointer to the input 32-bit float array.
+        \param [in] size - a size of input and output arrays.
+        \param [out] dst - a pointer to the output 32-bit float array.
+    */
+    SIMD_API void SimdSynetTanh32f(const float * src, size_t size, float * dst);
+
     /*! @ingroup texture_estimation
 
         \fn void SimdTextureBoostedSaturatedGradient(const uint8_t * src, size_t srcStride, size_t width, size_t height, uint8_t saturation, uint8_t boost, uint8_t * dx, size_t dxStride, uint8_t * dy, size_t dyStride);
@@ -32,6 +32,20 @@
 #include <numeric>
 #include <random>
 #include <iterator>
+#include <fstream>
+#include <atomic>
+
+#if defined(__linux__) || defined(__APPLE__) || defined(__unix__)
+#define SIMD_NEURAL_MMAP_ENABLE
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#include <xmmintrin.h>
+#endif
 
 #ifndef SIMD_CHECK_PERFORMANCE
 #define SIMD_CHECK_PERFORMANCE()
@@ -96,6 +110,105 @@ namespace Simd
                         throw std::runtime_error("Float overflow!");
                 }
             }
+
+            const uint32_t BINARY_MAGIC = 0x424E4E53; // "SNNB"
+            const uint32_t BINARY_VERSION = 1;
+            const size_t BINARY_ALIGNMENT = 64;
+
+            class Mapping
+            {
+            public:
+                Mapping()
+                    : _data(0)
+                    , _size(0)
+#ifndef SIMD_NEURAL_MMAP_ENABLE
+                    , _buffer(0)
+#endif
+                {
+                }
+
+                ~Mapping()
+                {
+#ifdef SIMD_NEURAL_MMAP_ENABLE
+                    if (_data)
+                        ::munmap((void*)_data, _size);
+#else
+                    if (_buffer)
+                        Allocator<uint8_t>::Free(_buffer);
+#endif
+                }
+
+                bool Open(const std::string & path)
+                {
+#ifdef SIMD_NEURAL_MMAP_ENABLE
+                    int file = ::open(path.c_str(), O_RDONLY);
+                    if (file == -1)
+                        return false;
+                    struct stat info;
+                    if (::fstat(file, &info) == 0 && info.st_size > 0)
+                    {
+                        void * data = ::mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_SHARED, file, 0);
+                        if (data != MAP_FAILED)
+                        {
+                            _data = (const uint8_t*)data;
+                            _size = (size_t)info.st_size;
+                        }
+                    }
+                    ::close(file);
+#else
+                    std::ifstream ifs(path.c_str(), std::ios::binary);
+                    if (ifs.is_open())
+                    {
+                        ifs.seekg(0, std::ios::end);
+                        size_t size = (size_t)ifs.tellg();
+                        ifs.seekg(0, std::ios::beg);
+                        _buffer = (uint8_t*)Allocator<uint8_t>::Allocate(size, BINARY_ALIGNMENT);
+                        if (ifs.read((char*)_buffer, size))
+                        {
+                            _data = _buffer;
+                            _size = size;
+                        }
+                    }
+#endif
+                    return _data != 0;
+                }
+
+                SIMD_INLINE const uint8_t * Data() const
+                {
+                    return _data;
+                }
+
+                SIMD_INLINE size_t Size() const
+                {
+                    return _size;
+                }
+
+            private:
+                const uint8_t * _data;
+                size_t _size;
+#ifndef SIMD_NEURAL_MMAP_ENABLE
+                uint8_t * _buffer;
+#endif
+                Mapping(const Mapping &);
+                Mapping & operator = (const Mapping &);
+            };
+            typedef std::shared_ptr<Mapping> MappingPtr;
+
+            struct BinaryHeader
+            {
+                uint32_t magic, version, count, alignment;
+            };
+
+            struct BinaryLayer
+            {
+                uint32_t type, function, src, dst;
+                uint64_t weightOffset, weightSize, biasOffset, biasSize;
+            };
+
+            SIMD_INLINE bool BinaryInside(uint64_t offset, uint64_t size, size_t total)
+            {
+                return offset % BINARY_ALIGNMENT == 0 && offset <= total && size <= total - offset;
+            }
         }
 
         /*! @ingroup cpp_neural
@@ -507,6 +620,27 @@ namespace Simd
 
             virtual void Backward(const Vector & src, size_t thread) = 0;
 
+            /*!
+                Forward propagation of a batch of samples (in Layer::Fast mode).
+                The samples are stored in src one after another, the results are stored in the same way in BatchDst().
+                By default every sample is processed separately with using of Forward().
+            */
+            virtual void ForwardBatch(const Vector & src, size_t count, size_t threads)
+            {
+                size_t srcSize = _src.Volume(), dstSize = _dst.Volume();
+                _batchDst.resize(count*dstSize);
+                Parallel(0, count, [&](size_t thread, size_t begin, size_t end)
+                {
+                    Vector sample(srcSize);
+                    for (size_t i = begin; i < end; ++i)
+                    {
+                        memcpy(sample.data(), src.data() + i*srcSize, srcSize * sizeof(float));
+                        Forward(sample, thread, Fast);
+                        memcpy(_batchDst.data() + i*dstSize, Dst(thread).data(), dstSize * sizeof(float));
+                    }
+                }, threads);
+            }
+
             virtual size_t FanSrc() const = 0;
 
             virtual size_t FanDst() const = 0;
@@ -538,6 +672,8 @@ namespace Simd
                 , _function(f)
                 , _prev(0)
                 , _next(0)
+                , _shared(0)
+                , _sharedSize(0)
             {
             }
 
@@ -563,6 +699,61 @@ namespace Simd
                 return _common[thread].prevDelta;
             }
 
+            virtual void Invalidate()
+            {
+            }
+
+            SIMD_INLINE const float * Weight() const
+            {
+                return _shared ? _shared : _weight.data();
+            }
+
+            SIMD_INLINE size_t WeightSize() const
+            {
+                return _shared ? _sharedSize : _weight.size();
+            }
+
+            virtual void Share(const float * weight, size_t size)
+            {
+                Vector().swap(_weight);
+                _shared = weight;
+                _sharedSize = size;
+                Invalidate();
+            }
+
+            virtual const float * OriginalWeight(Vector & buffer) const
+            {
+                return Weight();
+            }
+
+            virtual const float * FastWeight(Vector & buffer) const
+            {
+                return Weight();
+            }
+
+            virtual void Unshare()
+            {
+                if (_shared)
+                {
+                    _weight.assign(_shared, _shared + _sharedSize);
+                    _shared = 0;
+                    _sharedSize = 0;
+                    Invalidate();
+                }
+            }
+
+            SIMD_INLINE const Vector & BatchDst() const
+            {
+                return _batchDst;
+            }
+
+            void ActivateBatch(size_t begin, size_t end)
+            {
+                size_t size = _dst.Volume();
+                for (size_t i = begin; i < end; ++i)
+                    _function.function(_batchDst.data() + i*size, size, _batchDst.data() + i*size);
+            }
+
             const Type _type;
             const Function _function;
 
@@ -570,6 +761,10 @@ namespace Simd
 
             Index _src, _dst;
             Vector _weight, _bias, _gWeight, _gBias;
+            Vector _batchDst;
+
+            const float * _shared;
+            size_t _sharedSize;
 
             struct Common
             {
@@ -658,6 +853,8 @@ namespace Simd
                 , _functionForward(0)
                 , _functionBackward(0)
                 , _functionSum(0)
+                , _convolution(NULL)
+                , _actual(false)
             {
                 _valid = valid;
                 _indent = coreSize / 2;
@@ -704,8 +901,16 @@ namespace Simd
                 }
             }
 
+            ~ConvolutionalLayer()
+            {
+                if (_convolution)
+                    ::SimdRelease(_convolution);
+            }
+
             void Forward(const Vector & src, size_t thread, Method method) override
             {
+                if (method == Layer::Fast && !_partial && ForwardFast(src, thread))
+                    return;
                 const Vector & padded = PaddedSrc(src, thread);
                 Vector & sum = _common[thread].sum;
                 Vector & dst = _common[thread].dst;
@@ -719,7 +924,7 @@ namespace Simd
                             if (!_connection.At<bool>(dc, sc))
                                 return;
 
-                            const float * pweight = _core.Get(_weight, 0, 0, _src.depth*dc + sc);
+                            const float * pweight = Weight() + _core.Offset(0, 0, _src.depth*dc + sc);
                             const float * psrc = _padded.Get(padded, 0, 0, sc);
                             float * psum = _dst.Get(sum, 0, 0, dc);
 
@@ -750,7 +955,7 @@ namespace Simd
                 {
                     Buffer & buffer = _specific[thread].buffer;
                     size_t size = buffer.size();
-                    ::SimdNeuralConvolutionForward(padded.data(), _padded.width, _padded.height, _padded.depth, _weight.data(),
+                    ::SimdNeuralConvolutionForward(padded.data(), _padded.width, _padded.height, _padded.depth, Weight(),
                         _core.width, _core.height, 0, 0, 1, 1, 1, 1, buffer.data(), &size, sum.data(), _dst.width, _dst.height, _dst.depth, 0);
                     if (size > buffer.size())
                         buffer.resize(size);
@@ -763,6 +968,40 @@ namespace Simd
                 _function.function(sum.data(), sum.size(), dst.data());
             }
 
+            void ForwardBatch(const Vector & src, size_t count, size_t threads) override
+            {
+                if (_partial)
+                {
+                    Layer::ForwardBatch(src, count, threads);
+                    return;
+                }
+                size_t srcSize = _src.Volume(), dstSize = _dst.Volume(), area = _dst.Area();
+                size_t K = _core.Volume() / _dst.depth, block = std::max<size_t>(1, std::min<size_t>(count, 65536 / (K*area)));
+                _batchDst.resize(count*dstSize);
+                Parallel(0, count, [&](size_t thread, size_t begin, size_t end)
+                {
+                    Vector col(K*block*area), sum(_dst.depth*block*area);
+                    const float alpha = 1.0f, beta = 0.0f;
+                    for (size_t b = begin; b < end; b += block)
+                    {
+                        size_t n = std::min(block, end - b), N = n*area;
+                        ImgToCol(src.data() + b*srcSize, n, col.data());
+                        ::SimdGemm32fNN(_dst.depth, N, K, &alpha, Weight(), K, col.data(), N, &beta, sum.data(), N);
+                        for (size_t s = 0; s < n; ++s)
+                        {
+                            for (ptrdiff_t dc = 0; dc < _dst.depth; ++dc)
+                            {
+                                float * pdst = _batchDst.data() + (b + s)*dstSize + dc*area;
+                                memcpy(pdst, sum.data() + dc*N + s*area, area * sizeof(float));
+                                if (_bias.size())
+                                    ::SimdNeuralAddValue(_bias.data() + dc, pdst, area);
+                            }
+                        }
+                        ActivateBatch(b, b + n);
+                    }
+                }, threads);
+            }
+
             void Backward(const Vector & currDelta, size_t thread) override
             {
                 const Vector & prevDst = _valid ? _prev->Dst(thread) : _specific[thread].paddedSrc;
@@ -881,8 +1120,62 @@ namespace Simd
                 }
             }
 
+            void Invalidate() override
+            {
+                _actual.store(false, std::memory_order_release);
+            }
+
         private:
 
+            void * Convolution()
+            {
+                if (!_actual.load(std::memory_order_acquire))
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    if (!_actual.load(std::memory_order_relaxed))
+                    {
+                        if (_convolution == NULL)
+                        {
+                            ptrdiff_t padY = _valid ? 0 : _indent.y, padX = _valid ? 0 : _indent.x;
+                            ptrdiff_t padH = _valid ? 0 : _core.height - 1 - padY, padW = _valid ? 0 : _core.width - 1 - padX;
+                            SimdConvolutionActivationType activation = SimdConvolutionActivationIdentity;
+                            float slope = 0.01f;
+                            if (_function.type == Function::Relu)
+                                activation = SimdConvolutionActivationRelu;
+                            if (_function.type == Function::LeakyRelu)
+                                activation = SimdConvolutionActivationLeakyRelu;
+                            _convolution = ::SimdConvolutionInit(SimdFalse, 1, _src.depth, _src.height, _src.width, _dst.depth, 
+                                _core.height, _core.width, 1, 1, 1, 1, padY, padX, padH, padW, 1, activation, &slope);
+                        }
+                        if (_convolution)
+                            ::SimdConvolutionSetWeight(_convolution, Weight(), _bias.size() ? _bias.data() : NULL);
+                        _actual.store(true, std::memory_order_release);
+                    }
+                }
+                return _convolution;
+            }
+
+            bool ForwardFast(const Vector & src, size_t thread)
+            {
+                void * convolution = Convolution();
+                if (convolution == NULL)
+                    return false;
+                Vector & sum = _common[thread].sum;
+                Vector & dst = _common[thread].dst;
+                Buffer & buffer = _specific[thread].buffer;
+                size_t size = ::SimdConvolutionBufferSize(convolution) * sizeof(float);
+                if (buffer.size() < size)
+                    buffer.resize(size);
+                if (_function.type == Function::Relu || _function.type == Function::LeakyRelu)
+                    ::SimdConvolutionForward(convolution, src.data(), (float*)buffer.data(), dst.data());
+                else
+                {
+                    ::SimdConvolutionForward(convolution, src.data(), (float*)buffer.data(), sum.data());
+                    _function.function(sum.data(), sum.size(), dst.data());
+                }
+                return true;
+            }
+
             const Vector & PaddedSrc(const Vector & src, size_t thread)
             {
                 if (_valid)
@@ -914,6 +1207,41 @@ namespace Simd
                 }
             }
 
+            void ImgToCol(const float * src, size_t count, float * dst)
+            {
+                size_t srcSize = _src.Volume(), area = _dst.Area(), N = count*area;
+                ptrdiff_t indentY = _valid ? 0 : _indent.y, indentX = _valid ? 0 : _indent.x;
+                for (ptrdiff_t sc = 0; sc < _src.depth; ++sc)
+                {
+                    for (ptrdiff_t ky = 0; ky < _core.height; ++ky)
+                    {
+                        for (ptrdiff_t kx = 0; kx < _core.width; ++kx)
+                        {
+                            float * pd = dst + ((sc*_core.height + ky)*_core.width + kx)*N;
+                            for (size_t s = 0; s < count; ++s)
+                            {
+                                const float * ps = src + s*srcSize + sc*_src.Area();
+                                for (ptrdiff_t y = 0; y < _dst.height; ++y)
+                                {
+                                    ptrdiff_t sy = y + ky - indentY;
+                                    if (sy < 0 || sy >= _src.height)
+                                    {
+                                        memset(pd, 0, _dst.width * sizeof(float));
+                                        pd += _dst.width;
+                                        continue;
+                                    }
+                                    for (ptrdiff_t x = 0; x < _dst.width; ++x)
+                                    {
+                                        ptrdiff_t sx = x + kx - indentX;
+                                        *pd++ = (sx < 0 || sx >= _src.width) ? 0.0f : ps[sy*_src.width + sx];
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+
             struct Specific
             {
                 Vector paddedSrc, paddedDelta;
@@ -936,6 +1264,10 @@ namespace Simd
 
             typedef void(*FunctionSumPtr)(const float * src, size_t srcStride, const float * dst, size_t dstStride, size_t width, size_t height, float * sums);
             FunctionSumPtr _functionSum;
+
+            void * _convolution;
+            std::atomic<bool> _actual;
+            std::mutex _mutex;
         };
 
         /*! @ingroup cpp_neural
@@ -1209,27 +1541,24 @@ namespace Simd
                 Vector & sum = _common[thread].sum;
                 Vector & dst = _common[thread].dst;
 
-                if (method == Layer::Fast)
+                if (method == Layer::Fast && !_reordered.load(std::memory_order_acquire))
                 {
-                    if (!_reordered)
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    if (!_reordered.load(std::memory_order_relaxed))
                     {
-                        std::lock_guard<std::mutex> lock(_mutex);
-                        if (!_reordered)
-                        {
-                            Vector buffer(_weight.size());
-                            for (ptrdiff_t i = 0; i < _dst.width; ++i)
-                                for (ptrdiff_t j = 0; j < _src.width; ++j)
-                                    buffer[i*_src.width + j] = _weight[j*_dst.width + i];
-                            _weight.swap(buffer);
-                            _reordered = true;                        
-                        }
+                        Vector buffer(_weight.size());
+                        Transpose(_weight.data(), _src.width, _dst.width, buffer.data());
+                        _weight.swap(buffer);
+                        _reordered.store(true, std::memory_order_release);
                     }
+                }
+                if (_reordered.load(std::memory_order_acquire))
+                {
                     for (size_t i = 0; i < sum.size(); ++i)
-                        ::SimdNeuralProductSum(src.data(), &_weight[i*_src.width], src.size(), &sum[i]);
+                        ::SimdNeuralProductSum(src.data(), Weight() + i*_src.width, src.size(), &sum[i]);
                 }
                 else
                 {
-                    assert(!_reordered);
                     Detail::SetZero(sum);
                     for (size_t i = 0; i < src.size(); i++)
                         ::SimdNeuralAddVectorMultipliedByValue(&_weight[i*_dst.width], sum.size(), &src[i], sum.data());
@@ -1240,6 +1569,26 @@ namespace Simd
                 _function.function(sum.data(), sum.size(), dst.data());
             }
 
+            void ForwardBatch(const Vector & src, size_t count, size_t threads) override
+            {
+                size_t M = count, N = _dst.width, K = _src.width;
+                _batchDst.resize(M*N);
+                Parallel(0, M, [&](size_t thread, size_t begin, size_t end)
+                {
+                    const float alpha = 1.0f, beta = 0.0f;
+                    if (_reordered)
+                        ::SimdGemm32fNT(end - begin, N, K, &alpha, src.data() + begin*K, K, Weight(), K, &beta, _batchDst.data() + begin*N, N);
+                    else
+                        ::SimdGemm32fNN(end - begin, N, K, &alpha, src.data() + begin*K, K, Weight(), N, &beta, _batchDst.data() + begin*N, N);
+                    if (_bias.size())
+                    {
+                        for (size_t i = begin; i < end; ++i)
+                            ::SimdNeuralAddVector(_bias.data(), N, _batchDst.data() + i*N);
+                    }
+                    ActivateBatch(begin, end);
+                }, threads);
+            }
+
             void Backward(const Vector & currDelta, size_t thread) override
             {
                 const Vector & prevDst = _prev->Dst(thread);
@@ -1269,9 +1618,54 @@ namespace Simd
                 return _dst.width;
             }
 
+            const float * OriginalWeight(Vector & buffer) const override
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                if (!_reordered)
+                    return Weight();
+                buffer.resize(WeightSize());
+                Transpose(Weight(), _dst.width, _src.width, buffer.data());
+                return buffer.data();
+            }
+
+            const float * FastWeight(Vector & buffer) const override
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                if (_reordered)
+                    return Weight();
+                buffer.resize(WeightSize());
+                Transpose(Weight(), _src.width, _dst.width, buffer.data());
+                return buffer.data();
+            }
+
+            void Share(const float * weight, size_t size) override
+            {
+                Layer::Share(weight, size);
+                _reordered = true;
+            }
+
+            void Unshare() override
+            {
+                Layer::Unshare();
+                if (_reordered)
+                {
+                    Vector buffer(_weight.size());
+                    Transpose(_weight.data(), _dst.width, _src.width, buffer.data());
+                    _weight.swap(buffer);
+                    _reordered = false;
+                }
+            }
+
         protected:
-            bool _reordered;
-            std::mutex _mutex;
+            std::atomic<bool> _reordered;
+            mutable std::mutex _mutex;
+
+            static void Transpose(const float * src, size_t rows, size_t cols, float * dst)
+            {
+                for (size_t r = 0; r < rows; ++r)
+                    for (size_t c = 0; c < cols; ++c)
+                        dst[c*rows + r] = src[r*cols + c];
+            }
         };
 
         /*! @ingroup cpp_neural
@@ -1315,6 +1709,11 @@ namespace Simd
                     dst = src;
             }
 
+            void ForwardBatch(const Vector & src, size_t count, size_t threads) override
+            {
+                _batchDst.assign(src.begin(), src.begin() + count*_src.Volume());
+            }
+
             void Backward(const Vector & currDelta, size_t thread) override
             {
                 const Vector & prevDst = _prev->Dst(thread);
@@ -1488,11 +1887,22 @@ namespace Simd
                     delta[i] = -control[i] / current[i];
             }
 
-            template<TrainOptions::UpdateType type> void UpdateWeight(const TrainOptions & o, const Vector & d, Vector & g, Vector & v);
+            template<TrainOptions::UpdateType type> void UpdateWeight(const TrainOptions & o, const float * d, size_t size, float * g, float * v);
 
-            template<> SIMD_INLINE void UpdateWeight<TrainOptions::AdaptiveGradient>(const TrainOptions & o, const Vector & d, Vector & g, Vector & v)
+            template<> SIMD_INLINE void UpdateWeight<TrainOptions::AdaptiveGradient>(const TrainOptions & o, const float * d, size_t size, float * g, float * v)
             {
-                ::SimdNeuralAdaptiveGradientUpdate(d.data(), d.size(), o.batchSize, &o.alpha, &o.epsilon, g.data(), v.data());
+                ::SimdNeuralAdaptiveGradientUpdate(d, size, o.batchSize, &o.alpha, &o.epsilon, g, v);
+            }
+
+            SIMD_INLINE void Prefetch(const Vector & vector)
+            {
+#if defined(__GNUC__)
+                for (size_t i = 0; i < vector.size(); i += 64 / sizeof(float))
+                    __builtin_prefetch(vector.data() + i);
+#elif defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+                for (size_t i = 0; i < vector.size(); i += 64 / sizeof(float))
+                    _mm_prefetch((const char*)(vector.data() + i), _MM_HINT_T0);
+#endif
             }
         }
 
@@ -1520,6 +1930,7 @@ namespace Simd
             void Clear()
             {
                 _layers.clear();
+                _mapping.reset();
             }
 
             /*!
@@ -1605,10 +2016,15 @@ namespace Simd
                 if (src.size() != dst.size())
                     return false;
 
+                Unshare();
+
                 options.threadNumber = std::max<size_t>(1, std::min<size_t>(options.threadNumber, std::thread::hardware_concurrency()));
 
                 for (size_t i = 0; i < _layers.size(); ++i)
                     _layers[i]->SetThreadNumber(options.threadNumber, true);
+                _delta.resize(options.threadNumber);
+                for (size_t i = 0; i < _delta.size(); ++i)
+                    _delta[i].resize(OutputIndex().Volume());
 
                 if (options.epochStart == 0)
                     InitWeight(options);
@@ -1616,11 +2032,11 @@ namespace Simd
                 Labels index(src.size());
                 for (size_t i = 0; i < index.size(); ++i)
                     index[i] = i;
-                if (options.shuffle)
-                    std::random_shuffle(index.begin(), index.end());
 
                 for (size_t epoch = options.epochStart; epoch < options.epochFinish; ++epoch)
                 {
+                    if (options.shuffle)
+                        std::random_shuffle(index.begin(), index.end());
                     for (size_t i = 0; i < src.size(); i += options.batchSize)
                     {
                         Propagate(src, dst, index, i, std::min(i + options.batchSize, src.size()), options);
@@ -1659,6 +2075,39 @@ namespace Simd
                 return Forward(x, thread, method);
             }
 
+            /*!
+                \short Classifies given set of samples.
+
+                Every layer processes the whole batch at once: convolutional and fully connected layers are computed
+                with using of ::SimdGemm32fNN, the batch is split between threads (See functions ::SimdGetThreadNumber and ::SimdSetThreadNumber).
+
+                \note This method is not thread-safe.
+
+                \param [in] batch - a set of input samples.
+                \param [out] out - a set of results of classification (vectors with predicted probabilities).
+            */
+            void Predict(const Vectors & batch, Vectors & out)
+            {
+                SIMD_CHECK_PERFORMANCE();
+
+                size_t count = batch.size(), srcSize = InputIndex().Volume(), dstSize = OutputIndex().Volume();
+                size_t threads = std::max<size_t>(1, std::min<size_t>(count, ::SimdGetThreadNumber()));
+                Vector & src = _layers.front()->_batchDst;
+                src.resize(count*srcSize);
+                for (size_t i = 0; i < count; ++i)
+                    memcpy(src.data() + i*srcSize, batch[i].data(), srcSize * sizeof(float));
+                for (size_t i = 1; i < _layers.size(); ++i)
+                {
+                    if (_layers[i]->_common.size() < threads)
+                        _layers[i]->SetThreadNumber(threads, false);
+                    _layers[i]->ForwardBatch(_layers[i - 1]->BatchDst(), count, threads);
+                }
+                const Vector & dst = _layers.back()->BatchDst();
+                out.resize(count);
+                for (size_t i = 0; i < count; ++i)
+                    out[i].assign(dst.begin() + i*dstSize, dst.begin() + (i + 1)*dstSize);
+            }
+
             /*!
                 \short Loads the weights of neural network from an external buffer.
 
@@ -1671,6 +2120,7 @@ namespace Simd
             */
             bool Load(const void * data, size_t size, bool train = false)
             {
+                Unshare();
                 if (Requred(train) > size)
                     return false;
                 typedef  Vector::value_type Type;
@@ -1687,6 +2137,7 @@ namespace Simd
                     ptr += layer._weight.size();
                     memcpy(layer._bias.data(), ptr, layer._bias.size() * sizeof(Type));
                     ptr += layer._bias.size();
+                    layer.Invalidate();
                 }
                 if (train)
                 {
@@ -1715,6 +2166,7 @@ namespace Simd
             {
                 SIMD_CHECK_PERFORMANCE();
 
+                Unshare();
                 if (train)
                 {
                     for (size_t i = 0; i < _layers.size(); ++i)
@@ -1727,6 +2179,7 @@ namespace Simd
                         Load(is, layer._weight[j]);
                     for (size_t j = 0; j < layer._bias.size(); ++j)
                         Load(is, layer._bias[j]);
+                    layer.Invalidate();
                 }
                 if (train)
                 {
@@ -1787,8 +2240,9 @@ namespace Simd
                 for (size_t i = 0; i < _layers.size(); ++i)
                 {
                     const Layer & layer = *_layers[i];
-                    memcpy(ptr, layer._weight.data(), layer._weight.size() * sizeof(Type));
-                    ptr += layer._weight.size();
+                    Vector buffer;
+                    memcpy(ptr, layer.OriginalWeight(buffer), layer.WeightSize() * sizeof(Type));
+                    ptr += layer.WeightSize();
                     memcpy(ptr, layer._bias.data(), layer._bias.size() * sizeof(Type));
                     ptr += layer._bias.size();
                 }
@@ -1818,8 +2272,10 @@ namespace Simd
                 for (size_t i = 0; i < _layers.size(); ++i)
                 {
                     const Layer & layer = *_layers[i];
-                    for (size_t j = 0; j < layer._weight.size(); ++j)
-                        os << layer._weight[j] << " ";
+                    Vector buffer;
+                    const float * weight = layer.OriginalWeight(buffer);
+                    for (size_t j = 0, n = layer.WeightSize(); j < n; ++j)
+                        os << weight[j] << " ";
                     for (size_t j = 0; j < layer._bias.size(); ++j)
                         os << layer._bias[j] << " ";
                 }
@@ -1857,6 +2313,108 @@ namespace Simd
                 return false;
             }
 
+            /*!
+                \short Saves the weights of neural network to versioned binary file.
+
+                The weights are stored in the layout used by Layer::Fast prediction (weights of fully connected layers are transposed), 
+                every block of weights is aligned, so the file can be loaded with using of LoadBinary without any conversion.
+
+                \param [in] path - a path to output file.
+                \return a result of saving.
+            */
+            bool SaveBinary(const std::string & path) const
+            {
+                Detail::BinaryHeader header = { Detail::BINARY_MAGIC, Detail::BINARY_VERSION, (uint32_t)_layers.size(), (uint32_t)Detail::BINARY_ALIGNMENT };
+                std::vector<Detail::BinaryLayer> layers(_layers.size());
+                size_t offset = BinaryAlign(sizeof(header) + layers.size() * sizeof(Detail::BinaryLayer));
+                for (size_t i = 0; i < _layers.size(); ++i)
+                {
+                    const Layer & layer = *_layers[i];
+                    Detail::BinaryLayer & binary = layers[i];
+                    binary.type = layer._type;
+                    binary.function = layer._function.type;
+                    binary.src = (uint32_t)layer._src.Volume();
+                    binary.dst = (uint32_t)layer._dst.Volume();
+                    binary.weightOffset = offset;
+                    binary.weightSize = layer.WeightSize();
+                    offset = BinaryAlign(offset + layer.WeightSize() * sizeof(float));
+                    binary.biasOffset = offset;
+                    binary.biasSize = layer._bias.size();
+                    offset = BinaryAlign(offset + layer._bias.size() * sizeof(float));
+                }
+
+                std::ofstream ofs(path.c_str(), std::ios::binary);
+                if (!ofs.is_open())
+                    return false;
+                size_t position = 0;
+                BinaryWrite(ofs, &header, sizeof(header), position);
+                BinaryWrite(ofs, layers.data(), layers.size() * sizeof(Detail::BinaryLayer), position);
+                for (size_t i = 0; i < _layers.size(); ++i)
+                {
+                    const Layer & layer = *_layers[i];
+                    Vector buffer;
+                    const float * weight = layer.FastWeight(buffer);
+                    BinaryPad(ofs, (size_t)layers[i].weightOffset, position);
+                    BinaryWrite(ofs, weight, layer.WeightSize() * sizeof(float), position);
+                    BinaryPad(ofs, (size_t)layers[i].biasOffset, position);
+                    BinaryWrite(ofs, layer._bias.data(), layer._bias.size() * sizeof(float), position);
+                }
+                BinaryPad(ofs, offset, position);
+                return (bool)ofs;
+            }
+
+            /*!
+                \short Loads the weights of neural network from binary file created by SaveBinary.
+
+                The file is memory-mapped in read-only mode (on POSIX systems) and weights are used directly from the mapping, 
+                so loading does not copy them. Several processes which load the same file share one physical copy of the weights of fully connected layers. 
+                Convolutional layers pass the weights to convolution engine (see ::SimdConvolutionSetWeight) which can keep its own converted copy 
+                of them (Winograd and some other algorithms), so this part of weights is stored in memory of each process. 
+                On other systems the file is read into aligned memory buffer.
+
+                \note The network has to be created previously with using of methods Clear/Add. Prediction (with any method) and saving read the mapped weights.
+                Training, initialization and loading of other weights copy the weights into memory of the network first.
+
+                \param [in] path - a path to input file.
+                \return a result of loading.
+            */
+            bool LoadBinary(const std::string & path)
+            {
+                Detail::MappingPtr mapping(new Detail::Mapping());
+                if (!mapping->Open(path) || mapping->Size() < sizeof(Detail::BinaryHeader))
+                    return false;
+                const uint8_t * data = mapping->Data();
+                size_t size = mapping->Size();
+                const Detail::BinaryHeader & header = *(const Detail::BinaryHeader*)data;
+                if (header.magic != Detail::BINARY_MAGIC || header.version != Detail::BINARY_VERSION || header.count != _layers.size() ||
+                    header.alignment != Detail::BINARY_ALIGNMENT || header.count > (size - sizeof(header)) / sizeof(Detail::BinaryLayer))
+                    return false;
+                const Detail::BinaryLayer * layers = (const Detail::BinaryLayer*)(data + sizeof(header));
+                for (size_t i = 0; i < _layers.size(); ++i)
+                {
+                    const Layer & layer = *_layers[i];
+                    const Detail::BinaryLayer & binary = layers[i];
+                    if (binary.type != (uint32_t)layer._type || binary.function != (uint32_t)layer._function.type ||
+                        binary.src != (uint32_t)layer._src.Volume() || binary.dst != (uint32_t)layer._dst.Volume() ||
+                        binary.weightSize != layer.WeightSize() || binary.biasSize != layer._bias.size() ||
+                        !Detail::BinaryInside(binary.weightOffset, binary.weightSize * sizeof(float), size) ||
+                        !Detail::BinaryInside(binary.biasOffset, binary.biasSize * sizeof(float), size))
+                        return false;
+                }
+                for (size_t i = 0; i < _layers.size(); ++i)
+                {
+                    Layer & layer = *_layers[i];
+                    const Detail::BinaryLayer & binary = layers[i];
+                    if (binary.weightSize)
+                        layer.Share((const float*)(data + binary.weightOffset), (size_t)binary.weightSize);
+                    if (binary.biasSize)
+                        memcpy(layer._bias.data(), data + binary.biasOffset, layer._bias.size() * sizeof(float));
+                    layer.Invalidate();
+                }
+                _mapping = mapping;
+                return true;
+            }
+
             /*!
                 \short Converts format of classification results.
 
@@ -1878,7 +2436,33 @@ namespace Simd
             }
 
         private:
+            Detail::MappingPtr _mapping;
             LayerPtrs _layers;
+            Vectors _delta;
+
+            void Unshare()
+            {
+                for (size_t i = 0; i < _layers.size(); ++i)
+                    _layers[i]->Unshare();
+                _mapping.reset();
+            }
+
+            static SIMD_INLINE size_t BinaryAlign(size_t size)
+            {
+                return (size + Detail::BINARY_ALIGNMENT - 1) / Detail::BINARY_ALIGNMENT * Detail::BINARY_ALIGNMENT;
+            }
+
+            static SIMD_INLINE void BinaryWrite(std::ostream & os, const void * data, size_t size, size_t & position)
+            {
+                os.write((const char*)data, size);
+                position += size;
+            }
+
+            static SIMD_INLINE void BinaryPad(std::ostream & os, size_t offset, size_t & position)
+            {
+                for (; position < offset; ++position)
+                    os.put(0);
+            }
 
             size_t Requred(bool train) const
             {
@@ -1887,7 +2471,7 @@ namespace Simd
                 for (size_t i = 0; i < _layers.size(); ++i)
                 {
                     const Layer & layer = *_layers[i];
-                    requred += (layer._weight.size() + layer._bias.size()) * sizeof(Type);
+                    requred += (layer.WeightSize() + layer._bias.size()) * sizeof(Type);
                     if (train)
                         requred += (layer._gWeight.size() + layer._gBias.size()) * sizeof(Type);
                 }
@@ -1928,7 +2512,7 @@ namespace Simd
             {
                 SIMD_CHECK_PERFORMANCE();
 
-                Vector delta(current.size());
+                Vector & delta = _delta[thread];
                 if (Cannonical(options))
                 {
                     for (size_t i = 0; i < current.size(); ++i)
@@ -1970,7 +2554,12 @@ namespace Simd
                 {
                     for (size_t i = begin; i < end; ++i)
                     {
-                        Vector current = Forward(src[index[i]], thread, Layer::Train);
+                        if (i + 1 < end)
+                        {
+                            Detail::Prefetch(src[index[i + 1]]);
+                            Detail::Prefetch(dst[index[i + 1]]);
+                        }
+                        const Vector & current = Forward(src[index[i]], thread, Layer::Train);
                         Backward(current, dst[index[i]], thread, options);
                     }
                 }, options.threadNumber);
@@ -1985,11 +2574,13 @@ namespace Simd
                     Detail::InitWeight<type>(layer._bias, layer);
                     Detail::SetZero(layer._gWeight);
                     Detail::SetZero(layer._gBias);
+                    layer.Invalidate();
                 }
             }
 
             void InitWeight(const TrainOptions & options)
             {
+                Unshare();
                 switch (options.initType)
                 {
                 case TrainOptions::Xavier: InitWeight<TrainOptions::Xavier>(); break;
@@ -2006,24 +2597,47 @@ namespace Simd
                 }
             }
 
+            struct Slice
+            {
+                Layer * layer;
+                bool bias;
+                size_t offset, size;
+            };
+
             template<TrainOptions::UpdateType type> void UpdateWeight(const TrainOptions & options)
             {
+                const size_t block = 4096;
+                std::vector<Slice> slices;
                 for (size_t l = 0; l < _layers.size(); ++l)
                 {
-                    Layer & layer = *_layers[l];
-                    for (size_t t = 1; t < layer._common.size(); ++t)
-                    {
-                        ::SimdNeuralAddVector(layer._common[t].dWeight.data(), layer._common[t].dWeight.size(), layer._common[0].dWeight.data());
-                        ::SimdNeuralAddVector(layer._common[t].dBias.data(), layer._common[t].dBias.size(), layer._common[0].dBias.data());
-                    }
-                    Detail::UpdateWeight<type>(options, layer._common[0].dWeight, layer._gWeight, layer._weight);
-                    Detail::UpdateWeight<type>(options, layer._common[0].dBias, layer._gBias, layer._bias);
-                    for (size_t t = 0; t < layer._common.size(); ++t)
+                    Layer * layer = _layers[l].get();
+                    for (size_t offset = 0; offset < layer->_weight.size(); offset += block)
+                        slices.push_back({ layer, false, offset, std::min(block, layer->_weight.size() - offset) });
+                    for (size_t offset = 0; offset < layer->_bias.size(); offset += block)
+                        slices.push_back({ layer, true, offset, std::min(block, layer->_bias.size() - offset) });
+                }
+                Parallel(0, slices.size(), [&](size_t thread, size_t begin, size_t end)
+                {
+                    for (size_t i = begin; i < end; ++i)
                     {
-                        Detail::SetZero(layer._common[t].dWeight);
-                        Detail::SetZero(layer._common[t].dBias);
+                        const Slice & slice = slices[i];
+                        Layer & layer = *slice.layer;
+                        float * sum = (slice.bias ? layer._common[0].dBias : layer._common[0].dWeight).data() + slice.offset;
+                        for (size_t t = 1; t < layer._common.size(); ++t)
+                        {
+                            float * part = (slice.bias ? layer._common[t].dBias : layer._common[t].dWeight).data() + slice.offset;
+                            ::SimdNeuralAddVector(part, slice.size, sum);
+                            memset(part, 0, slice.size * sizeof(float));
+                        }
+                        if (slice.bias)
+                            Detail::UpdateWeight<type>(options, sum, slice.size, layer._gBias.data() + slice.offset, layer._bias.data() + slice.offset);
+                        else
+                            Detail::UpdateWeight<type>(options, sum, slice.size, layer._gWeight.data() + slice.offset, layer._weight.data() + slice.offset);
+                        memset(sum, 0, slice.size * sizeof(float));
                     }
-                }
+                }, options.threadNumber);
+                for (size_t l = 0; l < _layers.size(); ++l)
+                    _layers[l]->Invalidate();
             }
 
             void UpdateWeight(const TrainOptions & options)
@@ -24,36 +24,279 @@
 #ifndef __SimdParallel_hpp__
 #define __SimdParallel_hpp__
 
+#include <stdint.h>
+
 #include <thread>
-#include <future>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
 #include <vector>
+#include <algorithm>
+
+#ifndef SIMD_THREAD_POOL_SPIN
+#define SIMD_THREAD_POOL_SPIN 4096
+#endif
+
+#ifndef SIMD_THREAD_POOL_CHUNKS
+#define SIMD_THREAD_POOL_CHUNKS 4
+#endif
 
 namespace Simd
 {
-    template<class Function> inline void Parallel(size_t begin, size_t end, const Function & function, size_t threadNumber, size_t blockAlign = 1)
+    /*! \cond PRIVATE */
+
+    class ThreadPool
     {
-        threadNumber = std::min<size_t>(threadNumber, std::thread::hardware_concurrency());
-        if (threadNumber <= 1 || size_t(blockAlign*1.5) >= (end - begin))
-            function(0, begin, end);
-        else
+    public:
+        typedef void(*Invoker)(const void * function, size_t thread, size_t begin, size_t end);
+
+        template<class Function> static void Invoke(const void * function, size_t thread, size_t begin, size_t end)
+        {
+            (*(const Function*)function)(thread, begin, end);
+        }
+
+        static ThreadPool & Global()
         {
-            std::vector<std::future<void>> futures;
+            static ThreadPool pool;
+            return pool;
+        }
 
-            size_t blockSize = (end - begin + threadNumber - 1) / threadNumber;
-            blockSize = (blockSize + blockAlign - 1) / blockAlign * blockAlign;
-            size_t blockBegin = begin;
-            size_t blockEnd = blockBegin + blockSize;
+        static bool Nested()
+        {
+            return Inside();
+        }
+
+        static ThreadPool *& Current()
+        {
+            static thread_local ThreadPool * current = NULL;
+            return current;
+        }
+
+        static ThreadPool & Attached()
+        {
+            ThreadPool * current = Current();
+            return current ? *current : Global();
+        }
+
+        ThreadPool()
+            : _slots(NULL)
+            , _capacity(0)
+            , _job(0)
+            , _stop(false)
+        {
+        }
 
-            for (size_t thread = 0; thread < threadNumber && blockBegin < end; ++thread)
+        ~ThreadPool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _stop.store(true, std::memory_order_release);
+            }
+            _wakeup.notify_all();
+            for (size_t i = 0; i < _threads.size(); ++i)
+                _threads[i].join();
+            delete[] _slots;
+        }
+
+        void Reserve(size_t threadNumber)
+        {
+            if (Inside())
+                return;
+            std::lock_guard<std::mutex> lock(_run);
+            Grow(threadNumber);
+        }
+
+        bool Run(size_t begin, size_t end, size_t blockAlign, size_t threadNumber, Invoker invoker, const void * function)
+        {
+            if (Inside() || !_run.try_lock())
+                return false;
+            Inside() = true;
+
+            size_t size = end - begin;
+            size_t count = std::min((size + blockAlign - 1) / blockAlign, threadNumber * SIMD_THREAD_POOL_CHUNKS);
+            size_t chunk = ((size + count - 1) / count + blockAlign - 1) / blockAlign * blockAlign;
+            count = (size + chunk - 1) / chunk;
+            size_t participants = std::min(threadNumber, count);
+            Grow(participants);
+
+            _begin = begin;
+            _end = end;
+            _chunk = chunk;
+            _invoker = invoker;
+            _function = function;
+            for (size_t p = 0; p < participants; ++p)
+                _slots[p].range.store(Range(count * p / participants, count * (p + 1) / participants), std::memory_order_relaxed);
+            _done.store(0, std::memory_order_relaxed);
+            _active.store(participants - 1, std::memory_order_relaxed);
             {
-                futures.push_back(std::move(std::async(std::launch::async, [blockBegin, blockEnd, thread, &function] { function(thread, blockBegin, blockEnd); })));
-                blockBegin += blockSize;
-                blockEnd = std::min(blockBegin + blockSize, end);
+                std::lock_guard<std::mutex> lock(_mutex);
+                _job.store(((_job.load(std::memory_order_relaxed) >> 16) + 1) << 16 | participants, std::memory_order_release);
             }
+            _wakeup.notify_all();
 
-            for (size_t i = 0; i < futures.size(); ++i)
-                futures[i].wait();
+            Execute(0, participants);
+            while (_done.load(std::memory_order_acquire) < count || _active.load(std::memory_order_acquire) != 0)
+                std::this_thread::yield();
+
+            Inside() = false;
+            _run.unlock();
+            return true;
+        }
+
+    private:
+        struct Slot
+        {
+            std::atomic<uint64_t> range;
+            char padding[64 - sizeof(std::atomic<uint64_t>)];
+        };
+
+        static uint64_t Range(size_t lo, size_t hi)
+        {
+            return uint64_t(lo) | uint64_t(hi) << 32;
         }
+
+        static bool & Inside()
+        {
+            static thread_local bool inside = false;
+            return inside;
+        }
+
+        bool PopFront(Slot & slot, size_t & chunk)
+        {
+            uint64_t range = slot.range.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                uint32_t lo = uint32_t(range), hi = uint32_t(range >> 32);
+                if (lo >= hi)
+                    return false;
+                if (slot.range.compare_exchange_weak(range, Range(lo + 1, hi), std::memory_order_acq_rel))
+                {
+                    chunk = lo;
+                    return true;
+                }
+            }
+        }
+
+        bool PopBack(Slot & slot, size_t & chunk)
+        {
+            uint64_t range = slot.range.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                uint32_t lo = uint32_t(range), hi = uint32_t(range >> 32);
+                if (lo >= hi)
+                    return false;
+                if (slot.range.compare_exchange_weak(range, Range(lo, hi - 1), std::memory_order_acq_rel))
+                {
+                    chunk = hi - 1;
+                    return true;
+                }
+            }
+        }
+
+        void Perform(size_t thread, size_t chunk)
+        {
+            size_t begin = _begin + chunk * _chunk;
+            _invoker(_function, thread, begin, std::min(begin + _chunk, _end));
+            _done.fetch_add(1, std::memory_order_release);
+        }
+
+        void Execute(size_t thread, size_t participants)
+        {
+            size_t chunk;
+            while (PopFront(_slots[thread], chunk))
+                Perform(thread, chunk);
+            for (size_t i = 1; i < participants; ++i)
+            {
+                Slot & victim = _slots[(thread + i) % participants];
+                while (PopBack(victim, chunk))
+                    Perform(thread, chunk);
+            }
+        }
+
+        void Grow(size_t threadNumber)
+        {
+            if (threadNumber <= _capacity)
+                return;
+            delete[] _slots;
+            _slots = new Slot[threadNumber];
+            _capacity = threadNumber;
+            while (_threads.size() + 1 < threadNumber)
+                _threads.push_back(std::thread(&ThreadPool::Worker, this, _threads.size() + 1));
+        }
+
+        uint64_t Wait(uint64_t last)
+        {
+            for (size_t i = 0; i < SIMD_THREAD_POOL_SPIN; ++i)
+            {
+                uint64_t job = _job.load(std::memory_order_acquire);
+                if (job != last || _stop.load(std::memory_order_acquire))
+                    return job;
+                std::this_thread::yield();
+            }
+            std::unique_lock<std::mutex> lock(_mutex);
+            _wakeup.wait(lock, [&] { return _job.load(std::memory_order_acquire) != last || _stop.load(std::memory_order_acquire); });
+            return _job.load(std::memory_order_acquire);
+        }
+
+        void Worker(size_t thread)
+        {
+            Inside() = true;
+            uint64_t job = 0;
+            for (;;)
+            {
+                job = Wait(job);
+                if (_stop.load(std::memory_order_acquire))
+                    return;
+                size_t participants = size_t(job & 0xFFFF);
+                if (thread < participants)
+                {
+                    Execute(thread, participants);
+                    _active.fetch_sub(1, std::memory_order_release);
+                }
+            }
+        }
+
+        std::mutex _run, _mutex;
+        std::condition_variable _wakeup;
+        std::vector<std::thread> _threads;
+        Slot * _slots;
+        size_t _capacity, _begin, _end, _chunk;
+        Invoker _invoker;
+        const void * _function;
+        std::atomic<uint64_t> _job;
+        std::atomic<size_t> _done, _active;
+        std::atomic<bool> _stop;
+    };
+
+    template<class Function> inline void ParallelAsync(size_t begin, size_t end, const Function & function, size_t threadNumber, size_t blockAlign)
+    {
+        std::vector<std::thread> threads;
+
+        size_t blockSize = (end - begin + threadNumber - 1) / threadNumber;
+        blockSize = (blockSize + blockAlign - 1) / blockAlign * blockAlign;
+        size_t blockBegin = begin;
+        size_t blockEnd = blockBegin + blockSize;
+
+        for (size_t thread = 0; thread < threadNumber && blockBegin < end; ++thread)
+        {
+            threads.push_back(std::thread([blockBegin, blockEnd, thread, &function] { function(thread, blockBegin, blockEnd); }));
+            blockBegin += blockSize;
+            blockEnd = std::min(blockBegin + blockSize, end);
+        }
+
+        for (size_t i = 0; i < threads.size(); ++i)
+            threads[i].join();
+    }
+
+    /*! \endcond */
+
+    template<class Function> inline void Parallel(size_t begin, size_t end, const Function & function, size_t threadNumber, size_t blockAlign = 1)
+    {
+        threadNumber = std::min<size_t>(threadNumber, std::thread::hardware_concurrency());
+        if (threadNumber <= 1 || size_t(blockAlign*1.5) >= (end - begin) || ThreadPool::Nested())
+            function(0, begin, end);
+        else if (!ThreadPool::Attached().Run(begin, end, blockAlign, threadNumber, ThreadPool::Invoke<Function>, &function))
+            ParallelAsync(begin, end, function, threadNumber, blockAlign);
     }
 }
 
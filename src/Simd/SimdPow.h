@@ -94,6 +94,49 @@ namespace Simd
 #ifdef SIMD_AVX2_ENABLE    
     namespace Avx2
     {
+        SIMD_INLINE __m256 Exp2(__m256 x)
+        {
+            x = _mm256_max_ps(_mm256_min_ps(x, _mm256_set1_ps(129.00000f)), _mm256_set1_ps(-126.99999f));
+            __m256i ipart = _mm256_cvtps_epi32(_mm256_sub_ps(x, _mm256_set1_ps(0.5f)));
+            __m256 fpart = _mm256_sub_ps(x, _mm256_cvtepi32_ps(ipart));
+            __m256 expipart = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_add_epi32(ipart, _mm256_set1_epi32(127)), 23));
+            __m256 expfpart = _mm256_set1_ps(1.8775767e-3f);
+            expfpart = _mm256_fmadd_ps(fpart, expfpart, _mm256_set1_ps(8.9893397e-3f));
+            expfpart = _mm256_fmadd_ps(fpart, expfpart, _mm256_set1_ps(5.5826318e-2f));
+            expfpart = _mm256_fmadd_ps(fpart, expfpart, _mm256_set1_ps(2.4015361e-1f));
+            expfpart = _mm256_fmadd_ps(fpart, expfpart, _mm256_set1_ps(6.9315308e-1f));
+            expfpart = _mm256_fmadd_ps(fpart, expfpart, _mm256_set1_ps(9.9999994e-1f));
+            return _mm256_mul_ps(expipart, expfpart);
+        }
+
+        SIMD_INLINE __m256 Exponent(__m256 x)
+        {
+            return Exp2(_mm256_mul_ps(x, _mm256_set1_ps(1.44269504088896341f)));
+        }
+
+        SIMD_INLINE __m256 Sigmoid(__m256 x)
+        {
+            __m256 one = _mm256_set1_ps(1.0f);
+            return _mm256_div_ps(one, _mm256_add_ps(one, Exponent(_mm256_sub_ps(_mm256_setzero_ps(), x))));
+        }
+
+        SIMD_INLINE __m256 Tanh(__m256 x)
+        {
+            __m256 one = _mm256_set1_ps(1.0f);
+            __m256 sign = _mm256_and_ps(x, _mm256_set1_ps(-0.0f));
+            __m256 abs = _mm256_andnot_ps(_mm256_set1_ps(-0.0f), x);
+            __m256 e = Exponent(_mm256_mul_ps(abs, _mm256_set1_ps(-2.0f)));
+            __m256 large = _mm256_or_ps(_mm256_div_ps(_mm256_sub_ps(one, e), _mm256_add_ps(one, e)), sign);
+            __m256 x2 = _mm256_mul_ps(x, x);
+            __m256 p = _mm256_set1_ps(-5.70498872745e-3f);
+            p = _mm256_fmadd_ps(p, x2, _mm256_set1_ps(2.06390887954e-2f));
+            p = _mm256_fmadd_ps(p, x2, _mm256_set1_ps(-5.37397155531e-2f));
+            p = _mm256_fmadd_ps(p, x2, _mm256_set1_ps(1.33314422036e-1f));
+            p = _mm256_fmadd_ps(p, x2, _mm256_set1_ps(-3.33332819422e-1f));
+            __m256 small = _mm256_fmadd_ps(_mm256_mul_ps(p, x2), x, x);
+            return _mm256_blendv_ps(large, small, _mm256_cmp_ps(abs, _mm256_set1_ps(0.625f), _CMP_LT_OQ));
+        }
+
         class Pow
         {
             __m256i _exponent, _mantissa;
@@ -110,16 +153,6 @@ namespace Simd
                 return p;
             }
 
-            SIMD_INLINE __m256 Exp2(__m256 x) const
-            {
-                x = _mm256_max_ps(_mm256_min_ps(x, _mm256_set1_ps(129.00000f)), _mm256_set1_ps(-126.99999f));
-                __m256i ipart = _mm256_cvtps_epi32(_mm256_sub_ps(x, _mm256_set1_ps(0.5f)));
-                __m256 fpart = _mm256_sub_ps(x, _mm256_cvtepi32_ps(ipart));
-                __m256 expipart = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_add_epi32(ipart, _mm256_set1_epi32(127)), 23));
-                __m256 expfpart = Poly5(fpart, 9.9999994e-1f, 6.9315308e-1f, 2.4015361e-1f, 5.5826318e-2f, 8.9893397e-3f, 1.8775767e-3f);
-                return _mm256_mul_ps(expipart, expfpart);
-            }
-
             SIMD_INLINE __m256 Log2(__m256 x) const
             {
                 __m256i i = _mm256_castps_si256(x);
@@ -149,6 +182,50 @@ namespace Simd
 #ifdef SIMD_AVX512F_ENABLE    
     namespace Avx512f
     {
+        SIMD_INLINE __m512 Exp2(__m512 x)
+        {
+            x = _mm512_max_ps(_mm512_min_ps(x, _mm512_set1_ps(129.00000f)), _mm512_set1_ps(-126.99999f));
+            __m512i ipart = _mm512_cvtps_epi32(_mm512_sub_ps(x, _mm512_set1_ps(0.5f)));
+            __m512 fpart = _mm512_sub_ps(x, _mm512_cvtepi32_ps(ipart));
+            __m512 expipart = _mm512_castsi512_ps(_mm512_slli_epi32(_mm512_add_epi32(ipart, _mm512_set1_epi32(127)), 23));
+            __m512 expfpart = _mm512_set1_ps(1.8775767e-3f);
+            expfpart = _mm512_fmadd_ps(fpart, expfpart, _mm512_set1_ps(8.9893397e-3f));
+            expfpart = _mm512_fmadd_ps(fpart, expfpart, _mm512_set1_ps(5.5826318e-2f));
+            expfpart = _mm512_fmadd_ps(fpart, expfpart, _mm512_set1_ps(2.4015361e-1f));
+            expfpart = _mm512_fmadd_ps(fpart, expfpart, _mm512_set1_ps(6.9315308e-1f));
+            expfpart = _mm512_fmadd_ps(fpart, expfpart, _mm512_set1_ps(9.9999994e-1f));
+            return _mm512_mul_ps(expipart, expfpart);
+        }
+
+        SIMD_INLINE __m512 Exponent(__m512 x)
+        {
+            return Exp2(_mm512_mul_ps(x, _mm512_set1_ps(1.44269504088896341f)));
+        }
+
+        SIMD_INLINE __m512 Sigmoid(__m512 x)
+        {
+            __m512 one = _mm512_set1_ps(1.0f);
+            return _mm512_div_ps(one, _mm512_add_ps(one, Exponent(_mm512_sub_ps(_mm512_setzero_ps(), x))));
+        }
+
+        SIMD_INLINE __m512 Tanh(__m512 x)
+        {
+            __m512 one = _mm512_set1_ps(1.0f);
+            __m512i sign = _mm512_and_si512(_mm512_castps_si512(x), _mm512_set1_epi32(0x80000000));
+            __m512 abs = _mm512_castsi512_ps(_mm512_andnot_si512(_mm512_set1_epi32(0x80000000), _mm512_castps_si512(x)));
+            __m512 e = Exponent(_mm512_mul_ps(abs, _mm512_set1_ps(-2.0f)));
+            __m512 t = _mm512_div_ps(_mm512_sub_ps(one, e), _mm512_add_ps(one, e));
+            __m512 large = _mm512_castsi512_ps(_mm512_or_si512(_mm512_castps_si512(t), sign));
+            __m512 x2 = _mm512_mul_ps(x, x);
+            __m512 p = _mm512_set1_ps(-5.70498872745e-3f);
+            p = _mm512_fmadd_ps(p, x2, _mm512_set1_ps(2.06390887954e-2f));
+            p = _mm512_fmadd_ps(p, x2, _mm512_set1_ps(-5.37397155531e-2f));
+            p = _mm512_fmadd_ps(p, x2, _mm512_set1_ps(1.33314422036e-1f));
+            p = _mm512_fmadd_ps(p, x2, _mm512_set1_ps(-3.33332819422e-1f));
+            __m512 small = _mm512_fmadd_ps(_mm512_mul_ps(p, x2), x, x);
+            return _mm512_mask_blend_ps(_mm512_cmp_ps_mask(abs, _mm512_set1_ps(0.625f), _CMP_LT_OQ), large, small);
+        }
+
         class Pow
         {
             __m512i _exponent, _mantissa;
@@ -165,16 +242,6 @@ namespace Simd
                 return p;
             }
 
-            SIMD_INLINE __m512 Exp2(__m512 x) const
-            {
-                x = _mm512_max_ps(_mm512_min_ps(x, _mm512_set1_ps(129.00000f)), _mm512_set1_ps(-126.99999f));
-                __m512i ipart = _mm512_cvtps_epi32(_mm512_sub_ps(x, _mm512_set1_ps(0.5f)));
-                __m512 fpart = _mm512_sub_ps(x, _mm512_cvtepi32_ps(ipart));
-                __m512 expipart = _mm512_castsi512_ps(_mm512_slli_epi32(_mm512_add_epi32(ipart, _mm512_set1_epi32(127)), 23));
-                __m512 expfpart = Poly5(fpart, 9.9999994e-1f, 6.9315308e-1f, 2.4015361e-1f, 5.5826318e-2f, 8.9893397e-3f, 1.8775767e-3f);
-                return _mm512_mul_ps(expipart, expfpart);
-            }
-
             SIMD_INLINE __m512 Log2(__m512 x) const
             {
                 __m512i i = _mm512_castps_si512(x);
@@ -417,6 +417,102 @@ namespace Simd
             }
         }
 
+        template<SimdConvolutionActivationType type> SIMD_INLINE __m128 GemmActivate(__m128 value, __m128 slope)
+        {
+            return value;
+        }
+
+        template<> SIMD_INLINE __m128 GemmActivate<SimdConvolutionActivationRelu>(__m128 value, __m128 slope)
+        {
+            return _mm_max_ps(_mm_setzero_ps(), value);
+        }
+
+        template<> SIMD_INLINE __m128 GemmActivate<SimdConvolutionActivationLeakyRelu>(__m128 value, __m128 slope)
+        {
+            return _mm_add_ps(_mm_max_ps(_mm_setzero_ps(), value), _mm_mul_ps(slope, _mm_min_ps(_mm_setzero_ps(), value)));
+        }
+
+        template<> SIMD_INLINE __m128 GemmActivate<SimdConvolutionActivationPrelu>(__m128 value, __m128 slope)
+        {
+            return _mm_add_ps(_mm_max_ps(_mm_setzero_ps(), value), _mm_mul_ps(slope, _mm_min_ps(_mm_setzero_ps(), value)));
+        }
+
+        // Sigmoid(x) = 0.5 + 0.5 * tanh(x / 2); tanh uses a [13/6] rational approximation (max error ~1e-7), so it needs only float arithmetic.
+        SIMD_INLINE __m128 GemmSigmoid(__m128 value)
+        {
+            __m128 x = _mm_min_ps(_mm_set1_ps(7.90531110f), _mm_max_ps(_mm_set1_ps(-7.90531110f), _mm_mul_ps(value, _mm_set1_ps(0.5f))));
+            __m128 x2 = _mm_mul_ps(x, x);
+            __m128 p = _mm_add_ps(_mm_mul_ps(x2, _mm_set1_ps(-2.76076847742355e-16f)), _mm_set1_ps(2.00018790482477e-13f));
+            p = _mm_add_ps(_mm_mul_ps(p, x2), _mm_set1_ps(-8.60467152213735e-11f));
+            p = _mm_add_ps(_mm_mul_ps(p, x2), _mm_set1_ps(5.12229709037114e-08f));
+            p = _mm_add_ps(_mm_mul_ps(p, x2), _mm_set1_ps(1.48572235717979e-05f));
+            p = _mm_add_ps(_mm_mul_ps(p, x2), _mm_set1_ps(6.37261928875436e-04f));
+            p = _mm_add_ps(_mm_mul_ps(p, x2), _mm_set1_ps(4.89352455891786e-03f));
+            __m128 q = _mm_add_ps(_mm_mul_ps(x2, _mm_set1_ps(1.19825839466702e-06f)), _mm_set1_ps(1.18534705686654e-04f));
+            q = _mm_add_ps(_mm_mul_ps(q, x2), _mm_set1_ps(2.26843463243900e-03f));
+            q = _mm_add_ps(_mm_mul_ps(q, x2), _mm_set1_ps(4.89352518554385e-03f));
+            __m128 half = _mm_set1_ps(0.5f);
+            return _mm_add_ps(half, _mm_mul_ps(half, _mm_div_ps(_mm_mul_ps(x, p), q)));
+        }
+
+        template<> SIMD_INLINE __m128 GemmActivate<SimdConvolutionActivationSigmoid>(__m128 value, __m128 slope)
+        {
+            return GemmSigmoid(value);
+        }
+
+        template<SimdConvolutionActivationType type> void GemmApplyEpilogue(const GemmEpilogue & epilogue, size_t row, size_t col, size_t M, size_t N, float * C, size_t ldc)
+        {
+            const float * bias = epilogue.bias;
+            const float * slope = epilogue.params;
+            float leaky = type == SimdConvolutionActivationLeakyRelu ? slope[0] : 0.0f;
+            size_t NF = AlignLo(N, F);
+            for (size_t i = 0; i < M; ++i, C += ldc)
+            {
+                size_t j = 0;
+                if (epilogue.perColumn)
+                {
+                    __m128 _slope = _mm_set1_ps(leaky);
+                    for (; j < NF; j += F)
+                    {
+                        __m128 value = _mm_loadu_ps(C + j);
+                        if (bias)
+                            value = _mm_add_ps(value, _mm_loadu_ps(bias + col + j));
+                        if (type == SimdConvolutionActivationPrelu)
+                            _slope = _mm_loadu_ps(slope + col + j);
+                        _mm_storeu_ps(C + j, GemmActivate<type>(value, _slope));
+                    }
+                    for (; j < N; ++j)
+                    {
+                        float value = bias ? C[j] + bias[col + j] : C[j];
+                        C[j] = Base::GemmActivate<type>(value, type == SimdConvolutionActivationPrelu ? slope[col + j] : leaky);
+                    }
+                }
+                else
+                {
+                    float b = bias ? bias[row + i] : 0.0f;
+                    float s = type == SimdConvolutionActivationPrelu ? slope[row + i] : leaky;
+                    __m128 _bias = _mm_set1_ps(b), _slope = _mm_set1_ps(s);
+                    for (; j < NF; j += F)
+                        _mm_storeu_ps(C + j, GemmActivate<type>(_mm_add_ps(_mm_loadu_ps(C + j), _bias), _slope));
+                    for (; j < N; ++j)
+                        C[j] = Base::GemmActivate<type>(C[j] + b, s);
+                }
+            }
+        }
+
+        void GemmApplyEpilogue(const GemmEpilogue & epilogue, size_t row, size_t col, size_t M, size_t N, float * C, size_t ldc)
+        {
+            switch (epilogue.activation)
+            {
+            case SimdConvolutionActivationIdentity: GemmApplyEpilogue<SimdConvolutionActivationIdentity>(epilogue, row, col, M, N, C, ldc); break;
+            case SimdConvolutionActivationRelu: GemmApplyEpilogue<SimdConvolutionActivationRelu>(epilogue, row, col, M, N, C, ldc); break;
+            case SimdConvolutionActivationLeakyRelu: GemmApplyEpilogue<SimdConvolutionActivationLeakyRelu>(epilogue, row, col, M, N, C, ldc); break;
+            case SimdConvolutionActivationPrelu: GemmApplyEpilogue<SimdConvolutionActivationPrelu>(epilogue, row, col, M, N, C, ldc); break;
+            case SimdConvolutionActivationSigmoid: GemmApplyEpilogue<SimdConvolutionActivationSigmoid>(epilogue, row, col, M, N, C, ldc); break;
+            default: Base::GemmApplyEpilogue(epilogue, row, col, M, N, C, ldc);
+            }
+        }
+
         static void PackA(const float * src, size_t stride, size_t M, size_t K, size_t cell, float * dst)
         {
             for (size_t i = 0; i < M; i += cell)
@@ -546,11 +642,73 @@ namespace Simd
             }
         }
 
-        void Gemm32fNN(size_t M, size_t N, size_t K, const float * alpha, const float * A, size_t lda, const float * B, size_t ldb, const float * beta, float * C, size_t ldc)
+        SIMD_INLINE void Transpose4x4(const float * src, size_t srcStride, float * dst, size_t dstStride)
         {
-            const size_t CACHE_L1_SIZE = 32 * 1024;
-            const size_t CACHE_L2_SIZE = 256 * 1024;
-            const size_t CACHE_L3_SIZE = 2 * 1024 * 1024;
+            __m128 s0 = _mm_loadu_ps(src + 0 * srcStride);
+            __m128 s1 = _mm_loadu_ps(src + 1 * srcStride);
+            __m128 s2 = _mm_loadu_ps(src + 2 * srcStride);
+            __m128 s3 = _mm_loadu_ps(src + 3 * srcStride);
+            _MM_TRANSPOSE4_PS(s0, s1, s2, s3);
+            _mm_storeu_ps(dst + 0 * dstStride, s0);
+            _mm_storeu_ps(dst + 1 * dstStride, s1);
+            _mm_storeu_ps(dst + 2 * dstStride, s2);
+            _mm_storeu_ps(dst + 3 * dstStride, s3);
+        }
+
+        void GemmPackAT(const float * A, size_t lda, size_t M, size_t K, float * pA)
+        {
+            size_t M4 = AlignLo(M, 4), K4 = AlignLo(K, 4), i = 0;
+            for (; i < M4; i += 4)
+            {
+                size_t k = 0;
+                for (; k < K4; k += 4)
+                    Transpose4x4(A + k * lda + i, lda, pA + i * K + k, K);
+                for (; k < K; ++k)
+                    for (size_t c = 0; c < 4; ++c)
+                        pA[(i + c) * K + k] = A[k * lda + i + c];
+            }
+            for (; i < M; ++i)
+                for (size_t k = 0; k < K; ++k)
+                    pA[i * K + k] = A[k * lda + i];
+        }
+
+        void GemmPackBT(const float * B, size_t ldb, size_t K, size_t N, size_t microN, float * pB)
+        {
+            size_t K4 = AlignLo(K, 4);
+            for (size_t j = 0; j < N; j += microN)
+            {
+                size_t n = Simd::Min(microN, N - j), n4 = AlignLo(n, 4), k = 0;
+                for (; k < K4; k += 4)
+                {
+                    size_t c = 0;
+                    for (; c < n4; c += 4)
+                        Transpose4x4(B + c * ldb + k, ldb, pB + c, microN);
+                    for (; c < n; ++c)
+                        for (size_t r = 0; r < 4; ++r)
+                            pB[r * microN + c] = B[c * ldb + k + r];
+                    for (; c < microN; ++c)
+                        for (size_t r = 0; r < 4; ++r)
+                            pB[r * microN + c] = 0;
+                    pB += 4 * microN;
+                }
+                for (; k < K; ++k)
+                {
+                    size_t c = 0;
+                    for (; c < n; ++c)
+                        pB[c] = B[c * ldb + k];
+                    for (; c < microN; ++c)
+                        pB[c] = 0;
+                    pB += microN;
+                }
+                B += microN * ldb;
+            }
+        }
+
+        static Gemm<float> * CreateGemm32fNN(size_t M, size_t N, size_t K, SimdBool transA = SimdFalse, SimdBool transB = SimdFalse)
+        {
+            const size_t CACHE_L1_SIZE = Base::AlgCacheL1();
+            const size_t CACHE_L2_SIZE = Base::AlgCacheL2();
+            const size_t CACHE_L3_SIZE = Base::AlgCacheL3();
             typedef Simd::GemmNN<float, size_t> GemmNN;
             GemmNN::Main kernelMM, kernelMT;
             GemmNN::Tail kernelTM, kernelTT;
@@ -586,9 +744,39 @@ namespace Simd
 #endif
             L1 = N > 4096 ? CACHE_L2_SIZE : CACHE_L1_SIZE;
             L2 = N > 4096 ? CACHE_L3_SIZE : CACHE_L2_SIZE;
-            GemmNN gemmNN(M, N, K, microM, microN, L1, L2, CACHE_L3_SIZE, F,
-                kernelMM, kernelMT, kernelTM, kernelTT, GemmScaleC, PackBnn, NULL); 
-            gemmNN.Run(alpha, A, lda, B, ldb, beta, C, ldc);
+            return new GemmNN(M, N, K, microM, microN, L1, L2, CACHE_L3_SIZE, F,
+                kernelMM, kernelMT, kernelTM, kernelTT, GemmScaleC, PackBnn, NULL, Sse::GemmApplyEpilogue, 
+                transA ? Sse::GemmPackAT : NULL, transB ? Sse::GemmPackBT : NULL, Base::GemmPackA16);
+        }
+
+        void Gemm32fNN(size_t M, size_t N, size_t K, const float * alpha, const float * A, size_t lda, const float * B, size_t ldb, const float * beta, float * C, size_t ldc)
+        {
+            Gemm<float> * gemm = CreateGemm32fNN(M, N, K);
+            gemm->Run(alpha, A, lda, B, ldb, beta, C, ldc);
+            delete gemm;
+        }
+
+        void Gemm32fTN(size_t M, size_t N, size_t K, const float * alpha, const float * A, size_t lda, const float * B, size_t ldb, const float * beta, float * C, size_t ldc)
+        {
+            Gemm<float> * gemm = CreateGemm32fNN(M, N, K, SimdTrue, SimdFalse);
+            gemm->Run(alpha, A, lda, B, ldb, beta, C, ldc);
+            delete gemm;
+        }
+
+        void Gemm32fTT(size_t M, size_t N, size_t K, const float * alpha, const float * A, size_t lda, const float * B, size_t ldb, const float * beta, float * C, size_t ldc)
+        {
+            Gemm<float> * gemm = CreateGemm32fNN(M, N, K, SimdTrue, SimdTrue);
+            gemm->Run(alpha, A, lda, B, ldb, beta, C, ldc);
+            delete gemm;
+        }
+
+        void * Gemm32fInit(SimdBool transA, SimdBool transB, size_t M, size_t N, size_t K)
+        {
+            if (transA)
+                return CreateGemm32fNN(M, N, K, transA, transB);
+            if (transB)
+                return new GemmFunc<float>(M, N, K, true, Base::Gemm32fNT);
+            return CreateGemm32fNN(M, N, K);
         }
     }
 #endif// SIMD_SSE_ENABLE
@@ -447,18 +447,12 @@ namespace Simd
             Winograd2x3pSetInput4Store(t, dst, dstStride);
         }
 
-        void Winograd2x3pSetInput(const float * src, size_t srcChannels, size_t srcHeight, size_t srcWidth, float * dst, int pad)
+        static void Winograd2x3pSetInput(const float * src, size_t srcChannels, size_t srcHeight, size_t srcWidth, float * dst, size_t dstStride, int pad)
         {
-            if (srcHeight < 4 || srcWidth < 10)
-            {
-                Base::Winograd2x3pSetInput(src, srcChannels, srcHeight, srcWidth, dst, pad);
-                return;
-            }
             size_t dstH = pad ? srcHeight : srcHeight - 2;
             size_t dstW = pad ? srcWidth : srcWidth - 2;
             size_t tileH = (dstH + 1) / 2;
             size_t tileW = (dstW + 1) / 2;
-            size_t dstStride = srcChannels*tileH*tileW;
 
             size_t dstH2 = AlignLo(dstH, 2);
             size_t dstW2 = AlignLo(dstW, 2);
@@ -522,6 +516,16 @@ namespace Simd
             }
         }
 
+        void Winograd2x3pSetInput(const float * src, size_t srcChannels, size_t srcHeight, size_t srcWidth, float * dst, int pad)
+        {
+            if (srcHeight < 4 || srcWidth < 10)
+            {
+                Base::Winograd2x3pSetInput(src, srcChannels, srcHeight, srcWidth, dst, pad);
+                return;
+            }
+            WinogradSetInput(Winograd2x3pSetInput, 2, src, srcChannels, srcHeight, srcWidth, dst, pad);
+        }
+
         SIMD_INLINE void Winograd2x3pSetOutputLoad2t(const float * src, size_t srcStride, __m128 * dst)
         {
             __m128 s0 = _mm_loadu_ps(src + 0 * srcStride);
@@ -579,16 +583,10 @@ namespace Simd
             }
         }
 
-        void Winograd2x3pSetOutput(const float * src, float * dst, size_t dstChannels, size_t dstHeight, size_t dstWidth)
+        static void Winograd2x3pSetOutput(const float * src, size_t srcStride, float * dst, size_t dstChannels, size_t dstHeight, size_t dstWidth)
         {
-            if (dstHeight < 2 || dstWidth < 8)
-            {
-                Base::Winograd2x3pSetOutput(src, dst, dstChannels, dstHeight, dstWidth);
-                return;
-            }
             size_t tileH = (dstHeight + 1) / 2;
             size_t tileW = (dstWidth + 1) / 2;
-            size_t srcStride = dstChannels*tileH*tileW;
             size_t dstH2 = AlignLo(dstHeight, 2);
             size_t dstW2 = AlignLo(dstWidth, 2);
             size_t dstW8 = AlignLo(dstWidth, 8);
@@ -623,6 +621,16 @@ namespace Simd
             }
         }
 
+        void Winograd2x3pSetOutput(const float * src, float * dst, size_t dstChannels, size_t dstHeight, size_t dstWidth)
+        {
+            if (dstHeight < 2 || dstWidth < 8)
+            {
+                Base::Winograd2x3pSetOutput(src, dst, dstChannels, dstHeight, dstWidth);
+                return;
+            }
+            WinogradSetOutput(Winograd2x3pSetOutput, 2, src, dst, dstChannels, dstHeight, dstWidth);
+        }
+
         SIMD_INLINE void Winograd4x3pSetFilter4Row(const __m128 * t, float * dst, size_t stride)
         {
             const __m128 r4 = _mm_set1_ps(1.0f / 4.0f);
@@ -692,6 +700,179 @@ namespace Simd
             for (; i < size; i += 1, src += 9, dst += 1)
                 Base::Winograd4x3pSetFilter1(src, dst, size);
         }
+
+        SIMD_INLINE void Winograd4x3pSetInput6(const __m128 * src, size_t srcStep, __m128 * dst, size_t dstStep)
+        {
+            const __m128 _2 = _mm_set1_ps(2.0f);
+            const __m128 _4 = _mm_set1_ps(4.0f);
+            const __m128 _5 = _mm_set1_ps(5.0f);
+            const __m128 m2 = _mm_set1_ps(-2.0f);
+            const __m128 m4 = _mm_set1_ps(-4.0f);
+            __m128 s0 = src[0 * srcStep], s1 = src[1 * srcStep], s2 = src[2 * srcStep];
+            __m128 s3 = src[3 * srcStep], s4 = src[4 * srcStep], s5 = src[5 * srcStep];
+            dst[0 * dstStep] = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(_4, s0), _mm_mul_ps(_5, s2)), s4);
+            dst[1 * dstStep] = _mm_add_ps(_mm_add_ps(_mm_sub_ps(_mm_mul_ps(m4, s1), _mm_mul_ps(_4, s2)), s3), s4);
+            dst[2 * dstStep] = _mm_add_ps(_mm_sub_ps(_mm_sub_ps(_mm_mul_ps(_4, s1), _mm_mul_ps(_4, s2)), s3), s4);
+            dst[3 * dstStep] = _mm_add_ps(_mm_add_ps(_mm_sub_ps(_mm_mul_ps(m2, s1), s2), _mm_mul_ps(_2, s3)), s4);
+            dst[4 * dstStep] = _mm_add_ps(_mm_sub_ps(_mm_sub_ps(_mm_mul_ps(_2, s1), s2), _mm_mul_ps(_2, s3)), s4);
+            dst[5 * dstStep] = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(_4, s1), _mm_mul_ps(_5, s3)), s5);
+        }
+
+        SIMD_INLINE void Winograd4x3pSetInput4(const float * src, size_t srcStride, size_t rowB, size_t rowE, float * dst, size_t dstStride)
+        {
+            __m128 s[36], t[36], d[6];
+            for (size_t row = 0; row < 6; ++row)
+            {
+                __m128 * r = s + row * 6;
+                if (row < rowB || row >= rowE)
+                {
+                    for (size_t col = 0; col < 6; ++col)
+                        r[col] = _mm_setzero_ps();
+                    continue;
+                }
+                Load4(src + row * srcStride + 0, 4, r + 0);
+                Load4(src + row * srcStride + 2, 4, t);
+                r[4] = t[2];
+                r[5] = t[3];
+            }
+            for (size_t col = 0; col < 6; ++col)
+                Winograd4x3pSetInput6(s + col, 6, t + col, 6);
+            for (size_t row = 0; row < 6; ++row)
+            {
+                Winograd4x3pSetInput6(t + row * 6, 1, d, 1);
+                for (size_t col = 0; col < 6; ++col)
+                    _mm_storeu_ps(dst + (row * 6 + col) * dstStride, d[col]);
+            }
+        }
+
+        static void Winograd4x3pSetInput(const float * src, size_t srcChannels, size_t srcHeight, size_t srcWidth, float * dst, size_t dstStride, int pad)
+        {
+            size_t dstHeight = pad ? srcHeight : srcHeight - 2;
+            size_t dstWidth = pad ? srcWidth : srcWidth - 2;
+            size_t dstHeightFull = dstHeight / 4 * 4;
+            size_t dstWidthFull = dstWidth / 4 * 4;
+            size_t noseW = Simd::Min<size_t>(6, dstWidth + 1);
+            size_t noseH = Simd::Min<size_t>(6, dstHeight + 1);
+            size_t start = pad ? 4 : 0;
+            if (pad)
+            {
+                if (dstHeight == dstHeightFull)
+                    dstHeightFull -= 4;
+                if (dstWidth == dstWidthFull)
+                    dstWidthFull -= 4;
+                src -= srcWidth + 1;
+            }
+            size_t tailW = dstWidth - dstWidthFull + (pad ? 1 : 2);
+            size_t tailH = dstHeight - dstHeightFull + (pad ? 1 : 2);
+            for (size_t c = 0; c < srcChannels; ++c)
+            {
+                size_t row = 0, col = 0;
+                if (pad)
+                {
+                    Base::Winograd4x3pSetInput1p(src, srcWidth, 1, noseH, 1, noseW, dst++, dstStride);
+                    for (col = start; col + 12 < dstWidthFull; col += 16, dst += 4)
+                        Winograd4x3pSetInput4(src + col, srcWidth, 1, noseH, dst, dstStride);
+                    for (; col < dstWidthFull; col += 4)
+                        Base::Winograd4x3pSetInput1p(src + col, srcWidth, 1, noseH, 0, 6, dst++, dstStride);
+                    if (col < dstWidth)
+                        Base::Winograd4x3pSetInput1p(src + col, srcWidth, 1, noseH, 0, tailW, dst++, dstStride);
+                }
+                for (row = start; row < dstHeightFull; row += 4)
+                {
+                    if (pad)
+                        Base::Winograd4x3pSetInput1p(src + row * srcWidth, srcWidth, 0, 6, 1, noseW, dst++, dstStride);
+                    for (col = start; col + 12 < dstWidthFull; col += 16, dst += 4)
+                        Winograd4x3pSetInput4(src + row * srcWidth + col, srcWidth, 0, 6, dst, dstStride);
+                    for (; col < dstWidthFull; col += 4)
+                        Base::Winograd4x3pSetInput1(src + row * srcWidth + col, srcWidth, dst++, dstStride);
+                    if (col < dstWidth)
+                        Base::Winograd4x3pSetInput1p(src + row * srcWidth + col, srcWidth, 0, 6, 0, tailW, dst++, dstStride);
+                }
+                if (row < dstHeight)
+                {
+                    if (pad)
+                        Base::Winograd4x3pSetInput1p(src + row * srcWidth, srcWidth, 0, tailH, 1, noseW, dst++, dstStride);
+                    for (col = start; col + 12 < dstWidthFull; col += 16, dst += 4)
+                        Winograd4x3pSetInput4(src + row * srcWidth + col, srcWidth, 0, tailH, dst, dstStride);
+                    for (; col < dstWidthFull; col += 4)
+                        Base::Winograd4x3pSetInput1p(src + row * srcWidth + col, srcWidth, 0, tailH, 0, 6, dst++, dstStride);
+                    if (col < dstWidth)
+                        Base::Winograd4x3pSetInput1p(src + row * srcWidth + col, srcWidth, 0, tailH, 0, tailW, dst++, dstStride);
+                }
+                src += srcWidth * srcHeight;
+            }
+        }
+
+        void Winograd4x3pSetInput(const float * src, size_t srcChannels, size_t srcHeight, size_t srcWidth, float * dst, int pad)
+        {
+            WinogradSetInput(Winograd4x3pSetInput, 4, src, srcChannels, srcHeight, srcWidth, dst, pad);
+        }
+
+        SIMD_INLINE void Winograd4x3pSetOutput6(const __m128 * src, size_t srcStep, __m128 * dst, size_t dstStep)
+        {
+            const __m128 _2 = _mm_set1_ps(2.0f);
+            const __m128 _4 = _mm_set1_ps(4.0f);
+            const __m128 _8 = _mm_set1_ps(8.0f);
+            __m128 s0 = src[0 * srcStep], s1 = src[1 * srcStep], s2 = src[2 * srcStep];
+            __m128 s3 = src[3 * srcStep], s4 = src[4 * srcStep], s5 = src[5 * srcStep];
+            dst[0 * dstStep] = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_add_ps(s0, s1), s2), s3), s4);
+            dst[1 * dstStep] = _mm_sub_ps(_mm_add_ps(_mm_sub_ps(s1, s2), _mm_mul_ps(_2, s3)), _mm_mul_ps(_2, s4));
+            dst[2 * dstStep] = _mm_add_ps(_mm_add_ps(_mm_add_ps(s1, s2), _mm_mul_ps(_4, s3)), _mm_mul_ps(_4, s4));
+            dst[3 * dstStep] = _mm_add_ps(_mm_sub_ps(_mm_add_ps(_mm_sub_ps(s1, s2), _mm_mul_ps(_8, s3)), _mm_mul_ps(_8, s4)), s5);
+        }
+
+        SIMD_INLINE void Winograd4x3pSetOutput4(const float * src, size_t srcStride, float * dst, size_t dstStride, size_t rowE)
+        {
+            __m128 s[36], t[24], d[4];
+            for (size_t i = 0; i < 36; ++i)
+                s[i] = _mm_loadu_ps(src + i * srcStride);
+            for (size_t col = 0; col < 6; ++col)
+                Winograd4x3pSetOutput6(s + col, 6, t + col, 6);
+            for (size_t row = 0; row < rowE; ++row)
+            {
+                Winograd4x3pSetOutput6(t + row * 6, 1, d, 1);
+                _MM_TRANSPOSE4_PS(d[0], d[1], d[2], d[3]);
+                _mm_storeu_ps(dst + row * dstStride + 0, d[0]);
+                _mm_storeu_ps(dst + row * dstStride + 4, d[1]);
+                _mm_storeu_ps(dst + row * dstStride + 8, d[2]);
+                _mm_storeu_ps(dst + row * dstStride + 12, d[3]);
+            }
+        }
+
+        static void Winograd4x3pSetOutput(const float * src, size_t srcStride, float * dst, size_t dstChannels, size_t dstHeight, size_t dstWidth)
+        {
+            size_t dstHeightFull = dstHeight / 4 * 4;
+            size_t dstWidthFull = dstWidth / 4 * 4;
+            size_t dstWidthFull16 = dstWidth / 16 * 16;
+            for (size_t c = 0; c < dstChannels; ++c)
+            {
+                size_t row, col;
+                for (row = 0; row < dstHeightFull; row += 4)
+                {
+                    for (col = 0; col < dstWidthFull16; col += 16, src += 4)
+                        Winograd4x3pSetOutput4(src, srcStride, dst + row * dstWidth + col, dstWidth, 4);
+                    for (; col < dstWidthFull; col += 4)
+                        Base::Winograd4x3pSetOutput1(src++, srcStride, dst + row * dstWidth + col, dstWidth);
+                    if (col < dstWidth)
+                        Base::Winograd4x3pSetOutput1p(src++, srcStride, dst + row * dstWidth + col, dstWidth, 4, dstWidth - col);
+                }
+                if (row < dstHeight)
+                {
+                    for (col = 0; col < dstWidthFull16; col += 16, src += 4)
+                        Winograd4x3pSetOutput4(src, srcStride, dst + row * dstWidth + col, dstWidth, dstHeight - row);
+                    for (; col < dstWidthFull; col += 4)
+                        Base::Winograd4x3pSetOutput1p(src++, srcStride, dst + row * dstWidth + col, dstWidth, dstHeight - row, 4);
+                    if (col < dstWidth)
+                        Base::Winograd4x3pSetOutput1p(src++, srcStride, dst + row * dstWidth + col, dstWidth, dstHeight - row, dstWidth - col);
+                }
+                dst += dstHeight * dstWidth;
+            }
+        }
+
+        void Winograd4x3pSetOutput(const float * src, float * dst, size_t dstChannels, size_t dstHeight, size_t dstWidth)
+        {
+            WinogradSetOutput(Winograd4x3pSetOutput, 4, src, dst, dstChannels, dstHeight, dstWidth);
+        }
     }
 #endif// SIMD_SSE_ENABLE
 }
@@ -33,6 +33,7 @@ namespace Simd
         ConvolutionImgToRow::ConvolutionImgToRow(const ConvParam & p)
             : Base::ConvolutionImgToRow(p)
         {
+            SetGemm(Sse3::Gemm32fInit(SimdFalse, SimdTrue, _M, _N, _K));
         }
 
         bool ConvolutionImgToRow::Preferable(const ConvParam & p)
@@ -42,20 +43,45 @@ namespace Simd
 
         void ConvolutionImgToRow::GemmAndBias(const float * src, float * dst)
         {
-            const ConvParam & p = _param;
-            for (size_t g = 0; g < p.group; ++g)
-                Sse3::Gemm32fNT(_M, _N, _K, &_1, _weight + _weightStep * g, _K, src + _srcStep * g, _K, &_0, dst + _dstStep * g, _N);
-            if (_bias)
-                Sse::SynetAddBias(_bias, p.dstC, p.dstH*p.dstW, dst);
+            RunGemm(_gemm, src, dst);
         }
 
         //---------------------------------------------------------------------
 
-        void * ConvolutionInit(size_t srcC, size_t srcH, size_t srcW, size_t dstC, size_t kernelY, size_t kernelX, size_t dilationY, size_t dilationX, size_t strideY, size_t strideX, size_t padY, size_t padX, size_t padH, size_t padW, size_t group)
+        Convolution * ConvolutionCreate(const ConvParam & p, ConvolutionAlgorithm algorithm)
         {
-            ConvParam param(srcC, srcH, srcW, dstC, kernelY, kernelX, dilationY, dilationX, strideY, strideX, padY, padX, padH, padW, group);
-            if (ConvolutionWinograd2x3p::Preferable(param))
+            switch (algorithm)
+            {
+            case ConvolutionAlgorithmImgToCol: return new Sse::ConvolutionImgToCol(p);
+            case ConvolutionAlgorithmImgToRow: return new ConvolutionImgToRow(p);
+            case ConvolutionAlgorithmWinograd2x3p: return new Sse::ConvolutionWinograd2x3p(p);
+            case ConvolutionAlgorithmWinograd4x3p: return new Sse::ConvolutionWinograd4x3p(p);
+            case ConvolutionAlgorithmDirect: return new Base::ConvolutionDirect(p);
+            case ConvolutionAlgorithmDepthwise: return new Sse::ConvolutionDepthwise(p);
+            case ConvolutionAlgorithmNhwcGemm: return new Sse::ConvolutionNhwcGemm(p);
+            case ConvolutionAlgorithmNhwcDirect: return new Sse::ConvolutionNhwcDirect(p);
+            case ConvolutionAlgorithmNhwcDepthwise: return new Sse::ConvolutionNhwcDepthwise(p);
+            default: return NULL;
+            }
+        }
+
+        void * ConvolutionInit(SimdBool trans, size_t batch, size_t srcC, size_t srcH, size_t srcW, size_t dstC, size_t kernelY, size_t kernelX, size_t dilationY, size_t dilationX, size_t strideY, size_t strideX, size_t padY, size_t padX, size_t padH, size_t padW, size_t group, SimdConvolutionActivationType activation, const float * activationParams)
+        {
+            ConvParam param(trans, batch, srcC, srcH, srcW, dstC, kernelY, kernelX, dilationY, dilationX, strideY, strideX, padY, padX, padH, padW, group, activation, activationParams);
+            if (Convolution * convolution = Base::ConvolutionTune(param, "Sse3", ConvolutionCreate))
+                return convolution;
+            if (Base::ConvolutionNhwcDepthwise::Preferable(param))
+                return new Sse::ConvolutionNhwcDepthwise(param);
+            else if (Base::ConvolutionNhwcDirect::Preferable(param))
+                return new Sse::ConvolutionNhwcDirect(param);
+            else if (Base::ConvolutionNhwcGemm::Preferable(param))
+                return new Sse::ConvolutionNhwcGemm(param);
+            else if (ConvolutionWinograd4x3p::Preferable(param))
+                return new Sse::ConvolutionWinograd4x3p(param);
+            else if (ConvolutionWinograd2x3p::Preferable(param))
                 return new Sse::ConvolutionWinograd2x3p(param);
+            else if (ConvolutionDepthwise::Preferable(param))
+                return new Sse::ConvolutionDepthwise(param);
             else if (ConvolutionImgToRow::Preferable(param))
                 return new ConvolutionImgToRow(param);
             else
@@ -311,20 +311,33 @@ namespace Simd
             Add4ExtractedSums(c20, c21, c22, c23, _alpha, C + 2 * ldc);
         }
 
-        void Gemm32fNT(size_t M, size_t N, size_t K, const float * alpha, const float * A, size_t lda, const float * B, size_t ldb, const float * beta, float * C, size_t ldc)
+        static Gemm<float> * CreateGemm32fNT(size_t M, size_t N, size_t K)
         {
-            const size_t CACHE_L1_SIZE = 32 * 1024;
-            const size_t CACHE_L2_SIZE = 256 * 1024;
-            const size_t CACHE_L3_SIZE = 2 * 1024 * 1024;
+            const size_t CACHE_L1_SIZE = Base::AlgCacheL1();
+            const size_t CACHE_L2_SIZE = Base::AlgCacheL2();
+            const size_t CACHE_L3_SIZE = Base::AlgCacheL3();
             typedef Simd::GemmNT<float> GemmNT;
 #ifdef SIMD_X64_ENABLE
-            GemmNT gemmNT(M, N, K, CACHE_L1_SIZE, CACHE_L2_SIZE, CACHE_L3_SIZE, F, Sse::GemmScaleC,
-                Kernel1x1x4nt, Kernel1x4x4nt, Kernel2x1x4nt, Kernel2x4x4nt, Kernel3x1x4nt, Kernel3x4x4nt, NULL, NULL);
+            return new GemmNT(M, N, K, CACHE_L1_SIZE, CACHE_L2_SIZE, CACHE_L3_SIZE, F, Sse::GemmScaleC,
+                Kernel1x1x4nt, Kernel1x4x4nt, Kernel2x1x4nt, Kernel2x4x4nt, Kernel3x1x4nt, Kernel3x4x4nt, NULL, NULL, Sse::GemmApplyEpilogue);
 #else
-            GemmNT gemmNT(M, N, K, CACHE_L1_SIZE, CACHE_L2_SIZE, CACHE_L3_SIZE, F, Sse::GemmScaleC,
-                Kernel1x1x4nt, Kernel1x4x4nt, NULL, NULL, NULL, NULL, NULL, NULL);
+            return new GemmNT(M, N, K, CACHE_L1_SIZE, CACHE_L2_SIZE, CACHE_L3_SIZE, F, Sse::GemmScaleC,
+                Kernel1x1x4nt, Kernel1x4x4nt, NULL, NULL, NULL, NULL, NULL, NULL, Sse::GemmApplyEpilogue);
 #endif
-            gemmNT.Run(alpha, A, lda, B, ldb, beta, C, ldc);
+        }
+
+        void Gemm32fNT(size_t M, size_t N, size_t K, const float * alpha, const float * A, size_t lda, const float * B, size_t ldb, const float * beta, float * C, size_t ldc)
+        {
+            Gemm<float> * gemm = CreateGemm32fNT(M, N, K);
+            gemm->Run(alpha, A, lda, B, ldb, beta, C, ldc);
+            delete gemm;
+        }
+
+        void * Gemm32fInit(SimdBool transA, SimdBool transB, size_t M, size_t N, size_t K)
+        {
+            if (transB && !transA)
+                return CreateGemm32fNT(M, N, K);
+            return Sse::Gemm32fInit(transA, transB, M, N, K);
         }
     }
 #endif// SIMD_SSE3_ENABLE
@@ -46,6 +46,31 @@ namespace Simd
         {
             return Simd::Min(a, b);
         }
+
+        SIMD_INLINE float SynetElu32f(float value, float alpha)
+        {
+            return value >= 0.0f ? value : alpha*(::expf(value) - 1.0f);
+        }
+
+        SIMD_INLINE float SynetGelu32f(float value)
+        {
+            return 0.5f*value*(1.0f + ::tanhf(0.7978845608f*(value + 0.044715f*value*value*value)));
+        }
+
+        SIMD_INLINE float SynetHswish32f(float value, float shift, float scale)
+        {
+            return Simd::Max(Simd::Min(value, shift) + shift, 0.0f)*scale*value;
+        }
+
+        SIMD_INLINE float SynetSigmoid32f(float value)
+        {
+            return 1.0f / (1.0f + ::expf(-value));
+        }
+
+        SIMD_INLINE float SynetTanh32f(float value)
+        {
+            return ::tanhf(value);
+        }
     }
 }
 
@@ -0,0 +1,542 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2018 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#ifndef __SimdSynet_hpp__
+#define __SimdSynet_hpp__
+
+#include "Simd/SimdLib.hpp"
+
+#include <assert.h>
+#include <string.h>
+
+#include <vector>
+#include <numeric>
+#include <algorithm>
+
+namespace Simd
+{
+    /*! @ingroup cpp_synet
+
+        \short Contains a runtime which executes a graph of Synet layers (see \ref synet) in one preallocated memory arena.
+    */
+    namespace Synet
+    {
+        typedef std::vector<float, Allocator<float>> Vector; /*!< \brief Vector with 32-bit float point values. */
+        typedef size_t Tensor; /*!< \brief An identifier of tensor in Network. */
+
+        /*! @ingroup cpp_synet
+
+            \short Network class executes a graph of Synet layers.
+
+            All tensors have NCHW format and the same batch size. The layers are executed in order of their addition.
+            Method Network::Build must be called after the last layer is added. It folds bias and scale layers into preceding convolutions,
+            executes the rest element-wise layers in place where it is possible, computes lifetimes of tensors and packs them into one memory arena.
+            After that Network::Forward does not allocate any memory.
+
+            Using example:
+            \code
+            #include "Simd/SimdSynet.hpp"
+
+            const float * Run(Simd::Synet::Network & net, const float * image, const float * weight0, const float * bias0, const float * weight1, const float * scale, const float * shift)
+            {
+                Simd::Synet::Tensor src = net.Input(3, 64, 64);
+                Simd::Synet::Tensor conv0 = net.Convolution(src, 16, 3, 1, 1, 1, weight0, bias0, SimdConvolutionActivationRelu);
+                Simd::Synet::Tensor conv1 = net.Convolution(conv0, 16, 3, 1, 1, 1, weight1, NULL);
+                Simd::Synet::Tensor dst = net.Scale(conv1, scale, shift);
+                net.Output(dst);
+                if (!net.Build())
+                    return NULL;
+                net.Forward(image);
+                return net.Data(dst);
+            }
+            \endcode
+        */
+        class Network
+        {
+        public:
+            /*!
+                Creates a new empty Network.
+
+                \param [in] batch - a batch size of all tensors.
+            */
+            Network(size_t batch = 1)
+                : _batch(batch)
+                , _scratch(0)
+                , _input(UNDEFINED)
+                , _src(NULL)
+                , _built(false)
+            {
+            }
+
+            /*!
+                A Network destructor.
+            */
+            ~Network()
+            {
+                for (size_t i = 0; i < _layers.size(); ++i)
+                    if (_layers[i].handle)
+                        ::SimdRelease(_layers[i].handle);
+            }
+
+            /*!
+                Adds input tensor of the network. It can be called only once.
+
+                \param [in] channels - a number of channels.
+                \param [in] height - a height of input image.
+                \param [in] width - a width of input image.
+                \return an identifier of input tensor.
+            */
+            Tensor Input(size_t channels, size_t height, size_t width)
+            {
+                assert(_input == UNDEFINED && !_built);
+                _input = AddTensor(channels, height, width);
+                return _input;
+            }
+
+            /*!
+                Adds convolution layer (see ::SimdConvolutionInit). Weight has [dstC, srcC/group, kernel, kernel] layout.
+                The weight, bias and activation parameters are copied to the network.
+
+                \param [in] src - an input tensor.
+                \param [in] dstC - a number of output channels.
+                \param [in] kernel - a size of convolution kernel.
+                \param [in] stride - a stride of convolution.
+                \param [in] pad - a padding of convolution (the same at all sides).
+                \param [in] group - a number of convolution groups.
+                \param [in] weight - a pointer to convolution weight.
+                \param [in] bias - a pointer to bias. Can be NULL.
+                \param [in] activation - an activation function type.
+                \param [in] params - a pointer to activation function parameters. Can be NULL.
+                \return an identifier of output tensor.
+            */
+            Tensor Convolution(Tensor src, size_t dstC, size_t kernel, size_t stride, size_t pad, size_t group, const float * weight, const float * bias,
+                SimdConvolutionActivationType activation = SimdConvolutionActivationIdentity, const float * params = NULL)
+            {
+                size_t srcC = _tensors[src].channels, srcH = _tensors[src].height, srcW = _tensors[src].width;
+                Layer layer(LayerConvolution, src);
+                layer.weight.assign(weight, weight + dstC * srcC / group * kernel * kernel);
+                return AddConvolution(layer, dstC, kernel, stride, pad, group, bias, activation, params,
+                    (srcH + 2 * pad - kernel) / stride + 1, (srcW + 2 * pad - kernel) / stride + 1);
+            }
+
+            /*!
+                Adds deconvolution layer (see ::SimdDeconvolutionInit). Weight has [srcC, dstC/group, kernel, kernel] layout.
+                The weight, bias and activation parameters are copied to the network.
+
+                \param [in] src - an input tensor.
+                \param [in] dstC - a number of output channels.
+                \param [in] kernel - a size of deconvolution kernel.
+                \param [in] stride - a stride of deconvolution.
+                \param [in] pad - a padding of deconvolution (the same at all sides).
+                \param [in] group - a number of deconvolution groups.
+                \param [in] weight - a pointer to deconvolution weight.
+                \param [in] bias - a pointer to bias. Can be NULL.
+                \param [in] activation - an activation function type.
+                \param [in] params - a pointer to activation function parameters. Can be NULL.
+                \return an identifier of output tensor.
+            */
+            Tensor Deconvolution(Tensor src, size_t dstC, size_t kernel, size_t stride, size_t pad, size_t group, const float * weight, const float * bias,
+                SimdConvolutionActivationType activation = SimdConvolutionActivationIdentity, const float * params = NULL)
+            {
+                size_t srcC = _tensors[src].channels, srcH = _tensors[src].height, srcW = _tensors[src].width;
+                Layer layer(LayerDeconvolution, src);
+                layer.weight.assign(weight, weight + srcC * dstC / group * kernel * kernel);
+                return AddConvolution(layer, dstC, kernel, stride, pad, group, bias, activation, params,
+                    stride * (srcH - 1) + kernel - 2 * pad, stride * (srcW - 1) + kernel - 2 * pad);
+            }
+
+            /*!
+                Adds bias addition layer (see ::SimdSynetAddBias).
+
+                \param [in] src - an input tensor.
+                \param [in] bias - a pointer to bias (one value per channel). It is copied to the network.
+                \return an identifier of output tensor.
+            */
+            Tensor AddBias(Tensor src, const float * bias)
+            {
+                Layer layer(LayerAddBias, src);
+                layer.bias.assign(bias, bias + _tensors[src].channels);
+                return AddLayer(layer, _tensors[src].channels, _tensors[src].height, _tensors[src].width);
+            }
+
+            /*!
+                Adds scale layer (see ::SimdSynetScaleLayerForward).
+
+                \param [in] src - an input tensor.
+                \param [in] scale - a pointer to scale (one value per channel). It is copied to the network.
+                \param [in] bias - a pointer to bias (one value per channel). It is copied to the network. Can be NULL.
+                \return an identifier of output tensor.
+            */
+            Tensor Scale(Tensor src, const float * scale, const float * bias)
+            {
+                Layer layer(LayerScale, src);
+                layer.weight.assign(scale, scale + _tensors[src].channels);
+                if (bias)
+                    layer.bias.assign(bias, bias + _tensors[src].channels);
+                return AddLayer(layer, _tensors[src].channels, _tensors[src].height, _tensors[src].width);
+            }
+
+            /*!
+                Adds element-wise layer (see ::SimdSynetEltwiseLayerForward). All input tensors must have the same shape.
+
+                \param [in] src - input tensors (at least 2).
+                \param [in] operation - a type of operation.
+                \param [in] weight - a pointer to sum coefficients (one value per input). It is need only for ::SimdSynetEltwiseOperationSum.
+                \return an identifier of output tensor.
+            */
+            Tensor Eltwise(const std::vector<Tensor> & src, SimdSynetEltwiseOperationType operation, const float * weight = NULL)
+            {
+                assert(src.size() >= 2);
+                Layer layer(LayerEltwise, src[0]);
+                layer.src = src;
+                layer.operation = operation;
+                if (weight)
+                    layer.weight.assign(weight, weight + src.size());
+                return AddLayer(layer, _tensors[src[0]].channels, _tensors[src[0]].height, _tensors[src[0]].width);
+            }
+
+            /*!
+                Adds cross channels local response normalization layer (see ::SimdSynetLrnLayerCrossChannels).
+
+                \param [in] src - an input tensor.
+                \param [in] half - a local normalization half size.
+                \param [in] k - a pointer to 3 coefficients of normalization.
+                \return an identifier of output tensor.
+            */
+            Tensor Lrn(Tensor src, size_t half, const float * k)
+            {
+                Layer layer(LayerLrn, src);
+                layer.half = half;
+                layer.params.assign(k, k + 3);
+                return AddLayer(layer, _tensors[src].channels, _tensors[src].height, _tensors[src].width);
+            }
+
+            /*!
+                Marks tensor as output of the network. Its data stay valid after Network::Forward.
+
+                \param [in] tensor - a tensor.
+            */
+            void Output(Tensor tensor)
+            {
+                assert(!_built);
+                _tensors[tensor].output = true;
+            }
+
+            /*!
+                Prepares the network to execution: fuses layers, plans memory arena and creates convolution engines.
+
+                \return a result of this operation.
+            */
+            bool Build()
+            {
+                if (_input == UNDEFINED || _built)
+                    return false;
+                for (size_t i = 0; i < _layers.size(); ++i)
+                    for (size_t j = 0; j < _layers[i].src.size(); ++j)
+                        _tensors[_layers[i].src[j]].consumers++;
+                Fuse();
+                Plan();
+                size_t scratch = 0;
+                for (size_t i = 0; i < _layers.size(); ++i)
+                {
+                    Layer & l = _layers[i];
+                    if (l.skip || (l.type != LayerConvolution && l.type != LayerDeconvolution))
+                        continue;
+                    const Shape & s = _tensors[l.src[0]], & d = _tensors[l.dst];
+                    const float * bias = l.bias.empty() ? NULL : l.bias.data();
+                    const float * params = l.params.empty() ? NULL : l.params.data();
+                    if (l.type == LayerConvolution)
+                    {
+                        l.handle = ::SimdConvolutionInit(SimdFalse, _batch, s.channels, s.height, s.width, d.channels, l.kernel, l.kernel,
+                            1, 1, l.stride, l.stride, l.pad, l.pad, l.pad, l.pad, l.group, l.activation, params);
+                        if (l.handle == NULL)
+                            return false;
+                        ::SimdConvolutionSetWeight(l.handle, l.weight.data(), bias);
+                        scratch = std::max(scratch, ::SimdConvolutionBufferSize(l.handle));
+                    }
+                    else
+                    {
+                        l.handle = ::SimdDeconvolutionInit(SimdFalse, _batch, s.channels, s.height, s.width, d.channels, l.kernel, l.kernel,
+                            1, 1, l.stride, l.stride, l.pad, l.pad, l.pad, l.pad, l.group, l.activation, params);
+                        if (l.handle == NULL)
+                            return false;
+                        ::SimdDeconvolutionSetWeight(l.handle, l.weight.data(), bias);
+                        scratch = std::max(scratch, ::SimdDeconvolutionBufferSize(l.handle));
+                    }
+                }
+                for (size_t i = 0; i < _layers.size(); ++i)
+                    _sources.resize(std::max(_sources.size(), _layers[i].src.size()));
+                _arena.resize(_scratch + scratch);
+                _built = true;
+                return true;
+            }
+
+            /*!
+                Executes the network.
+
+                \param [in] src - a pointer to input data. Its size must be equal to batch*channels*height*width of input tensor.
+            */
+            void Forward(const float * src)
+            {
+                assert(_built);
+                _src = src;
+                float * scratch = _arena.data() + _scratch;
+                for (size_t i = 0; i < _layers.size(); ++i)
+                {
+                    const Layer & l = _layers[i];
+                    if (l.skip)
+                        continue;
+                    const Shape & d = _tensors[l.dst];
+                    size_t size = d.height * d.width, count = d.channels * size;
+                    const float * ps = Data(l.src[0]);
+                    float * pd = Mutable(l.dst);
+                    switch (l.type)
+                    {
+                    case LayerConvolution:
+                        ::SimdConvolutionForward(l.handle, ps, scratch, pd);
+                        break;
+                    case LayerDeconvolution:
+                        ::SimdDeconvolutionForward(l.handle, ps, scratch, pd);
+                        break;
+                    case LayerAddBias:
+                        if (ps != pd)
+                            memcpy(pd, ps, _batch * count * sizeof(float));
+                        for (size_t b = 0; b < _batch; ++b)
+                            ::SimdSynetAddBias(l.bias.data(), d.channels, size, pd + b * count);
+                        break;
+                    case LayerScale:
+                        for (size_t b = 0; b < _batch; ++b)
+                            ::SimdSynetScaleLayerForward(ps + b * count, l.weight.data(), l.bias.empty() ? NULL : l.bias.data(), d.channels, size, pd + b * count);
+                        break;
+                    case LayerEltwise:
+                        for (size_t j = 0; j < l.src.size(); ++j)
+                            _sources[j] = Data(l.src[j]);
+                        ::SimdSynetEltwiseLayerForward(_sources.data(), l.weight.empty() ? NULL : l.weight.data(), l.src.size(), _batch * count, l.operation, pd);
+                        break;
+                    case LayerLrn:
+                        for (size_t b = 0; b < _batch; ++b)
+                            ::SimdSynetLrnLayerCrossChannels(ps + b * count, l.half, d.channels, size, l.params.data(), pd + b * count);
+                        break;
+                    }
+                }
+            }
+
+            /*!
+                Gets data of the tensor. Only data of input and output tensors (see Network::Output) are valid after Network::Forward.
+
+                \param [in] tensor - a tensor.
+                \return a pointer to tensor data.
+            */
+            const float * Data(Tensor tensor) const
+            {
+                return tensor == _input ? _src : _arena.data() + _storages[_tensors[tensor].storage].offset;
+            }
+
+            /*!
+                Gets size of memory arena (activations and scratch buffer of convolutions) in bytes.
+
+                \return size of memory arena.
+            */
+            size_t MemoryUsage() const
+            {
+                return _arena.size() * sizeof(float);
+            }
+
+        private:
+            static const size_t UNDEFINED = size_t(-1);
+
+            enum LayerType
+            {
+                LayerConvolution,
+                LayerDeconvolution,
+                LayerAddBias,
+                LayerScale,
+                LayerEltwise,
+                LayerLrn,
+            };
+
+            struct Shape
+            {
+                size_t channels, height, width, producer, consumers, storage;
+                bool output;
+            };
+
+            struct Layer
+            {
+                LayerType type;
+                std::vector<Tensor> src;
+                Tensor dst;
+                size_t kernel, stride, pad, group, half;
+                SimdConvolutionActivationType activation;
+                SimdSynetEltwiseOperationType operation;
+                Vector weight, bias, params;
+                void * handle;
+                bool skip, inplace;
+
+                Layer(LayerType t, Tensor s)
+                    : type(t), src(1, s), dst(UNDEFINED), kernel(0), stride(0), pad(0), group(0), half(0)
+                    , activation(SimdConvolutionActivationIdentity), operation(SimdSynetEltwiseOperationSum)
+                    , handle(NULL), skip(false), inplace(false)
+                {
+                }
+            };
+
+            struct Storage
+            {
+                size_t size, begin, end, offset;
+            };
+
+            Network(const Network &);
+            Network & operator = (const Network &);
+
+            size_t _batch, _scratch;
+            Tensor _input;
+            const float * _src;
+            bool _built;
+            std::vector<Shape> _tensors;
+            std::vector<Layer> _layers;
+            std::vector<Storage> _storages;
+            std::vector<const float *> _sources;
+            Vector _arena;
+
+            Tensor AddTensor(size_t channels, size_t height, size_t width)
+            {
+                Shape shape = { channels, height, width, _layers.size(), 0, UNDEFINED, false };
+                _tensors.push_back(shape);
+                return _tensors.size() - 1;
+            }
+
+            Tensor AddLayer(Layer & layer, size_t channels, size_t height, size_t width)
+            {
+                assert(!_built);
+                layer.dst = AddTensor(channels, height, width);
+                _layers.push_back(layer);
+                return layer.dst;
+            }
+
+            Tensor AddConvolution(Layer & layer, size_t dstC, size_t kernel, size_t stride, size_t pad, size_t group, const float * bias,
+                SimdConvolutionActivationType activation, const float * params, size_t dstH, size_t dstW)
+            {
+                layer.kernel = kernel;
+                layer.stride = stride;
+                layer.pad = pad;
+                layer.group = group;
+                layer.activation = activation;
+                if (bias)
+                    layer.bias.assign(bias, bias + dstC);
+                size_t paramsSize = activation == SimdConvolutionActivationLeakyRelu ? 1 : (activation == SimdConvolutionActivationPrelu ? dstC : 0);
+                if (params && paramsSize)
+                    layer.params.assign(params, params + paramsSize);
+                return AddLayer(layer, dstC, dstH, dstW);
+            }
+
+            float * Mutable(Tensor tensor)
+            {
+                return _arena.data() + _storages[_tensors[tensor].storage].offset;
+            }
+
+            void Fuse()
+            {
+                for (size_t i = 0; i < _layers.size(); ++i)
+                {
+                    Layer & l = _layers[i];
+                    if (l.type != LayerAddBias && l.type != LayerScale)
+                        continue;
+                    const Shape & s = _tensors[l.src[0]];
+                    if (l.src[0] == _input || s.consumers != 1 || s.output)
+                        continue;
+                    Layer & p = _layers[s.producer];
+                    if (p.type == LayerConvolution && p.activation == SimdConvolutionActivationIdentity)
+                    {
+                        size_t dstC = s.channels, size = p.weight.size() / dstC;
+                        p.bias.resize(dstC, 0.0f);
+                        for (size_t c = 0; c < dstC; ++c)
+                        {
+                            if (l.type == LayerAddBias)
+                                p.bias[c] += l.bias[c];
+                            else
+                            {
+                                for (size_t k = 0; k < size; ++k)
+                                    p.weight[c * size + k] *= l.weight[c];
+                                p.bias[c] = p.bias[c] * l.weight[c] + (l.bias.empty() ? 0.0f : l.bias[c]);
+                            }
+                        }
+                        p.dst = l.dst;
+                        _tensors[l.dst].producer = s.producer;
+                        l.skip = true;
+                    }
+                    else
+                        l.inplace = true;
+                }
+            }
+
+            void Plan()
+            {
+                size_t align = Allocator<float>::Alignment() / sizeof(float);
+                for (size_t i = 0; i < _layers.size(); ++i)
+                {
+                    const Layer & l = _layers[i];
+                    if (l.skip)
+                        continue;
+                    for (size_t j = 0; j < l.src.size(); ++j)
+                        if (l.src[j] != _input)
+                            _storages[_tensors[l.src[j]].storage].end = i;
+                    Shape & d = _tensors[l.dst];
+                    if (l.inplace)
+                        d.storage = _tensors[l.src[0]].storage;
+                    else
+                    {
+                        Storage storage = { Allocator<float>::Align(_batch * d.channels * d.height * d.width, align), i, i, 0 };
+                        d.storage = _storages.size();
+                        _storages.push_back(storage);
+                    }
+                }
+                for (size_t t = 0; t < _tensors.size(); ++t)
+                    if (_tensors[t].output && t != _input)
+                        _storages[_tensors[t].storage].end = _layers.size();
+
+                std::vector<size_t> order(_storages.size());
+                std::iota(order.begin(), order.end(), 0);
+                std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) { return _storages[a].size > _storages[b].size; });
+                std::vector<const Storage*> placed, busy;
+                _scratch = 0;
+                for (size_t i = 0; i < order.size(); ++i)
+                {
+                    Storage & s = _storages[order[i]];
+                    busy.clear();
+                    for (size_t j = 0; j < placed.size(); ++j)
+                        if (placed[j]->begin <= s.end && s.begin <= placed[j]->end)
+                            busy.push_back(placed[j]);
+                    std::sort(busy.begin(), busy.end(), [](const Storage * a, const Storage * b) { return a->offset < b->offset; });
+                    s.offset = 0;
+                    for (size_t j = 0; j < busy.size() && s.offset + s.size > busy[j]->offset; ++j)
+                        s.offset = std::max(s.offset, busy[j]->offset + busy[j]->size);
+                    placed.push_back(&s);
+                    _scratch = std::max(_scratch, s.offset + s.size);
+                }
+            }
+        };
+    }
+}
+
+#endif//__SimdSynet_hpp__
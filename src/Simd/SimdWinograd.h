@@ -26,9 +26,36 @@
 
 #include "Simd/SimdMath.h"
 #include "Simd/SimdLoad.h"
+#include "Simd/SimdBase.h"
+#include "Simd/SimdGemm.h"
 
 namespace Simd
 {
+    typedef void(*WinogradSetInputPtr)(const float * src, size_t srcChannels, size_t srcHeight, size_t srcWidth, float * dst, size_t dstStride, int pad);
+    typedef void(*WinogradSetOutputPtr)(const float * src, size_t srcStride, float * dst, size_t dstChannels, size_t dstHeight, size_t dstWidth);
+
+    SIMD_INLINE void WinogradSetInput(WinogradSetInputPtr setInput, size_t block, const float * src, size_t srcChannels, size_t srcHeight, size_t srcWidth, float * dst, int pad)
+    {
+        size_t dstHeight = pad ? srcHeight : srcHeight - 2;
+        size_t dstWidth = pad ? srcWidth : srcWidth - 2;
+        size_t tiles = ((dstHeight + block - 1) / block) * ((dstWidth + block - 1) / block);
+        size_t srcSize = srcHeight * srcWidth;
+        Simd::Parallel(0, srcChannels, [&](size_t thread, size_t begin, size_t end)
+        {
+            setInput(src + begin * srcSize, end - begin, srcHeight, srcWidth, dst + begin * tiles, tiles * srcChannels, pad);
+        }, ConvolutionThreads(srcChannels * srcSize));
+    }
+
+    SIMD_INLINE void WinogradSetOutput(WinogradSetOutputPtr setOutput, size_t block, const float * src, float * dst, size_t dstChannels, size_t dstHeight, size_t dstWidth)
+    {
+        size_t tiles = ((dstHeight + block - 1) / block) * ((dstWidth + block - 1) / block);
+        size_t dstSize = dstHeight * dstWidth;
+        Simd::Parallel(0, dstChannels, [&](size_t thread, size_t begin, size_t end)
+        {
+            setOutput(src + begin * tiles, tiles * dstChannels, dst + begin * dstSize, end - begin, dstHeight, dstWidth);
+        }, ConvolutionThreads(dstChannels * dstSize));
+    }
+
     namespace Base
     {
         SIMD_INLINE void Winograd2x3iSetInput1(const float * src, size_t srcStride, float * dst)
@@ -131,6 +158,14 @@ namespace Simd
             dst[15 * stride] = src[8];
         }
 
+        void Winograd4x3pSetInput1(const float * src, size_t srcStride, float * dst, size_t dstStride);
+
+        void Winograd4x3pSetInput1p(const float * src, size_t srcStride, size_t rowB, size_t rowE, size_t colB, size_t colE, float * dst, size_t dstStride);
+
+        void Winograd4x3pSetOutput1(const float * src, size_t srcStride, float * dst, size_t dstStride);
+
+        void Winograd4x3pSetOutput1p(const float * src, size_t srcStride, float * dst, size_t dstStride, size_t rowE, size_t colE);
+
         SIMD_INLINE void Winograd4x3pSetFilter1(const float * src, float * dst, size_t stride)
         {
             const float r4 = float(1.0f / 4.0f);
@@ -138,6 +138,14 @@ namespace Test
     TEST_ADD_GROUP_AD0(CopyFrame);
 
     TEST_ADD_GROUP_A00(ConvolutionForward);
+    TEST_ADD_GROUP_A00(ConvolutionThreads);
+    TEST_ADD_GROUP_A00(ConvolutionTune);
+    TEST_ADD_GROUP_A00(Convolution8iForward);
+
+    TEST_ADD_GROUP_A00(DeconvolutionForward);
+    TEST_ADD_GROUP_A00(DeconvolutionStride2);
+
+    TEST_ADD_GROUP_A00(CpuCache);
 
     TEST_ADD_GROUP_AD0(Crc32c);
 
@@ -189,6 +197,15 @@ namespace Test
 
     TEST_ADD_GROUP_AD0(Gemm32fNN);
     TEST_ADD_GROUP_AD0(Gemm32fNT);
+    TEST_ADD_GROUP_A00(Gemm32fTN);
+    TEST_ADD_GROUP_A00(Gemm32fTT);
+    TEST_ADD_GROUP_A00(Gemm32fInit);
+    TEST_ADD_GROUP_A00(Gemm32fPackedB);
+    TEST_ADD_GROUP_A00(Gemm32fBatched);
+    TEST_ADD_GROUP_A00(Gemm32fRun16);
+    TEST_ADD_GROUP_A00(Gemm32fEpilogue);
+    TEST_ADD_GROUP_A00(Gemm8u8i32iNN);
+    TEST_ADD_GROUP_A00(Gemm8u8i8uNN);
 
     TEST_ADD_GROUP_AD0(MeanFilter3x3);
     TEST_ADD_GROUP_AD0(MedianFilterRhomb3x3);
@@ -274,7 +291,11 @@ namespace Test
     TEST_ADD_GROUP_AD0(NeuralPooling2x2Max2x2);
     TEST_ADD_GROUP_AD0(NeuralPooling2x2Max3x3);
     TEST_ADD_GROUP_AD0(NeuralConvolutionForward);
+    TEST_ADD_GROUP_A00(NeuralConvolutionalLayerFast);
+    TEST_ADD_GROUP_A00(NeuralTrainThreads);
     TEST_ADD_GROUP_00S(NeuralPredict);
+    TEST_ADD_GROUP_00S(NeuralPredictBatch);
+    TEST_ADD_GROUP_00S(NeuralPredictBinary);
     TEST_ADD_GROUP_00S(NeuralTrain);
 
     TEST_ADD_GROUP_AD0(OperationBinary8u);
@@ -323,14 +344,24 @@ namespace Test
 
     TEST_ADD_GROUP_AD0(SynetAddBias);
     TEST_ADD_GROUP_AD0(SynetEltwiseLayerForward);
+    TEST_ADD_GROUP_A00(SynetElu32f);
+    TEST_ADD_GROUP_A00(SynetGelu32f);
+    TEST_ADD_GROUP_A00(SynetHswish32f);
     TEST_ADD_GROUP_AD0(SynetLrnLayerCrossChannels);
     TEST_ADD_GROUP_AD0(SynetScaleLayerForward);
+    TEST_ADD_GROUP_A00(SynetSigmoid32f);
+    TEST_ADD_GROUP_AD0(SynetSoftmaxLayerForward);
+    TEST_ADD_GROUP_A00(SynetTanh32f);
+    TEST_ADD_GROUP_00S(SynetNetwork);
 
     TEST_ADD_GROUP_AD0(TextureBoostedSaturatedGradient);
     TEST_ADD_GROUP_AD0(TextureBoostedUv);
     TEST_ADD_GROUP_AD0(TextureGetDifferenceSum);
     TEST_ADD_GROUP_AD0(TexturePerformCompensation);
 
+    TEST_ADD_GROUP_A00(ThreadPool);
+    TEST_ADD_GROUP_A00(Context);
+
     TEST_ADD_GROUP_AD0(Winograd2x3iSetInput);
     TEST_ADD_GROUP_AD0(Winograd2x3iSetOutput);
     TEST_ADD_GROUP_AD0(Winograd2x3pSetFilter);
@@ -35,6 +35,9 @@
 
 #include <iostream>
 
+#include "Test/TestUtils.h"
+#include "Test/TestPerformance.h"
+
 namespace Test
 {
     static void TestCpuInfo()
@@ -54,6 +57,8 @@ namespace Test
         std::cout << "PowerPC-VSX: " << (info&(1 << SimdCpuInfoVsx) ? "Yes" : "No") << std::endl;
         std::cout << "ARM-NEON: " << (info&(1 << SimdCpuInfoNeon) ? "Yes" : "No") << std::endl;
         std::cout << "MIPS-MSA: " << (info&(1 << SimdCpuInfoMsa) ? "Yes" : "No") << std::endl;
+        for (size_t level = 1; level <= 3; ++level)
+            std::cout << "L" << level << " cache: " << ::SimdCpuCacheSize(level) / 1024 << " KB, shared by " << ::SimdCpuCacheSharing(level) << " core(s)" << std::endl;
     }
 
     static void TestPoint()
@@ -117,6 +122,55 @@ namespace Test
         v[15] = 0.0f;
     }
 
+    bool CpuCacheAutoTest()
+    {
+        bool result = true;
+
+        TEST_LOG_SS(Info, "Test SimdCpuCacheSize & SimdCpuCacheSharing.");
+
+        size_t size[4], sharing[4];
+        for (size_t level = 0; level < 4; ++level)
+        {
+            {
+                TEST_PERFORMANCE_TEST("SimdCpuCacheSize");
+                size[level] = ::SimdCpuCacheSize(level);
+                sharing[level] = ::SimdCpuCacheSharing(level);
+            }
+            {
+                TEST_PERFORMANCE_TEST("Simd::Base::CpuCacheSize");
+                if (Simd::Base::CpuCacheSize(level) != size[level] || Simd::Base::CpuCacheSharing(level) != sharing[level])
+                {
+                    TEST_LOG_SS(Error, "L" << level << " cache: SimdCpuCacheSize or SimdCpuCacheSharing differs from Simd::Base!");
+                    result = false;
+                }
+            }
+        }
+
+        if (size[0] != 0 || sharing[0] != 0 || ::SimdCpuCacheSize(4) != 0 || ::SimdCpuCacheSharing(4) != 0)
+        {
+            TEST_LOG_SS(Error, "Unknown cache level must have zero size and sharing!");
+            result = false;
+        }
+
+        for (size_t level = 1; level <= 3; ++level)
+        {
+            TEST_LOG_SS(Info, "L" << level << " cache: " << size[level] / 1024 << " KB, shared by " << sharing[level] << " core(s).");
+            if (size[level] == 0 || sharing[level] == 0)
+            {
+                TEST_LOG_SS(Error, "L" << level << " cache has zero size or sharing!");
+                result = false;
+            }
+        }
+
+        if (size[1] > size[2] || size[2] > size[3])
+        {
+            TEST_LOG_SS(Error, "Cache sizes must satisfy L1 <= L2 <= L3!");
+            result = false;
+        }
+
+        return result;
+    }
+
     void CheckCpp()
     {
         //TestCpuInfo();
@@ -26,7 +26,7 @@
 #include "Test/TestData.h"
 #include "Test/TestTensor.h"
 
-#include "Simd/SimdConvolution.h"
+#include "Simd/SimdConvolution8i.h"
 
 namespace Test
 {
@@ -34,20 +34,39 @@ namespace Test
     {
         struct Param
         {
-            size_t srcC, srcH, srcW, dstC, kernelY, kernelX, dilationY, dilationX, strideY, strideX, padY, padX, padH, padW, group;
+            size_t srcC, srcH, srcW, dstC, kernelY, kernelX, dilationY, dilationX, strideY, strideX, padY, padX, padH, padW, group, batch;
+            SimdBool trans;
+            SimdConvolutionActivationType activation;
 
-            Param(size_t sC, size_t sH, size_t sW, size_t dC, size_t kY, size_t kX, size_t dY, size_t dX, size_t sY, size_t sX, size_t pY, size_t pX, size_t pH, size_t pW, size_t g)
-                : srcC(sC), srcH(sH), srcW(sW), dstC(dC), kernelY(kY), kernelX(kX), dilationY(dY), dilationX(dX), strideY(sY), strideX(sX), padY(pY), padX(pX), padH(pH), padW(pW), group(g)
+            Param(size_t sC, size_t sH, size_t sW, size_t dC, size_t kY, size_t kX, size_t dY, size_t dX, size_t sY, size_t sX, size_t pY, size_t pX, size_t pH, size_t pW, size_t g, SimdBool t = SimdFalse, size_t n = 1, SimdConvolutionActivationType a = SimdConvolutionActivationIdentity)
+                : srcC(sC), srcH(sH), srcW(sW), dstC(dC), kernelY(kY), kernelX(kX), dilationY(dY), dilationX(dX), strideY(sY), strideX(sX), padY(pY), padX(pX), padH(pH), padW(pW), group(g), batch(n), trans(t), activation(a)
             {}
 
-            Param(size_t sC, size_t sH, size_t sW, size_t dC, Size k, Size d, Size s, Size b, Size e, size_t g)
-                : srcC(sC), srcH(sH), srcW(sW), dstC(dC), kernelY(k.y), kernelX(k.x), dilationY(d.y), dilationX(d.x), strideY(s.y), strideX(s.x), padY(b.y), padX(b.x), padH(e.y), padW(e.x), group(g)
+            Param(size_t sC, size_t sH, size_t sW, size_t dC, Size k, Size d, Size s, Size b, Size e, size_t g, SimdBool t = SimdFalse, size_t n = 1, SimdConvolutionActivationType a = SimdConvolutionActivationIdentity)
+                : srcC(sC), srcH(sH), srcW(sW), dstC(dC), kernelY(k.y), kernelX(k.x), dilationY(d.y), dilationX(d.x), strideY(s.y), strideX(s.x), padY(b.y), padX(b.x), padH(e.y), padW(e.x), group(g), batch(n), trans(t), activation(a)
             {}
+
+            Shape SrcShape() const
+            {
+                return trans ? Shape({ batch, srcH, srcW, srcC }) : Shape({ batch, srcC, srcH, srcW });
+            }
+
+            Shape WeightShape() const
+            {
+                return trans ? Shape({ kernelY, kernelX, srcC / group, dstC }) : Shape({ dstC, srcC / group, kernelY, kernelX });
+            }
+
+            Shape DstShape() const
+            {
+                size_t dstH = (srcH + padY + padH - (dilationY * (kernelY - 1) + 1)) / strideY + 1;
+                size_t dstW = (srcW + padX + padW - (dilationX * (kernelX - 1) + 1)) / strideX + 1;
+                return trans ? Shape({ batch, dstH, dstW, dstC }) : Shape({ batch, dstC, dstH, dstW });
+            }
         };
 
         struct FuncC
         {
-            typedef void*(*FuncPtr)(size_t srcC, size_t srcH, size_t srcW, size_t dstC, size_t kernelY, size_t kernelX, size_t dilationY, size_t dilationX, size_t strideY, size_t strideX, size_t padY, size_t padX, size_t padH, size_t padW, size_t group);
+            typedef void*(*FuncPtr)(SimdBool trans, size_t batch, size_t srcC, size_t srcH, size_t srcW, size_t dstC, size_t kernelY, size_t kernelX, size_t dilationY, size_t dilationX, size_t strideY, size_t strideX, size_t padY, size_t padX, size_t padH, size_t padW, size_t group, SimdConvolutionActivationType activation, const float * activationParams);
 
             FuncPtr func;
             String description;
@@ -58,16 +77,17 @@ namespace Test
             {
                 std::stringstream ss;
                 ss << description;
-                ss << "[" << p.srcC << "x" << p.srcH << "x" << p.srcW;
+                ss << "[" << p.batch << "x" << p.srcC << "x" << p.srcH << "x" << p.srcW;
                 ss << "-" << p.dstC << "x" << p.kernelY << "x" << p.kernelX;
                 ss << "-" << p.strideX << "-" << Simd::Max(p.padX, p.padW) << "-" << p.group;
-                ss << "]";
+                ss << (p.trans ? "-nhwc" : "") << (p.activation ? "-a" + ToString(p.activation) : "") << "]";
                 description = ss.str();
             }
 
-            void Call(const Param & p, const Tensor32f & weight, const Tensor32f & bias, const Tensor32f & src, Tensor32f & buf, Tensor32f & dst) const
+            void Call(const Param & p, const Tensor32f & weight, const Tensor32f & bias, const Tensor32f & params, const Tensor32f & src, Tensor32f & buf, Tensor32f & dst) const
             {
-                void * convolution = func(p.srcC, p.srcH, p.srcW, p.dstC, p.kernelY, p.kernelX, p.dilationY, p.dilationX, p.strideY, p.strideX, p.padY, p.padX, p.padH, p.padW, p.group);
+                void * convolution = func(p.trans, p.batch, p.srcC, p.srcH, p.srcW, p.dstC, p.kernelY, p.kernelX, p.dilationY, p.dilationX, 
+                    p.strideY, p.strideX, p.padY, p.padX, p.padH, p.padW, p.group, p.activation, params.Data());
                 buf.Extend({ ::SimdConvolutionBufferSize(convolution) });
                 ::SimdConvolutionSetWeight(convolution, weight.Data(), bias.Data());
                 {
@@ -91,27 +111,28 @@ namespace Test
 
         TEST_LOG_SS(Info, "Test " << f1.description << " & " << f2.description << "].");
 
-        Tensor32f src({ p.srcC, p.srcH, p.srcW });
+        Tensor32f src(p.SrcShape());
         FillRandom(src.Data(), src.Size(), -1.0, 1.0f);
 
-        Tensor32f weight({ p.dstC, p.srcC / p.group, p.kernelY, p.kernelX });
+        Tensor32f weight(p.WeightShape());
         FillRandom(weight.Data(), weight.Size(), -1.0, 1.0f);
 
         Tensor32f bias({ p.dstC });
         FillRandom(bias.Data(), bias.Size(), -1.0, 1.0f);
 
+        Tensor32f params({ p.dstC });
+        FillRandom(params.Data(), params.Size(), 0.0f, 0.5f);
+
         Tensor32f buf;
 
-        size_t dstH = (p.srcH + p.padY + p.padH - (p.dilationY * (p.kernelY - 1) + 1)) / p.strideY + 1;
-        size_t dstW = (p.srcW + p.padX + p.padW - (p.dilationX * (p.kernelX - 1) + 1)) / p.strideX + 1;
-        Tensor32f dst1({ p.dstC, dstH, dstW });
-        Tensor32f dst2({ p.dstC, dstH, dstW });
+        Tensor32f dst1(p.DstShape());
+        Tensor32f dst2(p.DstShape());
 
         TEST_ALIGN(SIMD_ALIGN);
 
-        TEST_EXECUTE_AT_LEAST_MIN_TIME(f1.Call(p, weight, bias, src, buf, dst1));
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f1.Call(p, weight, bias, params, src, buf, dst1));
 
-        TEST_EXECUTE_AT_LEAST_MIN_TIME(f2.Call(p, weight, bias, src, buf, dst2));
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f2.Call(p, weight, bias, params, src, buf, dst2));
 
         result = result && Compare(dst1, dst2, EPS, true, 64, DifferenceAbsolute);
 
@@ -160,6 +181,9 @@ namespace Test
         result = result && ConvolutionForwardAutoTest(Param(256, 3, 3, 16, _3, _1, _1, _1, _1, 1), f1, f2);
         result = result && ConvolutionForwardAutoTest(Param(256, 2, 2, 16, _3, _1, _1, _1, _1, 1), f1, f2);
         result = result && ConvolutionForwardAutoTest(Param(128, 1, 1, 16, _3, _1, _1, _1, _1, 1), f1, f2);
+        result = result && ConvolutionForwardAutoTest(Param(32, 38, 38, 48, _3, _1, _1, _1, _1, 1), f1, f2);
+        result = result && ConvolutionForwardAutoTest(Param(32, 50, 50, 64, _3, _1, _1, _1, _1, 1), f1, f2);
+        result = result && ConvolutionForwardAutoTest(Param(24, 30, 27, 32, _3, _1, _1, _0, _0, 1), f1, f2);
         
         result = result && ConvolutionForwardAutoTest(Param(3, 300, 300, 32, _3, _1, _2, _0, _1, 1), f1, f2);
 
@@ -179,6 +203,50 @@ namespace Test
         result = result && ConvolutionForwardAutoTest(Param(128, 3, 3, 128, _3, _1, _2, _1, _1, 128), f1, f2);
         result = result && ConvolutionForwardAutoTest(Param(64, 2, 2, 64, _3, _1, _2, _0, _1, 64), f1, f2);
 
+        result = result && ConvolutionForwardAutoTest(Param(24, 30, 30, 24, _3, _1, _1, _0, _0, 24), f1, f2);
+        result = result && ConvolutionForwardAutoTest(Param(16, 7, 7, 16, _3, _1, _1, _1, _1, 16), f1, f2);
+        result = result && ConvolutionForwardAutoTest(Param(32, 19, 19, 32, _5, _1, _1, _2, _2, 32), f1, f2);
+        result = result && ConvolutionForwardAutoTest(Param(64, 20, 20, 64, _5, _1, _2, _1, _2, 64), f1, f2);
+        result = result && ConvolutionForwardAutoTest(Param(48, 33, 33, 48, _5, _1, _2, _2, _2, 48), f1, f2);
+        result = result && ConvolutionForwardAutoTest(Param(13, 17, 23, 13, _3, _1, _2, _1, _0, 13), f1, f2);
+        result = result && ConvolutionForwardAutoTest(Param(29, 40, 40, 29, _5, _1, _1, _2, _2, 29, SimdFalse, 2), f1, f2);
+        result = result && ConvolutionForwardAutoTest(Param(37, 21, 21, 37, _3, _2, _1, _2, _2, 37), f1, f2);
+        result = result && ConvolutionForwardAutoTest(Param(13, 17, 23, 13, _3, _2, _2, _1, _1, 13, SimdTrue), f1, f2);
+        result = result && ConvolutionForwardAutoTest(Param(37, 20, 20, 37, _5, _1, _1, _2, _2, 37, SimdTrue, 2, SimdConvolutionActivationRelu), f1, f2);
+
+        result = result && ConvolutionForwardAutoTest(Param(32, 38, 38, 48, _3, _1, _1, _1, _1, 1, SimdTrue), f1, f2);
+        result = result && ConvolutionForwardAutoTest(Param(256, 3, 3, 16, _3, _1, _1, _1, _1, 1, SimdTrue), f1, f2);
+        result = result && ConvolutionForwardAutoTest(Param(3, 300, 300, 32, _3, _1, _2, _0, _1, 1, SimdTrue), f1, f2);
+        result = result && ConvolutionForwardAutoTest(Param(64, 19, 19, 96, _1, _1, _1, _0, _0, 1, SimdTrue), f1, f2);
+        result = result && ConvolutionForwardAutoTest(Param(64, 20, 20, 64, _3, _1, _1, _1, _1, 4, SimdTrue), f1, f2);
+        result = result && ConvolutionForwardAutoTest(Param(96, 20, 20, 40, _3, _2, _1, _2, _2, 2, SimdTrue), f1, f2);
+        result = result && ConvolutionForwardAutoTest(Param(144, 75, 75, 144, _3, _1, _2, _1, _1, 144, SimdTrue), f1, f2);
+        result = result && ConvolutionForwardAutoTest(Param(36, 19, 19, 36, _5, _1, _1, _2, _2, 36, SimdTrue), f1, f2);
+
+        result = result && ConvolutionForwardAutoTest(Param(32, 38, 38, 48, _3, _1, _1, _1, _1, 1, SimdFalse, 4), f1, f2);
+        result = result && ConvolutionForwardAutoTest(Param(64, 19, 19, 96, _1, _1, _1, _0, _0, 1, SimdFalse, 4), f1, f2);
+        result = result && ConvolutionForwardAutoTest(Param(256, 3, 3, 16, _3, _1, _1, _1, _1, 1, SimdFalse, 16), f1, f2);
+        result = result && ConvolutionForwardAutoTest(Param(64, 20, 20, 64, _3, _1, _1, _1, _1, 4, SimdFalse, 3), f1, f2);
+        result = result && ConvolutionForwardAutoTest(Param(144, 38, 38, 144, _3, _1, _2, _1, _1, 144, SimdFalse, 3), f1, f2);
+        result = result && ConvolutionForwardAutoTest(Param(32, 38, 38, 48, _3, _1, _1, _1, _1, 1, SimdTrue, 4), f1, f2);
+        result = result && ConvolutionForwardAutoTest(Param(64, 19, 19, 96, _1, _1, _1, _0, _0, 1, SimdTrue, 4), f1, f2);
+        result = result && ConvolutionForwardAutoTest(Param(63, 13, 13, 37, _1, _1, _1, _0, _0, 1, SimdTrue, 2, SimdConvolutionActivationPrelu), f1, f2);
+        result = result && ConvolutionForwardAutoTest(Param(256, 7, 7, 256, _3, _1, _1, _1, _1, 1, SimdTrue, 16), f1, f2);
+        result = result && ConvolutionForwardAutoTest(Param(96, 20, 20, 40, _3, _2, _1, _2, _2, 2, SimdTrue, 3), f1, f2);
+        result = result && ConvolutionForwardAutoTest(Param(144, 38, 38, 144, _3, _1, _2, _1, _1, 144, SimdTrue, 3), f1, f2);
+
+        result = result && ConvolutionForwardAutoTest(Param(32, 38, 38, 48, _3, _1, _1, _1, _1, 1, SimdFalse, 1, SimdConvolutionActivationRelu), f1, f2);
+        result = result && ConvolutionForwardAutoTest(Param(64, 19, 19, 96, _1, _1, _1, _0, _0, 1, SimdFalse, 1, SimdConvolutionActivationLeakyRelu), f1, f2);
+        result = result && ConvolutionForwardAutoTest(Param(256, 3, 3, 16, _3, _1, _1, _1, _1, 1, SimdFalse, 1, SimdConvolutionActivationPrelu), f1, f2);
+        result = result && ConvolutionForwardAutoTest(Param(3, 300, 300, 32, _3, _1, _2, _0, _1, 1, SimdFalse, 1, SimdConvolutionActivationPrelu), f1, f2);
+        result = result && ConvolutionForwardAutoTest(Param(64, 20, 20, 64, _3, _1, _1, _1, _1, 4, SimdFalse, 1, SimdConvolutionActivationPrelu), f1, f2);
+        result = result && ConvolutionForwardAutoTest(Param(144, 38, 38, 144, _3, _1, _2, _1, _1, 144, SimdFalse, 1, SimdConvolutionActivationPrelu), f1, f2);
+        result = result && ConvolutionForwardAutoTest(Param(32, 38, 38, 48, _3, _1, _1, _1, _1, 1, SimdTrue, 1, SimdConvolutionActivationPrelu), f1, f2);
+        result = result && ConvolutionForwardAutoTest(Param(64, 19, 19, 96, _1, _1, _1, _0, _0, 1, SimdTrue, 1, SimdConvolutionActivationLeakyRelu), f1, f2);
+        result = result && ConvolutionForwardAutoTest(Param(64, 20, 20, 64, _3, _1, _1, _1, _1, 4, SimdTrue, 1, SimdConvolutionActivationPrelu), f1, f2);
+        result = result && ConvolutionForwardAutoTest(Param(144, 38, 38, 144, _3, _1, _2, _1, _1, 144, SimdTrue, 1, SimdConvolutionActivationRelu), f1, f2);
+        result = result && ConvolutionForwardAutoTest(Param(32, 19, 19, 32, _3, _1, _1, _1, _1, 1, SimdFalse, 1, SimdConvolutionActivationSigmoid), f1, f2);
+
 #if 0
         result = result && ConvolutionForwardAutoTest(Param(48, 256, 256, 48, _1, _1, _1, _0, _0, 1), f1, f2);
         result = result && ConvolutionForwardAutoTest(Param(96, 128, 128, 96, _1, _1, _1, _0, _0, 1), f1, f2);
@@ -206,6 +274,8 @@ namespace Test
 #endif
 #else
         result = result && ConvolutionForwardAutoTest(Param(3, 300, 300, 32, _3, _1, _2, _0, _1, 1), f1, f2);
+        result = result && ConvolutionForwardAutoTest(Param(3, 300, 300, 32, _3, _1, _2, _0, _1, 1, SimdTrue), f1, f2);
+        result = result && ConvolutionForwardAutoTest(Param(32, 19, 19, 32, _3, _1, _1, _1, _1, 1, SimdFalse, 4), f1, f2);
 #endif
         return result;
     }
@@ -243,4 +313,332 @@ namespace Test
 
         return result;
     }
+
+    //-----------------------------------------------------------------------
+
+    bool ConvolutionThreadsAutoTest(const Param & p, FuncC f1, FuncC f2)
+    {
+        bool result = true;
+
+        size_t threadNumber = SimdGetThreadNumber();
+        SimdSetThreadNumber(4);
+        size_t multiple = SimdGetThreadNumber();
+
+        FuncC f3 = f1;
+        f1.Update(p);
+        f2.Update(p);
+        f3.Update(p);
+        f3.description += "-mt";
+
+        TEST_LOG_SS(Info, "Test " << f1.description << " with 1 and " << multiple << " threads.");
+
+        Tensor32f src(p.SrcShape());
+        FillRandom(src.Data(), src.Size(), -1.0, 1.0f);
+
+        Tensor32f weight(p.WeightShape());
+        FillRandom(weight.Data(), weight.Size(), -1.0, 1.0f);
+
+        Tensor32f bias({ p.dstC });
+        FillRandom(bias.Data(), bias.Size(), -1.0, 1.0f);
+
+        Tensor32f params({ p.dstC });
+        FillRandom(params.Data(), params.Size(), 0.0f, 0.5f);
+
+        Tensor32f buf;
+
+        Tensor32f dst1(p.DstShape());
+        Tensor32f dst2(p.DstShape());
+        Tensor32f dst3(p.DstShape());
+
+        TEST_ALIGN(SIMD_ALIGN);
+
+        SimdSetThreadNumber(1);
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f1.Call(p, weight, bias, params, src, buf, dst1));
+
+        SimdSetThreadNumber(multiple);
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f3.Call(p, weight, bias, params, src, buf, dst3));
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f2.Call(p, weight, bias, params, src, buf, dst2));
+
+        SimdSetThreadNumber(threadNumber);
+
+        result = result && Compare(dst1, dst3, EPS, true, 64, DifferenceAbsolute);
+        result = result && Compare(dst3, dst2, EPS, true, 64, DifferenceAbsolute);
+
+        return result;
+    }
+
+    bool ConvolutionThreadsAutoTest(const FuncC & f1, const FuncC & f2)
+    {
+        bool result = true;
+
+        Size _0(0, 0), _1(1, 1), _2(2, 2), _3(3, 3), _5(5, 5);
+
+        result = result && ConvolutionThreadsAutoTest(Param(64, 19, 19, 96, _3, _1, _1, _1, _1, 1), f1, f2);
+        result = result && ConvolutionThreadsAutoTest(Param(64, 38, 38, 64, _3, _1, _1, _0, _0, 1), f1, f2);
+        result = result && ConvolutionThreadsAutoTest(Param(32, 50, 50, 64, _3, _1, _1, _1, _1, 1, SimdFalse, 2), f1, f2);
+        result = result && ConvolutionThreadsAutoTest(Param(144, 38, 38, 144, _3, _1, _2, _1, _1, 144), f1, f2);
+        result = result && ConvolutionThreadsAutoTest(Param(37, 40, 40, 37, _5, _1, _1, _2, _2, 37, SimdTrue), f1, f2);
+        result = result && ConvolutionThreadsAutoTest(Param(64, 19, 19, 96, _1, _1, _1, _0, _0, 1, SimdTrue, 4), f1, f2);
+        result = result && ConvolutionThreadsAutoTest(Param(32, 38, 38, 48, _3, _1, _1, _1, _1, 1, SimdTrue, 1, SimdConvolutionActivationRelu), f1, f2);
+
+        return result;
+    }
+
+    bool ConvolutionThreadsAutoTest()
+    {
+        bool result = true;
+
+        result = result && ConvolutionThreadsAutoTest(FUNC_C(Simd::Base::ConvolutionInit), FUNC_C(SimdConvolutionInit));
+
+#ifdef SIMD_SSE_ENABLE
+        if (Simd::Sse::Enable)
+            result = result && ConvolutionThreadsAutoTest(FUNC_C(Simd::Sse::ConvolutionInit), FUNC_C(SimdConvolutionInit));
+#endif 
+
+#ifdef SIMD_SSE3_ENABLE
+        if (Simd::Sse3::Enable)
+            result = result && ConvolutionThreadsAutoTest(FUNC_C(Simd::Sse3::ConvolutionInit), FUNC_C(SimdConvolutionInit));
+#endif 
+
+#ifdef SIMD_AVX_ENABLE
+        if (Simd::Avx::Enable)
+            result = result && ConvolutionThreadsAutoTest(FUNC_C(Simd::Avx::ConvolutionInit), FUNC_C(SimdConvolutionInit));
+#endif 
+
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable)
+            result = result && ConvolutionThreadsAutoTest(FUNC_C(Simd::Avx2::ConvolutionInit), FUNC_C(SimdConvolutionInit));
+#endif
+
+#ifdef SIMD_AVX512F_ENABLE
+        if (Simd::Avx512f::Enable)
+            result = result && ConvolutionThreadsAutoTest(FUNC_C(Simd::Avx512f::ConvolutionInit), FUNC_C(SimdConvolutionInit));
+#endif
+
+        return result;
+    }
+
+    //-----------------------------------------------------------------------
+
+    void ConvolutionTuneForward(const Param & p, const Tensor32f & weight, const Tensor32f & bias, const Tensor32f & params, const Tensor32f & src, Tensor32f & dst)
+    {
+        void * convolution = ::SimdConvolutionInit(p.trans, p.batch, p.srcC, p.srcH, p.srcW, p.dstC, p.kernelY, p.kernelX, p.dilationY, p.dilationX, 
+            p.strideY, p.strideX, p.padY, p.padX, p.padH, p.padW, p.group, p.activation, params.Data());
+        ::SimdConvolutionSetWeight(convolution, weight.Data(), bias.Data());
+        ::SimdConvolutionForward(convolution, src.Data(), NULL, dst.Data());
+        ::SimdRelease(convolution);
+    }
+
+    bool ConvolutionTuneAutoTest(const Param & p, const String & cache)
+    {
+        bool result = true;
+
+        FuncC f(SimdConvolutionInit, "SimdConvolutionSetTuning");
+        f.Update(p);
+
+        TEST_LOG_SS(Info, "Test " << f.description << ".");
+
+        Tensor32f src(p.SrcShape());
+        FillRandom(src.Data(), src.Size(), -1.0, 1.0f);
+
+        Tensor32f weight(p.WeightShape());
+        FillRandom(weight.Data(), weight.Size(), -1.0, 1.0f);
+
+        Tensor32f bias({ p.dstC });
+        FillRandom(bias.Data(), bias.Size(), -1.0, 1.0f);
+
+        Tensor32f params({ p.dstC });
+        FillRandom(params.Data(), params.Size(), 0.0f, 0.5f);
+
+        Tensor32f dst1(p.DstShape());
+        Tensor32f dst2(p.DstShape());
+        Tensor32f dst3(p.DstShape());
+
+        ::SimdConvolutionSetTuning(SimdFalse, NULL);
+        ConvolutionTuneForward(p, weight, bias, params, src, dst1);
+
+        ::SimdConvolutionSetTuning(SimdTrue, cache.c_str());
+        ConvolutionTuneForward(p, weight, bias, params, src, dst2);
+
+        ::SimdConvolutionSetTuning(SimdTrue, cache.c_str());
+        ConvolutionTuneForward(p, weight, bias, params, src, dst3);
+
+        ::SimdConvolutionSetTuning(SimdFalse, NULL);
+
+        result = result && Compare(dst1, dst2, EPS, true, 64, DifferenceAbsolute);
+        result = result && Compare(dst1, dst3, EPS, true, 64, DifferenceAbsolute);
+
+        return result;
+    }
+
+    bool ConvolutionTuneAutoTest()
+    {
+        bool result = true;
+
+        const String cache = "_ConvolutionTune.txt";
+        ::remove(cache.c_str());
+
+        Size _0(0, 0), _1(1, 1), _2(2, 2), _3(3, 3);
+
+        std::vector<Param> params;
+        params.push_back(Param(32, 38, 38, 48, _3, _1, _1, _1, _1, 1));
+        params.push_back(Param(256, 3, 3, 16, _3, _1, _1, _1, _1, 1));
+        params.push_back(Param(3, 60, 60, 16, _3, _1, _2, _0, _1, 1));
+        params.push_back(Param(64, 19, 19, 32, _1, _1, _1, _0, _0, 1));
+        params.push_back(Param(48, 20, 20, 48, _3, _1, _1, _1, _1, 48));
+        params.push_back(Param(64, 20, 20, 64, _3, _1, _1, _1, _1, 4));
+        params.push_back(Param(64, 19, 19, 96, _1, _1, _1, _0, _0, 1, SimdTrue));
+        params.push_back(Param(48, 20, 20, 48, _3, _1, _1, _1, _1, 48, SimdTrue));
+        params.push_back(Param(128, 7, 7, 128, _3, _1, _1, _1, _1, 1, SimdFalse, 8));
+        params.push_back(Param(32, 38, 38, 48, _3, _1, _1, _1, _1, 1, SimdFalse, 1, SimdConvolutionActivationPrelu));
+
+        for (size_t i = 0; i < params.size(); ++i)
+            result = result && ConvolutionTuneAutoTest(params[i], cache);
+
+        size_t lines = 0;
+        std::ifstream file(cache.c_str());
+        for (String line; std::getline(file, line);)
+            lines++;
+        file.close();
+        if (result && lines != params.size())
+        {
+            TEST_LOG_SS(Error, "Cache file " << cache << " contains " << lines << " decisions instead of " << params.size() << "!");
+            result = false;
+        }
+        ::remove(cache.c_str());
+
+        return result;
+    }
+
+    //-----------------------------------------------------------------------
+
+    namespace
+    {
+        typedef Tensor<uint8_t> Tensor8u;
+
+        struct FuncC8i
+        {
+            typedef void*(*FuncPtr)(size_t batch, size_t srcC, size_t srcH, size_t srcW, size_t dstC, size_t kernelY, size_t kernelX, size_t dilationY, size_t dilationX, size_t strideY, size_t strideX, size_t padY, size_t padX, size_t padH, size_t padW, size_t group, SimdConvolutionActivationType activation, SimdBool dst8u);
+
+            FuncPtr func;
+            String description;
+
+            FuncC8i(const FuncPtr & f, const String & d) : func(f), description(d) {}
+
+            void Update(const Param & p, SimdBool dst8u)
+            {
+                std::stringstream ss;
+                ss << description;
+                ss << "[" << p.batch << "x" << p.srcC << "x" << p.srcH << "x" << p.srcW;
+                ss << "-" << p.dstC << "x" << p.kernelY << "x" << p.kernelX;
+                ss << "-" << p.strideX << "-" << Simd::Max(p.padX, p.padW) << "-" << p.group;
+                ss << (dst8u ? "-8u" : "-32f") << (p.activation ? "-a" + ToString(p.activation) : "") << "]";
+                description = ss.str();
+            }
+
+            void Call(const Param & p, SimdBool dst8u, const Tensor32f & weight, const Tensor32f & bias, const Tensor8u & src, Tensor8u & buf, Tensor8u & dst) const
+            {
+                void * convolution = func(p.batch, p.srcC, p.srcH, p.srcW, p.dstC, p.kernelY, p.kernelX, p.dilationY, p.dilationX,
+                    p.strideY, p.strideX, p.padY, p.padX, p.padH, p.padW, p.group, p.activation, dst8u);
+                buf.Extend({ ::SimdConvolution8iBufferSize(convolution) });
+                ::SimdConvolution8iSetWeight(convolution, weight.Data(), bias.Data(), 0.02f, 100, 0.05f, 64);
+                {
+                    TEST_PERFORMANCE_TEST(description);
+                    ::SimdConvolution8iForward(convolution, src.Data(), buf.Data(), dst.Data());
+                }
+                ::SimdRelease(convolution);
+            }
+        };
+    }
+
+#define FUNC_C8I(function) \
+    FuncC8i(function, std::string(#function))
+
+    bool Convolution8iForwardAutoTest(const Param & p, SimdBool dst8u, FuncC8i f1, FuncC8i f2)
+    {
+        bool result = true;
+
+        f1.Update(p, dst8u);
+        f2.Update(p, dst8u);
+
+        TEST_LOG_SS(Info, "Test " << f1.description << " & " << f2.description << "].");
+
+        Tensor8u src(p.SrcShape());
+        for (size_t i = 0; i < src.Size(); ++i)
+            src.Data()[i] = Random(256);
+
+        Tensor32f weight(p.WeightShape());
+        FillRandom(weight.Data(), weight.Size(), -1.0, 1.0f);
+
+        Tensor32f bias({ p.dstC });
+        FillRandom(bias.Data(), bias.Size(), -1.0, 1.0f);
+
+        Tensor8u buf;
+
+        Shape shape = p.DstShape();
+        shape.back() *= dst8u ? 1 : sizeof(float);
+        Tensor8u dst1(shape);
+        Tensor8u dst2(shape);
+
+        TEST_ALIGN(SIMD_ALIGN);
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f1.Call(p, dst8u, weight, bias, src, buf, dst1));
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f2.Call(p, dst8u, weight, bias, src, buf, dst2));
+
+        Tensor32f out1(p.DstShape()), out2(p.DstShape());
+        for (size_t i = 0; i < out1.Size(); ++i)
+        {
+            out1.Data()[i] = dst8u ? dst1.Data()[i] : ((float*)dst1.Data())[i];
+            out2.Data()[i] = dst8u ? dst2.Data()[i] : ((float*)dst2.Data())[i];
+        }
+        result = result && Compare(out1, out2, EPS, true, 64, DifferenceAbsolute);
+
+        return result;
+    }
+
+    bool Convolution8iForwardAutoTest(const FuncC8i & f1, const FuncC8i & f2)
+    {
+        bool result = true;
+
+        Size _0(0, 0), _1(1, 1), _2(2, 2), _3(3, 3);
+
+        for (int dst8u = 0; dst8u < 2; ++dst8u)
+        {
+            SimdBool d = dst8u ? SimdTrue : SimdFalse;
+            result = result && Convolution8iForwardAutoTest(Param(32, 38, 38, 48, _3, _1, _1, _1, _1, 1, SimdTrue), d, f1, f2);
+            result = result && Convolution8iForwardAutoTest(Param(64, 19, 19, 96, _1, _1, _1, _0, _0, 1, SimdTrue), d, f1, f2);
+            result = result && Convolution8iForwardAutoTest(Param(3, 300, 300, 32, _3, _1, _2, _0, _1, 1, SimdTrue), d, f1, f2);
+            result = result && Convolution8iForwardAutoTest(Param(64, 20, 20, 64, _3, _1, _1, _1, _1, 4, SimdTrue), d, f1, f2);
+            result = result && Convolution8iForwardAutoTest(Param(256, 7, 7, 256, _3, _1, _1, _1, _1, 1, SimdTrue, 4), d, f1, f2);
+            result = result && Convolution8iForwardAutoTest(Param(96, 20, 20, 40, _3, _2, _1, _2, _2, 2, SimdTrue, 1, SimdConvolutionActivationRelu), d, f1, f2);
+        }
+
+        return result;
+    }
+
+    bool Convolution8iForwardAutoTest()
+    {
+        bool result = true;
+
+        result = result && Convolution8iForwardAutoTest(FUNC_C8I(Simd::Base::Convolution8iInit), FUNC_C8I(SimdConvolution8iInit));
+
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable)
+            result = result && Convolution8iForwardAutoTest(FUNC_C8I(Simd::Avx2::Convolution8iInit), FUNC_C8I(SimdConvolution8iInit));
+#endif
+
+#ifdef SIMD_AVX512BW_ENABLE
+        if (Simd::Avx512bw::Enable)
+            result = result && Convolution8iForwardAutoTest(FUNC_C8I(Simd::Avx512bw::Convolution8iInit), FUNC_C8I(SimdConvolution8iInit));
+#endif
+
+#ifdef SIMD_AVX512VNNI_ENABLE
+        if (Simd::Avx512vnni::Enable)
+            result = result && Convolution8iForwardAutoTest(FUNC_C8I(Simd::Avx512vnni::Convolution8iInit), FUNC_C8I(SimdConvolution8iInit));
+#endif
+
+        return result;
+    }
 }
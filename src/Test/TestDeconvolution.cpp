@@ -0,0 +1,324 @@
+/*
+* Tests for Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2018 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Test/TestUtils.h"
+#include "Test/TestPerformance.h"
+#include "Test/TestData.h"
+#include "Test/TestTensor.h"
+
+#include "Simd/SimdDeconvolution.h"
+
+namespace Test
+{
+    namespace
+    {
+        struct Param
+        {
+            size_t srcC, srcH, srcW, dstC, kernelY, kernelX, dilationY, dilationX, strideY, strideX, padY, padX, padH, padW, group, batch;
+            SimdBool trans;
+            SimdConvolutionActivationType activation;
+
+            Param(size_t sC, size_t sH, size_t sW, size_t dC, Size k, Size d, Size s, Size b, Size e, size_t g, SimdBool t = SimdFalse, size_t n = 1, SimdConvolutionActivationType a = SimdConvolutionActivationIdentity)
+                : srcC(sC), srcH(sH), srcW(sW), dstC(dC), kernelY(k.y), kernelX(k.x), dilationY(d.y), dilationX(d.x), strideY(s.y), strideX(s.x), padY(b.y), padX(b.x), padH(e.y), padW(e.x), group(g), batch(n), trans(t), activation(a)
+            {}
+
+            Shape SrcShape() const
+            {
+                return trans ? Shape({ batch, srcH, srcW, srcC }) : Shape({ batch, srcC, srcH, srcW });
+            }
+
+            Shape WeightShape() const
+            {
+                return trans ? Shape({ kernelY, kernelX, dstC / group, srcC }) : Shape({ srcC, dstC / group, kernelY, kernelX });
+            }
+
+            Shape DstShape() const
+            {
+                size_t dstH = strideY * (srcH - 1) + dilationY * (kernelY - 1) + 1 - padY - padH;
+                size_t dstW = strideX * (srcW - 1) + dilationX * (kernelX - 1) + 1 - padX - padW;
+                return trans ? Shape({ batch, dstH, dstW, dstC }) : Shape({ batch, dstC, dstH, dstW });
+            }
+        };
+
+        struct FuncD
+        {
+            typedef void*(*FuncPtr)(SimdBool trans, size_t batch, size_t srcC, size_t srcH, size_t srcW, size_t dstC, size_t kernelY, size_t kernelX, size_t dilationY, size_t dilationX, size_t strideY, size_t strideX, size_t padY, size_t padX, size_t padH, size_t padW, size_t group, SimdConvolutionActivationType activation, const float * activationParams);
+
+            FuncPtr func;
+            String description;
+
+            FuncD(const FuncPtr & f, const String & d) : func(f), description(d) {}
+
+            void Update(const Param & p)
+            {
+                std::stringstream ss;
+                ss << description;
+                ss << "[" << p.batch << "x" << p.srcC << "x" << p.srcH << "x" << p.srcW;
+                ss << "-" << p.dstC << "x" << p.kernelY << "x" << p.kernelX;
+                ss << "-" << p.strideX << "-" << Simd::Max(p.padX, p.padW) << "-" << p.group;
+                ss << (p.trans ? "-nhwc" : "") << (p.activation ? "-a" + ToString(p.activation) : "") << "]";
+                description = ss.str();
+            }
+
+            void Call(const Param & p, const Tensor32f & weight, const Tensor32f & bias, const Tensor32f & params, const Tensor32f & src, Tensor32f & buf, Tensor32f & dst) const
+            {
+                void * deconvolution = func(p.trans, p.batch, p.srcC, p.srcH, p.srcW, p.dstC, p.kernelY, p.kernelX, p.dilationY, p.dilationX,
+                    p.strideY, p.strideX, p.padY, p.padX, p.padH, p.padW, p.group, p.activation, params.Data());
+                buf.Extend({ ::SimdDeconvolutionBufferSize(deconvolution) });
+                ::SimdDeconvolutionSetWeight(deconvolution, weight.Data(), bias.Data());
+                {
+                    TEST_PERFORMANCE_TEST(description);
+                    ::SimdDeconvolutionForward(deconvolution, src.Data(), buf.Data(), dst.Data());
+                }
+                ::SimdRelease(deconvolution);
+            }
+        };
+    }
+
+#define FUNC_D(function) \
+    FuncD(function, std::string(#function))
+
+    bool DeconvolutionForwardAutoTest(const Param & p, FuncD f1, FuncD f2)
+    {
+        bool result = true;
+
+        f1.Update(p);
+        f2.Update(p);
+
+        TEST_LOG_SS(Info, "Test " << f1.description << " & " << f2.description << "].");
+
+        Tensor32f src(p.SrcShape());
+        FillRandom(src.Data(), src.Size(), -1.0, 1.0f);
+
+        Tensor32f weight(p.WeightShape());
+        FillRandom(weight.Data(), weight.Size(), -1.0, 1.0f);
+
+        Tensor32f bias({ p.dstC });
+        FillRandom(bias.Data(), bias.Size(), -1.0, 1.0f);
+
+        Tensor32f params({ p.dstC });
+        FillRandom(params.Data(), params.Size(), 0.0f, 0.5f);
+
+        Tensor32f buf;
+
+        Tensor32f dst1(p.DstShape());
+        Tensor32f dst2(p.DstShape());
+
+        TEST_ALIGN(SIMD_ALIGN);
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f1.Call(p, weight, bias, params, src, buf, dst1));
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f2.Call(p, weight, bias, params, src, buf, dst2));
+
+        result = result && Compare(dst1, dst2, EPS, true, 64, DifferenceAbsolute);
+
+        return result;
+    }
+
+    bool DeconvolutionForwardAutoTest(const FuncD & f1, const FuncD & f2)
+    {
+        bool result = true;
+
+        Size _0(0, 0), _1(1, 1), _2(2, 2), _3(3, 3), _4(4, 4);
+
+#ifdef NDEBUG
+        result = result && DeconvolutionForwardAutoTest(Param(64, 38, 38, 32, _2, _1, _2, _0, _0, 1), f1, f2);
+        result = result && DeconvolutionForwardAutoTest(Param(128, 19, 19, 64, _2, _1, _2, _0, _0, 1), f1, f2);
+        result = result && DeconvolutionForwardAutoTest(Param(64, 38, 38, 32, _3, _1, _2, _1, _0, 1), f1, f2);
+        result = result && DeconvolutionForwardAutoTest(Param(32, 40, 40, 16, _4, _1, _2, _1, _1, 1), f1, f2);
+        result = result && DeconvolutionForwardAutoTest(Param(64, 20, 20, 64, _4, _1, _2, _1, _1, 64), f1, f2);
+        result = result && DeconvolutionForwardAutoTest(Param(48, 19, 19, 32, _3, _2, _1, _2, _2, 2), f1, f2);
+        result = result && DeconvolutionForwardAutoTest(Param(64, 38, 38, 32, _2, _1, _2, _0, _0, 1, SimdTrue), f1, f2);
+        result = result && DeconvolutionForwardAutoTest(Param(128, 19, 19, 64, _2, _1, _2, _0, _0, 1, SimdTrue), f1, f2);
+        result = result && DeconvolutionForwardAutoTest(Param(64, 38, 38, 32, _3, _1, _2, _1, _0, 1, SimdTrue), f1, f2);
+        result = result && DeconvolutionForwardAutoTest(Param(64, 20, 20, 64, _4, _1, _2, _1, _1, 4, SimdTrue), f1, f2);
+        result = result && DeconvolutionForwardAutoTest(Param(32, 20, 20, 16, _2, _1, _2, _0, _0, 1, SimdFalse, 3, SimdConvolutionActivationRelu), f1, f2);
+        result = result && DeconvolutionForwardAutoTest(Param(32, 20, 20, 16, _2, _1, _2, _0, _0, 1, SimdTrue, 3, SimdConvolutionActivationPrelu), f1, f2);
+        result = result && DeconvolutionForwardAutoTest(Param(32, 20, 20, 16, _3, _1, _2, _1, _0, 1, SimdTrue, 2, SimdConvolutionActivationLeakyRelu), f1, f2);
+#else
+        result = result && DeconvolutionForwardAutoTest(Param(32, 20, 20, 16, _2, _1, _2, _0, _0, 1), f1, f2);
+        result = result && DeconvolutionForwardAutoTest(Param(32, 20, 20, 16, _3, _1, _2, _1, _0, 1, SimdTrue), f1, f2);
+#endif
+        return result;
+    }
+
+    bool DeconvolutionForwardAutoTest()
+    {
+        bool result = true;
+
+        result = result && DeconvolutionForwardAutoTest(FUNC_D(Simd::Base::DeconvolutionInit), FUNC_D(SimdDeconvolutionInit));
+
+#ifdef SIMD_SSE_ENABLE
+        if (Simd::Sse::Enable)
+            result = result && DeconvolutionForwardAutoTest(FUNC_D(Simd::Sse::DeconvolutionInit), FUNC_D(SimdDeconvolutionInit));
+#endif 
+
+#ifdef SIMD_AVX_ENABLE
+        if (Simd::Avx::Enable)
+            result = result && DeconvolutionForwardAutoTest(FUNC_D(Simd::Avx::DeconvolutionInit), FUNC_D(SimdDeconvolutionInit));
+#endif 
+
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable)
+            result = result && DeconvolutionForwardAutoTest(FUNC_D(Simd::Avx2::DeconvolutionInit), FUNC_D(SimdDeconvolutionInit));
+#endif
+
+#ifdef SIMD_AVX512F_ENABLE
+        if (Simd::Avx512f::Enable)
+            result = result && DeconvolutionForwardAutoTest(FUNC_D(Simd::Avx512f::DeconvolutionInit), FUNC_D(SimdDeconvolutionInit));
+#endif
+
+        return result;
+    }
+
+    namespace
+    {
+        struct FuncS
+        {
+            typedef Simd::Deconvolution*(*FuncPtr)(const Simd::DeconvParam & p);
+
+            FuncPtr func;
+            String description;
+
+            FuncS(const FuncPtr & f, const String & d) : func(f), description(d) {}
+
+            void Update(const Param & p)
+            {
+                std::stringstream ss;
+                ss << description;
+                ss << "[" << p.batch << "x" << p.srcC << "x" << p.srcH << "x" << p.srcW << "-" << p.dstC;
+                ss << (p.trans ? "-nhwc" : "") << (p.activation ? "-a" + ToString(p.activation) : "") << "]";
+                description = ss.str();
+            }
+
+            void Call(const Param & p, const Tensor32f & weight, const Tensor32f & bias, const Tensor32f & params, const Tensor32f & src, Tensor32f & buf, Tensor32f & dst) const
+            {
+                Simd::DeconvParam param(p.trans, p.batch, p.srcC, p.srcH, p.srcW, p.dstC, p.kernelY, p.kernelX, p.dilationY, p.dilationX,
+                    p.strideY, p.strideX, p.padY, p.padX, p.padH, p.padW, p.group, p.activation, params.Data());
+                Simd::Deconvolution * deconvolution = func(param);
+                buf.Extend({ deconvolution->BufferSize() });
+                deconvolution->SetWeight(weight.Data(), bias.Data());
+                {
+                    TEST_PERFORMANCE_TEST(description);
+                    deconvolution->Forward(src.Data(), buf.Data(), dst.Data());
+                }
+                delete deconvolution;
+            }
+        };
+
+        template<class D> Simd::Deconvolution * DeconvolutionCreate(const Simd::DeconvParam & p)
+        {
+            return new D(p);
+        }
+    }
+
+#define FUNC_S(isa, type) \
+    FuncS(DeconvolutionCreate<isa::type>, std::string(#isa "::" #type))
+
+    bool DeconvolutionStride2AutoTest(const Param & p, FuncS stride2, FuncS gemm, FuncD api)
+    {
+        bool result = true;
+
+        stride2.Update(p);
+        gemm.Update(p);
+        api.Update(p);
+
+        TEST_LOG_SS(Info, "Test " << stride2.description << " & " << gemm.description << "].");
+
+        Tensor32f src(p.SrcShape());
+        FillRandom(src.Data(), src.Size(), -1.0, 1.0f);
+
+        Tensor32f weight(p.WeightShape());
+        FillRandom(weight.Data(), weight.Size(), -1.0, 1.0f);
+
+        Tensor32f bias({ p.dstC });
+        FillRandom(bias.Data(), bias.Size(), -1.0, 1.0f);
+
+        Tensor32f params({ p.dstC });
+        FillRandom(params.Data(), params.Size(), 0.0f, 0.5f);
+
+        Tensor32f buf;
+
+        Tensor32f dst1(p.DstShape());
+        Tensor32f dst2(p.DstShape());
+        Tensor32f dst3(p.DstShape());
+
+        TEST_ALIGN(SIMD_ALIGN);
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(stride2.Call(p, weight, bias, params, src, buf, dst1));
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(gemm.Call(p, weight, bias, params, src, buf, dst2));
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(api.Call(p, weight, bias, params, src, buf, dst3));
+
+        result = result && Compare(dst1, dst2, EPS, true, 64, DifferenceAbsolute);
+        result = result && Compare(dst1, dst3, EPS, true, 64, DifferenceAbsolute);
+
+        return result;
+    }
+
+    bool DeconvolutionStride2AutoTest(const FuncS & stride2, const FuncS & gemm)
+    {
+        bool result = true;
+        const FuncD api = FUNC_D(SimdDeconvolutionInit);
+
+        Size _0(0, 0), _1(1, 1), _2(2, 2);
+
+        result = result && DeconvolutionStride2AutoTest(Param(64, 38, 38, 32, _2, _1, _2, _0, _0, 1), stride2, gemm, api);
+        result = result && DeconvolutionStride2AutoTest(Param(35, 13, 17, 19, _2, _1, _2, _0, _0, 1), stride2, gemm, api);
+        result = result && DeconvolutionStride2AutoTest(Param(32, 20, 20, 16, _2, _1, _2, _0, _0, 1, SimdFalse, 3, SimdConvolutionActivationPrelu), stride2, gemm, api);
+        result = result && DeconvolutionStride2AutoTest(Param(128, 19, 19, 64, _2, _1, _2, _0, _0, 1, SimdTrue), stride2, gemm, api);
+        result = result && DeconvolutionStride2AutoTest(Param(35, 13, 17, 19, _2, _1, _2, _0, _0, 1, SimdTrue, 2, SimdConvolutionActivationRelu), stride2, gemm, api);
+
+        return result;
+    }
+
+    bool DeconvolutionStride2AutoTest()
+    {
+        bool result = true;
+
+        result = result && DeconvolutionStride2AutoTest(FUNC_S(Simd::Base, DeconvolutionStride2), FUNC_S(Simd::Base, DeconvolutionGemm));
+
+#ifdef SIMD_SSE_ENABLE
+        if (Simd::Sse::Enable)
+            result = result && DeconvolutionStride2AutoTest(FUNC_S(Simd::Sse, DeconvolutionStride2), FUNC_S(Simd::Sse, DeconvolutionGemm));
+#endif 
+
+#ifdef SIMD_AVX_ENABLE
+        if (Simd::Avx::Enable)
+            result = result && DeconvolutionStride2AutoTest(FUNC_S(Simd::Avx, DeconvolutionStride2), FUNC_S(Simd::Avx, DeconvolutionGemm));
+#endif 
+
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable)
+            result = result && DeconvolutionStride2AutoTest(FUNC_S(Simd::Avx2, DeconvolutionStride2), FUNC_S(Simd::Avx2, DeconvolutionGemm));
+#endif
+
+#ifdef SIMD_AVX512F_ENABLE
+        if (Simd::Avx512f::Enable)
+            result = result && DeconvolutionStride2AutoTest(FUNC_S(Simd::Avx512f, DeconvolutionStride2), FUNC_S(Simd::Avx512f, DeconvolutionGemm));
+#endif
+
+        return result;
+    }
+}
@@ -25,6 +25,8 @@
 #include "Test/TestPerformance.h"
 #include "Test/TestData.h"
 
+#include "Simd/SimdGemm.h"
+
 namespace Test
 {
     namespace
@@ -201,6 +203,766 @@ namespace Test
         return result;
     }
 
+    bool Gemm32fTNAutoTest(const FuncGemm32f & f1, const FuncGemm32f & f2)
+    {
+        bool result = true;
+
+        result = result && Gemm32fAutoTest(1, 0, 728, 196, 728, f1, f2);
+        result = result && Gemm32fAutoTest(1, 0, 728, 192, 728, f1, f2);
+        result = result && Gemm32fAutoTest(1, 0, 727, 4, 725, f1, f2);
+
+        return result;
+    }
+
+    bool Gemm32fTNAutoTest()
+    {
+        bool result = true;
+
+        result = result && Gemm32fTNAutoTest(FUNC_GEMM32F(Simd::Base::Gemm32fTN), FUNC_GEMM32F(SimdGemm32fTN));
+
+#ifdef SIMD_SSE_ENABLE
+        if (Simd::Sse::Enable)
+            result = result && Gemm32fTNAutoTest(FUNC_GEMM32F(Simd::Sse::Gemm32fTN), FUNC_GEMM32F(SimdGemm32fTN));
+#endif 
+
+#ifdef SIMD_AVX_ENABLE
+        if (Simd::Avx::Enable)
+            result = result && Gemm32fTNAutoTest(FUNC_GEMM32F(Simd::Avx::Gemm32fTN), FUNC_GEMM32F(SimdGemm32fTN));
+#endif 
+
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable)
+            result = result && Gemm32fTNAutoTest(FUNC_GEMM32F(Simd::Avx2::Gemm32fTN), FUNC_GEMM32F(SimdGemm32fTN));
+#endif 
+
+#ifdef SIMD_AVX512F_ENABLE
+        if (Simd::Avx512f::Enable)
+            result = result && Gemm32fTNAutoTest(FUNC_GEMM32F(Simd::Avx512f::Gemm32fTN), FUNC_GEMM32F(SimdGemm32fTN));
+#endif 
+
+        return result;
+    }
+
+    bool Gemm32fTTAutoTest(const FuncGemm32f & f1, const FuncGemm32f & f2)
+    {
+        bool result = true;
+
+        result = result && Gemm32fAutoTest(1, 1, 728, 196, 728, f1, f2);
+        result = result && Gemm32fAutoTest(1, 1, 728, 192, 728, f1, f2);
+        result = result && Gemm32fAutoTest(1, 1, 727, 4, 725, f1, f2);
+
+        return result;
+    }
+
+    bool Gemm32fTTAutoTest()
+    {
+        bool result = true;
+
+        result = result && Gemm32fTTAutoTest(FUNC_GEMM32F(Simd::Base::Gemm32fTT), FUNC_GEMM32F(SimdGemm32fTT));
+
+#ifdef SIMD_SSE_ENABLE
+        if (Simd::Sse::Enable)
+            result = result && Gemm32fTTAutoTest(FUNC_GEMM32F(Simd::Sse::Gemm32fTT), FUNC_GEMM32F(SimdGemm32fTT));
+#endif 
+
+#ifdef SIMD_AVX_ENABLE
+        if (Simd::Avx::Enable)
+            result = result && Gemm32fTTAutoTest(FUNC_GEMM32F(Simd::Avx::Gemm32fTT), FUNC_GEMM32F(SimdGemm32fTT));
+#endif 
+
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable)
+            result = result && Gemm32fTTAutoTest(FUNC_GEMM32F(Simd::Avx2::Gemm32fTT), FUNC_GEMM32F(SimdGemm32fTT));
+#endif 
+
+#ifdef SIMD_AVX512F_ENABLE
+        if (Simd::Avx512f::Enable)
+            result = result && Gemm32fTTAutoTest(FUNC_GEMM32F(Simd::Avx512f::Gemm32fTT), FUNC_GEMM32F(SimdGemm32fTT));
+#endif 
+
+        return result;
+    }
+
+    namespace
+    {
+        struct FuncGemm32fInit
+        {
+            typedef void*(*FuncPtr)(SimdBool transA, SimdBool transB, size_t M, size_t N, size_t K);
+
+            FuncPtr func;
+            String description;
+
+            FuncGemm32fInit(const FuncPtr & f, const String & d) : func(f), description(d) {}
+
+            void Call(void * gemm, float alpha, const View & A, const View & B, const float * pB, float beta, const View & srcC, View & dstC) const
+            {
+                Simd::Copy(srcC, dstC);
+                TEST_PERFORMANCE_TEST(description);
+                if (pB)
+                    SimdGemm32fRunPackedB(gemm, &alpha, (float*)A.data, A.stride / sizeof(float),
+                        pB, &beta, (float*)dstC.data, dstC.stride / sizeof(float));
+                else
+                    SimdGemm32fRun(gemm, &alpha, (float*)A.data, A.stride / sizeof(float),
+                        (float*)B.data, B.stride / sizeof(float), &beta, (float*)dstC.data, dstC.stride / sizeof(float));
+            }
+
+            void CallBatched(void * gemm, size_t batch, float alpha, const View & A, const View & B, bool shareB, float beta, const View & srcC, View & dstC) const
+            {
+                Simd::Copy(srcC, dstC);
+                TEST_PERFORMANCE_TEST(description);
+                SimdGemm32fRunBatched(gemm, batch, &alpha, (float*)A.data, A.stride / sizeof(float), A.height / batch * A.stride / sizeof(float),
+                    (float*)B.data, B.stride / sizeof(float), shareB ? 0 : B.height / batch * B.stride / sizeof(float), 
+                    &beta, (float*)dstC.data, dstC.stride / sizeof(float), dstC.height / batch * dstC.stride / sizeof(float));
+            }
+
+            void Call16(void * gemm, SimdGemmFormatType format, float alpha, const View & A, const View & B, float beta, const View & srcC, View & dstC) const
+            {
+                Simd::Copy(srcC, dstC);
+                TEST_PERFORMANCE_TEST(description);
+                SimdGemm32fRun16(gemm, format, &alpha, (uint16_t*)A.data, A.stride / sizeof(uint16_t),
+                    (float*)B.data, B.stride / sizeof(float), &beta, (float*)dstC.data, dstC.stride / sizeof(float));
+            }
+
+            void CallEpilogue(void * gemm, float alpha, const View & A, const View & B, float beta, const Simd::GemmEpilogue & epilogue, const View & srcC, View & dstC) const
+            {
+                Simd::Copy(srcC, dstC);
+                TEST_PERFORMANCE_TEST(description);
+                ((Simd::Gemm<float>*)gemm)->Run(&alpha, (float*)A.data, A.stride / sizeof(float),
+                    (float*)B.data, B.stride / sizeof(float), &beta, (float*)dstC.data, dstC.stride / sizeof(float), &epilogue);
+            }
+
+            void Update(int transA, int transB, size_t M, size_t N, size_t K, bool packedB)
+            {
+                std::stringstream ss;
+                ss << description;
+                ss << "[" << (transA ? "T" : "N") << (transB ? "T" : "N") << (packedB ? "p" : "") << "-" << M << "-" << N << "-" << K << "]";
+                description = ss.str();
+            }
+
+            void Update(int transB, size_t batch, size_t M, size_t N, size_t K, bool shareB)
+            {
+                std::stringstream ss;
+                ss << description;
+                ss << "[" << (transB ? "NT" : "NN") << (shareB ? "s" : "") << "-" << batch << "x" << M << "-" << N << "-" << K << "]";
+                description = ss.str();
+            }
+
+            void Update(SimdGemmFormatType format, int transA, int transB, size_t M, size_t N, size_t K)
+            {
+                std::stringstream ss;
+                ss << description;
+                ss << "[" << (format == SimdGemmFormat16f ? "16f" : "16b") << "-" << (transA ? "T" : "N") << (transB ? "T" : "N");
+                ss << "-" << M << "-" << N << "-" << K << "]";
+                description = ss.str();
+            }
+        };
+    }
+
+#define FUNC_GEMM32F_INIT(function) FuncGemm32fInit(function, #function)
+
+    bool Gemm32fInitAutoTest(int transA, int transB, size_t M, size_t N, size_t K, bool packedB, FuncGemm32fInit f1, FuncGemm32fInit f2)
+    {
+        bool result = true;
+
+        f1.Update(transA, transB, M, N, K, packedB);
+        f2.Update(transA, transB, M, N, K, false);
+
+        TEST_LOG_SS(Info, "Test " << f1.description << " & " << f2.description << " [" << M << ", " << N << ", " << K << "].");
+
+        View A(transA ? M : K, transA ? K : M, View::Float, NULL, TEST_ALIGN(1));
+        View B(transB ? K : N, transB ? N : K, View::Float, NULL, TEST_ALIGN(1));
+        View dstC1(N, M, View::Float, NULL, TEST_ALIGN(1));
+        View dstC2(N, M, View::Float, NULL, TEST_ALIGN(1));
+        View srcC(N, M, View::Float, NULL, TEST_ALIGN(SIMD_ALIGN));
+
+        const float alpha = 1.5f, beta = 0.5f;
+        FillRandom32f(A, -1.0f, 1.0f);
+        FillRandom32f(B, -1.0f, 1.0f);
+        FillRandom32f(srcC, -1.0f, 1.0f);
+
+        void * gemm1 = f1.func(transA ? SimdTrue : SimdFalse, transB ? SimdTrue : SimdFalse, M, N, K);
+        void * gemm2 = f2.func(transA ? SimdTrue : SimdFalse, transB ? SimdTrue : SimdFalse, M, N, K);
+
+        std::vector<float> pB;
+        if (packedB)
+        {
+            pB.resize(SimdGemm32fPackedBSize(gemm1));
+            SimdGemm32fPackB(gemm1, (float*)B.data, B.stride / sizeof(float), pB.data());
+        }
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f1.Call(gemm1, alpha, A, B, packedB ? pB.data() : NULL, beta, srcC, dstC1));
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f2.Call(gemm2, alpha, A, B, NULL, beta, srcC, dstC2));
+
+        SimdRelease(gemm1);
+        SimdRelease(gemm2);
+
+        result = result && Compare(dstC1, dstC2, EPS, true, 32, DifferenceBoth);
+
+        if (packedB && !transA && !transB)
+        {
+            View dstC3(N, M, View::Float, NULL, TEST_ALIGN(1));
+            Simd::Copy(srcC, dstC3);
+            SimdGemm32fNN(M, N, K, &alpha, (float*)A.data, A.stride / sizeof(float), (float*)B.data, B.stride / sizeof(float),
+                &beta, (float*)dstC3.data, dstC3.stride / sizeof(float));
+            result = result && Compare(dstC1, dstC3, EPS, true, 32, DifferenceBoth);
+        }
+
+        return result;
+    }
+
+    bool Gemm32fInitAutoTest(bool packedB, const FuncGemm32fInit & f1, const FuncGemm32fInit & f2)
+    {
+        bool result = true;
+
+        for (int transA = 0; transA <= 1 && result; ++transA)
+        {
+            for (int transB = 0; transB <= 1 && result; ++transB)
+            {
+                result = result && Gemm32fInitAutoTest(transA, transB, 728, 196, 728, packedB, f1, f2);
+                result = result && Gemm32fInitAutoTest(transA, transB, 728, 192, 728, packedB, f1, f2);
+                result = result && Gemm32fInitAutoTest(transA, transB, 728, 4, 728, packedB, f1, f2);
+            }
+        }
+
+        return result;
+    }
+
+    bool Gemm32fInitAutoTest(bool packedB)
+    {
+        bool result = true;
+
+        result = result && Gemm32fInitAutoTest(packedB, FUNC_GEMM32F_INIT(Simd::Base::Gemm32fInit), FUNC_GEMM32F_INIT(SimdGemm32fInit));
+
+#ifdef SIMD_SSE_ENABLE
+        if (Simd::Sse::Enable)
+            result = result && Gemm32fInitAutoTest(packedB, FUNC_GEMM32F_INIT(Simd::Sse::Gemm32fInit), FUNC_GEMM32F_INIT(SimdGemm32fInit));
+#endif 
+
+#ifdef SIMD_SSE3_ENABLE
+        if (Simd::Sse3::Enable)
+            result = result && Gemm32fInitAutoTest(packedB, FUNC_GEMM32F_INIT(Simd::Sse3::Gemm32fInit), FUNC_GEMM32F_INIT(SimdGemm32fInit));
+#endif 
+
+#ifdef SIMD_AVX_ENABLE
+        if (Simd::Avx::Enable)
+            result = result && Gemm32fInitAutoTest(packedB, FUNC_GEMM32F_INIT(Simd::Avx::Gemm32fInit), FUNC_GEMM32F_INIT(SimdGemm32fInit));
+#endif 
+
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable)
+            result = result && Gemm32fInitAutoTest(packedB, FUNC_GEMM32F_INIT(Simd::Avx2::Gemm32fInit), FUNC_GEMM32F_INIT(SimdGemm32fInit));
+#endif 
+
+#ifdef SIMD_AVX512F_ENABLE
+        if (Simd::Avx512f::Enable)
+            result = result && Gemm32fInitAutoTest(packedB, FUNC_GEMM32F_INIT(Simd::Avx512f::Gemm32fInit), FUNC_GEMM32F_INIT(SimdGemm32fInit));
+#endif 
+
+        return result;
+    }
+
+    bool Gemm32fInitAutoTest()
+    {
+        return Gemm32fInitAutoTest(false);
+    }
+
+    bool Gemm32fPackedBAutoTest()
+    {
+        return Gemm32fInitAutoTest(true);
+    }
+
+    bool Gemm32fBatchedAutoTest(int transB, size_t batch, size_t M, size_t N, size_t K, bool shareB, FuncGemm32fInit f1, FuncGemm32fInit f2)
+    {
+        bool result = true;
+
+        f1.Update(transB, batch, M, N, K, shareB);
+        f2.Update(transB, batch, M, N, K, shareB);
+
+        TEST_LOG_SS(Info, "Test " << f1.description << " & " << f2.description << " [" << batch << ", " << M << ", " << N << ", " << K << "].");
+
+        size_t bB = shareB ? 1 : batch;
+        View A(K, M * batch, View::Float, NULL, TEST_ALIGN(1));
+        View B(transB ? K : N, (transB ? N : K) * bB, View::Float, NULL, TEST_ALIGN(1));
+        View dstC1(N, M * batch, View::Float, NULL, TEST_ALIGN(1));
+        View dstC2(N, M * batch, View::Float, NULL, TEST_ALIGN(1));
+        View srcC(N, M * batch, View::Float, NULL, TEST_ALIGN(SIMD_ALIGN));
+
+        const float alpha = 1.5f, beta = 0.5f;
+        FillRandom32f(A, -1.0f, 1.0f);
+        FillRandom32f(B, -1.0f, 1.0f);
+        FillRandom32f(srcC, -1.0f, 1.0f);
+
+        void * gemm1 = f1.func(SimdFalse, transB ? SimdTrue : SimdFalse, M, N, K);
+        void * gemm2 = f2.func(SimdFalse, transB ? SimdTrue : SimdFalse, M, N, K);
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f1.CallBatched(gemm1, batch, alpha, A, B, shareB, beta, srcC, dstC1));
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f2.CallBatched(gemm2, batch, alpha, A, B, shareB, beta, srcC, dstC2));
+
+        SimdRelease(gemm1);
+        SimdRelease(gemm2);
+
+        result = result && Compare(dstC1, dstC2, EPS, true, 32, DifferenceBoth);
+
+        return result;
+    }
+
+    bool Gemm32fBatchedAutoTest(const FuncGemm32fInit & f1, const FuncGemm32fInit & f2)
+    {
+        bool result = true;
+
+        for (int transB = 0; transB <= 1 && result; ++transB)
+        {
+            result = result && Gemm32fBatchedAutoTest(transB, 64, 32, 196, 72, false, f1, f2);
+            result = result && Gemm32fBatchedAutoTest(transB, 16, 48, 49, 144, true, f1, f2);
+            result = result && Gemm32fBatchedAutoTest(transB, 4, 256, 196, 256, false, f1, f2);
+            result = result && Gemm32fBatchedAutoTest(transB, 1, 17, 5, 9, false, f1, f2);
+        }
+
+        return result;
+    }
+
+    bool Gemm32fBatchedAutoTest()
+    {
+        bool result = true;
+
+        result = result && Gemm32fBatchedAutoTest(FUNC_GEMM32F_INIT(Simd::Base::Gemm32fInit), FUNC_GEMM32F_INIT(SimdGemm32fInit));
+
+#ifdef SIMD_SSE_ENABLE
+        if (Simd::Sse::Enable)
+            result = result && Gemm32fBatchedAutoTest(FUNC_GEMM32F_INIT(Simd::Sse::Gemm32fInit), FUNC_GEMM32F_INIT(SimdGemm32fInit));
+#endif 
+
+#ifdef SIMD_SSE3_ENABLE
+        if (Simd::Sse3::Enable)
+            result = result && Gemm32fBatchedAutoTest(FUNC_GEMM32F_INIT(Simd::Sse3::Gemm32fInit), FUNC_GEMM32F_INIT(SimdGemm32fInit));
+#endif 
+
+#ifdef SIMD_AVX_ENABLE
+        if (Simd::Avx::Enable)
+            result = result && Gemm32fBatchedAutoTest(FUNC_GEMM32F_INIT(Simd::Avx::Gemm32fInit), FUNC_GEMM32F_INIT(SimdGemm32fInit));
+#endif 
+
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable)
+            result = result && Gemm32fBatchedAutoTest(FUNC_GEMM32F_INIT(Simd::Avx2::Gemm32fInit), FUNC_GEMM32F_INIT(SimdGemm32fInit));
+#endif 
+
+#ifdef SIMD_AVX512F_ENABLE
+        if (Simd::Avx512f::Enable)
+            result = result && Gemm32fBatchedAutoTest(FUNC_GEMM32F_INIT(Simd::Avx512f::Gemm32fInit), FUNC_GEMM32F_INIT(SimdGemm32fInit));
+#endif 
+
+        return result;
+    }
+
+    bool Gemm32fRun16AutoTest(SimdGemmFormatType format, int transA, int transB, size_t M, size_t N, size_t K, FuncGemm32fInit f1, FuncGemm32fInit f2)
+    {
+        bool result = true;
+
+        f1.Update(format, transA, transB, M, N, K);
+        f2.Update(format, transA, transB, M, N, K);
+
+        TEST_LOG_SS(Info, "Test " << f1.description << " & " << f2.description << " [" << M << ", " << N << ", " << K << "].");
+
+        View A32(transA ? M : K, transA ? K : M, View::Float, NULL, TEST_ALIGN(1));
+        View A16(A32.width, A32.height, View::Int16, NULL, TEST_ALIGN(1));
+        View B(transB ? K : N, transB ? N : K, View::Float, NULL, TEST_ALIGN(1));
+        View dstC1(N, M, View::Float, NULL, TEST_ALIGN(1));
+        View dstC2(N, M, View::Float, NULL, TEST_ALIGN(1));
+        View srcC(N, M, View::Float, NULL, TEST_ALIGN(SIMD_ALIGN));
+
+        const float alpha = 1.5f, beta = 0.5f;
+        FillRandom32f(A32, -1.0f, 1.0f);
+        FillRandom32f(B, -1.0f, 1.0f);
+        FillRandom32f(srcC, -1.0f, 1.0f);
+
+        for (size_t row = 0; row < A32.height; ++row)
+        {
+            const float * src = A32.Row<float>(row);
+            uint16_t * dst = A16.Row<uint16_t>(row);
+            if (format == SimdGemmFormat16f)
+                SimdFloat32ToFloat16(src, A32.width, dst);
+            else
+                for (size_t col = 0; col < A32.width; ++col)
+                    dst[col] = uint16_t(((uint32_t*)src)[col] >> 16);
+        }
+
+        void * gemm1 = f1.func(transA ? SimdTrue : SimdFalse, transB ? SimdTrue : SimdFalse, M, N, K);
+        void * gemm2 = f2.func(transA ? SimdTrue : SimdFalse, transB ? SimdTrue : SimdFalse, M, N, K);
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f1.Call16(gemm1, format, alpha, A16, B, beta, srcC, dstC1));
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f2.Call16(gemm2, format, alpha, A16, B, beta, srcC, dstC2));
+
+        SimdRelease(gemm1);
+        SimdRelease(gemm2);
+
+        result = result && Compare(dstC1, dstC2, EPS, true, 32, DifferenceBoth);
+
+        return result;
+    }
+
+    bool Gemm32fRun16AutoTest(const FuncGemm32fInit & f1, const FuncGemm32fInit & f2)
+    {
+        bool result = true;
+
+        for (int format = SimdGemmFormat16f; format <= SimdGemmFormat16b && result; ++format)
+        {
+            for (int transA = 0; transA <= 1 && result; ++transA)
+            {
+                for (int transB = 0; transB <= 1 && result; ++transB)
+                {
+                    result = result && Gemm32fRun16AutoTest((SimdGemmFormatType)format, transA, transB, 256, 196, 256, f1, f2);
+                    result = result && Gemm32fRun16AutoTest((SimdGemmFormatType)format, transA, transB, 17, 5, 9, f1, f2);
+                }
+            }
+        }
+
+        return result;
+    }
+
+    bool Gemm32fRun16AutoTest()
+    {
+        bool result = true;
+
+        result = result && Gemm32fRun16AutoTest(FUNC_GEMM32F_INIT(Simd::Base::Gemm32fInit), FUNC_GEMM32F_INIT(SimdGemm32fInit));
+
+#ifdef SIMD_SSE_ENABLE
+        if (Simd::Sse::Enable)
+            result = result && Gemm32fRun16AutoTest(FUNC_GEMM32F_INIT(Simd::Sse::Gemm32fInit), FUNC_GEMM32F_INIT(SimdGemm32fInit));
+#endif 
+
+#ifdef SIMD_SSE3_ENABLE
+        if (Simd::Sse3::Enable)
+            result = result && Gemm32fRun16AutoTest(FUNC_GEMM32F_INIT(Simd::Sse3::Gemm32fInit), FUNC_GEMM32F_INIT(SimdGemm32fInit));
+#endif 
+
+#ifdef SIMD_AVX_ENABLE
+        if (Simd::Avx::Enable)
+            result = result && Gemm32fRun16AutoTest(FUNC_GEMM32F_INIT(Simd::Avx::Gemm32fInit), FUNC_GEMM32F_INIT(SimdGemm32fInit));
+#endif 
+
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable)
+            result = result && Gemm32fRun16AutoTest(FUNC_GEMM32F_INIT(Simd::Avx2::Gemm32fInit), FUNC_GEMM32F_INIT(SimdGemm32fInit));
+#endif 
+
+#ifdef SIMD_AVX512F_ENABLE
+        if (Simd::Avx512f::Enable)
+            result = result && Gemm32fRun16AutoTest(FUNC_GEMM32F_INIT(Simd::Avx512f::Gemm32fInit), FUNC_GEMM32F_INIT(SimdGemm32fInit));
+#endif 
+
+        return result;
+    }
+
+    float GemmActivate(SimdConvolutionActivationType type, float value, float slope)
+    {
+        switch (type)
+        {
+        case SimdConvolutionActivationRelu: return Simd::Max(0.0f, value);
+        case SimdConvolutionActivationLeakyRelu:
+        case SimdConvolutionActivationPrelu: return Simd::Max(0.0f, value) + slope * Simd::Min(0.0f, value);
+        case SimdConvolutionActivationSigmoid: return 1.0f / (1.0f + ::exp(-value));
+        default: return value;
+        }
+    }
+
+    bool Gemm32fEpilogueAutoTest(int transB, size_t M, size_t N, size_t K, SimdConvolutionActivationType type, bool bias, bool perColumn, FuncGemm32fInit f1, FuncGemm32fInit f2)
+    {
+        bool result = true;
+
+        std::stringstream ss;
+        ss << "[" << (transB ? "NT" : "NN") << "-" << M << "-" << N << "-" << K << "-a" << int(type) << (bias ? "b" : "") << (perColumn ? "c" : "r") << "]";
+        f1.description += ss.str();
+        f2.description += ss.str();
+
+        TEST_LOG_SS(Info, "Test " << f1.description << " & " << f2.description << " [" << M << ", " << N << ", " << K << "].");
+
+        View A(K, M, View::Float, NULL, TEST_ALIGN(1));
+        View B(transB ? K : N, transB ? N : K, View::Float, NULL, TEST_ALIGN(1));
+        View dstC1(N, M, View::Float, NULL, TEST_ALIGN(1));
+        View dstC2(N, M, View::Float, NULL, TEST_ALIGN(1));
+        View srcC(N, M, View::Float, NULL, TEST_ALIGN(SIMD_ALIGN));
+
+        size_t size = perColumn ? N : M;
+        std::vector<float> _bias(size), _params(size);
+        FillRandom(_bias.data(), size, -1.0f, 1.0f);
+        FillRandom(_params.data(), size, 0.0f, 0.5f);
+
+        const float alpha = 1.5f, beta = 0.5f;
+        FillRandom32f(A, -1.0f, 1.0f);
+        FillRandom32f(B, -1.0f, 1.0f);
+        FillRandom32f(srcC, -1.0f, 1.0f);
+
+        void * gemm1 = f1.func(SimdFalse, transB ? SimdTrue : SimdFalse, M, N, K);
+        void * gemm2 = f2.func(SimdFalse, transB ? SimdTrue : SimdFalse, M, N, K);
+
+        Simd::GemmEpilogue epilogue(bias ? _bias.data() : NULL, type, _params.data(), perColumn);
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f1.CallEpilogue(gemm1, alpha, A, B, beta, epilogue, srcC, dstC1));
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f2.Call(gemm2, alpha, A, B, NULL, beta, srcC, dstC2));
+        for (size_t i = 0; i < M; ++i)
+        {
+            float * C = (float*)(dstC2.data + i * dstC2.stride);
+            for (size_t j = 0; j < N; ++j)
+            {
+                size_t index = perColumn ? j : i;
+                float slope = type == SimdConvolutionActivationLeakyRelu ? _params.data()[0] : _params.data()[index];
+                C[j] = GemmActivate(type, bias ? C[j] + _bias.data()[index] : C[j], slope);
+            }
+        }
+
+        SimdRelease(gemm1);
+        SimdRelease(gemm2);
+
+        result = result && Compare(dstC1, dstC2, EPS, true, 32, DifferenceBoth);
+
+        return result;
+    }
+
+    bool Gemm32fEpilogueAutoTest(const FuncGemm32fInit & f1, const FuncGemm32fInit & f2)
+    {
+        bool result = true;
+
+        for (int transB = 0; transB <= 1 && result; ++transB)
+        {
+            result = result && Gemm32fEpilogueAutoTest(transB, 37, 61, 53, SimdConvolutionActivationRelu, false, true, f1, f2);
+            result = result && Gemm32fEpilogueAutoTest(transB, 37, 61, 53, SimdConvolutionActivationLeakyRelu, true, false, f1, f2);
+            result = result && Gemm32fEpilogueAutoTest(transB, 128, 196, 256, SimdConvolutionActivationPrelu, true, true, f1, f2);
+            result = result && Gemm32fEpilogueAutoTest(transB, 128, 196, 256, SimdConvolutionActivationPrelu, true, false, f1, f2);
+            result = result && Gemm32fEpilogueAutoTest(transB, 128, 196, 256, SimdConvolutionActivationSigmoid, true, true, f1, f2);
+            result = result && Gemm32fEpilogueAutoTest(transB, 37, 61, 53, SimdConvolutionActivationSigmoid, true, false, f1, f2);
+        }
+
+        return result;
+    }
+
+    bool Gemm32fEpilogueAutoTest()
+    {
+        bool result = true;
+
+        result = result && Gemm32fEpilogueAutoTest(FUNC_GEMM32F_INIT(Simd::Base::Gemm32fInit), FUNC_GEMM32F_INIT(SimdGemm32fInit));
+
+#ifdef SIMD_SSE_ENABLE
+        if (Simd::Sse::Enable)
+            result = result && Gemm32fEpilogueAutoTest(FUNC_GEMM32F_INIT(Simd::Sse::Gemm32fInit), FUNC_GEMM32F_INIT(SimdGemm32fInit));
+#endif 
+
+#ifdef SIMD_SSE3_ENABLE
+        if (Simd::Sse3::Enable)
+            result = result && Gemm32fEpilogueAutoTest(FUNC_GEMM32F_INIT(Simd::Sse3::Gemm32fInit), FUNC_GEMM32F_INIT(SimdGemm32fInit));
+#endif 
+
+#ifdef SIMD_AVX_ENABLE
+        if (Simd::Avx::Enable)
+            result = result && Gemm32fEpilogueAutoTest(FUNC_GEMM32F_INIT(Simd::Avx::Gemm32fInit), FUNC_GEMM32F_INIT(SimdGemm32fInit));
+#endif 
+
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable)
+            result = result && Gemm32fEpilogueAutoTest(FUNC_GEMM32F_INIT(Simd::Avx2::Gemm32fInit), FUNC_GEMM32F_INIT(SimdGemm32fInit));
+#endif 
+
+#ifdef SIMD_AVX512F_ENABLE
+        if (Simd::Avx512f::Enable)
+            result = result && Gemm32fEpilogueAutoTest(FUNC_GEMM32F_INIT(Simd::Avx512f::Gemm32fInit), FUNC_GEMM32F_INIT(SimdGemm32fInit));
+#endif 
+
+        return result;
+    }
+
+    namespace
+    {
+        struct FuncGemm8u8i32i
+        {
+            typedef void(*FuncPtr)(size_t M, size_t N, size_t K, const uint8_t * A, size_t lda, const int8_t * B, size_t ldb, int32_t * C, size_t ldc);
+
+            FuncPtr func;
+            String description;
+
+            FuncGemm8u8i32i(const FuncPtr & f, const String & d) : func(f), description(d) {}
+
+            void Call(size_t M, size_t N, size_t K, const View & A, const View & B, View & C) const
+            {
+                TEST_PERFORMANCE_TEST(description);
+                func(M, N, K, A.data, A.stride, (int8_t*)B.data, B.stride, (int32_t*)C.data, C.stride / sizeof(int32_t));
+            }
+
+            void Update(size_t M, size_t N, size_t K)
+            {
+                std::stringstream ss;
+                ss << description;
+                ss << "[" << M << "-" << N << "-" << K << "]";
+                description = ss.str();
+            }
+        };
+    }
+
+#define FUNC_GEMM8U8I32I(function) FuncGemm8u8i32i(function, #function)
+
+    bool Gemm8u8i32iAutoTest(size_t M, size_t N, size_t K, FuncGemm8u8i32i f1, FuncGemm8u8i32i f2)
+    {
+        bool result = true;
+
+        f1.Update(M, N, K);
+        f2.Update(M, N, K);
+
+        TEST_LOG_SS(Info, "Test " << f1.description << " & " << f2.description << " [" << M << ", " << N << ", " << K << "].");
+
+        View C1(N, M, View::Int32, NULL, TEST_ALIGN(1));
+        View C2(N, M, View::Int32, NULL, TEST_ALIGN(1));
+        View A(K, M, View::Gray8, NULL, TEST_ALIGN(SIMD_ALIGN));
+        View B(N, K, View::Gray8, NULL, TEST_ALIGN(SIMD_ALIGN));
+
+        FillRandom(A);
+        FillRandom(B);
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f1.Call(M, N, K, A, B, C1));
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f2.Call(M, N, K, A, B, C2));
+
+        result = result && Compare(C1, C2, 0, true, 32);
+
+        return result;
+    }
+
+    bool Gemm8u8i32iNNAutoTest(const FuncGemm8u8i32i & f1, const FuncGemm8u8i32i & f2)
+    {
+        bool result = true;
+
+        result = result && Gemm8u8i32iAutoTest(728, 196, 728, f1, f2);
+        result = result && Gemm8u8i32iAutoTest(728, 192, 727, f1, f2);
+        result = result && Gemm8u8i32iAutoTest(97, 33, 83, f1, f2);
+        result = result && Gemm8u8i32iAutoTest(5, 4, 3, f1, f2);
+
+        return result;
+    }
+
+    bool Gemm8u8i32iNNAutoTest()
+    {
+        bool result = true;
+
+        result = result && Gemm8u8i32iNNAutoTest(FUNC_GEMM8U8I32I(Simd::Base::Gemm8u8i32iNN), FUNC_GEMM8U8I32I(SimdGemm8u8i32iNN));
+
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable)
+            result = result && Gemm8u8i32iNNAutoTest(FUNC_GEMM8U8I32I(Simd::Avx2::Gemm8u8i32iNN), FUNC_GEMM8U8I32I(SimdGemm8u8i32iNN));
+#endif
+
+#ifdef SIMD_AVX512BW_ENABLE
+        if (Simd::Avx512bw::Enable)
+            result = result && Gemm8u8i32iNNAutoTest(FUNC_GEMM8U8I32I(Simd::Avx512bw::Gemm8u8i32iNN), FUNC_GEMM8U8I32I(SimdGemm8u8i32iNN));
+#endif
+
+#ifdef SIMD_AVX512VNNI_ENABLE
+        if (Simd::Avx512vnni::Enable)
+            result = result && Gemm8u8i32iNNAutoTest(FUNC_GEMM8U8I32I(Simd::Avx512vnni::Gemm8u8i32iNN), FUNC_GEMM8U8I32I(SimdGemm8u8i32iNN));
+#endif
+
+        return result;
+    }
+
+    namespace
+    {
+        struct FuncGemm8u8i8u
+        {
+            typedef void(*FuncPtr)(size_t M, size_t N, size_t K, const uint8_t * A, size_t lda, const int8_t * B, size_t ldb, const int32_t * bias, const float * scale, uint8_t zero, uint8_t * C, size_t ldc);
+
+            FuncPtr func;
+            String description;
+
+            FuncGemm8u8i8u(const FuncPtr & f, const String & d) : func(f), description(d) {}
+
+            void Call(size_t M, size_t N, size_t K, const View & A, const View & B, const int32_t * bias, const float * scale, uint8_t zero, View & C) const
+            {
+                TEST_PERFORMANCE_TEST(description);
+                func(M, N, K, A.data, A.stride, (int8_t*)B.data, B.stride, bias, scale, zero, C.data, C.stride);
+            }
+
+            void Update(size_t M, size_t N, size_t K)
+            {
+                std::stringstream ss;
+                ss << description;
+                ss << "[" << M << "-" << N << "-" << K << "]";
+                description = ss.str();
+            }
+        };
+    }
+
+#define FUNC_GEMM8U8I8U(function) FuncGemm8u8i8u(function, #function)
+
+    bool Gemm8u8i8uAutoTest(size_t M, size_t N, size_t K, FuncGemm8u8i8u f1, FuncGemm8u8i8u f2)
+    {
+        bool result = true;
+
+        f1.Update(M, N, K);
+        f2.Update(M, N, K);
+
+        TEST_LOG_SS(Info, "Test " << f1.description << " & " << f2.description << " [" << M << ", " << N << ", " << K << "].");
+
+        View C1(N, M, View::Gray8, NULL, TEST_ALIGN(1));
+        View C2(N, M, View::Gray8, NULL, TEST_ALIGN(1));
+        View A(K, M, View::Gray8, NULL, TEST_ALIGN(SIMD_ALIGN));
+        View B(N, K, View::Gray8, NULL, TEST_ALIGN(SIMD_ALIGN));
+
+        FillRandom(A);
+        FillRandom(B);
+
+        const uint8_t zero = 128;
+        const float range = 64.0f / 10000.0f / ::sqrt(float(K));
+        Buffer32f scale(N);
+        FillRandom(scale, range * 0.5f, range * 1.5f);
+        std::vector<int32_t> bias(N);
+        for (size_t j = 0; j < N; ++j)
+            bias[j] = Random(20001) - 10000;
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f1.Call(M, N, K, A, B, bias.data(), scale.data(), zero, C1));
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f2.Call(M, N, K, A, B, bias.data(), scale.data(), zero, C2));
+
+        result = result && Compare(C1, C2, 0, true, 32);
+
+        return result;
+    }
+
+    bool Gemm8u8i8uNNAutoTest(const FuncGemm8u8i8u & f1, const FuncGemm8u8i8u & f2)
+    {
+        bool result = true;
+
+        result = result && Gemm8u8i8uAutoTest(728, 196, 728, f1, f2);
+        result = result && Gemm8u8i8uAutoTest(728, 192, 727, f1, f2);
+        result = result && Gemm8u8i8uAutoTest(97, 33, 83, f1, f2);
+        result = result && Gemm8u8i8uAutoTest(5, 4, 3, f1, f2);
+
+        return result;
+    }
+
+    bool Gemm8u8i8uNNAutoTest()
+    {
+        bool result = true;
+
+        result = result && Gemm8u8i8uNNAutoTest(FUNC_GEMM8U8I8U(Simd::Base::Gemm8u8i8uNN), FUNC_GEMM8U8I8U(SimdGemm8u8i8uNN));
+
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable)
+            result = result && Gemm8u8i8uNNAutoTest(FUNC_GEMM8U8I8U(Simd::Avx2::Gemm8u8i8uNN), FUNC_GEMM8U8I8U(SimdGemm8u8i8uNN));
+#endif
+
+#ifdef SIMD_AVX512BW_ENABLE
+        if (Simd::Avx512bw::Enable)
+            result = result && Gemm8u8i8uNNAutoTest(FUNC_GEMM8U8I8U(Simd::Avx512bw::Gemm8u8i8uNN), FUNC_GEMM8U8I8U(SimdGemm8u8i8uNN));
+#endif
+
+#ifdef SIMD_AVX512VNNI_ENABLE
+        if (Simd::Avx512vnni::Enable)
+            result = result && Gemm8u8i8uNNAutoTest(FUNC_GEMM8U8I8U(Simd::Avx512vnni::Gemm8u8i8uNN), FUNC_GEMM8U8I8U(SimdGemm8u8i8uNN));
+#endif
+
+        return result;
+    }
+
     //-----------------------------------------------------------------------
 
     bool Gemm32fDataTest(bool create, int transA, int transB, size_t M, size_t N, size_t K, const FuncGemm32f & f)
@@ -716,17 +716,33 @@ namespace Test
         return result;
     }
 
-    bool NeuralPowAutoTest(float error, bool relative, const FuncAF & f1, const FuncAF & f2)
+    bool NeuralPowAutoTest(float error, bool relative, float exponent, const FuncAF & f1, const FuncAF & f2)
     {
         bool result = true;
 
-        const float lo = 0.001f, hi = 9.999f, exponent = -0.75;
+        const float lo = 0.001f, hi = 9.999f;
         result = result && NeuralActivateFunctionAutoTest(W*H, error, relative, exponent, lo, hi, f1, f2);
         result = result && NeuralActivateFunctionAutoTest(W*H + O, error, relative, exponent, lo, hi, f1, f2);
 
         return result;
     }
 
+    bool NeuralPowAutoTest(float error, bool relative, const FuncAF & f1, const FuncAF & f2)
+    {
+        return NeuralPowAutoTest(error, relative, -0.75f, f1, f2);
+    }
+
+    bool NeuralPowAccuracyAutoTest(const FuncAF & f)
+    {
+        bool result = true;
+
+        const float exponents[] = { -0.75f, 0.5f, 2.5f };
+        for (size_t i = 0; i < 3; ++i)
+            result = result && NeuralPowAutoTest(0.0001f, true, exponents[i], FUNC_AF(Simd::Base::NeuralPow), f);
+
+        return result;
+    }
+
     bool NeuralPowAutoTest()
     {
         bool result = true;
@@ -735,17 +751,26 @@ namespace Test
 
 #ifdef SIMD_SSE2_ENABLE
         if (Simd::Sse2::Enable)
+        {
             result = result && NeuralPowAutoTest(EPS, false, FUNC_AF(Simd::Sse2::NeuralPow), FUNC_AF(SimdNeuralPow));
+            result = result && NeuralPowAccuracyAutoTest(FUNC_AF(Simd::Sse2::NeuralPow));
+        }
 #endif 
 
 #ifdef SIMD_AVX2_ENABLE
         if (Simd::Avx2::Enable)
+        {
             result = result && NeuralPowAutoTest(EPS, false, FUNC_AF(Simd::Avx2::NeuralPow), FUNC_AF(SimdNeuralPow));
+            result = result && NeuralPowAccuracyAutoTest(FUNC_AF(Simd::Avx2::NeuralPow));
+        }
 #endif 
 
 #ifdef SIMD_AVX512F_ENABLE
         if (Simd::Avx512f::Enable)
+        {
             result = result && NeuralPowAutoTest(EPS, false, FUNC_AF(Simd::Avx512f::NeuralPow), FUNC_AF(SimdNeuralPow));
+            result = result && NeuralPowAccuracyAutoTest(FUNC_AF(Simd::Avx512f::NeuralPow));
+        }
 #endif
 
         return result;
@@ -2993,6 +3018,175 @@ namespace Test
         return true;
     }
 
+    bool NeuralConvolutionalLayerFastAutoTest(Simd::Neural::Function::Type f, const Size & size, size_t srcDepth, size_t dstDepth, const Size & core)
+    {
+        using namespace Simd::Neural;
+        bool result = true;
+
+        TEST_LOG_SS(Info, "Test Simd::Neural::ConvolutionalLayer Fast & Check [" << size.x << "x" << size.y << "x" << srcDepth << ", " << dstDepth << ", " << core.x << "x" << core.y << ", " << int(f) << "].");
+
+        Network net;
+        TEST_ADD_LAYER(net, (new ConvolutionalLayer(f, size, srcDepth, dstDepth, core, false)));
+
+        Vectors src(4), dst(src.size());
+        for (size_t i = 0; i < src.size(); ++i)
+        {
+            src[i].resize(net.InputIndex().Volume());
+            for (size_t j = 0; j < src[i].size(); ++j)
+                src[i][j] = float(rand()) / RAND_MAX * 2.0f - 1.0f;
+            dst[i].resize(net.OutputIndex().Volume());
+            for (size_t j = 0; j < dst[i].size(); ++j)
+                dst[i][j] = float(rand()) / RAND_MAX;
+        }
+
+        TrainOptions options;
+        options.threadNumber = 1;
+        options.batchSize = src.size();
+        options.alpha = 0.1f;
+        options.epochStart = 0;
+        options.epochFinish = 0;
+        net.Train(src, dst, options, [](){});
+
+        Vector before[2];
+        for (size_t step = 0; step < 2 && result; ++step)
+        {
+            Vector fast, check;
+            {
+                TEST_PERFORMANCE_TEST("SimdNeuralConvolutionalLayer");
+                fast = net.Predict(src[0], 0, Layer::Fast);
+            }
+            {
+                TEST_PERFORMANCE_TEST("Simd::Base::NeuralConvolutionalLayer");
+                check = net.Predict(src[0], 0, Layer::Check);
+            }
+            float maxDifference = 0;
+            for (size_t j = 0; j < fast.size(); ++j)
+                maxDifference = std::max(maxDifference, ::fabs(fast[j] - check[j]));
+            if (maxDifference > EPS)
+            {
+                TEST_LOG_SS(Error, "Fast and Check predictions differ " << (step ? "after" : "before") << " training step: " << maxDifference << " !");
+                result = false;
+            }
+            before[step] = fast;
+            if (step == 0)
+            {
+                options.epochStart = 1;
+                options.epochFinish = 2;
+                net.Train(src, dst, options, [](){});
+            }
+        }
+
+        if (result && before[0] == before[1])
+        {
+            TEST_LOG_SS(Error, "Fast prediction is not changed after training step!");
+            result = false;
+        }
+
+        return result;
+    }
+
+    bool NeuralConvolutionalLayerFastAutoTest()
+    {
+        using namespace Simd::Neural;
+        bool result = true;
+
+        result = result && NeuralConvolutionalLayerFastAutoTest(Function::LeakyRelu, Size(12, 10), 3, 8, Size(3, 3));
+        result = result && NeuralConvolutionalLayerFastAutoTest(Function::LeakyRelu, Size(11, 13), 2, 5, Size(5, 5));
+        result = result && NeuralConvolutionalLayerFastAutoTest(Function::Sigmoid, Size(12, 10), 3, 8, Size(3, 3));
+        result = result && NeuralConvolutionalLayerFastAutoTest(Function::Sigmoid, Size(11, 13), 2, 5, Size(4, 4));
+        result = result && NeuralConvolutionalLayerFastAutoTest(Function::LeakyRelu, Size(24, 24), 16, 8, Size(3, 3));
+
+        return result;
+    }
+
+    bool NeuralTrainThreadsAutoTest(size_t threadNumber, size_t epochs, float eps)
+    {
+        using namespace Simd::Neural;
+        bool result = true;
+
+        TEST_LOG_SS(Info, "Test Simd::Neural::Network::Train [" << epochs << " epochs] with 1 and " << threadNumber << " threads.");
+
+        Network net[2];
+        for (size_t n = 0; n < 2; ++n)
+        {
+            TEST_ADD_LAYER(net[n], (new ConvolutionalLayer(Function::Relu, Size(12, 12), 2, 6, Size(3, 3))));
+            TEST_ADD_LAYER(net[n], (new MaxPoolingLayer(Function::Relu, Size(10, 10), 6, Size(2, 2), Size(2, 2))));
+            TEST_ADD_LAYER(net[n], (new FullyConnectedLayer(Function::Relu, 5 * 5 * 6, 32)));
+            TEST_ADD_LAYER(net[n], (new FullyConnectedLayer(Function::Sigmoid, 32, 10)));
+        }
+
+        Vectors src(256), dst(src.size());
+        for (size_t i = 0; i < src.size(); ++i)
+        {
+            src[i].resize(net[0].InputIndex().Volume());
+            for (size_t j = 0; j < src[i].size(); ++j)
+                src[i][j] = float(rand()) / RAND_MAX * 2.0f - 1.0f;
+            dst[i].resize(net[0].OutputIndex().Volume());
+            for (size_t j = 0; j < dst[i].size(); ++j)
+                dst[i][j] = float(rand()) / RAND_MAX;
+        }
+
+        TrainOptions options;
+        options.threadNumber = 1;
+        options.batchSize = 32;
+        options.shuffle = false;
+        options.epochStart = 0;
+        options.epochFinish = 0;
+        net[0].Train(src, dst, options, [](){});
+
+        std::stringstream init;
+        net[0].Save(init, true);
+        for (size_t n = 0; n < 2; ++n)
+        {
+            std::stringstream is(init.str());
+            net[n].Load(is, true);
+        }
+
+        Vector weights[2];
+        for (size_t n = 0; n < 2; ++n)
+        {
+            options.threadNumber = n ? threadNumber : 1;
+            options.epochStart = 1;
+            options.epochFinish = 1 + epochs;
+            {
+                TEST_PERFORMANCE_TEST(n ? "SimdNeuralTrain-mt" : "Simd::Base::NeuralTrain");
+                net[n].Train(src, dst, options, [](){});
+            }
+            std::stringstream os;
+            os.precision(9);
+            net[n].Save(os);
+            float value;
+            while (os >> value)
+                weights[n].push_back(value);
+        }
+
+        if (weights[0].size() != weights[1].size() || weights[0].empty())
+        {
+            TEST_LOG_SS(Error, "Saved weights have different sizes: " << weights[0].size() << " != " << weights[1].size() << " !");
+            return false;
+        }
+        float maxDifference = 0;
+        for (size_t i = 0; i < weights[0].size(); ++i)
+            maxDifference = std::max(maxDifference, ::fabs(weights[0][i] - weights[1][i]));
+        if (maxDifference > eps)
+        {
+            TEST_LOG_SS(Error, "Weights trained with 1 and " << options.threadNumber << " threads differ: " << maxDifference << " !");
+            result = false;
+        }
+
+        return result;
+    }
+
+    bool NeuralTrainThreadsAutoTest()
+    {
+        bool result = true;
+
+        result = result && NeuralTrainThreadsAutoTest(2, 3, 0.001f);
+        result = result && NeuralTrainThreadsAutoTest(4, 3, 0.001f);
+
+        return result;
+    }
+
     bool NeuralPredictSpecialTest()
     {
         Network net;
@@ -3024,6 +3218,170 @@ namespace Test
         return true;
     }
 
+    bool NeuralPredictBatchSpecialTest()
+    {
+        Network net;
+        if (!CreateNetwork(net, false, false))
+        {
+            TEST_LOG_SS(Error, "Can't create Simd::Neural::Network!");
+            return false;
+        }
+
+        String path = ROOT_PATH + "/data/network/digit.txt";
+        if (!net.Load(path))
+        {
+            TEST_LOG_SS(Error, "Can't load Simd::Neural::Network from file '" << path << "'!");
+            return false;
+        }
+
+        TrainSample sample;
+        if (!LoadDigits(net, true, sample))
+            return false;
+
+        Vectors batch;
+        net.Predict(sample.src, batch);
+        if (batch.size() != sample.src.size())
+        {
+            TEST_LOG_SS(Error, "Wrong size of batch prediction result: " << batch.size() << " instead of " << sample.src.size() << "!");
+            return false;
+        }
+
+        bool result = true;
+        for (size_t i = 0; i < sample.src.size() && result; ++i)
+        {
+            const Vector & single = net.Predict(sample.src[i]);
+            float maxDifference = 0;
+            for (size_t j = 0; j < single.size(); ++j)
+                maxDifference = std::max(maxDifference, ::fabs(single[j] - batch[i][j]));
+            if (maxDifference > EPS)
+            {
+                TEST_LOG_SS(Error, "Batch and single predictions of sample " << i << " differ: " << maxDifference << " !");
+                result = false;
+            }
+        }
+
+        Vectors reordered;
+        net.Predict(sample.src, reordered);
+        for (size_t i = 0; i < reordered.size() && result; ++i)
+        {
+            for (size_t j = 0; j < reordered[i].size() && result; ++j)
+            {
+                if (::fabs(reordered[i][j] - batch[i][j]) > EPS)
+                {
+                    TEST_LOG_SS(Error, "Batch predictions of sample " << i << " before and after weight reordering differ!");
+                    result = false;
+                }
+            }
+        }
+
+        TEST_LOG_SS(Info, "Batch prediction of " << batch.size() << " samples is checked.");
+
+        return result;
+    }
+
+    bool NeuralPredictBinarySpecialTest()
+    {
+        Network net;
+        if (!CreateNetwork(net, false, false))
+        {
+            TEST_LOG_SS(Error, "Can't create Simd::Neural::Network!");
+            return false;
+        }
+
+        String path = ROOT_PATH + "/data/network/digit.txt";
+        if (!net.Load(path))
+        {
+            TEST_LOG_SS(Error, "Can't load Simd::Neural::Network from file '" << path << "'!");
+            return false;
+        }
+
+        TrainSample sample;
+        if (!LoadDigits(net, true, sample))
+            return false;
+
+        String binary = "digit.bin";
+        if (!net.SaveBinary(binary))
+        {
+            TEST_LOG_SS(Error, "Can't save Simd::Neural::Network to binary file '" << binary << "'!");
+            return false;
+        }
+
+        Network mapped;
+        CreateNetwork(mapped, false, false);
+        if (!mapped.LoadBinary(binary))
+        {
+            TEST_LOG_SS(Error, "Can't load Simd::Neural::Network from binary file '" << binary << "'!");
+            std::remove(binary.c_str());
+            return false;
+        }
+
+        bool result = true;
+        for (size_t m = 0; m < 2 && result; ++m)
+        {
+            Simd::Neural::Layer::Method method = m ? Simd::Neural::Layer::Check : Simd::Neural::Layer::Fast;
+            for (size_t i = 0; i < sample.src.size() && result; ++i)
+            {
+                Vector control = net.Predict(sample.src[i], 0, method);
+                const Vector & current = mapped.Predict(sample.src[i], 0, method);
+                for (size_t j = 0; j < control.size() && result; ++j)
+                {
+                    if (::fabs(control[j] - current[j]) > EPS)
+                    {
+                        TEST_LOG_SS(Error, "Predictions of original and binary loaded networks differ for sample " << i << (m ? " (check)" : " (fast)") << " !");
+                        result = false;
+                    }
+                }
+            }
+        }
+
+        if (result)
+        {
+            std::stringstream control, current;
+            net.Save(control);
+            mapped.Save(current);
+            if (control.str() != current.str())
+            {
+                TEST_LOG_SS(Error, "Weights saved from original and binary loaded networks differ!");
+                result = false;
+            }
+        }
+
+        if (result)
+        {
+            std::ifstream ifs(binary.c_str(), std::ios::binary);
+            std::string original((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+            ifs.close();
+            const size_t position = sizeof(Simd::Neural::Detail::BinaryHeader) + offsetof(Simd::Neural::Detail::BinaryLayer, weightOffset);
+            uint64_t weightOffset;
+            memcpy(&weightOffset, original.data() + position, sizeof(weightOffset));
+            const uint64_t corrupted[2] = { uint64_t(-64), weightOffset + sizeof(float) };
+            String broken = "digit_broken.bin";
+            for (size_t c = 0; c < 2 && result; ++c)
+            {
+                std::string data = original;
+                memcpy((char*)data.data() + position, corrupted + c, sizeof(uint64_t));
+                std::ofstream ofs(broken.c_str(), std::ios::binary);
+                ofs.write(data.data(), data.size());
+                ofs.close();
+                Network network;
+                CreateNetwork(network, false, false);
+                if (network.LoadBinary(broken))
+                {
+                    TEST_LOG_SS(Error, "Binary file with " << (c ? "unaligned" : "out of range") << " weight offset is loaded!");
+                    result = false;
+                }
+            }
+            std::remove(broken.c_str());
+        }
+
+        mapped.Clear();
+        std::remove(binary.c_str());
+
+        TEST_LOG_SS(Info, "Binary model '" << binary << "' is checked.");
+
+        return result;
+    }
+
     SIMD_INLINE void Add(const TrainSample & src, size_t index, TrainSample & dst)
     {
         dst.src.push_back(src.src[index]);
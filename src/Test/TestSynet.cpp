@@ -25,6 +25,8 @@
 #include "Test/TestPerformance.h"
 #include "Test/TestData.h"
 
+#include "Simd/SimdSynet.hpp"
+
 namespace Test
 {
     namespace
@@ -388,6 +390,348 @@ namespace Test
 
     //-----------------------------------------------------------------------
 
+    namespace
+    {
+        struct FuncSA
+        {
+            typedef void(*FuncPtr)(const float * src, size_t size, float * dst);
+
+            FuncPtr func;
+            String desc;
+
+            FuncSA(const FuncPtr & f, const String & d) : func(f), desc(d) {}
+
+            void Call(const View & src, View & dst) const
+            {
+                TEST_PERFORMANCE_TEST(desc);
+                func((float*)src.data, src.width, (float*)dst.data);
+            }
+        };
+    }
+
+#define FUNC_SA(function) FuncSA(function, #function)
+
+    bool SynetActivationAutoTest(size_t size, float lo, float hi, float differenceMax, DifferenceType differenceType, const FuncSA & f1, const FuncSA & f2)
+    {
+        bool result = true;
+
+        TEST_LOG_SS(Info, "Test " << f1.desc << " & " << f2.desc << " [" << size << "] in range [" << lo << ", " << hi << "].");
+
+        View src(size, 1, View::Float, NULL, TEST_ALIGN(SIMD_ALIGN));
+        View dst1(size, 1, View::Float, NULL, TEST_ALIGN(SIMD_ALIGN));
+        View dst2(size, 1, View::Float, NULL, TEST_ALIGN(SIMD_ALIGN));
+
+        FillRandom32f(src, lo, hi);
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f1.Call(src, dst1));
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f2.Call(src, dst2));
+
+        result = result && Compare(dst1, dst2, differenceMax, true, 32, differenceType);
+
+        return result;
+    }
+
+    bool SynetActivationAutoTest(const FuncSA & f1, const FuncSA & f2)
+    {
+        bool result = true;
+
+        result = result && SynetActivationAutoTest(H*W, -10.0f, 10.0f, EPS, DifferenceAbsolute, f1, f2);
+        result = result && SynetActivationAutoTest(H*W + O, -10.0f, 10.0f, EPS, DifferenceAbsolute, f1, f2);
+
+        return result;
+    }
+
+    bool SynetGelu32fAutoTest()
+    {
+        bool result = true;
+
+        result = result && SynetActivationAutoTest(FUNC_SA(Simd::Base::SynetGelu32f), FUNC_SA(SimdSynetGelu32f));
+
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable)
+            result = result && SynetActivationAutoTest(FUNC_SA(Simd::Avx2::SynetGelu32f), FUNC_SA(SimdSynetGelu32f));
+#endif
+
+#ifdef SIMD_AVX512F_ENABLE
+        if (Simd::Avx512f::Enable)
+            result = result && SynetActivationAutoTest(FUNC_SA(Simd::Avx512f::SynetGelu32f), FUNC_SA(SimdSynetGelu32f));
+#endif
+
+        return result;
+    }
+
+    bool SynetSigmoid32fAutoTest()
+    {
+        bool result = true;
+
+        result = result && SynetActivationAutoTest(FUNC_SA(Simd::Base::SynetSigmoid32f), FUNC_SA(SimdSynetSigmoid32f));
+
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable)
+            result = result && SynetActivationAutoTest(FUNC_SA(Simd::Avx2::SynetSigmoid32f), FUNC_SA(SimdSynetSigmoid32f));
+#endif
+
+#ifdef SIMD_AVX512F_ENABLE
+        if (Simd::Avx512f::Enable)
+            result = result && SynetActivationAutoTest(FUNC_SA(Simd::Avx512f::SynetSigmoid32f), FUNC_SA(SimdSynetSigmoid32f));
+#endif
+
+        return result;
+    }
+
+    bool SynetTanh32fAutoTest()
+    {
+        bool result = true;
+
+        result = result && SynetActivationAutoTest(FUNC_SA(Simd::Base::SynetTanh32f), FUNC_SA(SimdSynetTanh32f));
+
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable)
+        {
+            result = result && SynetActivationAutoTest(FUNC_SA(Simd::Avx2::SynetTanh32f), FUNC_SA(SimdSynetTanh32f));
+            result = result && SynetActivationAutoTest(H*W, -0.01f, 0.01f, 0.00001f, DifferenceRelative, FUNC_SA(Simd::Base::SynetTanh32f), FUNC_SA(Simd::Avx2::SynetTanh32f));
+        }
+#endif
+
+#ifdef SIMD_AVX512F_ENABLE
+        if (Simd::Avx512f::Enable)
+        {
+            result = result && SynetActivationAutoTest(FUNC_SA(Simd::Avx512f::SynetTanh32f), FUNC_SA(SimdSynetTanh32f));
+            result = result && SynetActivationAutoTest(H*W, -0.01f, 0.01f, 0.00001f, DifferenceRelative, FUNC_SA(Simd::Base::SynetTanh32f), FUNC_SA(Simd::Avx512f::SynetTanh32f));
+        }
+#endif
+
+        return result;
+    }
+
+    //-----------------------------------------------------------------------
+
+    namespace
+    {
+        struct FuncE
+        {
+            typedef void(*FuncPtr)(const float * src, size_t size, const float * alpha, float * dst);
+
+            FuncPtr func;
+            String desc;
+
+            FuncE(const FuncPtr & f, const String & d) : func(f), desc(d) {}
+
+            void Call(const View & src, float alpha, View & dst) const
+            {
+                TEST_PERFORMANCE_TEST(desc);
+                func((float*)src.data, src.width, &alpha, (float*)dst.data);
+            }
+        };
+    }
+
+#define FUNC_E(function) FuncE(function, #function)
+
+    bool SynetElu32fAutoTest(size_t size, const FuncE & f1, const FuncE & f2)
+    {
+        bool result = true;
+
+        TEST_LOG_SS(Info, "Test " << f1.desc << " & " << f2.desc << " [" << size << "].");
+
+        View src(size, 1, View::Float, NULL, TEST_ALIGN(SIMD_ALIGN));
+        View dst1(size, 1, View::Float, NULL, TEST_ALIGN(SIMD_ALIGN));
+        View dst2(size, 1, View::Float, NULL, TEST_ALIGN(SIMD_ALIGN));
+
+        FillRandom32f(src, -10.0, 10.0);
+        float alpha = 1.1f;
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f1.Call(src, alpha, dst1));
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f2.Call(src, alpha, dst2));
+
+        result = result && Compare(dst1, dst2, EPS, true, 32, false);
+
+        return result;
+    }
+
+    bool SynetElu32fAutoTest(const FuncE & f1, const FuncE & f2)
+    {
+        bool result = true;
+
+        result = result && SynetElu32fAutoTest(H*W, f1, f2);
+        result = result && SynetElu32fAutoTest(H*W + O, f1, f2);
+
+        return result;
+    }
+
+    bool SynetElu32fAutoTest()
+    {
+        bool result = true;
+
+        result = result && SynetElu32fAutoTest(FUNC_E(Simd::Base::SynetElu32f), FUNC_E(SimdSynetElu32f));
+
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable)
+            result = result && SynetElu32fAutoTest(FUNC_E(Simd::Avx2::SynetElu32f), FUNC_E(SimdSynetElu32f));
+#endif
+
+#ifdef SIMD_AVX512F_ENABLE
+        if (Simd::Avx512f::Enable)
+            result = result && SynetElu32fAutoTest(FUNC_E(Simd::Avx512f::SynetElu32f), FUNC_E(SimdSynetElu32f));
+#endif
+
+        return result;
+    }
+
+    //-----------------------------------------------------------------------
+
+    namespace
+    {
+        struct FuncHS
+        {
+            typedef void(*FuncPtr)(const float * src, size_t size, const float * shift, const float * scale, float * dst);
+
+            FuncPtr func;
+            String desc;
+
+            FuncHS(const FuncPtr & f, const String & d) : func(f), desc(d) {}
+
+            void Call(const View & src, float shift, float scale, View & dst) const
+            {
+                TEST_PERFORMANCE_TEST(desc);
+                func((float*)src.data, src.width, &shift, &scale, (float*)dst.data);
+            }
+        };
+    }
+
+#define FUNC_HS(function) FuncHS(function, #function)
+
+    bool SynetHswish32fAutoTest(size_t size, const FuncHS & f1, const FuncHS & f2)
+    {
+        bool result = true;
+
+        TEST_LOG_SS(Info, "Test " << f1.desc << " & " << f2.desc << " [" << size << "].");
+
+        View src(size, 1, View::Float, NULL, TEST_ALIGN(SIMD_ALIGN));
+        View dst1(size, 1, View::Float, NULL, TEST_ALIGN(SIMD_ALIGN));
+        View dst2(size, 1, View::Float, NULL, TEST_ALIGN(SIMD_ALIGN));
+
+        FillRandom32f(src, -10.0, 10.0);
+        float shift = 3.0f;
+        float scale = 1.0f / 6.0f;
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f1.Call(src, shift, scale, dst1));
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f2.Call(src, shift, scale, dst2));
+
+        result = result && Compare(dst1, dst2, EPS, true, 32, false);
+
+        return result;
+    }
+
+    bool SynetHswish32fAutoTest(const FuncHS & f1, const FuncHS & f2)
+    {
+        bool result = true;
+
+        result = result && SynetHswish32fAutoTest(H*W, f1, f2);
+        result = result && SynetHswish32fAutoTest(H*W + O, f1, f2);
+
+        return result;
+    }
+
+    bool SynetHswish32fAutoTest()
+    {
+        bool result = true;
+
+        result = result && SynetHswish32fAutoTest(FUNC_HS(Simd::Base::SynetHswish32f), FUNC_HS(SimdSynetHswish32f));
+
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable)
+            result = result && SynetHswish32fAutoTest(FUNC_HS(Simd::Avx2::SynetHswish32f), FUNC_HS(SimdSynetHswish32f));
+#endif
+
+#ifdef SIMD_AVX512F_ENABLE
+        if (Simd::Avx512f::Enable)
+            result = result && SynetHswish32fAutoTest(FUNC_HS(Simd::Avx512f::SynetHswish32f), FUNC_HS(SimdSynetHswish32f));
+#endif
+
+        return result;
+    }
+
+    //-----------------------------------------------------------------------
+
+    namespace
+    {
+        struct FuncSM
+        {
+            typedef void(*FuncPtr)(const float * src, size_t outer, size_t count, size_t inner, float * dst);
+
+            FuncPtr func;
+            String desc;
+
+            FuncSM(const FuncPtr & f, const String & d) : func(f), desc(d) {}
+
+            void Call(const View & src, size_t outer, size_t count, size_t inner, View & dst) const
+            {
+                TEST_PERFORMANCE_TEST(desc);
+                func((float*)src.data, outer, count, inner, (float*)dst.data);
+            }
+        };
+    }
+
+#define FUNC_SM(function) FuncSM(function, #function)
+
+    bool SynetSoftmaxLayerForwardAutoTest(size_t outer, size_t count, size_t inner, const FuncSM & f1, const FuncSM & f2)
+    {
+        bool result = true;
+
+        TEST_LOG_SS(Info, "Test " << f1.desc << " & " << f2.desc << " [" << outer << ", " << count << ", " << inner << "].");
+
+        View src(outer*count*inner, 1, View::Float, NULL, TEST_ALIGN(SIMD_ALIGN));
+        View dst1(outer*count*inner, 1, View::Float, NULL, TEST_ALIGN(SIMD_ALIGN));
+        View dst2(outer*count*inner, 1, View::Float, NULL, TEST_ALIGN(SIMD_ALIGN));
+
+        FillRandom32f(src, -10.0, 10.0);
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f1.Call(src, outer, count, inner, dst1));
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f2.Call(src, outer, count, inner, dst2));
+
+        result = result && Compare(dst1, dst2, EPS, true, 32, false);
+
+        return result;
+    }
+
+    bool SynetSoftmaxLayerForwardAutoTest(const FuncSM & f1, const FuncSM & f2)
+    {
+        bool result = true;
+
+        result = result && SynetSoftmaxLayerForwardAutoTest(1, H, W, f1, f2);
+        result = result && SynetSoftmaxLayerForwardAutoTest(1, H - O, W + O, f1, f2);
+        result = result && SynetSoftmaxLayerForwardAutoTest(H, W, 1, f1, f2);
+        result = result && SynetSoftmaxLayerForwardAutoTest(H - O, W + O, 1, f1, f2);
+        result = result && SynetSoftmaxLayerForwardAutoTest(H*W/O, O, 1, f1, f2);
+
+        return result;
+    }
+
+    bool SynetSoftmaxLayerForwardAutoTest()
+    {
+        bool result = true;
+
+        result = result && SynetSoftmaxLayerForwardAutoTest(FUNC_SM(Simd::Base::SynetSoftmaxLayerForward), FUNC_SM(SimdSynetSoftmaxLayerForward));
+
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable)
+            result = result && SynetSoftmaxLayerForwardAutoTest(FUNC_SM(Simd::Avx2::SynetSoftmaxLayerForward), FUNC_SM(SimdSynetSoftmaxLayerForward));
+#endif
+
+#ifdef SIMD_AVX512F_ENABLE
+        if (Simd::Avx512f::Enable)
+            result = result && SynetSoftmaxLayerForwardAutoTest(FUNC_SM(Simd::Avx512f::SynetSoftmaxLayerForward), FUNC_SM(SimdSynetSoftmaxLayerForward));
+#endif
+
+        return result;
+    }
+
+    //-----------------------------------------------------------------------
+
     bool SynetAddBiasDataTest(bool create, size_t count, size_t size, const FuncAB & f)
     {
         bool result = true;
@@ -585,4 +929,139 @@ namespace Test
     {
         return SynetScaleLayerForwardDataTest(create, DH, DW, FUNC_SLF(SimdSynetScaleLayerForward));
     }
+
+    bool SynetSoftmaxLayerForwardDataTest(bool create, size_t outer, size_t count, size_t inner, const FuncSM & f)
+    {
+        bool result = true;
+
+        Data data(f.desc);
+
+        TEST_LOG_SS(Info, (create ? "Create" : "Verify") << " test " << f.desc << " [" << outer << ", " << count << ", " << inner << "].");
+
+        View src(outer*count*inner, 1, View::Float, NULL, TEST_ALIGN(SIMD_ALIGN));
+        View dst1(outer*count*inner, 1, View::Float, NULL, TEST_ALIGN(SIMD_ALIGN));
+        View dst2(outer*count*inner, 1, View::Float, NULL, TEST_ALIGN(SIMD_ALIGN));
+
+        if (create)
+        {
+            FillRandom32f(src, -10.0, 10.0);
+
+            TEST_SAVE(src);
+
+            f.Call(src, outer, count, inner, dst1);
+
+            TEST_SAVE(dst1);
+        }
+        else
+        {
+            TEST_LOAD(src);
+
+            TEST_LOAD(dst1);
+
+            f.Call(src, outer, count, inner, dst2);
+
+            TEST_SAVE(dst2);
+
+            result = result && Compare(dst1, dst2, EPS, true, 32, false);
+        }
+
+        return result;
+    }
+
+    bool SynetSoftmaxLayerForwardDataTest(bool create)
+    {
+        return SynetSoftmaxLayerForwardDataTest(create, 1, DH, DW, FUNC_SM(SimdSynetSoftmaxLayerForward));
+    }
+
+    //-----------------------------------------------------------------------
+
+    namespace
+    {
+        void Convolution(const Buffer32f & src, size_t N, size_t C, size_t H, size_t W, size_t D, size_t K, size_t S, size_t P, size_t G, bool deconvolution,
+            const Buffer32f & weight, const float * bias, SimdConvolutionActivationType activation, Buffer32f & dst)
+        {
+            void * handle = deconvolution ? 
+                SimdDeconvolutionInit(SimdFalse, N, C, H, W, D, K, K, 1, 1, S, S, P, P, P, P, G, activation, NULL) :
+                SimdConvolutionInit(SimdFalse, N, C, H, W, D, K, K, 1, 1, S, S, P, P, P, P, G, activation, NULL);
+            if (deconvolution)
+            {
+                SimdDeconvolutionSetWeight(handle, weight.data(), bias);
+                SimdDeconvolutionForward(handle, src.data(), NULL, dst.data());
+            }
+            else
+            {
+                SimdConvolutionSetWeight(handle, weight.data(), bias);
+                SimdConvolutionForward(handle, src.data(), NULL, dst.data());
+            }
+            SimdRelease(handle);
+        }
+    }
+
+    bool SynetNetworkSpecialTest()
+    {
+        bool result = true;
+
+        const size_t N = 2, C = 8, H = 24, W = 20, D = 16, size = H * W, count = D * size;
+
+        TEST_LOG_SS(Info, "Test Simd::Synet::Network [" << N << "x" << C << "x" << H << "x" << W << "].");
+
+        Buffer32f src(N * C * size), weight0(D * C * 9), bias0(D), scale(D), shift(D), weight1(D * D / 2 * 9), k(3), sum(2), weight2(D * D * 4), bias2(D);
+        FillRandom(src, -1.0f, 1.0f);
+        FillRandom(weight0, -1.0f, 1.0f);
+        FillRandom(bias0, -1.0f, 1.0f);
+        FillRandom(scale, 0.5f, 1.5f);
+        FillRandom(shift, -1.0f, 1.0f);
+        FillRandom(weight1, -0.2f, 0.2f);
+        FillRandom(weight2, -1.0f, 1.0f);
+        FillRandom(bias2, -1.0f, 1.0f);
+        k[0] = 1.0f, k[1] = 0.02f, k[2] = -0.75f;
+        sum[0] = 0.5f, sum[1] = 2.0f;
+
+        Simd::Synet::Network network(N);
+        Simd::Synet::Tensor t0 = network.Input(C, H, W);
+        Simd::Synet::Tensor t1 = network.Convolution(t0, D, 3, 1, 1, 1, weight0.data(), NULL);
+        Simd::Synet::Tensor t2 = network.AddBias(t1, bias0.data());
+        Simd::Synet::Tensor t3 = network.Scale(t2, scale.data(), shift.data());
+        Simd::Synet::Tensor t4 = network.Convolution(t3, D, 3, 1, 1, 2, weight1.data(), NULL, SimdConvolutionActivationRelu);
+        Simd::Synet::Tensor t5 = network.Lrn(t4, 2, k.data());
+        Simd::Synet::Tensor t6 = network.Eltwise({ t4, t5 }, SimdSynetEltwiseOperationSum, sum.data());
+        Simd::Synet::Tensor t7 = network.Scale(t6, scale.data(), NULL);
+        Simd::Synet::Tensor t8 = network.Deconvolution(t7, D, 2, 2, 0, 1, weight2.data(), bias2.data());
+        network.Output(t8);
+        if (!network.Build())
+        {
+            TEST_LOG_SS(Error, "Can't build Simd::Synet::Network!");
+            return false;
+        }
+        network.Forward(src.data());
+
+        Buffer32f b1(N * count), b2(N * count), b3(N * count), b4(N * count), dst(N * count * 4);
+        Convolution(src, N, C, H, W, D, 3, 1, 1, 1, false, weight0, NULL, SimdConvolutionActivationIdentity, b1);
+        for (size_t b = 0; b < N; ++b)
+        {
+            SimdSynetAddBias(bias0.data(), D, size, b1.data() + b * count);
+            SimdSynetScaleLayerForward(b1.data() + b * count, scale.data(), shift.data(), D, size, b1.data() + b * count);
+        }
+        Convolution(b1, N, D, H, W, D, 3, 1, 1, 2, false, weight1, NULL, SimdConvolutionActivationRelu, b2);
+        for (size_t b = 0; b < N; ++b)
+            SimdSynetLrnLayerCrossChannels(b2.data() + b * count, 2, D, size, k.data(), b3.data() + b * count);
+        const float * eltwise[2] = { b2.data(), b3.data() };
+        SimdSynetEltwiseLayerForward(eltwise, sum.data(), 2, N * count, SimdSynetEltwiseOperationSum, b4.data());
+        for (size_t b = 0; b < N; ++b)
+            SimdSynetScaleLayerForward(b4.data() + b * count, scale.data(), NULL, D, size, b4.data() + b * count);
+        Convolution(b4, N, D, H, W, D, 2, 2, 0, 1, true, weight2, bias2.data(), SimdConvolutionActivationIdentity, dst);
+
+        Buffer32f out(network.Data(t8), network.Data(t8) + dst.size());
+        result = result && Compare(out, dst, EPS*10, true, 32, DifferenceBoth, "network");
+
+        size_t naive = (b1.size() * 7 + dst.size()) * sizeof(float);
+        TEST_LOG_SS(Info, "Simd::Synet::Network uses " << network.MemoryUsage() << " bytes of arena (" << naive << " bytes for separate tensors).");
+        if (network.MemoryUsage() >= naive)
+        {
+            TEST_LOG_SS(Error, "Simd::Synet::Network memory arena is not reused!");
+            result = false;
+        }
+
+        return result;
+    }
 }
@@ -0,0 +1,363 @@
+/*
+* Tests for Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2018 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Test/TestUtils.h"
+#include "Test/TestPerformance.h"
+
+#include <atomic>
+
+#include "Simd/SimdParallel.hpp"
+#include "Simd/SimdContext.h"
+#include "Simd/SimdConvolution.h"
+
+namespace Test
+{
+    namespace
+    {
+        struct Coverage
+        {
+            size_t begin, end, blockAlign, threadNumber;
+            mutable std::vector<std::atomic<int>> counts;
+            mutable std::atomic<bool> wrong;
+
+            Coverage(size_t b, size_t e, size_t a, size_t t)
+                : begin(b), end(e), blockAlign(a), threadNumber(t), counts(e - b), wrong(false)
+            {
+                for (size_t i = 0; i < counts.size(); ++i)
+                    counts[i] = 0;
+            }
+
+            void operator()(size_t thread, size_t blockBegin, size_t blockEnd) const
+            {
+                if (thread >= threadNumber || blockBegin < begin || blockEnd > end || blockBegin >= blockEnd || (blockBegin - begin) % blockAlign)
+                    wrong = true;
+                for (size_t i = std::max(blockBegin, begin); i < std::min(blockEnd, end); ++i)
+                    counts[i - begin]++;
+            }
+
+            bool Check(const String & name, bool touched = true) const
+            {
+                if (wrong)
+                {
+                    TEST_LOG_SS(Error, name << ": wrong block or thread index!");
+                    return false;
+                }
+                for (size_t i = 0; i < counts.size(); ++i)
+                {
+                    if (counts[i] != (touched ? 1 : 0))
+                    {
+                        TEST_LOG_SS(Error, name << ": element " << begin + i << " is processed " << counts[i] << " times!");
+                        return false;
+                    }
+                }
+                return true;
+            }
+        };
+    }
+
+    bool ThreadPoolCoverageTest(size_t begin, size_t end, size_t blockAlign, size_t threadNumber)
+    {
+        TEST_LOG_SS(Info, "Test ThreadPool coverage [" << begin << ", " << end << "), align " << blockAlign << ", threads " << threadNumber << ".");
+
+        Simd::ThreadPool pool;
+        Coverage coverage(begin, end, blockAlign, threadNumber);
+        {
+            TEST_PERFORMANCE_TEST("Simd::Base::ThreadPool");
+            if (!pool.Run(begin, end, blockAlign, threadNumber, Simd::ThreadPool::Invoke<Coverage>, &coverage))
+            {
+                TEST_LOG_SS(Error, "Idle ThreadPool refuses to run a job!");
+                return false;
+            }
+        }
+
+        Coverage parallel(begin, end, blockAlign, threadNumber);
+        {
+            TEST_PERFORMANCE_TEST("SimdParallel");
+            Simd::Parallel(begin, end, parallel, threadNumber, blockAlign);
+        }
+
+        Coverage async(begin, end, blockAlign, threadNumber);
+        Simd::ParallelAsync(begin, end, async, threadNumber, blockAlign);
+
+        return coverage.Check("ThreadPool") && parallel.Check("Parallel") && async.Check("ParallelAsync");
+    }
+
+    bool ThreadPoolNestedTest()
+    {
+        TEST_LOG_SS(Info, "Test ThreadPool nested calls.");
+
+        Simd::ThreadPool pool;
+        const size_t outer = 16, inner = 1000, threadNumber = 4;
+        std::vector<Coverage*> coverages(outer);
+        for (size_t i = 0; i < outer; ++i)
+            coverages[i] = new Coverage(0, inner, 1, 1);
+        std::atomic<bool> refused(true);
+        auto function = [&](size_t thread, size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                if (pool.Run(0, inner, 1, threadNumber, Simd::ThreadPool::Invoke<Coverage>, coverages[i]))
+                    refused = false;
+                Simd::Parallel(0, inner, *coverages[i], threadNumber);
+            }
+        };
+        bool result = true;
+        {
+            TEST_PERFORMANCE_TEST("Simd::Base::ThreadPool");
+            result = pool.Run(0, outer, 1, threadNumber, Simd::ThreadPool::Invoke<decltype(function)>, &function);
+        }
+        if (!refused)
+        {
+            TEST_LOG_SS(Error, "ThreadPool runs a nested job instead of refusing it!");
+            result = false;
+        }
+        for (size_t i = 0; i < outer; ++i)
+        {
+            result = result && coverages[i]->Check("Nested Parallel");
+            delete coverages[i];
+        }
+        return result;
+    }
+
+    bool ThreadPoolConcurrentTest(size_t callers, size_t threadNumber)
+    {
+        TEST_LOG_SS(Info, "Test ThreadPool and Parallel with " << callers << " concurrent callers.");
+
+        Simd::ThreadPool pool;
+        const size_t size = 10000, repeats = 20;
+        std::vector<int> accepted(callers, 0), correct(callers, 1);
+        std::vector<std::thread> threads;
+        for (size_t c = 0; c < callers; ++c)
+        {
+            threads.push_back(std::thread([&, c]
+            {
+                for (size_t r = 0; r < repeats; ++r)
+                {
+                    Coverage direct(0, size, 4, threadNumber);
+                    bool run = pool.Run(0, size, 4, threadNumber, Simd::ThreadPool::Invoke<Coverage>, &direct);
+                    accepted[c] += run ? 1 : 0;
+                    if (!direct.Check("Concurrent ThreadPool", run))
+                        correct[c] = 0;
+
+                    Coverage parallel(0, size, 4, threadNumber);
+                    Simd::Parallel(0, size, parallel, threadNumber, 4);
+                    if (!parallel.Check("Concurrent Parallel"))
+                        correct[c] = 0;
+                }
+            }));
+        }
+        for (size_t c = 0; c < callers; ++c)
+            threads[c].join();
+
+        bool result = true;
+        size_t total = 0;
+        for (size_t c = 0; c < callers; ++c)
+        {
+            result = result && correct[c];
+            total += accepted[c];
+        }
+        if (total == 0)
+        {
+            TEST_LOG_SS(Error, "ThreadPool refuses all concurrent jobs!");
+            result = false;
+        }
+        return result;
+    }
+
+    bool ThreadPoolAutoTest()
+    {
+        bool result = true;
+
+        result = result && ThreadPoolCoverageTest(0, 1, 1, 4);
+        result = result && ThreadPoolCoverageTest(0, 1000, 1, 4);
+        result = result && ThreadPoolCoverageTest(17, 1017, 8, 3);
+        result = result && ThreadPoolCoverageTest(5, 12345, 16, 8);
+        result = result && ThreadPoolCoverageTest(0, 7, 1, 16);
+        result = result && ThreadPoolCoverageTest(0, 100000, 64, 2);
+
+        result = result && ThreadPoolNestedTest();
+
+        result = result && ThreadPoolConcurrentTest(4, 3);
+
+        return result;
+    }
+
+    //-----------------------------------------------------------------------
+
+    bool ContextAttachTest()
+    {
+        bool result = true;
+
+        TEST_LOG_SS(Info, "Test SimdContextInit, SimdSetContext and SimdGetContext.");
+
+        size_t global = ::SimdGetThreadNumber(), hardware = std::thread::hardware_concurrency();
+        void * context = ::SimdContextInit(hardware + 3);
+        {
+            TEST_PERFORMANCE_TEST("SimdSetContext");
+            if (::SimdContextGetThreadNumber(context) != hardware)
+            {
+                TEST_LOG_SS(Error, "Thread number of context " << ::SimdContextGetThreadNumber(context) << " is not restricted to " << hardware << "!");
+                result = false;
+            }
+            ::SimdContextSetThreadNumber(context, 1);
+            if (::SimdGetContext() != NULL || ::SimdGetThreadNumber() != global)
+            {
+                TEST_LOG_SS(Error, "Context must not be attached before SimdSetContext!");
+                result = false;
+            }
+
+            ::SimdSetContext(context);
+            if (::SimdGetContext() != context || ::SimdGetThreadNumber() != 1 || Simd::ThreadPool::Current() != &((Simd::Context*)context)->pool)
+            {
+                TEST_LOG_SS(Error, "Context is not attached by SimdSetContext!");
+                result = false;
+            }
+            ::SimdContextSetThreadNumber(context, hardware);
+            if (::SimdGetThreadNumber() != hardware)
+            {
+                TEST_LOG_SS(Error, "Thread number of attached context is not used!");
+                result = false;
+            }
+
+            std::thread other([&]
+            {
+                if (::SimdGetContext() != NULL || ::SimdGetThreadNumber() != global || Simd::ThreadPool::Current() != NULL)
+                {
+                    TEST_LOG_SS(Error, "Context is attached to other thread!");
+                    result = false;
+                }
+            });
+            other.join();
+
+            ::SimdSetContext(NULL);
+            if (::SimdGetContext() != NULL || ::SimdGetThreadNumber() != global || Simd::ThreadPool::Current() != NULL)
+            {
+                TEST_LOG_SS(Error, "Context is not detached by SimdSetContext(NULL)!");
+                result = false;
+            }
+        }
+        ::SimdRelease(context);
+
+        return result;
+    }
+
+    namespace
+    {
+        struct Pipeline
+        {
+            size_t srcC, srcH, srcW, dstC;
+            void * convolution;
+            std::vector<float> src, weight, bias, buf, control, dst;
+
+            Pipeline(size_t c, size_t h, size_t w, size_t d)
+                : srcC(c), srcH(h), srcW(w), dstC(d)
+            {
+                src.resize(srcC*srcH*srcW);
+                weight.resize(dstC*srcC * 9);
+                bias.resize(dstC);
+                FillRandom(src.data(), src.size(), -1.0f, 1.0f);
+                FillRandom(weight.data(), weight.size(), -1.0f, 1.0f);
+                FillRandom(bias.data(), bias.size(), -1.0f, 1.0f);
+                control.resize(dstC*srcH*srcW);
+                dst.resize(dstC*srcH*srcW);
+
+                void * base = Simd::Base::ConvolutionInit(SimdFalse, 1, srcC, srcH, srcW, dstC, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1, 1, SimdConvolutionActivationIdentity, NULL);
+                ::SimdConvolutionSetWeight(base, weight.data(), bias.data());
+                buf.resize(::SimdConvolutionBufferSize(base) + 1);
+                {
+                    TEST_PERFORMANCE_TEST("Simd::Base::ConvolutionForward");
+                    ::SimdConvolutionForward(base, src.data(), buf.data(), control.data());
+                }
+                ::SimdRelease(base);
+
+                convolution = ::SimdConvolutionInit(SimdFalse, 1, srcC, srcH, srcW, dstC, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1, 1, SimdConvolutionActivationIdentity, NULL);
+                ::SimdConvolutionSetWeight(convolution, weight.data(), bias.data());
+            }
+
+            ~Pipeline()
+            {
+                ::SimdRelease(convolution);
+            }
+
+            bool Run(void * context, size_t repeats)
+            {
+                bool result = true;
+                ::SimdSetContext(context);
+                for (size_t r = 0; r < repeats && result; ++r)
+                {
+                    {
+                        TEST_PERFORMANCE_TEST("SimdConvolutionForward");
+                        ::SimdConvolutionForward(convolution, src.data(), NULL, dst.data());
+                    }
+                    for (size_t i = 0; i < dst.size() && result; ++i)
+                        result = ::fabs(dst[i] - control[i]) <= EPS*Simd::Max(1.0f, ::fabs(control[i]));
+                }
+                ::SimdSetContext(NULL);
+                return result;
+            }
+        };
+    }
+
+    bool ContextParallelTest(bool shared)
+    {
+        bool result = true;
+
+        TEST_LOG_SS(Info, "Test two pipelines running in parallel with " << (shared ? "shared context" : "own contexts") << ".");
+
+        size_t hardware = std::thread::hardware_concurrency();
+        Pipeline small(8, 16, 16, 8), large(64, 56, 56, 64);
+        void * contexts[2];
+        contexts[0] = ::SimdContextInit(std::max<size_t>(hardware / 2, 1));
+        contexts[1] = shared ? contexts[0] : ::SimdContextInit(hardware);
+
+        bool results[2] = { true, true };
+        std::thread first([&] { results[0] = small.Run(contexts[0], 200); });
+        std::thread second([&] { results[1] = large.Run(contexts[1], 10); });
+        first.join();
+        second.join();
+
+        if (!results[0] || !results[1])
+        {
+            TEST_LOG_SS(Error, "Output of convolution in parallel pipeline differs from control!");
+            result = false;
+        }
+
+        ::SimdRelease(contexts[0]);
+        if (!shared)
+            ::SimdRelease(contexts[1]);
+
+        return result;
+    }
+
+    bool ContextAutoTest()
+    {
+        bool result = true;
+
+        result = result && ContextAttachTest();
+
+        result = result && ContextParallelTest(false);
+        result = result && ContextParallelTest(true);
+
+        return result;
+    }
+}
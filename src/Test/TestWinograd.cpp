@@ -228,6 +228,11 @@ namespace Test
 
         result = result && WinogradSetInputAutoTest(4, 3, FUNC_WI(Simd::Base::Winograd4x3pSetInput), FUNC_WI(SimdWinograd4x3pSetInput));
 
+#ifdef SIMD_SSE_ENABLE
+        if (Simd::Sse::Enable)
+            result = result && WinogradSetInputAutoTest(4, 3, FUNC_WI(Simd::Sse::Winograd4x3pSetInput), FUNC_WI(SimdWinograd4x3pSetInput));
+#endif 
+
         return result;
     }
 
@@ -349,6 +354,11 @@ namespace Test
 
         result = result && WinogradSetOutputAutoTest(4, 3, FUNC_WO(Simd::Base::Winograd4x3pSetOutput), FUNC_WO(SimdWinograd4x3pSetOutput));
 
+#ifdef SIMD_SSE_ENABLE
+        if (Simd::Sse::Enable)
+            result = result && WinogradSetOutputAutoTest(4, 3, FUNC_WO(Simd::Sse::Winograd4x3pSetOutput), FUNC_WO(SimdWinograd4x3pSetOutput));
+#endif 
+
         return result;
     }
 